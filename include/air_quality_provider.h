@@ -1,14 +1,17 @@
 #pragma once
 
 #include "data_models.h"
+#include "fetch_cancel.h"
 #include "provider_result.h"
+#include "response_body.h"
 
 /* Interface for air quality providers.
  *
  * Implementations are responsible for fetching provider-specific data and
  * mapping it into the generic air quality model. Each implementation owns its
- * own transport (WiFiClient / WiFiClientSecure) and opens and closes the
- * connection inside fetch().
+ * own transport (WiFiClient / TlsSessionClient) and opens and closes the
+ * connection inside fetch(), which must give up promptly once `cancel` is
+ * cancelled or expired (see fetch_cancel.h).
  *
  * Returns ProviderResult::ok() on success. On failure, detail() holds a
  * already-localized message suitable for the error screen.
@@ -16,5 +19,5 @@
 class AirQualityProvider {
  public:
   virtual ~AirQualityProvider() = default;
-  virtual ProviderResult fetch(air_quality_t &airQuality) = 0;
+  virtual ProviderResult fetch(air_quality_t &airQuality, const FetchCancel &cancel) = 0;
 };
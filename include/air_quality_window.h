@@ -0,0 +1,103 @@
+/* Rolling 24-hour window of a streamed air quality response.
+ * Copyright (C) 2026  Lumixen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include "data_models.h"
+
+/*
+ * Both air quality APIs can answer with other hourly rows than the model
+ * holds (a row past `now` when the server's current hour is ahead of the
+ * local clock), and the model wants the NUM_AIR_POLLUTION rows ending at
+ * the last one at or before `now`. The streaming decoders hand every
+ * timestamp and every value to this window as they are parsed, in whatever
+ * order the response lays them out: column by column (Open-Meteo: all
+ * timestamps, then each pollutant) or row by row (OWM: the components of a
+ * row, then its dt). resolve() makes the cut once the document closed.
+ *
+ * Each column is a circular buffer of NUM_AIR_POLLUTION + 1 slots indexed by
+ * row % slots, so its memory is one air_quality_t plus a row. Rows keep
+ * coming after the cut (forecast hours): a timestamp past `now` fixes the
+ * cut and later rows are dropped from then on. The spare slot covers the one
+ * row a row-major response sends before its timestamp tells it is too late.
+ */
+class AirQualityWindow {
+ public:
+  // Columns of a row, in air_quality_components_t order.
+  enum class Pollutant : uint8_t { CO, NO, NO2, O3, SO2, PM2_5, PM10, NH3, COUNT };
+
+  explicit AirQualityWindow(int64_t now) : now_(now) {
+    for (int32_t &last : lastRow_) {
+      last = -1;
+    }
+  }
+
+  // Timestamp of row `row`; rows arrive in ascending time.
+  void time(size_t row, int64_t dt) {
+    if (cutFixed_ || dt > now_) {
+      cutFixed_ = true;
+      return;
+    }
+    cut_ = static_cast<int32_t>(row);
+    dt_[row % SLOTS] = dt;
+  }
+
+  // Concentration of `pollutant` at row `row`; rows arrive in ascending
+  // order per pollutant. Nulls are passed as 0, like the DOM decoder read
+  // them.
+  void value(Pollutant pollutant, size_t row, float concentration) {
+    if (cutFixed_ && static_cast<int32_t>(row) > cut_) {
+      return;
+    }
+    const size_t column = static_cast<size_t>(pollutant);
+    values_[column][row % SLOTS] = concentration;
+    lastRow_[column] = static_cast<int32_t>(row);
+  }
+
+  /* Copy the rows ending at the last timestamp at or before `now` into
+   * `airQuality`, oldest first; slots past the returned count are zeroed.
+   * Values a column no longer holds (it ran past the cut before any
+   * timestamp fixed it) read 0. */
+  size_t resolve(air_quality_t &airQuality) const {
+    airQuality = {};
+    if (cut_ < 0) {
+      return 0;
+    }
+    const int32_t start = cut_ >= NUM_AIR_POLLUTION ? cut_ - NUM_AIR_POLLUTION + 1 : 0;
+    const size_t count = static_cast<size_t>(cut_ - start + 1);
+    float *columns[COLUMNS] = {airQuality.components.co,   airQuality.components.no,
+                               airQuality.components.no2,  airQuality.components.o3,
+                               airQuality.components.so2,  airQuality.components.pm2_5,
+                               airQuality.components.pm10, airQuality.components.nh3};
+    for (size_t i = 0; i < count; ++i) {
+      const int32_t row = start + static_cast<int32_t>(i);
+      airQuality.dt[i] = dt_[row % SLOTS];
+      for (size_t c = 0; c < COLUMNS; ++c) {
+        if (row <= lastRow_[c] && row > lastRow_[c] - static_cast<int32_t>(SLOTS)) {
+          columns[c][i] = values_[c][row % SLOTS];
+        }
+      }
+    }
+    return count;
+  }
+
+ private:
+  static constexpr size_t SLOTS = NUM_AIR_POLLUTION + 1;
+  static constexpr size_t COLUMNS = static_cast<size_t>(Pollutant::COUNT);
+
+  int64_t now_;
+  int32_t cut_ = -1;  // last row at or before now_, -1 while none
+  bool cutFixed_ = false;
+  int64_t dt_[SLOTS] = {};
+  float values_[COLUMNS][SLOTS] = {};
+  int32_t lastRow_[COLUMNS];  // last row stored per column, -1 while none
+};
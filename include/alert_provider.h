@@ -2,12 +2,14 @@
 
 #include <vector>
 #include "data_models.h"
+#include "fetch_cancel.h"
 #include "provider_result.h"
 
 /* Interface for national weather alert providers.
  *
  * Alerts may be served by the weather provider itself (when they ride along
- * in the weather response) or by a dedicated external provider.
+ * in the weather response) or by a dedicated external provider. fetch()
+ * must give up promptly once `cancel` is cancelled or expired.
  *
  * Returns ProviderResult::ok() on success. On failure, detail() holds a
  * already-localized message suitable for the error screen.
@@ -15,5 +17,5 @@
 class AlertProvider {
  public:
   virtual ~AlertProvider() = default;
-  virtual ProviderResult fetch(std::vector<weather_alert_t> &alerts) = 0;
+  virtual ProviderResult fetch(std::vector<weather_alert_t> &alerts, const FetchCancel &cancel) = 0;
 };
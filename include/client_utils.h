@@ -21,11 +21,18 @@
 #include <WiFi.h>
 #include <WiFiClient.h>
 #include "config.h"
+#include "fetch_cancel.h"
 #include "provider_result.h"
+#include "response_body.h"
 
 wl_status_t startWiFi(int8_t &wifiRSSI);
 void killWiFi();
 
+/* Forget the access point and DHCP lease kept for fast connect. Call when the
+ * network misbehaved after connecting (a reused lease may have gone stale),
+ * so the next wake scans and renews the lease through DHCP. */
+void forgetWiFiFastConnect();
+
 /* Perform an HTTP GET request with retry.
  *
  * Returns ProviderResult::ok() once the response was received and parsed
@@ -33,25 +40,36 @@ void killWiFi();
  * errors are phrased from getHttpResponsePhrase() by this function, and
  * parse failures carry the message the `parse` callback returned.
  *
- * The `parse` callback is invoked with the response stream once the request
+ * The `parse` callback is invoked with the response body once the request
  * succeeds and is responsible for deserializing and mapping the provider
- * response into the output model. `expectedLen` is the response content
- * length in bytes (0 if unknown); providers may use it to stop reading
- * exactly at the end of the body instead of reading until EOF.
+ * response into the output model. The body is handed out in chunks (see
+ * response_body.h) and ends at the declared content length when there is
+ * one; `expectedLen` is that length in bytes (0 if unknown).
  *
  * `timeoutMs` sets both the TCP connect timeout and the read timeout of the
  * response stream. Providers with large responses (e.g. the MeteoAlarm feed
  * is hundreds of KB) must pass a value large enough to stream the whole body.
+ *
+ * `cancel` bounds the whole call: no connect outlasts the budget left, no
+ * retry starts once it is cancelled or expired, and the body read stops
+ * within a few ms of it (the connection is then closed and an error
+ * returned).
+ *
+ * With `acceptCompressed` the request offers gzip/deflate (over HTTP/1.0, so
+ * a compressed body of unknown length is close-delimited, never chunked) and
+ * a compressed response is decoded on the fly: `parse` then reads the
+ * decompressed body and gets 0 for `expectedLen`.
  */
 ProviderResult httpGetWithRetry(WiFiClient &client, const String &host, uint16_t port, const String &uri,
-                                const String &sanitizedUri, bool useHttp10, uint32_t timeoutMs,
-                                std::function<ProviderResult(Stream &, size_t expectedLen)> parse);
+                                const String &sanitizedUri, bool useHttp10, bool acceptCompressed, uint32_t timeoutMs,
+                                const FetchCancel &cancel,
+                                std::function<ProviderResult(ResponseBody &, size_t expectedLen)> parse);
 
-/* Buffered input stream adapter feeding a streaming JSON parser (such as
- * rapidjson's SAX reader) from an Arduino Stream, e.g. the live HTTP
- * response body of an HTTPClient. The underlying stream is read in
- * 64-byte chunks, so each refill issues a single bulk read instead of one
- * call per byte. EOF is signalled by '\0', the rapidjson convention.
+/* Input stream adapter feeding a streaming JSON parser (such as rapidjson's
+ * SAX reader) from a ResponseBody, e.g. the live HTTP response body. The
+ * adapter reads the body's chunks in place, so there is no copy and no call
+ * into the transport per byte. EOF is signalled by '\0', the rapidjson
+ * convention.
  *
  * Implements the rapidjson InputStream concept: Ch, Peek(), Take(), Tell()
  * and the in-place editing hooks PutBegin()/Put()/PutEnd() (only reached
@@ -62,14 +80,14 @@ class StreamInput {
  public:
   typedef char Ch;
 
-  explicit StreamInput(Stream &stream) : stream_(stream), pos_(0), len_(0), total_(0) {}
+  explicit StreamInput(ResponseBody &body) : body_(body), chunk_(nullptr), pos_(0), len_(0), total_(0) {}
 
   char Peek() {
     if (pos_ >= len_ && !fill()) {
       reachedEof_ = true;
       return '\0';
     }
-    return buffer_[pos_];
+    return chunk_[pos_];
   }
 
   char Take() {
@@ -78,14 +96,14 @@ class StreamInput {
       return '\0';
     }
     ++total_;
-    return buffer_[pos_++];
+    return chunk_[pos_++];
   }
 
   size_t Tell() { return total_; }
 
-  /* True once the underlying stream returned no more bytes (seen by either
-   * Peek() or Take()). Lets parsers classify a parse error as premature end
-   * of input (IncompleteInput) instead of invalid syntax. */
+  /* True once the body returned no more bytes (seen by either Peek() or
+   * Take()). Lets parsers classify a parse error as premature end of input
+   * (IncompleteInput) instead of invalid syntax. */
   bool reachedEof() const { return reachedEof_; }
 
   // In-place editing hooks. Only reached with
@@ -106,14 +124,13 @@ class StreamInput {
 
  private:
   bool fill() {
-    const size_t n = stream_.readBytes(buffer_, sizeof(buffer_));
     pos_ = 0;
-    len_ = n;
-    return n > 0;
+    len_ = 0;
+    return body_.next(chunk_, len_);
   }
 
-  Stream &stream_;
-  char buffer_[64];
+  ResponseBody &body_;
+  const char *chunk_;
   char scratch_[64];
   size_t scratchLen_ = 0;
   size_t pos_;
@@ -0,0 +1,204 @@
+/* Fast path for the numeric column arrays of Open-Meteo responses.
+ * Copyright (C) 2026  Lumixen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+/*
+ * Open-Meteo sends hourly and daily data as long arrays of plain numbers
+ * ("temperature_2m":[21.5,21.2,...]). Fed to the streaming JSON parser, each
+ * element costs a pass through its state machine, an ElementPath for the
+ * value() callback and a number conversion. Once the parser opened a column
+ * the decoder knows, ColumnScanner takes the bytes up to the closing bracket
+ * instead: it splits the elements itself and converts each one straight to
+ * a double for the caller's sink, and the parser is then handed the ']' as
+ * if the array had been empty.
+ *
+ * Elements are numbers or null (skipped, but counted). Anything else (a
+ * string, a nested value, a stray comma) is an error: the scanner cannot
+ * hand a half-read array back to the parser.
+ */
+namespace column_scanner {
+
+/* Parse the JSON number in [text, text + len) into `out`. Short decimals
+ * (at most 19 significant digits, a power of ten within 1e±22) take the
+ * exact fast path: mantissa times or over an exactly representable power of
+ * ten, one rounding, so the result is the correctly rounded double strtod
+ * returns. Longer numbers go to strtod. Returns false unless the whole
+ * range is one number in the JSON grammar. */
+inline bool parseNumber(const char *text, size_t len, double &out) {
+  static const double POW10[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+  const char *p = text;
+  const char *end = text + len;
+  const bool negative = p < end && *p == '-';
+  if (negative) {
+    ++p;
+  }
+  if (p == end || *p < '0' || *p > '9' || (*p == '0' && p + 1 < end && p[1] >= '0' && p[1] <= '9')) {
+    return false;  // no integer part, or a leading zero
+  }
+  uint64_t mantissa = 0;
+  int digits = 0;  // significant digits in `mantissa`
+  int scale = 0;   // decimal exponent of `mantissa`'s last digit
+  bool exact = true;
+  for (; p < end && *p >= '0' && *p <= '9'; ++p) {
+    if (digits < 19) {
+      mantissa = mantissa * 10 + static_cast<uint64_t>(*p - '0');
+      digits += mantissa != 0 ? 1 : 0;
+    } else {
+      exact = false;
+    }
+  }
+  if (p < end && *p == '.') {
+    ++p;
+    if (p == end || *p < '0' || *p > '9') {
+      return false;
+    }
+    for (; p < end && *p >= '0' && *p <= '9'; ++p) {
+      if (digits < 19) {
+        mantissa = mantissa * 10 + static_cast<uint64_t>(*p - '0');
+        digits += mantissa != 0 ? 1 : 0;
+        --scale;
+      } else {
+        exact = false;
+      }
+    }
+  }
+  if (p < end && (*p == 'e' || *p == 'E')) {
+    ++p;
+    const bool negativeExponent = p < end && *p == '-';
+    if (p < end && (*p == '-' || *p == '+')) {
+      ++p;
+    }
+    if (p == end || *p < '0' || *p > '9') {
+      return false;
+    }
+    int exponent = 0;
+    for (; p < end && *p >= '0' && *p <= '9'; ++p) {
+      exponent = exponent < 10000 ? exponent * 10 + (*p - '0') : exponent;
+    }
+    scale += negativeExponent ? -exponent : exponent;
+  }
+  if (p != end) {
+    return false;
+  }
+  if (exact && mantissa < (1ULL << 53) && scale >= -22 && scale <= 22) {
+    const double value = static_cast<double>(mantissa);
+    out = scale < 0 ? value / POW10[-scale] : value * POW10[scale];
+  } else {
+    char buffer[64];
+    if (len >= sizeof(buffer)) {
+      return false;
+    }
+    memcpy(buffer, text, len);
+    buffer[len] = '\0';
+    out = strtod(buffer, nullptr);
+    return true;  // sign already applied by strtod
+  }
+  out = negative ? -out : out;
+  return true;
+}
+
+/* Splits the elements of one array, across as many chunks as it takes. */
+class ColumnScanner {
+ public:
+  enum class Status : uint8_t { MORE, DONE, ERROR };
+
+  // Start on a new array; the '[' was consumed by the parser.
+  void reset() {
+    state_ = State::FIRST;
+    tokenLen_ = 0;
+    index_ = 0;
+  }
+
+  /* Scan `len` bytes of the array. DONE stops at the ']' (not consumed),
+   * MORE has used the whole chunk, ERROR stopped at an offending byte.
+   * `used` gets the bytes consumed; `sink(index, value)` gets each number. */
+  template <typename Sink>
+  Status scan(const char *data, size_t len, size_t &used, Sink &&sink) {
+    size_t i = 0;
+    while (i < len) {
+      const char c = data[i];
+      if (state_ == State::TOKEN) {
+        if (isTokenChar(c)) {
+          if (tokenLen_ == sizeof(token_)) {
+            used = i;
+            return Status::ERROR;
+          }
+          token_[tokenLen_++] = c;
+          ++i;
+          continue;
+        }
+        if (!endToken(sink)) {
+          used = i;
+          return Status::ERROR;
+        }
+        state_ = State::AFTER;
+      }
+      if (c == ' ' || c == '\n' || c == '\r' || c == '\t') {
+        ++i;
+      } else if (c == ']' && (state_ == State::FIRST || state_ == State::AFTER)) {
+        used = i;
+        return Status::DONE;
+      } else if (c == ',' && state_ == State::AFTER) {
+        state_ = State::NEXT;
+        ++index_;
+        ++i;
+      } else if (state_ != State::AFTER && isTokenChar(c)) {
+        state_ = State::TOKEN;
+        token_[0] = c;
+        tokenLen_ = 1;
+        ++i;
+      } else {
+        used = i;
+        return Status::ERROR;
+      }
+    }
+    used = len;
+    return Status::MORE;
+  }
+
+ private:
+  enum class State : uint8_t {
+    FIRST,  // after '[': an element or ']'
+    NEXT,   // after ',': an element
+    TOKEN,  // inside an element
+    AFTER,  // after an element: ',' or ']'
+  };
+
+  static bool isTokenChar(char c) {
+    return (c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E' || c == 'n' ||
+           c == 'u' || c == 'l';
+  }
+
+  template <typename Sink>
+  bool endToken(Sink &sink) {
+    if (tokenLen_ == 4 && memcmp(token_, "null", 4) == 0) {
+      return true;
+    }
+    double value;
+    if (!parseNumber(token_, tokenLen_, value)) {
+      return false;
+    }
+    sink(index_, value);
+    return true;
+  }
+
+  State state_ = State::FIRST;
+  char token_[32];
+  uint8_t tokenLen_ = 0;
+  size_t index_ = 0;
+};
+
+}  // namespace column_scanner
@@ -17,6 +17,7 @@
 #pragma once
 
 #include <Arduino.h>
+#include <optional>
 #include <vector>
 
 #define NUM_HOURLY 24  // 48
@@ -0,0 +1,289 @@
+/* Display list of one e-paper scene, recorded once and replayed per page.
+ * Copyright (C) 2026  Lumixen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "text_metrics.h"
+
+/*
+ * The 3-color and 7-color panels are driven with a page buffer of half or a
+ * quarter of the screen: the whole scene is drawn once per page and GxEPD2
+ * clips it to the page band. Every String format, text measurement, AQI
+ * computation and icon lookup of the draw functions then runs two to four
+ * times.
+ *
+ * A DisplayList takes the drawing calls the renderer makes, with the names
+ * and semantics of Adafruit_GFX, and stores them as a compact command buffer:
+ * text runs at their final cursor position, inverted bitmaps, lines, pixels
+ * and stipples (pixels on a grid: dotted rules, hatched bars). Text is
+ * measured here exactly like Adafruit_GFX::getTextBounds() does (text size
+ * 1, no wrap), so the draw functions can align and chain runs with
+ * getCursorX() while recording. Fonts with a generated metrics table
+ * (setMetrics(), text_metrics.h) are measured from it, others from their
+ * glyph table; a string measured with measureText() to align it is recorded
+ * with printMeasured() without being measured again.
+ * Each command keeps the rows it covers, and replay() hands a page only the
+ * commands that intersect its band.
+ *
+ * Capacity is fixed. A command or text run that does not fit is dropped and
+ * overflowed() is set; the cursor still advances so later runs keep their
+ * positions.
+ *
+ * Font is Adafruit's GFXfont or a struct with the same members; a null font
+ * is the built-in 6x8 font. Canvas is anything with Adafruit_GFX's drawing
+ * methods (GxEPD2 in the firmware).
+ */
+namespace display_list {
+
+enum class Op : uint8_t { TEXT, BITMAP, LINE, PIXEL, STIPPLE };
+
+template <typename Font, size_t MAX_COMMANDS, size_t TEXT_BYTES>
+class DisplayList {
+ public:
+  static_assert(TEXT_BYTES <= INT16_MAX, "text offsets are 16-bit");
+
+  struct Command {
+    const void *ref;  // font (TEXT) or bitmap (BITMAP)
+    int16_t x, y;
+    int16_t a, b;         // LINE: end point; BITMAP, STIPPLE: size; TEXT: text offset
+    int16_t top, bottom;  // rows covered, inclusive
+    uint16_t color;
+    Op op;
+    uint8_t stepX, stepY;  // STIPPLE
+  };
+
+  void clear() {
+    count_ = 0;
+    textUsed_ = 0;
+    overflowed_ = false;
+    font_ = nullptr;
+    textColor_ = 0;
+    cursorX_ = 0;
+    cursorY_ = 0;
+    metrics_ = nullptr;
+    measureCalls_ = 0;
+    measuredChars_ = 0;
+  }
+
+  // Metrics tables of the fonts setFont() will be given; kept across clear().
+  void setMetrics(const text_metrics::FontMetrics *table, size_t count) {
+    metricsTable_ = table;
+    metricsCount_ = count;
+  }
+
+  void setFont(const Font *font) {
+    font_ = font;
+    metrics_ = font == nullptr ? nullptr : text_metrics::find(metricsTable_, metricsCount_, font);
+  }
+  void setTextColor(uint16_t color) { textColor_ = color; }
+  void setCursor(int16_t x, int16_t y) {
+    cursorX_ = x;
+    cursorY_ = y;
+  }
+  int16_t getCursorX() const { return cursorX_; }
+  int16_t getCursorY() const { return cursorY_; }
+
+  // Box of `text` relative to the cursor and its advance, in the current font.
+  text_metrics::Extent measureText(const char *text) const {
+    ++measureCalls_;
+    measuredChars_ += strlen(text);
+    return metrics_ != nullptr ? text_metrics::measure(*metrics_, text) : walkGlyphs(text);
+  }
+
+  // Box of `text` printed at (x, y) with the current font; w = h = 0 and
+  // (x1, y1) = (x, y) when no glyph has pixels.
+  void getTextBounds(const char *text, int16_t x, int16_t y, int16_t *x1, int16_t *y1, uint16_t *w,
+                     uint16_t *h) const {
+    const text_metrics::Extent extent = measureText(text);
+    *x1 = extent.empty() ? x : static_cast<int16_t>(x + extent.minX);
+    *y1 = extent.empty() ? y : static_cast<int16_t>(y + extent.minY);
+    *w = extent.width();
+    *h = extent.height();
+  }
+
+  // Byte `c` in the current font as measureText() sees it: '\n', '\r' (the
+  // renderer prints single lines) and bytes outside the font are blanks
+  // without advance.
+  text_metrics::GlyphMetrics glyphMetrics(uint8_t c) const {
+    static constexpr text_metrics::GlyphMetrics SKIPPED = {0, 1, 0, 1, 0};
+    if (c == '\n' || c == '\r') {
+      return SKIPPED;
+    }
+    if (font_ == nullptr) {
+      return text_metrics::GlyphMetrics{6, 0, 5, 0, 7};  // built-in 6x8 font
+    }
+    if (c < font_->first || c > font_->last) {
+      return SKIPPED;
+    }
+    return metrics_ != nullptr ? metrics_->glyphs[c - font_->first]
+                               : text_metrics::fromGlyph(font_->glyph[c - font_->first]);
+  }
+
+  // Text run at the cursor in the current font and text color; advances the
+  // cursor like Print::print().
+  void print(const char *text) { printMeasured(text, measureText(text)); }
+
+  // print() of a `text` whose measureText() is `extent`, with the same font.
+  void printMeasured(const char *text, const text_metrics::Extent &extent) {
+    const int16_t x = cursorX_;
+    const int16_t y = cursorY_;
+    cursorX_ = static_cast<int16_t>(x + extent.advance);
+    if (extent.empty()) {
+      return;  // nothing visible
+    }
+    const size_t len = strlen(text);
+    if (textUsed_ + len + 1 > TEXT_BYTES) {
+      overflowed_ = true;
+      return;
+    }
+    Command *command = add(Op::TEXT, x, y, static_cast<int16_t>(y + extent.minY), static_cast<int16_t>(y + extent.maxY),
+                           textColor_);
+    if (command == nullptr) {
+      return;
+    }
+    memcpy(text_ + textUsed_, text, len + 1);
+    command->ref = font_;
+    command->a = static_cast<int16_t>(textUsed_);
+    textUsed_ += len + 1;
+  }
+
+  void drawInvertedBitmap(int16_t x, int16_t y, const uint8_t *bitmap, int16_t w, int16_t h, uint16_t color) {
+    Command *command = add(Op::BITMAP, x, y, y, static_cast<int16_t>(y + h - 1), color);
+    if (command != nullptr) {
+      command->ref = bitmap;
+      command->a = w;
+      command->b = h;
+    }
+  }
+
+  void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
+    Command *command = add(Op::LINE, x0, y0, y0 < y1 ? y0 : y1, y0 < y1 ? y1 : y0, color);
+    if (command != nullptr) {
+      command->a = x1;
+      command->b = y1;
+    }
+  }
+
+  void drawPixel(int16_t x, int16_t y, uint16_t color) { add(Op::PIXEL, x, y, y, y, color); }
+
+  // Pixels at (x + i * stepX, y + j * stepY) inside the w x h box at (x, y):
+  // one command for what would be hundreds of drawPixel() calls.
+  void drawStipple(int16_t x, int16_t y, int16_t w, int16_t h, uint8_t stepX, uint8_t stepY, uint16_t color) {
+    if (w <= 0 || h <= 0 || stepX == 0 || stepY == 0) {
+      return;
+    }
+    Command *command = add(Op::STIPPLE, x, y, y, static_cast<int16_t>(y + h - 1), color);
+    if (command != nullptr) {
+      command->a = w;
+      command->b = h;
+      command->stepX = stepX;
+      command->stepY = stepY;
+    }
+  }
+
+  // Draw the commands covering a row in [top, bottom) onto `canvas`, in
+  // recording order. Returns how many were drawn.
+  template <typename Canvas>
+  size_t replay(Canvas &canvas, int16_t top, int16_t bottom) const {
+    size_t drawn = 0;
+    for (size_t i = 0; i < count_; ++i) {
+      const Command &c = commands_[i];
+      if (c.bottom < top || c.top >= bottom) {
+        continue;
+      }
+      ++drawn;
+      switch (c.op) {
+        case Op::TEXT:
+          canvas.setFont(static_cast<const Font *>(c.ref));
+          canvas.setTextColor(c.color);
+          canvas.setCursor(c.x, c.y);
+          canvas.print(text_ + c.a);
+          break;
+        case Op::BITMAP:
+          canvas.drawInvertedBitmap(c.x, c.y, static_cast<const uint8_t *>(c.ref), c.a, c.b, c.color);
+          break;
+        case Op::LINE:
+          canvas.drawLine(c.x, c.y, c.a, c.b, c.color);
+          break;
+        case Op::PIXEL:
+          canvas.drawPixel(c.x, c.y, c.color);
+          break;
+        case Op::STIPPLE: {
+          // Only the rows inside the band, the canvas would clip the others.
+          int32_t row = c.y;
+          if (row < top) {
+            row += (top - row + c.stepY - 1) / c.stepY * c.stepY;
+          }
+          for (; row <= c.bottom && row < bottom; row += c.stepY) {
+            for (int32_t col = c.x; col < c.x + c.a; col += c.stepX) {
+              canvas.drawPixel(static_cast<int16_t>(col), static_cast<int16_t>(row), c.color);
+            }
+          }
+          break;
+        }
+      }
+    }
+    return drawn;
+  }
+
+  size_t size() const { return count_; }
+  size_t textBytes() const { return textUsed_; }
+  // Whether a command or text run was dropped since clear().
+  bool overflowed() const { return overflowed_; }
+  const Command &operator[](size_t i) const { return commands_[i]; }
+  // Strings measured and characters walked since clear().
+  size_t measureCalls() const { return measureCalls_; }
+  size_t measuredChars() const { return measuredChars_; }
+
+ private:
+  Command *add(Op op, int16_t x, int16_t y, int16_t top, int16_t bottom, uint16_t color) {
+    if (count_ == MAX_COMMANDS) {
+      overflowed_ = true;
+      return nullptr;
+    }
+    Command &command = commands_[count_++];
+    command = Command{nullptr, x, y, 0, 0, top, bottom, color, op, 0, 0};
+    return &command;
+  }
+
+  // Adafruit_GFX::charBounds() over `text` from the origin, text size 1 and
+  // no wrap, for fonts without a metrics table.
+  text_metrics::Extent walkGlyphs(const char *text) const {
+    text_metrics::Extent extent = text_metrics::EMPTY_EXTENT;
+    int16_t x = 0;
+    for (const char *p = text; *p != '\0'; ++p) {
+      const text_metrics::GlyphMetrics glyph = glyphMetrics(static_cast<uint8_t>(*p));
+      text_metrics::grow(extent, x, glyph);
+      x += glyph.advance;
+    }
+    extent.advance = x;
+    return extent;
+  }
+
+  Command commands_[MAX_COMMANDS];
+  size_t count_ = 0;
+  char text_[TEXT_BYTES];
+  size_t textUsed_ = 0;
+  bool overflowed_ = false;
+  const Font *font_ = nullptr;
+  uint16_t textColor_ = 0;
+  int16_t cursorX_ = 0;
+  int16_t cursorY_ = 0;
+  const text_metrics::FontMetrics *metricsTable_ = nullptr;
+  size_t metricsCount_ = 0;
+  const text_metrics::FontMetrics *metrics_ = nullptr;
+  mutable size_t measureCalls_ = 0;
+  mutable size_t measuredChars_ = 0;
+};
+
+}  // namespace display_list
@@ -0,0 +1,68 @@
+/* Cancellation token and deadline of a fetch round.
+ * Copyright (C) 2026  Lumixen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+
+/*
+ * One token is shared by all operations of executeParallel(). It is
+ * cancelled when an operation whose failure aborts the wake (see
+ * FetchOperation::shouldAbortOnFailure) fails, or expires once the fetch
+ * budget (FETCH_DEADLINE) is spent. Providers check it between retries and
+ * the HTTP read loops on every wait, so a cancelled sibling stops within a
+ * poll interval and closes its socket instead of draining its body.
+ */
+class FetchCancel {
+ public:
+  static constexpr int NO_CAUSE = -1;
+
+  // Never expires; cancel() still applies.
+  FetchCancel() = default;
+  // Expires `budgetMs` after `startMs`; a budget of 0 never expires.
+  FetchCancel(uint32_t startMs, uint32_t budgetMs) : deadline_(startMs + budgetMs), bounded_(budgetMs > 0) {}
+
+  FetchCancel(const FetchCancel &) = delete;
+  FetchCancel &operator=(const FetchCancel &) = delete;
+
+  /* Cancel because operation `index` failed. The first cause is kept, so
+   * the operations it took down are not reported in its place. */
+  void cancel(int index) {
+    int expected = NO_CAUSE;
+    cause_.compare_exchange_strong(expected, index);
+  }
+
+  // Index of the operation whose failure cancelled the round, or NO_CAUSE.
+  int cause() const { return cause_.load(); }
+
+  bool expired(uint32_t nowMs) const { return bounded_ && static_cast<int32_t>(nowMs - deadline_) >= 0; }
+
+  bool cancelled(uint32_t nowMs) const { return cause() != NO_CAUSE || expired(nowMs); }
+
+  // Budget left at `nowMs` (UINT32_MAX without a deadline).
+  uint32_t remainingMs(uint32_t nowMs) const {
+    if (!bounded_) {
+      return UINT32_MAX;
+    }
+    return expired(nowMs) ? 0 : deadline_ - nowMs;
+  }
+
+  /* `timeoutMs` cut to the budget left, never below 1 ms: clients read a 0
+   * timeout as "no timeout". */
+  uint32_t clamp(uint32_t timeoutMs, uint32_t nowMs) const {
+    return std::max<uint32_t>(1, std::min(timeoutMs, remainingMs(nowMs)));
+  }
+
+ private:
+  uint32_t deadline_ = 0;
+  bool bounded_ = false;
+  std::atomic<int> cause_{NO_CAUSE};
+};
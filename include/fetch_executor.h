@@ -11,11 +11,23 @@
 
 #include <memory>
 #include <vector>
+#include "fetch_cancel.h"
 #include "fetch_operation.h"
 #include "provider_result.h"
 
-static constexpr size_t FETCH_MAX_CONCURRENCY = 2;
+// Upper bound of the pool; how many fetches actually overlap is decided by
+// heap admission (see fetch_schedule.h).
+static constexpr size_t FETCH_MAX_CONCURRENCY = 3;
+// Worker stack, unless auto-sized from the observed use (stack_watermark.h).
 static constexpr size_t FETCH_STACK_BYTES = 8192;
 static constexpr uint32_t FETCH_TASK_PRIORITY = 1;
 
-std::vector<ProviderResult> executeParallel(std::vector<std::unique_ptr<FetchOperation>> &ops);
+/* Run the operations on a bounded pool and return their results in order.
+ * The first failing operation that aborts the wake cancels `cancel`, which
+ * stops its siblings early; cancel.cause() then tells which one it was. */
+std::vector<ProviderResult> executeParallel(std::vector<std::unique_ptr<FetchOperation>> &ops, FetchCancel &cancel);
+
+/* Note the free heap on behalf of the operation running on the calling task
+ * (no-op outside one). Called where fetches allocate the most: after the
+ * TLS handshake and per body chunk, while the parser's document grows. */
+void fetchHeapSample();
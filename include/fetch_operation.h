@@ -9,12 +9,47 @@
 
 #pragma once
 
+#include <cstdint>
+#include "fetch_cancel.h"
 #include "provider_result.h"
 
+/* Kind of data an operation fetches. Stable small integers: they index
+ * per-provider state kept across deep sleep and tag profiler samples. */
+enum class FetchKind : uint8_t {
+  WEATHER = 0,
+  AIR_QUALITY,
+  ALERTS,
+  COUNT,
+};
+
+inline const char *fetchKindName(FetchKind kind) {
+  switch (kind) {
+    case FetchKind::WEATHER:
+      return "weather";
+    case FetchKind::AIR_QUALITY:
+      return "air_quality";
+    case FetchKind::ALERTS:
+      return "alerts";
+    default:
+      return "unknown";
+  }
+}
+
+// Bit of `kind` in a set of kinds (FetchOperation::dependsOn).
+constexpr uint32_t fetchKindBit(FetchKind kind) { return 1u << static_cast<uint8_t>(kind); }
+
 class FetchOperation {
  public:
   virtual ~FetchOperation() = default;
-  virtual ProviderResult execute() = 0;
+  // Run the fetch; give up promptly once `cancel` is cancelled or expired.
+  virtual ProviderResult execute(const FetchCancel &cancel) = 0;
   virtual const char *name() const = 0;
+  virtual FetchKind kind() const = 0;
   virtual bool shouldAbortOnFailure() const = 0;
+  // Fill the output from a still fresh response cache record instead of
+  // fetching. Returns true when it did: the operation then need not run.
+  virtual bool restoreFromCache() { return false; }
+  // Kinds (fetchKindBit) whose operations must finish before this one
+  // starts when they run in the same round.
+  virtual uint32_t dependsOn() const { return 0; }
 };
@@ -0,0 +1,201 @@
+/* History-driven scheduling of the fetch operations of a wake.
+ * Copyright (C) 2026  Lumixen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "fetch_operation.h"
+
+/*
+ * The executor runs the operations of a wake on a pool of
+ * FETCH_MAX_CONCURRENCY workers. Which operation starts first decides the
+ * makespan: the longest one should not be left for last. The duration of
+ * every successful operation is averaged per FetchKind over recent wakes
+ * (RTC memory) and the operations are ordered longest-expected-first by a
+ * list schedule that also honours declared dependencies (an operation only
+ * starts once those it depends on finished).
+ *
+ * The peak heap each kind needed is learned alongside: an operation is only
+ * admitted next to running ones when the largest free block covers it, so
+ * a fragmented heap runs fetches one after the other instead of failing a
+ * TLS handshake, and light fetches (plain HTTP, small bodies) run all at
+ * once.
+ *
+ * The executor keeps the history in RTC memory and runs the schedule.
+ */
+namespace fetch_schedule {
+
+constexpr uint32_t HISTORY_MAGIC = 0x46534832;  // "FSH2", bump on layout change
+constexpr size_t KINDS = static_cast<size_t>(FetchKind::COUNT);
+// Jobs per schedule; dependencies are bit masks of job indices.
+constexpr size_t MAX_JOBS = 8;
+// Expected duration of a kind never seen yet.
+constexpr uint32_t DEFAULT_MS = 2000;
+// Expected peak heap of a kind never seen yet: a TLS connection (mbedTLS
+// record buffers and handshake) plus a parsed document.
+constexpr uint32_t DEFAULT_PEAK_HEAP = 48 * 1024;
+// Headroom kept above an admitted operation's peak for everything else.
+constexpr uint32_t HEAP_MARGIN = 4 * 1024;
+
+struct KindStats {
+  uint32_t samples;
+  uint32_t avgMs;  // exponential moving average, 1/4 weight per sample
+  uint32_t lastMs;
+  uint32_t heapSamples;
+  uint32_t peakHeap;  // bytes; rises to a larger sample at once, decays by 1/4
+};
+
+struct History {
+  uint32_t magic;
+  KindStats kinds[KINDS];
+};
+
+inline void ensureValid(History &history) {
+  if (history.magic != HISTORY_MAGIC) {
+    history = History{};
+    history.magic = HISTORY_MAGIC;
+  }
+}
+
+inline void record(History &history, FetchKind kind, uint32_t durationMs) {
+  const size_t index = static_cast<size_t>(kind);
+  if (index >= KINDS) {
+    return;
+  }
+  KindStats &stats = history.kinds[index];
+  stats.avgMs = stats.samples == 0 ? durationMs : stats.avgMs - stats.avgMs / 4 + durationMs / 4;
+  stats.lastMs = durationMs;
+  ++stats.samples;
+}
+
+inline uint32_t expectedMs(const History &history, FetchKind kind) {
+  const size_t index = static_cast<size_t>(kind);
+  if (index >= KINDS || history.kinds[index].samples == 0) {
+    return DEFAULT_MS;
+  }
+  return history.kinds[index].avgMs;
+}
+
+/* Peak heap of one run. An under-estimate risks an allocation failure while
+ * an over-estimate only costs parallelism, so a larger sample is taken as
+ * is and smaller ones only pull the estimate down gradually. */
+inline void recordHeap(History &history, FetchKind kind, uint32_t peakBytes) {
+  const size_t index = static_cast<size_t>(kind);
+  if (index >= KINDS) {
+    return;
+  }
+  KindStats &stats = history.kinds[index];
+  if (stats.heapSamples == 0 || peakBytes >= stats.peakHeap) {
+    stats.peakHeap = peakBytes;
+  } else {
+    stats.peakHeap = stats.peakHeap - stats.peakHeap / 4 + peakBytes / 4;
+  }
+  ++stats.heapSamples;
+}
+
+inline uint32_t expectedHeap(const History &history, FetchKind kind) {
+  const size_t index = static_cast<size_t>(kind);
+  if (index >= KINDS || history.kinds[index].heapSamples == 0) {
+    return DEFAULT_PEAK_HEAP;
+  }
+  return history.kinds[index].peakHeap;
+}
+
+/* Whether an operation expected to need `peakHeap` bytes may start while
+ * `inFlight` others run. The first one is always admitted: waiting would
+ * not make the heap any larger. */
+inline bool admits(uint32_t largestFreeBlock, uint32_t peakHeap, size_t inFlight) {
+  return inFlight == 0 || largestFreeBlock >= peakHeap + HEAP_MARGIN;
+}
+
+struct Job {
+  uint32_t expectedMs;
+  uint32_t dependsOn;  // bit i: job i must finish first
+};
+
+/* List schedule of `n` jobs on `workers` workers: whenever a worker frees
+ * up, it takes the best ranked job whose dependencies finished (lowest
+ * `rank`, ties by index), or waits for the next one to become ready. Writes
+ * the start order to `order` and returns the makespan. Out of range
+ * dependencies are ignored and a cycle is broken at its best ranked job
+ * rather than stalling. */
+inline uint32_t simulate(const Job *jobs, size_t n, size_t workers, const uint32_t *rank, uint8_t *order) {
+  uint32_t finish[MAX_JOBS] = {};
+  uint32_t freeAt[MAX_JOBS] = {};
+  bool scheduled[MAX_JOBS] = {};
+  n = n < MAX_JOBS ? n : MAX_JOBS;
+  workers = workers == 0 ? 1 : (workers < MAX_JOBS ? workers : MAX_JOBS);
+  const uint32_t all = (1u << n) - 1;
+  uint32_t scheduledMask = 0;
+  uint32_t makespan = 0;
+  for (size_t step = 0; step < n; ++step) {
+    size_t worker = 0;
+    for (size_t w = 1; w < workers; ++w) {
+      if (freeAt[w] < freeAt[worker]) {
+        worker = w;
+      }
+    }
+    // Candidates have all dependencies started; a candidate is ready once
+    // they also finished. Without candidates (a cycle), dependencies are
+    // dropped for this pick.
+    bool anyCandidate = false;
+    for (size_t j = 0; j < n; ++j) {
+      anyCandidate |= !scheduled[j] && (jobs[j].dependsOn & all & ~scheduledMask) == 0;
+    }
+    size_t best = n;
+    uint32_t bestReady = 0;
+    for (size_t j = 0; j < n; ++j) {
+      const uint32_t deps = anyCandidate ? jobs[j].dependsOn & all : 0;
+      if (scheduled[j] || (deps & ~scheduledMask) != 0) {
+        continue;
+      }
+      uint32_t ready = freeAt[worker];
+      for (size_t k = 0; k < n; ++k) {
+        if ((deps >> k) & 1u) {
+          ready = finish[k] > ready ? finish[k] : ready;
+        }
+      }
+      // Prefer what can start earliest, then the better rank.
+      if (best == n || ready < bestReady || (ready == bestReady && rank[j] < rank[best])) {
+        best = j;
+        bestReady = ready;
+      }
+    }
+    scheduled[best] = true;
+    scheduledMask |= 1u << best;
+    finish[best] = bestReady + jobs[best].expectedMs;
+    freeAt[worker] = finish[best];
+    makespan = finish[best] > makespan ? finish[best] : makespan;
+    order[step] = static_cast<uint8_t>(best);
+  }
+  return makespan;
+}
+
+// Longest-expected-first schedule; returns its predicted makespan.
+inline uint32_t longestFirst(const Job *jobs, size_t n, size_t workers, uint8_t *order) {
+  uint32_t rank[MAX_JOBS] = {};
+  for (size_t j = 0; j < n && j < MAX_JOBS; ++j) {
+    // Descending expected duration, ties keep the given order.
+    rank[j] = UINT32_MAX - jobs[j].expectedMs;
+  }
+  return simulate(jobs, n, workers, rank, order);
+}
+
+// Predicted makespan of running the jobs in their given order.
+inline uint32_t staticMakespan(const Job *jobs, size_t n, size_t workers) {
+  uint32_t rank[MAX_JOBS] = {};
+  uint8_t order[MAX_JOBS] = {};
+  for (size_t j = 0; j < n && j < MAX_JOBS; ++j) {
+    rank[j] = static_cast<uint32_t>(j);
+  }
+  return simulate(jobs, n, workers, rank, order);
+}
+
+}  // namespace fetch_schedule
@@ -0,0 +1,182 @@
+/* Bounds-checked reader of FlatBuffers messages.
+ * Copyright (C) 2026  Lumixen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/*
+ * Just enough of the FlatBuffers wire format to read a message in place,
+ * without the generated code or the flatbuffers library: tables (through
+ * their vtable), scalars, sub-tables and vectors of scalars or tables.
+ *
+ * The message comes off the network, so every offset is checked against the
+ * buffer before it is followed: a field that points outside of it reads as
+ * absent (the default value, an invalid table or an empty vector) rather
+ * than out of bounds. Values are read with memcpy, the buffer needs no
+ * alignment. Little-endian hosts only, like the format itself.
+ */
+namespace flatbuffer {
+
+// Whether [pos, pos + len) lies within a buffer of `size` bytes.
+inline bool inBounds(size_t size, size_t pos, size_t len) {
+  return pos <= size && len <= size - pos;
+}
+
+template <typename T>
+inline T load(const uint8_t *data, size_t pos) {
+  T value;
+  memcpy(&value, data + pos, sizeof(T));
+  return value;
+}
+
+template <typename T>
+class Vector {
+ public:
+  Vector() = default;
+  Vector(const uint8_t *data, size_t pos, uint32_t length) : data_(data), pos_(pos), length_(length) {}
+
+  uint32_t size() const { return length_; }
+  T operator[](uint32_t i) const { return load<T>(data_, pos_ + i * sizeof(T)); }
+
+ private:
+  const uint8_t *data_ = nullptr;
+  size_t pos_ = 0;
+  uint32_t length_ = 0;
+};
+
+class Table;
+
+// Vector of offsets to tables.
+class TableVector {
+ public:
+  TableVector() = default;
+  TableVector(const uint8_t *data, size_t size, size_t pos, uint32_t length)
+      : data_(data), size_(size), pos_(pos), length_(length) {}
+
+  uint32_t size() const { return length_; }
+  inline Table operator[](uint32_t i) const;
+
+ private:
+  const uint8_t *data_ = nullptr;
+  size_t size_ = 0;
+  size_t pos_ = 0;
+  uint32_t length_ = 0;
+};
+
+class Table {
+ public:
+  Table() = default;
+
+  // Table at `pos`, invalid unless it and its vtable lie within the buffer.
+  Table(const uint8_t *data, size_t size, size_t pos) : data_(data), size_(size), pos_(pos) {
+    if (!inBounds(size, pos, sizeof(int32_t))) {
+      return;
+    }
+    const int64_t vtable = static_cast<int64_t>(pos) - load<int32_t>(data, pos);
+    if (vtable < 0 || !inBounds(size, static_cast<size_t>(vtable), 2 * sizeof(uint16_t))) {
+      return;
+    }
+    vtable_ = static_cast<size_t>(vtable);
+    vtableSize_ = load<uint16_t>(data, vtable_);
+    tableSize_ = load<uint16_t>(data, vtable_ + sizeof(uint16_t));
+    valid_ = vtableSize_ >= 4 && inBounds(size, vtable_, vtableSize_) && inBounds(size, pos, tableSize_);
+  }
+
+  // Root table of a message (after its size prefix, if any).
+  static Table root(const uint8_t *data, size_t size) {
+    if (!inBounds(size, 0, sizeof(uint32_t))) {
+      return Table();
+    }
+    return Table(data, size, load<uint32_t>(data, 0));
+  }
+
+  bool valid() const { return valid_; }
+
+  template <typename T>
+  T scalar(uint16_t field, T defaultValue) const {
+    const size_t pos = fieldPos(field, sizeof(T));
+    return pos != 0 ? load<T>(data_, pos) : defaultValue;
+  }
+
+  Table table(uint16_t field) const {
+    const size_t target = follow(field);
+    return target != 0 ? Table(data_, size_, target) : Table();
+  }
+
+  template <typename T>
+  Vector<T> vector(uint16_t field) const {
+    uint32_t length;
+    const size_t elements = vectorPos(field, sizeof(T), length);
+    return elements != 0 ? Vector<T>(data_, elements, length) : Vector<T>();
+  }
+
+  TableVector tables(uint16_t field) const {
+    uint32_t length;
+    const size_t elements = vectorPos(field, sizeof(uint32_t), length);
+    return elements != 0 ? TableVector(data_, size_, elements, length) : TableVector();
+  }
+
+ private:
+  // Position of the value of `field` (`len` bytes), 0 when absent.
+  size_t fieldPos(uint16_t field, size_t len) const {
+    const size_t entry = 2 * sizeof(uint16_t) + field * sizeof(uint16_t);
+    if (!valid_ || entry + sizeof(uint16_t) > vtableSize_) {
+      return 0;
+    }
+    const uint16_t offset = load<uint16_t>(data_, vtable_ + entry);
+    if (offset == 0 || offset + len > tableSize_) {
+      return 0;
+    }
+    return pos_ + offset;
+  }
+
+  // Target of the offset stored in `field`, 0 when absent or out of bounds.
+  size_t follow(uint16_t field) const {
+    const size_t pos = fieldPos(field, sizeof(uint32_t));
+    if (pos == 0) {
+      return 0;
+    }
+    const uint32_t offset = load<uint32_t>(data_, pos);
+    return offset < size_ - pos ? pos + offset : 0;
+  }
+
+  // First element of the vector in `field` with its length, 0 when absent
+  // or when its elements run past the buffer.
+  size_t vectorPos(uint16_t field, size_t elementSize, uint32_t &length) const {
+    const size_t pos = follow(field);
+    if (pos == 0 || !inBounds(size_, pos, sizeof(uint32_t))) {
+      return 0;
+    }
+    length = load<uint32_t>(data_, pos);
+    const size_t elements = pos + sizeof(uint32_t);
+    if (length > (size_ - elements) / elementSize) {
+      return 0;
+    }
+    return elements;
+  }
+
+  const uint8_t *data_ = nullptr;
+  size_t size_ = 0;
+  size_t pos_ = 0;
+  size_t vtable_ = 0;
+  uint16_t vtableSize_ = 0;
+  uint16_t tableSize_ = 0;
+  bool valid_ = false;
+};
+
+Table TableVector::operator[](uint32_t i) const {
+  const size_t pos = pos_ + i * sizeof(uint32_t);
+  const uint32_t offset = load<uint32_t>(data_, pos);
+  return offset < size_ - pos ? Table(data_, size_, pos + offset) : Table();
+}
+
+}  // namespace flatbuffer
@@ -0,0 +1,131 @@
+/* Incremental refresh of the hourly and daily forecast across deep sleep.
+ * Copyright (C) 2026  Lumixen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include "config.h"
+#include "data_models.h"
+
+/*
+ * Between two wakes only the current conditions change meaningfully; the
+ * hourly and daily forecast barely move. With a refresh interval of N
+ * wakes, a full request (current, hourly and daily) is only made every N
+ * wakes and its hourly and daily sections are kept in RTC memory. The wakes
+ * in between request the current section alone, a tenth of the body, and
+ * merge the kept sections back in.
+ *
+ * The kept hourly rows start at the hour of the full request; as hours pass
+ * the window is shifted forward locally. A full request asks for
+ * KEEP_HOURLY rows: the graph plus the hours that pass over the N wakes, so
+ * the graph does not run out of rows before the next full request is due
+ * anyway. Its hourly rows are decoded straight into the store, the model
+ * gets NUM_HOURLY of them. A full request is also due once the day of
+ * daily[0] is over, or when nothing is kept (cold boot).
+ */
+namespace forecast_refresh {
+
+constexpr uint32_t STORE_MAGIC = 0x46435232;  // "FCR2", bump on layout change
+constexpr int64_t HOUR = 3600;
+constexpr int64_t DAY = 24 * HOUR;
+
+/* Hourly rows a full request asks for and the store keeps. The hours that
+ * pass are rounded up and capped at a day: the end of the day of daily[0]
+ * forces a full request before more would be needed. */
+constexpr size_t KEEP_HOURLY =
+    static_cast<size_t>(HOURLY_GRAPH_MAX) +
+    std::min<size_t>((WEATHER_API_FORECAST_REFRESH_EVERY * SLEEP_DURATION + 59) / 60, 24);
+
+struct Store {
+  uint32_t magic;
+  uint32_t wakesSinceFull;  // current-only requests merged since the last full one
+  hourly_t hourly[KEEP_HOURLY];
+  daily_t daily[NUM_DAILY];
+};
+
+// Reset the store unless it carries the current layout (cold boot, reflash).
+inline void ensureValid(Store &store) {
+  if (store.magic != STORE_MAGIC) {
+    store = Store{};
+  }
+}
+
+// Forget the kept sections, so the next request is a full one.
+inline void invalidate(Store &store) { store.magic = 0; }
+
+// Index of the kept row of the hour holding `now`: rows of hours already
+// over are skipped. KEEP_HOURLY when none is left.
+inline size_t firstHour(const Store &store, int64_t now) {
+  size_t first = 0;
+  while (first < KEEP_HOURLY && store.hourly[first].dt != 0 && store.hourly[first].dt + HOUR <= now) {
+    ++first;
+  }
+  return first;
+}
+
+// Kept rows from the hour holding `now` on.
+inline size_t hoursLeft(const Store &store, int64_t now) {
+  size_t left = 0;
+  for (size_t i = firstHour(store, now); i < KEEP_HOURLY && store.hourly[i].dt != 0; ++i) {
+    ++left;
+  }
+  return left;
+}
+
+/* Whether this wake needs a full request: every `every` wakes, when nothing
+ * is kept, when fewer than `graphHours` rows are left from `now` on or when
+ * the day of daily[0] (local midnight, as the API sends it) is over. */
+inline bool fullDue(const Store &store, int64_t now, uint32_t every, size_t graphHours) {
+  if (store.magic != STORE_MAGIC || store.wakesSinceFull + 1 >= every) {
+    return true;
+  }
+  if (store.daily[0].dt == 0 || now >= store.daily[0].dt + DAY) {
+    return true;
+  }
+  return hoursLeft(store, now) < graphHours;
+}
+
+// Give the model the NUM_HOURLY kept rows from the hour of current.dt on;
+// rows past the kept ones are zeroed.
+inline void shiftHourly(const Store &store, forecast_t &forecast) {
+  const size_t first = firstHour(store, forecast.current.dt);
+  for (size_t i = 0; i < NUM_HOURLY; ++i) {
+    forecast.hourly[i] = first + i < KEEP_HOURLY ? store.hourly[first + i] : hourly_t{};
+  }
+}
+
+/* Keep a full response: its hourly rows were decoded into store.hourly (see
+ * OpenMeteoWeatherProvider::deserializeCall), its daily rows are copied.
+ * The model gets its hourly rows from the store. */
+inline void keep(Store &store, forecast_t &forecast) {
+  store.magic = STORE_MAGIC;
+  store.wakesSinceFull = 0;
+  for (size_t i = 0; i < NUM_DAILY; ++i) {
+    store.daily[i] = forecast.daily[i];
+  }
+  shiftHourly(store, forecast);
+}
+
+/* Complete a current-only response with the kept sections: the hourly rows
+ * from the hour of current.dt on, the daily rows and what the current
+ * conditions take from today's row. */
+inline void merge(Store &store, forecast_t &forecast) {
+  shiftHourly(store, forecast);
+  for (size_t i = 0; i < NUM_DAILY; ++i) {
+    forecast.daily[i] = store.daily[i];
+  }
+  forecast.current.sunrise = store.daily[0].sunrise;
+  forecast.current.sunset = store.daily[0].sunset;
+  forecast.current.uvi = store.daily[0].uvi;
+  ++store.wakesSinceFull;
+}
+
+}  // namespace forecast_refresh
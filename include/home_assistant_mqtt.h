@@ -25,6 +25,10 @@ static const char HOME_ASSISTANT_MQTT_HUMIDITY_TOPIC[] PROGMEM =
 static const char HOME_ASSISTANT_MQTT_PRESSURE_TOPIC[] PROGMEM =
     HOME_ASSISTANT_MQTT_DISCOVERY_PREFIX "/sensor/${clientId}/pressure/config";
 #endif  // BME_TYPE_NONE
+#if WAKE_PROFILER
+static const char HOME_ASSISTANT_MQTT_WAKE_PROFILE_TOPIC[] PROGMEM =
+    HOME_ASSISTANT_MQTT_DISCOVERY_PREFIX "/sensor/${clientId}/wake_profile/config";
+#endif  // WAKE_PROFILER
 
 // State Topics
 static const char MQTT_STATE_TOPIC_VOLTAGE[] PROGMEM = MQTT_STATE_BASE_TOPIC "${clientId}/battery_voltage";
@@ -37,6 +41,9 @@ static const char MQTT_STATE_TOPIC_TEMPERATURE[] PROGMEM = MQTT_STATE_BASE_TOPIC
 static const char MQTT_STATE_TOPIC_HUMIDITY[] PROGMEM = MQTT_STATE_BASE_TOPIC "${clientId}/humidity";
 static const char MQTT_STATE_TOPIC_PRESSURE[] PROGMEM = MQTT_STATE_BASE_TOPIC "${clientId}/pressure";
 #endif  // BME_TYPE_NONE
+#if WAKE_PROFILER
+static const char MQTT_STATE_TOPIC_WAKE_PROFILE[] PROGMEM = MQTT_STATE_BASE_TOPIC "${clientId}/wake_profile";
+#endif  // WAKE_PROFILER
 
 // Device information (shared across all sensors)
 #define MQTT_DEVICE_INFO \
@@ -86,6 +93,21 @@ static const char HOME_ASSISTANT_MQTT_API_ACTIVITY_DURATION_PAYLOAD[] PROGMEM =
     "\"name\":\"API Activity Duration\","
     "\"state_topic\":\"" MQTT_STATE_BASE_TOPIC "${clientId}/api_activity_duration\"," MQTT_DEVICE_INFO "}";
 
+// Total duration of the previous wake; the per-phase breakdown (ms) is
+// exposed as attributes of the same sensor.
+#if WAKE_PROFILER
+static const char HOME_ASSISTANT_MQTT_WAKE_PROFILE_PAYLOAD[] PROGMEM =
+    "{"
+    "\"device_class\":\"duration\","
+    "\"unit_of_measurement\":\"ms\","
+    "\"unique_id\":\"${clientId}_wake_profile\","
+    "\"object_id\":\"${clientId}_wake_profile\","
+    "\"name\":\"Wake Duration\","
+    "\"value_template\":\"{{ value_json.total_ms }}\","
+    "\"json_attributes_topic\":\"" MQTT_STATE_BASE_TOPIC "${clientId}/wake_profile\","
+    "\"state_topic\":\"" MQTT_STATE_BASE_TOPIC "${clientId}/wake_profile\"," MQTT_DEVICE_INFO "}";
+#endif  // WAKE_PROFILER
+
 #ifndef BME_TYPE_NONE
 
 static const char HOME_ASSISTANT_MQTT_TEMPERATURE_PAYLOAD[] PROGMEM =
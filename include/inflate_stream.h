@@ -0,0 +1,208 @@
+/* Streaming gzip/deflate decoding of HTTP response bodies.
+ * Copyright (C) 2026  Lumixen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <strings.h>
+#include "response_body.h"
+
+/*
+ * Providers configured with `compression: true` send Accept-Encoding and, if
+ * the server answers with Content-Encoding gzip or deflate, decode the body
+ * on the fly between the HTTP stream and the existing parsers (ArduinoJson,
+ * the Open-Meteo stream parser, the MeteoAlarm FeedParser). Decoding uses
+ * the tinfl inflater in the ESP32 ROM with its fixed 32 KB window and never
+ * holds more of the body than that window.
+ *
+ * The header parsing helpers below are inline; Inflater and InflateBody,
+ * which wrap the ROM inflater, are implemented in src/inflate_stream.cpp.
+ */
+namespace inflate {
+
+// Value of the Accept-Encoding request header.
+constexpr const char *ACCEPT_ENCODING = "gzip, deflate";
+
+enum class Encoding : uint8_t {
+  IDENTITY = 0,
+  GZIP,
+  DEFLATE,      // zlib-wrapped per RFC 9110; raw deflate is accepted too
+  UNSUPPORTED,  // some other coding, the body cannot be parsed
+};
+
+// Classify a Content-Encoding header value (nullptr when absent).
+inline Encoding contentEncoding(const char *value) {
+  if (value == nullptr || *value == '\0' || strcasecmp(value, "identity") == 0) {
+    return Encoding::IDENTITY;
+  }
+  if (strcasecmp(value, "gzip") == 0 || strcasecmp(value, "x-gzip") == 0) {
+    return Encoding::GZIP;
+  }
+  if (strcasecmp(value, "deflate") == 0) {
+    return Encoding::DEFLATE;
+  }
+  return Encoding::UNSUPPORTED;
+}
+
+// True when the first two bytes of a deflate body form a zlib header (RFC
+// 1950): CM = 8 and the check bits make the pair a multiple of 31.
+inline bool isZlibHeader(uint8_t cmf, uint8_t flg) {
+  return (cmf & 0x0F) == 8 && (cmf >> 4) <= 7 && ((cmf << 8) | flg) % 31 == 0;
+}
+
+/* Byte-at-a-time parser of the gzip member header (RFC 1952), so the header
+ * may span any number of network reads. The deflate data starts right after
+ * the byte for which push() returned DONE. */
+class GzipHeader {
+ public:
+  enum class Status : uint8_t { NEED_MORE, DONE, INVALID };
+
+  Status push(uint8_t byte) {
+    switch (state_) {
+      case State::FIXED:
+        if ((pos_ == 0 && byte != 0x1F) || (pos_ == 1 && byte != 0x8B) || (pos_ == 2 && byte != 8)) {
+          return fail();
+        }
+        if (pos_ == 3) {
+          flags_ = byte;
+          if (flags_ & 0xE0) {  // reserved bits
+            return fail();
+          }
+        }
+        if (++pos_ < FIXED_LEN) {
+          return Status::NEED_MORE;
+        }
+        return next(State::EXTRA_LEN);
+      case State::EXTRA_LEN:
+        remaining_ |= static_cast<uint16_t>(byte) << (pos_++ * 8);
+        return pos_ < 2 ? Status::NEED_MORE : next(State::EXTRA);
+      case State::EXTRA:
+        return --remaining_ > 0 ? Status::NEED_MORE : next(State::NAME);
+      case State::NAME:
+      case State::COMMENT:
+        return byte != 0 ? Status::NEED_MORE : next(static_cast<State>(static_cast<uint8_t>(state_) + 1));
+      case State::HEADER_CRC:
+        return ++pos_ < 2 ? Status::NEED_MORE : next(State::BODY);
+      case State::BODY:
+        return Status::DONE;
+      case State::FAILED:
+        break;
+    }
+    return Status::INVALID;
+  }
+
+ private:
+  enum class State : uint8_t { FIXED, EXTRA_LEN, EXTRA, NAME, COMMENT, HEADER_CRC, BODY, FAILED };
+  static constexpr uint8_t FIXED_LEN = 10;
+  static constexpr uint8_t FLAG_HCRC = 0x02;
+  static constexpr uint8_t FLAG_EXTRA = 0x04;
+  static constexpr uint8_t FLAG_NAME = 0x08;
+  static constexpr uint8_t FLAG_COMMENT = 0x10;
+
+  Status fail() {
+    state_ = State::FAILED;
+    return Status::INVALID;
+  }
+
+  // Enter `state`, skipping the optional fields the flags leave out.
+  Status next(State state) {
+    pos_ = 0;
+    remaining_ = state == State::EXTRA ? remaining_ : 0;
+    if (state == State::EXTRA_LEN && !(flags_ & FLAG_EXTRA)) {
+      state = State::NAME;
+    }
+    if (state == State::EXTRA && remaining_ == 0) {
+      state = State::NAME;
+    }
+    if (state == State::NAME && !(flags_ & FLAG_NAME)) {
+      state = State::COMMENT;
+    }
+    if (state == State::COMMENT && !(flags_ & FLAG_COMMENT)) {
+      state = State::HEADER_CRC;
+    }
+    if (state == State::HEADER_CRC && !(flags_ & FLAG_HCRC)) {
+      state = State::BODY;
+    }
+    state_ = state;
+    return state == State::BODY ? Status::DONE : Status::NEED_MORE;
+  }
+
+  State state_ = State::FIXED;
+  uint8_t pos_ = 0;
+  uint8_t flags_ = 0;
+  uint16_t remaining_ = 0;
+};
+
+}  // namespace inflate
+
+struct tinfl_decompressor_tag;
+typedef struct tinfl_decompressor_tag tinfl_decompressor;
+
+/* Incremental inflater: feed it compressed bytes as they arrive and take
+ * the decompressed bytes it hands back. The decompressor state and its window
+ * (~43 KB together) are allocated for the lifetime of the object only. */
+class Inflater {
+ public:
+  explicit Inflater(inflate::Encoding encoding);
+  ~Inflater();
+  Inflater(const Inflater &) = delete;
+  Inflater &operator=(const Inflater &) = delete;
+
+  /* Decompress from `in`; `inLen` is updated to the bytes consumed. `out`
+   * and `outLen` receive the bytes decompressed by this call, valid until
+   * the next one. Call again with the remaining input (or none) while it
+   * produces output. `moreInput` is false once the body ended. Returns false
+   * on corrupt or truncated input, or when the buffers were not allocated. */
+  bool step(const uint8_t *in, size_t &inLen, const uint8_t *&out, size_t &outLen, bool moreInput);
+
+  // End of the compressed stream reached; trailing bytes are ignored.
+  bool done() const { return done_; }
+  bool failed() const { return failed_; }
+
+ private:
+  enum class Stage : uint8_t { GZIP_HEADER, ZLIB_DETECT, DATA };
+
+  bool fail() {
+    failed_ = true;
+    return false;
+  }
+
+  tinfl_decompressor *decompressor_ = nullptr;
+  uint8_t *window_ = nullptr;
+  size_t windowPos_ = 0;
+  Stage stage_;
+  inflate::GzipHeader gzipHeader_;
+  uint8_t zlibFirst_ = 0;
+  bool haveZlibFirst_ = false;
+  uint32_t flags_ = 0;
+  bool done_ = false;
+  bool failed_ = false;
+};
+
+/* Decompressed view of a compressed body: every chunk is a slice of the
+ * inflater window, handed to the parser without another copy. */
+class InflateBody : public ResponseBody {
+ public:
+  InflateBody(ResponseBody &source, inflate::Encoding encoding) : source_(source), inflater_(encoding) {}
+
+  // Corrupt or truncated input was met.
+  bool failed() const { return inflater_.failed(); }
+  size_t compressedBytes() const { return source_.consumed(); }
+
+ protected:
+  bool fill(const char *&data, size_t &len) override;
+
+ private:
+  ResponseBody &source_;
+  Inflater inflater_;
+  const char *in_ = nullptr;
+  size_t inLen_ = 0;
+  bool sourceEnded_ = false;
+};
@@ -0,0 +1,64 @@
+/* Streaming JSON decoding of response bodies with json-streaming-parser2.
+ * Copyright (C) 2026  Lumixen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#pragma once
+
+#include <ArduinoStreamParser.h>
+#include <cstddef>
+#include "provider_result.h"
+#include "response_body.h"
+
+/*
+ * The SAX decoders (Open-Meteo forecast and air quality, OWM One Call and
+ * air pollution) map values into their model from the parser's callbacks
+ * and derive their handler from DocumentHandler. parse() feeds a body to
+ * one of them and maps the outcome to a ProviderResult the same way for
+ * all: the decoders only add their own completeness checks on top.
+ */
+namespace json_stream {
+
+class DocumentHandler : public JsonHandler {
+ public:
+  void startDocument() override { sawStart_ = true; }
+  void endDocument() override { documentDone_ = true; }
+  void startObject(ElementPath) override {}
+  void endObject(ElementPath) override {}
+  void startArray(ElementPath) override {}
+  void endArray(ElementPath) override {}
+  void whitespace(char) override {}
+
+  // Any parse event happened: tells an empty body from a truncated one.
+  bool sawStart() const { return sawStart_; }
+  bool finishedDocument() const { return documentDone_; }
+
+  // Whether the next bytes go to divert() instead of the parser.
+  bool diverting() const { return diverting_; }
+
+  /* Take bytes from the start of `data` past the parser (the Open-Meteo
+   * column scanner), clearing diverting() when done with them. Returns the
+   * bytes used; `failed` rejects the body as invalid. */
+  virtual size_t divert(const char *, size_t, bool &) {
+    diverting_ = false;
+    return 0;
+  }
+
+ protected:
+  bool diverting_ = false;
+
+ private:
+  bool sawStart_ = false;
+  bool documentDone_ = false;
+};
+
+/* Feed `body` to `handler` until the root document closes or an error is
+ * flagged. Ok once the document closed; otherwise an invalid, empty or
+ * incomplete input error, parse errors logged under `source`. */
+ProviderResult parse(ResponseBody &body, DocumentHandler &handler, const char *source);
+
+}  // namespace json_stream
@@ -0,0 +1,116 @@
+/* Compile-time perfect hash of JSON keys.
+ * Copyright (C) 2026  Lumixen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/*
+ * The streaming decoders see the key of every value they are handed and
+ * used to pick the model field with a chain of strcmp calls, up to one per
+ * known key. A KeyTable maps a key to its field with one hash over the key
+ * and a single strcmp to confirm it (unknown keys can hash to a used slot).
+ *
+ * The table is built by the compiler from the list of known keys: it
+ * searches a seed for which a seeded FNV-1a puts every key in its own slot of a
+ * power-of-two table at least twice the key count. A list that finds no
+ * such seed fails the static_assert next to the table (see found()).
+ */
+namespace key_dispatch {
+
+template <typename Field>
+struct Key {
+  const char *name;
+  Field field;
+};
+
+// Slots for `keys` keys: the power of two at or above twice the count.
+constexpr size_t slotsFor(size_t keys) {
+  size_t slots = 1;
+  while (slots < 2 * keys) {
+    slots <<= 1;
+  }
+  return slots;
+}
+
+// FNV-1a over the key, offset basis perturbed by `seed`. The low bits of
+// FNV-1a only depend on the low bits of the seed and the characters, and the
+// slot is taken from them: the final shifts fold the high bits in.
+constexpr uint32_t hash(const char *key, uint32_t seed) {
+  uint32_t h = 2166136261u ^ (seed * 0x9E3779B9u);
+  for (; *key != '\0'; ++key) {
+    h = (h ^ static_cast<uint8_t>(*key)) * 16777619u;
+  }
+  h ^= h >> 16;
+  h *= 0x7FEB352Du;
+  return h ^ (h >> 15);
+}
+
+template <typename Field, size_t N>
+class KeyTable {
+ public:
+  static constexpr size_t SLOTS = slotsFor(N);
+  static_assert(N < 0xFF, "slot indices are 8-bit");
+
+  constexpr explicit KeyTable(const Key<Field> (&keys)[N]) : keys_(), slots_() {
+    for (size_t i = 0; i < N; ++i) {
+      keys_[i] = keys[i];
+    }
+    for (uint32_t seed = 0; seed < MAX_SEEDS; ++seed) {
+      if (place(seed)) {
+        seed_ = seed;
+        found_ = true;
+        return;
+      }
+    }
+  }
+
+  // Whether a collision-free seed was found; static_assert it on the table.
+  constexpr bool found() const { return found_; }
+
+  // Field of `key`; false for a null or unknown key.
+  bool find(const char *key, Field &field) const {
+    if (key == nullptr) {
+      return false;
+    }
+    const uint8_t slot = slots_[hash(key, seed_) & (SLOTS - 1)];
+    if (slot == EMPTY || strcmp(keys_[slot].name, key) != 0) {
+      return false;
+    }
+    field = keys_[slot].field;
+    return true;
+  }
+
+ private:
+  static constexpr uint8_t EMPTY = 0xFF;
+  static constexpr uint32_t MAX_SEEDS = 4096;
+
+  constexpr bool place(uint32_t seed) {
+    for (uint8_t &slot : slots_) {
+      slot = EMPTY;
+    }
+    for (size_t i = 0; i < N; ++i) {
+      uint8_t &slot = slots_[hash(keys_[i].name, seed) & (SLOTS - 1)];
+      if (slot != EMPTY) {
+        return false;
+      }
+      slot = static_cast<uint8_t>(i);
+    }
+    return true;
+  }
+
+  Key<Field> keys_[N];
+  uint8_t slots_[SLOTS];
+  uint32_t seed_ = 0;
+  bool found_ = false;
+};
+
+}  // namespace key_dispatch
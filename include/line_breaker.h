@@ -0,0 +1,158 @@
+/* Line breaking of the multi-line texts (alerts, descriptors) for esp32-weather-epd.
+ * Copyright (C) 2026  Lumixen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "text_metrics.h"
+
+/*
+ * breakLines() lays `text` out in at most maxLines lines of maxWidth pixels
+ * the way drawMultiLnString() always has:
+ *
+ *   - a line that fits is taken whole, with the rest of the text;
+ *   - otherwise it is cut at the last space or hyphen that makes it fit,
+ *     the space dropped and the hyphen kept on the line;
+ *   - the last line is only cut at spaces, and gets an ellipsis ("...")
+ *     when the cut text and the ellipsis fit;
+ *   - a word wider than maxWidth is not split: it overflows its line.
+ *
+ * The old implementation searched with lastIndexOf(), cut with substring()
+ * and measured every candidate with getTextBounds(), allocating each time.
+ * Here the glyph advances of the text are summed once, each line is scanned
+ * once for the running box of its glyphs, and every candidate's width is
+ * then read off in constant time while the break search walks back from
+ * the end of the line. Nothing is allocated; lines are reported as spans of
+ * `text`. Quirks of the old search are kept (a hyphen given up for an
+ * earlier space is not printed, for one) so the layout does not change.
+ *
+ * GlyphOf maps a byte to its text_metrics::GlyphMetrics in the font the
+ * lines will be drawn with (DisplayList::glyphMetrics()). Only the first
+ * MAX_TEXT bytes are laid out; alert events and descriptors are shorter.
+ */
+namespace line_breaker {
+
+inline constexpr size_t MAX_TEXT = 128;
+inline constexpr const char ELLIPSIS[] = "...";
+
+struct Line {
+  uint16_t start;   // offset in the text
+  uint16_t length;  // bytes of the text on this line
+  bool ellipsis;    // ELLIPSIS follows them
+};
+
+// Calls onLine(line, index) for each line of `text` and returns how many
+// there are.
+template <typename GlyphOf, typename OnLine>
+uint16_t breakLines(const char *text, uint16_t maxWidth, uint16_t maxLines, const GlyphOf &glyphOf,
+                    const OnLine &onLine) {
+  size_t n = 0;
+  while (n < MAX_TEXT && text[n] != '\0') {
+    ++n;
+  }
+
+  // x of every glyph from the start of the text, and its pixel columns.
+  int16_t x[MAX_TEXT + 1];
+  int16_t left[MAX_TEXT], right[MAX_TEXT];  // left > right: blank
+  x[0] = 0;
+  for (size_t i = 0; i < n; ++i) {
+    const text_metrics::GlyphMetrics glyph = glyphOf(static_cast<uint8_t>(text[i]));
+    left[i] = static_cast<int16_t>(x[i] + glyph.left);
+    right[i] = static_cast<int16_t>(x[i] + glyph.right);
+    x[i + 1] = static_cast<int16_t>(x[i] + glyph.advance);
+  }
+
+  // The ellipsis from its own origin.
+  int16_t dotsLeft = INT16_MAX, dotsRight = INT16_MIN, dotsX = 0;
+  for (const char *p = ELLIPSIS; *p != '\0'; ++p) {
+    const text_metrics::GlyphMetrics glyph = glyphOf(static_cast<uint8_t>(*p));
+    if (glyph.left <= glyph.right) {
+      dotsLeft = dotsX + glyph.left < dotsLeft ? static_cast<int16_t>(dotsX + glyph.left) : dotsLeft;
+      dotsRight = dotsX + glyph.right > dotsRight ? static_cast<int16_t>(dotsX + glyph.right) : dotsRight;
+    }
+    dotsX = static_cast<int16_t>(dotsX + glyph.advance);
+  }
+
+  // Running pixel columns of the current line: [start, i] spans lo[i]..hi[i].
+  int16_t lo[MAX_TEXT], hi[MAX_TEXT];
+  size_t start = 0;
+  // Width of [start, end), as getTextBounds() reports it, optionally
+  // followed by the ellipsis.
+  auto width = [&](size_t end, bool dots) -> uint16_t {
+    int16_t l = end > start ? lo[end - 1] : INT16_MAX;
+    int16_t r = end > start ? hi[end - 1] : INT16_MIN;
+    if (dots && dotsLeft <= dotsRight) {
+      const int16_t shift = x[end];
+      l = shift + dotsLeft < l ? static_cast<int16_t>(shift + dotsLeft) : l;
+      r = shift + dotsRight > r ? static_cast<int16_t>(shift + dotsRight) : r;
+    }
+    return r < l ? 0 : static_cast<uint16_t>(r - l + 1);
+  };
+
+  uint16_t count = 0;
+  while (count < maxLines && start < n) {
+    const bool lastLine = count + 1 >= maxLines;
+    int16_t lineLeft = INT16_MAX, lineRight = INT16_MIN;
+    for (size_t i = start; i < n; ++i) {
+      if (left[i] <= right[i]) {
+        lineLeft = left[i] < lineLeft ? left[i] : lineLeft;
+        lineRight = right[i] > lineRight ? right[i] : lineRight;
+      }
+      lo[i] = lineLeft;
+      hi[i] = lineRight;
+    }
+
+    size_t end = n;
+    int endIndex = static_cast<int>(n - start);  // last byte of the line, relative to start
+    bool keepHyphen = false;
+    bool ellipsis = false;
+    bool found = true;
+    uint16_t w = width(end, false);
+    while (w > maxWidth && found) {
+      if (keepHyphen) {
+        --end;  // the hyphen of the previous candidate
+      }
+      found = false;
+      size_t at = end;
+      while (at > start) {
+        --at;
+        if (text[at] == ' ' || (!lastLine && text[at] == '-')) {
+          found = true;
+          break;
+        }
+      }
+      if (!found) {
+        break;
+      }
+      endIndex = static_cast<int>(at - start);
+      end = at + 1;
+      keepHyphen = text[at] == '-';
+      if (!keepHyphen) {
+        end = at;
+        --endIndex;
+      }
+      if (!lastLine) {
+        w = width(end, false);
+      } else {
+        w = width(end, true);
+        ellipsis = w <= maxWidth;
+      }
+    }
+
+    onLine(Line{static_cast<uint16_t>(start), static_cast<uint16_t>(end - start), ellipsis}, count);
+    ++count;
+    // past the line and the space or hyphen after it
+    start += static_cast<size_t>(endIndex + 2 - (keepHyphen ? 1 : 0));
+  }
+  return count;
+}
+
+}  // namespace line_breaker
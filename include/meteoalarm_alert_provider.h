@@ -1,7 +1,9 @@
 #pragma once
 
+#include <cmath>
 #include <vector>
 #include "alert_provider.h"
+#include "polygon_scan.h"
 #include "provider_result.h"
 
 /* MeteoAlarm (EUMETNET) national weather alert provider.
@@ -16,7 +18,7 @@
  */
 class MeteoAlarmAlertProvider : public AlertProvider {
  public:
-  ProviderResult fetch(std::vector<weather_alert_t> &alerts) override;
+  ProviderResult fetch(std::vector<weather_alert_t> &alerts, const FetchCancel &cancel) override;
 
    /* Incremental parser for the MeteoAlarm Atom feed. Bytes are fed in as
    * they arrive (e.g. from esp_http_client_read chunks) via feed(); collects
@@ -37,22 +39,45 @@ class MeteoAlarmAlertProvider : public AlertProvider {
     ProviderResult finish();
     bool isAlertCapReached() const { return alertCapReached_; }
 
+    /* EMMA_ID regions of the location (see geocodeFromEmmaId), from
+     * alertsAPI.geocodes. An entry tagged with EMMA_ID geocodes is then kept
+     * if one of them is listed and dropped otherwise, whatever its polygon
+     * says. An entry without geocodes is still located by its polygon. */
+    void setGeocodes(const uint32_t *codes, size_t count);
+
+    // Elements the scanner recognizes, by local name (the namespace prefix
+    // is dropped). Public for the tag trie in the implementation.
+    enum class Tag : uint8_t { NONE, ENTRY, EVENT, SEVERITY, EFFECTIVE, ONSET, EXPIRES, POLYGON, VALUE_NAME, VALUE };
+
    private:
     enum class St { TEXT, ENTITY, TAG_NAME, TAG_ATTR, TAG_ATTR_QUOTED, SKIP };
 
+    // Text fields of an entry, in Tag order from EVENT; the polygon is not
+    // kept but tested against the location as it streams by.
+    static constexpr size_t TEXT_FIELDS = 5;
+    // Arena of the captured text fields of one entry. Each field takes its
+    // text plus a NUL; a field that does not fit is cut (warning names and
+    // timestamps are a few dozen bytes).
+    static constexpr size_t TEXT_ARENA_BYTES = 192;
+
     // Data of the <entry> currently being parsed.
     struct EntryData {
-      String event;
-      String severity;
-      String effective;
-      String onset;
-      String expires;
-      String polygon;  // raw space-separated "lat,lon" ring, empty if absent
+      char arena[TEXT_ARENA_BYTES];
+      size_t used = 0;                  // arena bytes taken by finished fields
+      int16_t field[TEXT_FIELDS] = {};  // arena offset of each field, -1 if absent
+      polygon_scan::PointInPolygon polygon{NAN, NAN};
+      bool geocoded = false;      // carries an EMMA_ID geocode
+      bool geocodeMatch = false;  // one of them is a location region
       bool any = false;
 
-      void reset();
+      void reset(double lat, double lon);
+      const char *text(Tag tag) const;
     };
 
+    void openCapture(Tag tag);
+    void appendText(const char *data, size_t len);
+    void closeCapture();
+    void finishTag();
     void addEntry();
 
     std::vector<weather_alert_t> &alerts_;
@@ -65,11 +90,15 @@ class MeteoAlarmAlertProvider : public AlertProvider {
     bool endTag_ = false;
     bool selfClosing_ = false;
     bool alertCapReached_ = false;  // true once METEOALARM_NUM_ALERTS have been collected
+    const uint32_t *geocodes_ = nullptr;
+    size_t geocodeCount_ = 0;
+    bool emmaIdValue_ = false;  // the last <valueName> was EMMA_ID
     char quote_ = 0;
-    String tagName_;  // tag currently being parsed
-    String capture_;  // entry element currently accumulating text
-    String text_;     // captured text so far
-    String entity_;   // pending "&...;" reference
+    uint8_t tagNode_ = 0;      // trie node of the tag name read so far
+    Tag capture_ = Tag::NONE;  // entry element currently accumulating text
+    size_t captureLen_ = 0;    // bytes captured so far, at entry_.arena + entry_.used
+    char entity_[9];           // pending "&...;" reference
+    uint8_t entityLen_ = 0;
     EntryData entry_;
 
     size_t total_ = 0;  // bytes fed so far
@@ -98,4 +127,10 @@ class MeteoAlarmAlertProvider : public AlertProvider {
    * evaluated and counts as containing every point (alert is kept); points
    * on the boundary count as inside. */
   static bool pointInPolygon(double lat, double lon, const String &polygon);
+
+  /* Pack an EMMA_ID region code ("NL004": two capital letters, 1 to 4
+   * digits) into an integer: the letters in the high bytes, the number in
+   * the low 16 bits. scripts/config.py packs the configured regions the
+   * same way. Returns 0 for anything else. */
+  static uint32_t geocodeFromEmmaId(const char *id);
 };
@@ -6,9 +6,13 @@
 /* Open-Meteo air quality API provider. */
 class OpenMeteoAirQualityProvider : public AirQualityProvider {
  public:
-  ProviderResult fetch(air_quality_t &airQuality) override;
+  ProviderResult fetch(air_quality_t &airQuality, const FetchCancel &cancel) override;
 
   /* Map a streamed JSON response of the Open-Meteo air quality API into the
    * generic air quality model. Public for unit testing. */
-  static ProviderResult deserializeAirQuality(Stream &json, air_quality_t &airQuality);
+  static ProviderResult deserializeAirQuality(ResponseBody &json, air_quality_t &airQuality);
+
+  /* Map a FlatBuffers response (format=flatbuffers) of the Open-Meteo air
+   * quality API into the generic air quality model. Public for unit testing. */
+  static ProviderResult deserializeFlatBuffers(ResponseBody &body, air_quality_t &airQuality);
 };
@@ -0,0 +1,142 @@
+/* Keys of the Open-Meteo forecast response.
+ * Copyright (C) 2026  Lumixen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "key_dispatch.h"
+
+/*
+ * Every section and field key WeatherHandler maps, with the model field it
+ * lands in. The handler looks each key up in a compile-time perfect hash
+ * (key_dispatch.h) and switches on the field, instead of comparing the key
+ * against each name in turn.
+ */
+namespace open_meteo_fields {
+
+enum class Section : uint8_t { CURRENT, HOURLY, DAILY };
+
+enum class CurrentField : uint8_t {
+  TIME,
+  TEMPERATURE,
+  APPARENT_TEMPERATURE,
+  HUMIDITY,
+  DEW_POINT,
+  WEATHER_CODE,
+  CLOUD_COVER,
+  VISIBILITY,
+  PRESSURE,
+  WIND_SPEED,
+  WIND_DIRECTION,
+  WIND_GUSTS,
+  IS_DAY,
+};
+
+enum class HourlyField : uint8_t {
+  TIME,
+  TEMPERATURE,
+  CLOUD_COVER,
+  WIND_SPEED,
+  WIND_GUSTS,
+  PRECIPITATION_PROBABILITY,
+  RAIN,
+  SNOWFALL,
+  WEATHER_CODE,
+  IS_DAY,
+  SOIL_TEMPERATURE,
+};
+
+enum class DailyField : uint8_t {
+  TIME,
+  TEMPERATURE_MAX,
+  TEMPERATURE_MIN,
+  SUNRISE,
+  SUNSET,
+  UV_INDEX_MAX,
+  RAIN_SUM,
+  SNOWFALL_SUM,
+  PRECIPITATION_PROBABILITY_MAX,
+  WIND_SPEED_MAX,
+  WIND_GUSTS_MAX,
+  WEATHER_CODE,
+  SHORTWAVE_RADIATION_SUM,
+};
+
+inline constexpr key_dispatch::Key<Section> SECTION_LIST[] = {
+    {"current", Section::CURRENT},
+    {"hourly", Section::HOURLY},
+    {"daily", Section::DAILY},
+};
+
+inline constexpr key_dispatch::Key<CurrentField> CURRENT_LIST[] = {
+    {"time", CurrentField::TIME},
+    {"temperature_2m", CurrentField::TEMPERATURE},
+    {"apparent_temperature", CurrentField::APPARENT_TEMPERATURE},
+    {"relative_humidity_2m", CurrentField::HUMIDITY},
+    {"dew_point_2m", CurrentField::DEW_POINT},
+    {"weather_code", CurrentField::WEATHER_CODE},
+    {"cloud_cover", CurrentField::CLOUD_COVER},
+    {"visibility", CurrentField::VISIBILITY},
+    {"surface_pressure", CurrentField::PRESSURE},
+    {"wind_speed_10m", CurrentField::WIND_SPEED},
+    {"wind_direction_10m", CurrentField::WIND_DIRECTION},
+    {"wind_gusts_10m", CurrentField::WIND_GUSTS},
+    {"is_day", CurrentField::IS_DAY},
+};
+
+inline constexpr key_dispatch::Key<HourlyField> HOURLY_LIST[] = {
+    {"time", HourlyField::TIME},
+    {"temperature_2m", HourlyField::TEMPERATURE},
+    {"cloud_cover", HourlyField::CLOUD_COVER},
+    {"wind_speed_10m", HourlyField::WIND_SPEED},
+    {"wind_gusts_10m", HourlyField::WIND_GUSTS},
+    {"precipitation_probability", HourlyField::PRECIPITATION_PROBABILITY},
+    {"rain", HourlyField::RAIN},
+    {"snowfall", HourlyField::SNOWFALL},
+    {"weather_code", HourlyField::WEATHER_CODE},
+    {"is_day", HourlyField::IS_DAY},
+    {"soil_temperature_18cm", HourlyField::SOIL_TEMPERATURE},
+};
+
+inline constexpr key_dispatch::Key<DailyField> DAILY_LIST[] = {
+    {"time", DailyField::TIME},
+    {"temperature_2m_max", DailyField::TEMPERATURE_MAX},
+    {"temperature_2m_min", DailyField::TEMPERATURE_MIN},
+    {"sunrise", DailyField::SUNRISE},
+    {"sunset", DailyField::SUNSET},
+    {"uv_index_max", DailyField::UV_INDEX_MAX},
+    {"rain_sum", DailyField::RAIN_SUM},
+    {"snowfall_sum", DailyField::SNOWFALL_SUM},
+    {"precipitation_probability_max", DailyField::PRECIPITATION_PROBABILITY_MAX},
+    {"wind_speed_10m_max", DailyField::WIND_SPEED_MAX},
+    {"wind_gusts_10m_max", DailyField::WIND_GUSTS_MAX},
+    {"weather_code", DailyField::WEATHER_CODE},
+    {"shortwave_radiation_sum", DailyField::SHORTWAVE_RADIATION_SUM},
+};
+
+// Key of `field` in `list`, null if it has none.
+template <typename Field, size_t N>
+constexpr const char *keyName(const key_dispatch::Key<Field> (&list)[N], Field field) {
+  for (const key_dispatch::Key<Field> &key : list) {
+    if (key.field == field) {
+      return key.name;
+    }
+  }
+  return nullptr;
+}
+
+inline constexpr key_dispatch::KeyTable SECTION_KEYS(SECTION_LIST);
+inline constexpr key_dispatch::KeyTable CURRENT_KEYS(CURRENT_LIST);
+inline constexpr key_dispatch::KeyTable HOURLY_KEYS(HOURLY_LIST);
+inline constexpr key_dispatch::KeyTable DAILY_KEYS(DAILY_LIST);
+static_assert(SECTION_KEYS.found() && CURRENT_KEYS.found() && HOURLY_KEYS.found() && DAILY_KEYS.found(),
+              "no collision-free seed for the Open-Meteo keys");
+
+}  // namespace open_meteo_fields
@@ -0,0 +1,130 @@
+/* Open-Meteo responses in the FlatBuffers format.
+ * Copyright (C) 2026  Lumixen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include "_locale.h"
+#include "flatbuffer_reader.h"
+#include "response_body.h"
+
+/*
+ * With format=flatbuffers, the forecast and air quality APIs answer with one
+ * size-prefixed WeatherApiResponse message per location (schema in
+ * open-meteo/sdk, weather_api.fbs) instead of JSON. Each section (current,
+ * hourly, daily) is a VariablesWithTime: the start time, the interval
+ * between steps and one VariableWithValues per requested variable, in the
+ * order the query listed them, holding a float (current), a float array or
+ * an int64 array (sunrise, sunset). Timestamps are not sent per step: step
+ * i is at time + i * interval. Missing values are NaN.
+ *
+ * The decoders map variables by their position in the query, so they do not
+ * depend on the Variable enum numbering of the SDK. The message is read into
+ * one heap buffer (a few KB: 4 bytes per value) and decoded in place.
+ */
+namespace open_meteo_fb {
+
+// Field ids (declaration order) of the tables used.
+namespace response {
+constexpr uint16_t CURRENT = 9;
+constexpr uint16_t DAILY = 10;
+constexpr uint16_t HOURLY = 11;
+}  // namespace response
+
+namespace series {
+constexpr uint16_t TIME = 0;
+constexpr uint16_t TIME_END = 1;
+constexpr uint16_t INTERVAL = 2;
+constexpr uint16_t VARIABLES = 3;
+}  // namespace series
+
+namespace variable {
+constexpr uint16_t VALUE = 2;
+constexpr uint16_t VALUES = 3;
+constexpr uint16_t VALUES_INT64 = 4;
+}  // namespace variable
+
+// A response of one location is a few KB; anything larger is not one.
+constexpr uint32_t MAX_MESSAGE_BYTES = 32 * 1024;
+
+enum class ReadStatus : uint8_t { OK, EMPTY, TRUNCATED, TOO_LARGE, NO_MEMORY };
+
+// Deserialization error text of a failed read.
+inline const char *readError(ReadStatus status) {
+  switch (status) {
+    case ReadStatus::EMPTY:
+      return TXT_DESERIALIZATION_ERROR_EMPTY_INPUT;
+    case ReadStatus::TRUNCATED:
+      return TXT_DESERIALIZATION_ERROR_INCOMPLETE_INPUT;
+    case ReadStatus::NO_MEMORY:
+      return TXT_DESERIALIZATION_ERROR_NO_MEMORY;
+    default:
+      return TXT_DESERIALIZATION_ERROR_INVALID_INPUT;
+  }
+}
+
+/* The first message of a response body, size prefix stripped. */
+class Message {
+ public:
+  ReadStatus read(ResponseBody &body) {
+    uint32_t size = 0;
+    const size_t prefix = body.readBytes(reinterpret_cast<char *>(&size), sizeof(size));
+    if (prefix == 0) {
+      return ReadStatus::EMPTY;
+    }
+    if (prefix < sizeof(size)) {
+      return ReadStatus::TRUNCATED;
+    }
+    if (size > MAX_MESSAGE_BYTES) {
+      return ReadStatus::TOO_LARGE;
+    }
+    data_.reset(static_cast<uint8_t *>(malloc(size)));
+    if (data_ == nullptr && size > 0) {
+      return ReadStatus::NO_MEMORY;
+    }
+    size_ = body.readBytes(reinterpret_cast<char *>(data_.get()), size);
+    return size_ == size ? ReadStatus::OK : ReadStatus::TRUNCATED;
+  }
+
+  flatbuffer::Table root() const { return flatbuffer::Table::root(data_.get(), size_); }
+  size_t size() const { return size_; }
+
+ private:
+  struct Free {
+    void operator()(uint8_t *p) const { free(p); }
+  };
+
+  std::unique_ptr<uint8_t, Free> data_;
+  size_t size_ = 0;
+};
+
+/* One section of the response. */
+struct Series {
+  explicit Series(const flatbuffer::Table &table)
+      : time(table.scalar<int64_t>(series::TIME, 0)),
+        timeEnd(table.scalar<int64_t>(series::TIME_END, 0)),
+        interval(table.scalar<int32_t>(series::INTERVAL, 0)),
+        variables(table.tables(series::VARIABLES)) {}
+
+  // Steps in [time, timeEnd); 0 for the current section (no interval).
+  uint32_t steps() const {
+    return interval > 0 && timeEnd > time ? static_cast<uint32_t>((timeEnd - time) / interval) : 0;
+  }
+  int64_t at(uint32_t step) const { return time + static_cast<int64_t>(step) * interval; }
+
+  int64_t time;
+  int64_t timeEnd;
+  int32_t interval;
+  flatbuffer::TableVector variables;
+};
+
+}  // namespace open_meteo_fb
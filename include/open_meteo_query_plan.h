@@ -0,0 +1,125 @@
+/* Open-Meteo forecast variables planned from the build config.
+ * Copyright (C) 2026  Lumixen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include "config.h"
+#include "open_meteo_fields.h"
+
+/*
+ * The variables the forecast request asks for, per section and in query
+ * order: only those the configured display draws. The left panel layout
+ * (POS_*), the precipitation units and DISPLAY_DAILY_PRECIP / _HOURLY_ICONS
+ * decide, e.g. a layout without POS_VISIBILITY does not request visibility
+ * and a POP precipitation unit requests no rain or snowfall sums. Time
+ * comes with every section without being asked for.
+ *
+ * Fields always kept: temperatures, the weather code and the wind speed and
+ * gusts (every condition icon reads them, see getConditionsBitmap), and
+ * current cloud cover and is_day (the current icon). A FlatBuffers response
+ * carries the variables in this order and nothing else identifies them, so
+ * the URI and the FlatBuffers decoder both read these lists.
+ */
+namespace open_meteo_plan {
+
+using open_meteo_fields::CurrentField;
+using open_meteo_fields::DailyField;
+using open_meteo_fields::HourlyField;
+
+inline constexpr CurrentField CURRENT_QUERY[] = {
+    CurrentField::TEMPERATURE,
+#if defined(POS_HUMIDITY)
+    CurrentField::HUMIDITY,
+#endif
+#if defined(POS_DEWPOINT)
+    CurrentField::DEW_POINT,
+#endif
+    CurrentField::APPARENT_TEMPERATURE,
+    CurrentField::WEATHER_CODE,
+    CurrentField::CLOUD_COVER,
+#if defined(POS_VISIBILITY)
+    CurrentField::VISIBILITY,
+#endif
+#if defined(POS_PRESSURE)
+    CurrentField::PRESSURE,
+#endif
+    CurrentField::WIND_SPEED,
+#if defined(POS_WIND)
+    CurrentField::WIND_DIRECTION,
+#endif
+    CurrentField::WIND_GUSTS,
+    CurrentField::IS_DAY,
+};
+
+inline constexpr HourlyField HOURLY_QUERY[] = {
+    HourlyField::TEMPERATURE,
+#if DISPLAY_HOURLY_ICONS
+    HourlyField::CLOUD_COVER,
+    HourlyField::WIND_SPEED,
+    HourlyField::WIND_GUSTS,
+#endif
+#if defined(UNITS_HOURLY_PRECIP_POP)
+    HourlyField::PRECIPITATION_PROBABILITY,
+#else
+    HourlyField::RAIN,
+    HourlyField::SNOWFALL,
+#endif
+#if DISPLAY_HOURLY_ICONS
+    HourlyField::WEATHER_CODE,
+    HourlyField::IS_DAY,
+#endif
+};
+
+inline constexpr DailyField DAILY_QUERY[] = {
+    DailyField::WEATHER_CODE,
+    DailyField::TEMPERATURE_MAX,
+    DailyField::TEMPERATURE_MIN,
+#if defined(POS_SUNRISE)
+    DailyField::SUNRISE,
+#endif
+#if defined(POS_SUNSET)
+    DailyField::SUNSET,
+#endif
+#if defined(POS_UVI)
+    DailyField::UV_INDEX_MAX,
+#endif
+#if !defined(DISPLAY_DAILY_PRECIP_DISABLED) && !defined(UNITS_DAILY_PRECIP_POP)
+    DailyField::RAIN_SUM,
+    DailyField::SNOWFALL_SUM,
+#endif
+#if !defined(DISPLAY_DAILY_PRECIP_DISABLED) && defined(UNITS_DAILY_PRECIP_POP)
+    DailyField::PRECIPITATION_PROBABILITY_MAX,
+#endif
+    DailyField::WIND_SPEED_MAX,
+    DailyField::WIND_GUSTS_MAX,
+};
+
+// True if `field` is in `query`.
+template <typename Field, size_t N>
+constexpr bool planned(const Field (&query)[N], Field field) {
+  for (Field queried : query) {
+    if (queried == field) {
+      return true;
+    }
+  }
+  return false;
+}
+
+inline constexpr bool planned(CurrentField field) {
+  return planned(CURRENT_QUERY, field);
+}
+inline constexpr bool planned(HourlyField field) {
+  return planned(HOURLY_QUERY, field);
+}
+inline constexpr bool planned(DailyField field) {
+  return planned(DAILY_QUERY, field);
+}
+
+}  // namespace open_meteo_plan
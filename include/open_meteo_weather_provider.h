@@ -7,13 +7,28 @@
 class OpenMeteoWeatherProvider : public WeatherProvider {
  public:
   const char *getApiName() const override;
-  ProviderResult fetch(forecast_t &forecast) override;
+  ProviderResult fetch(forecast_t &forecast, const FetchCancel &cancel) override;
 
   /* Map a WMO weather interpretation code onto the unified weather_condition
    * enum. Public for unit testing. */
   static weather_condition mapWeatherCode(int id);
 
+  /* Sections a request asks for, and a response must carry: all of them, or
+   * only `current` on the wakes between two full requests (see
+   * forecast_refresh.h). */
+  enum class Sections { ALL, CURRENT };
+
   /* Map a streamed JSON response of the Open-Meteo forecast API into the
-   * generic forecast model. Public for unit testing. */
-  static ProviderResult deserializeCall(Stream &json, forecast_t &forecast);
+   * generic forecast model. With `hourly` given, the hourly rows go there
+   * (up to `hourlyRows`, the window a full request keeps, see
+   * forecast_refresh.h) instead of into the model. Public for unit testing. */
+  static ProviderResult deserializeCall(ResponseBody &json, forecast_t &forecast, Sections sections = Sections::ALL,
+                                        hourly_t *hourly = nullptr, size_t hourlyRows = 0);
+
+  /* Map a FlatBuffers response (format=flatbuffers) of the Open-Meteo
+   * forecast API into the generic forecast model, the hourly rows as for
+   * deserializeCall. Public for unit testing. */
+  static ProviderResult deserializeFlatBuffers(ResponseBody &body, forecast_t &forecast,
+                                               Sections sections = Sections::ALL, hourly_t *hourly = nullptr,
+                                               size_t hourlyRows = 0);
 };
@@ -6,8 +6,8 @@
 /* OpenWeatherMap "Air Pollution" API air quality provider. */
 class OWMAirQualityProvider : public AirQualityProvider {
  public:
-  ProviderResult fetch(air_quality_t &airQuality) override;
+  ProviderResult fetch(air_quality_t &airQuality, const FetchCancel &cancel) override;
 
  private:
-  static ProviderResult deserializeAirQuality(Stream &json, air_quality_t &airQuality);
+  static ProviderResult deserializeAirQuality(ResponseBody &json, air_quality_t &airQuality);
 };
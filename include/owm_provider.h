@@ -28,16 +28,22 @@ class OWMProvider : public WeatherProvider, public AlertProvider {
   OWMProvider();
   ~OWMProvider() override;
   const char *getApiName() const override;
-  ProviderResult fetch(forecast_t &forecast) override;
-  ProviderResult fetch(std::vector<weather_alert_t> &alerts) override;
+  ProviderResult fetch(forecast_t &forecast, const FetchCancel &cancel) override;
+  ProviderResult fetch(std::vector<weather_alert_t> &alerts, const FetchCancel &cancel) override;
 
   static weather_condition mapWeatherCode(int id);
 
- private:
-  static ProviderResult deserializeOneCall(Stream &json, forecast_t &forecast,
+  /* Map a streamed One Call response into the forecast model and, with
+   * `alerts`, the alerts (OWM alerts provider only). Public for unit
+   * testing. */
+  static ProviderResult deserializeOneCall(ResponseBody &json, forecast_t &forecast,
                                            std::vector<weather_alert_t> *alerts);
-  static ProviderResult deserializeAlerts(Stream &json, std::vector<weather_alert_t> &alerts);
-  ProviderResult fetchInternal(forecast_t *forecast, std::vector<weather_alert_t> *alertsOut);
+  // Same for an alerts-only response. Public for unit testing.
+  static ProviderResult deserializeAlerts(ResponseBody &json, std::vector<weather_alert_t> &alerts);
+
+ private:
+  ProviderResult fetchInternal(forecast_t *forecast, std::vector<weather_alert_t> *alertsOut,
+                               const FetchCancel &cancel);
 
   std::vector<weather_alert_t> alerts_;
   bool haveAlerts_ = false;
@@ -0,0 +1,48 @@
+/* Core split of a fetch: receive on the network core, parse on the other.
+ * Copyright (C) 2026  Lumixen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include "config.h"
+#include "provider_result.h"
+#include "response_body.h"
+
+// Core of the WiFi/lwIP tasks (PRO_CPU): fetch workers, socket reads and
+// TLS decryption run next to them.
+constexpr int NETWORK_CORE = 0;
+// Core the body is parsed (and the display rendered) on (APP_CPU).
+constexpr int PARSE_CORE = 1;
+// Body bytes in flight between the two cores; a power of two (SpscRing).
+constexpr size_t PARSE_RING_BYTES = 4096;
+// Parse task stack, unless auto-sized (stack_watermark.h): the parse ran on
+// the fetch worker's stack before the split.
+constexpr uint32_t PARSE_STACK_BYTES = 8192;
+
+// True when fetches are split over both cores (config `coreSplit`, dual-core
+// chips only).
+inline bool coreSplitEnabled() {
+#if CORE_SPLIT && !CONFIG_FREERTOS_UNICORE
+  return true;
+#else
+  return false;
+#endif
+}
+
+/* Run `parse` on `source` with the parsing on PARSE_CORE: a parse task reads
+ * the body from a lock-free ring (spsc_ring.h) while the calling task keeps
+ * receiving into it, so network waits and parse CPU overlap instead of
+ * alternating. Returns what `parse` returned; the rest of the body is not
+ * read once `parse` returned early.
+ *
+ * Falls back to parsing on the calling task when the ring or the task cannot
+ * be allocated. */
+ProviderResult pipelinedParse(ResponseBody &source, const std::function<ProviderResult(ResponseBody &)> &parse);
@@ -0,0 +1,121 @@
+/* Streaming point-in-polygon test of a CAP polygon.
+ * Copyright (C) 2026  Lumixen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+/*
+ * A CAP polygon is a ring of space-separated "lat,lon" pairs in WGS84
+ * decimal degrees, and the ones of a national feed run to kilobytes. Ray
+ * casting only needs the previous point to test an edge, so PointInPolygon
+ * takes the text in pieces as a scanner hands them over, in whatever split,
+ * and keeps the crossing parity instead of the text. Only the number being
+ * read is buffered.
+ *
+ * A token that is not a number is skipped where a latitude is expected, and
+ * ends the ring where a longitude is (a malformed trailing point). A ring of
+ * fewer than 3 points can not be evaluated and counts as containing every
+ * point; points on the boundary count as inside.
+ */
+namespace polygon_scan {
+
+class PointInPolygon {
+ public:
+  PointInPolygon(double lat, double lon) : lat_(lat), lon_(lon) {}
+
+  void feed(const char *text, size_t len) {
+    for (size_t i = 0; i < len && !ended_; ++i) {
+      const char c = text[i];
+      if (c == ' ' || c == ',' || c == '\t' || c == '\r' || c == '\n') {
+        endToken();
+      } else if (tokenLen_ < sizeof(token_) - 1) {
+        token_[tokenLen_++] = c;
+      } else {
+        tokenTooLong_ = true;
+      }
+    }
+  }
+
+  // Whether the ring fed so far, closed if it is open, contains the point.
+  bool inside() {
+    endToken();
+    if (points_ < 3) {
+      return true;  // not a usable polygon
+    }
+    bool inside = inside_;
+    // Closing edge (last -> first) if the ring is not explicitly closed
+    if (prevLat_ != firstLat_ || prevLon_ != firstLon_) {
+      inside ^= crosses(prevLat_, prevLon_, firstLat_, firstLon_);
+    }
+    return inside;
+  }
+
+ private:
+  // Whether the edge (aLat, aLon) -> (bLat, bLon) crosses the ray cast from
+  // the point towards increasing longitude.
+  bool crosses(double aLat, double aLon, double bLat, double bLon) const {
+    return (aLat > lat_) != (bLat > lat_) && lon_ < (bLon - aLon) * (lat_ - aLat) / (bLat - aLat) + aLon;
+  }
+
+  void endToken() {
+    if (tokenLen_ == 0 && !tokenTooLong_) {
+      return;
+    }
+    token_[tokenLen_] = '\0';
+    char *next = nullptr;
+    const double value = strtod(token_, &next);
+    const bool valid = !tokenTooLong_ && next == token_ + tokenLen_;
+    tokenLen_ = 0;
+    tokenTooLong_ = false;
+    if (!haveLat_) {
+      if (valid) {  // a stray token before a latitude is skipped
+        pendingLat_ = value;
+        haveLat_ = true;
+      }
+      return;
+    }
+    haveLat_ = false;
+    if (!valid) {
+      ended_ = true;  // malformed trailing point
+      return;
+    }
+    point(pendingLat_, value);
+  }
+
+  void point(double lat, double lon) {
+    if (points_ == 0) {
+      firstLat_ = lat;
+      firstLon_ = lon;
+    } else if (crosses(prevLat_, prevLon_, lat, lon)) {
+      inside_ = !inside_;
+    }
+    prevLat_ = lat;
+    prevLon_ = lon;
+    ++points_;
+  }
+
+  double lat_;
+  double lon_;
+  char token_[32] = {};  // number being read
+  uint8_t tokenLen_ = 0;
+  bool tokenTooLong_ = false;
+  bool haveLat_ = false;
+  bool ended_ = false;
+  double pendingLat_ = 0;
+  double firstLat_ = 0, firstLon_ = 0;
+  double prevLat_ = 0, prevLon_ = 0;
+  uint32_t points_ = 0;
+  bool inside_ = false;
+};
+
+}  // namespace polygon_scan
@@ -15,14 +15,28 @@
 #include "alert_provider.h"
 #include "data_models.h"
 #include "fetch_operation.h"
+#include "response_cache.h"
 #include "weather_provider.h"
 
+// Keep a successful result for the response cache, see response_cache.h.
+template <typename Model>
+ProviderResult stageOnSuccess(const ProviderResult &result, const Model &out) {
+  if (result.isOk()) {
+    responseCacheStage(out, result.maxAge());
+  }
+  return result;
+}
+
 class WeatherFetchOperation : public FetchOperation {
  public:
   WeatherFetchOperation(WeatherProvider *provider, forecast_t &out) : provider_(provider), out_(out) {}
-  ProviderResult execute() override { return provider_->fetch(out_); }
+  ProviderResult execute(const FetchCancel &cancel) override {
+    return stageOnSuccess(provider_->fetch(out_, cancel), out_);
+  }
   const char *name() const override { return provider_->getApiName(); }
+  FetchKind kind() const override { return FetchKind::WEATHER; }
   bool shouldAbortOnFailure() const override { return true; }
+  bool restoreFromCache() override { return responseCacheRestore(out_); }
 
  private:
   WeatherProvider *provider_;
@@ -32,9 +46,13 @@ class WeatherFetchOperation : public FetchOperation {
 class AirQualityFetchOperation : public FetchOperation {
  public:
   AirQualityFetchOperation(AirQualityProvider *provider, air_quality_t &out) : provider_(provider), out_(out) {}
-  ProviderResult execute() override { return provider_->fetch(out_); }
+  ProviderResult execute(const FetchCancel &cancel) override {
+    return stageOnSuccess(provider_->fetch(out_, cancel), out_);
+  }
   const char *name() const override { return "Air Pollution API"; }
+  FetchKind kind() const override { return FetchKind::AIR_QUALITY; }
   bool shouldAbortOnFailure() const override { return true; }
+  bool restoreFromCache() override { return responseCacheRestore(out_); }
 
  private:
   AirQualityProvider *provider_;
@@ -43,18 +61,30 @@ class AirQualityFetchOperation : public FetchOperation {
 
 class AlertFetchOperation : public FetchOperation {
  public:
-  AlertFetchOperation(AlertProvider *provider, std::vector<weather_alert_t> &out) : provider_(provider), out_(out) {}
-  ProviderResult execute() override { return provider_->fetch(out_); }
+  AlertFetchOperation(AlertProvider *provider, std::vector<weather_alert_t> &out, uint32_t dependsOn = 0)
+      : provider_(provider), out_(out), dependsOn_(dependsOn) {}
+  ProviderResult execute(const FetchCancel &cancel) override {
+    return stageOnSuccess(provider_->fetch(out_, cancel), out_);
+  }
   const char *name() const override { return "Alerts API"; }
+  FetchKind kind() const override { return FetchKind::ALERTS; }
   bool shouldAbortOnFailure() const override { return false; }
+  bool restoreFromCache() override { return responseCacheRestore(out_); }
+  uint32_t dependsOn() const override { return dependsOn_; }
 
  private:
   AlertProvider *provider_;
   std::vector<weather_alert_t> &out_;
+  uint32_t dependsOn_;
 };
 
-/* Build fetch operations in alerts-first order so alerts goes first into the
- * bounded pool (max 2 concurrent). Caller owns providers; operations borrow them.
+/* Drop the operations whose output was restored from a fresh response cache
+ * record, so only stale data is fetched. Call once the clock is set. */
+void skipCachedFetchOperations(std::vector<std::unique_ptr<FetchOperation>> &ops);
+
+/* Build the fetch operations, alerts first. That order is only the baseline:
+ * the executor starts them longest-expected-first (see fetch_schedule.h) and
+ * keeps it for ties. Caller owns providers; operations borrow them.
  */
 std::vector<std::unique_ptr<FetchOperation>> createFetchOperations(
     WeatherProvider *weatherProvider, AirQualityProvider *airQualityProvider, AlertProvider *alertProvider,
@@ -13,6 +13,7 @@
 #pragma once
 
 #include <WString.h>
+#include <cstdint>
 
 class ProviderResult {
  public:
@@ -26,9 +27,29 @@ class ProviderResult {
   bool isOk() const { return ok_; }
   const String &detail() const { return detail_; }
 
+  // Freshness lifetime (s) the server advertised for the response through
+  // Cache-Control max-age or Expires, -1 when it did not say. Feeds the
+  // response cache TTL (see response_cache.h).
+  int32_t maxAge() const { return maxAge_; }
+  ProviderResult &setMaxAge(int32_t seconds) {
+    maxAge_ = seconds;
+    return *this;
+  }
+
+  // A failure that a retry of the same request would only repeat (e.g. a
+  // response coding the firmware can not decode): httpGetWithRetry gives up
+  // on it at once.
+  bool isPermanent() const { return permanent_; }
+  ProviderResult &setPermanent() {
+    permanent_ = true;
+    return *this;
+  }
+
  private:
   ProviderResult(bool ok, const String &detail) : ok_(ok), detail_(detail) {}
 
   bool ok_;
   String detail_;
+  int32_t maxAge_ = -1;
+  bool permanent_ = false;
 };
\ No newline at end of file
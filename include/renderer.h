@@ -25,6 +25,7 @@
 #include <GxEPD2_750c_86BF.h>
 #endif
 #include "moon_tools.h"
+#include "view_model.h"
 
 #ifdef EPD_PANEL_GENERIC_BW_V2
 #define DISP_WIDTH 800
@@ -66,30 +67,19 @@ typedef enum alignment { LEFT, RIGHT, CENTER } alignment_t;
 
 uint16_t getStringWidth(const String &text);
 uint16_t getStringHeight(const String &text);
-void drawString(int16_t x, int16_t y, const String &text, alignment_t alignment, uint16_t color = GxEPD_BLACK);
+uint16_t drawString(int16_t x, int16_t y, const String &text, alignment_t alignment, uint16_t color = GxEPD_BLACK);
 void drawMultiLnString(int16_t x, int16_t y, const String &text, alignment_t alignment, uint16_t max_width,
                        uint16_t max_lines, int16_t line_spacing, uint16_t color = GxEPD_BLACK);
 void beginLightSleep(const void *);
 void initDisplay();
 void powerOffDisplay();
-void drawCurrentConditions(const current_t &current, const air_quality_t &air_quality, std::optional<float> inPressure,
-                           const moon_state_t &moon);
-void drawForecast(const daily_t *daily, tm timeInfo);
-void drawAlerts(std::vector<weather_alert_t> &alerts, const String &city, const String &date);
+bool beginScene();
+bool renderScene();
+void drawConditionCell(const condition_cell_view_t &cell);
+void drawCurrentConditions(const current_view_t &view);
+void drawForecast(const forecast_day_view_t *days);
+void drawAlerts(const alert_view_t *alerts, int count, const String &city, const String &date);
 void drawLocationDate(const String &city, const String &date);
-void drawOutlookGraph(const hourly_t *hourly, const daily_t *daily, tm timeInfo, const moon_state_t &moon);
-void drawStatusBar(const String &statusStr, const String &refreshTimeStr, int rssi, uint32_t batVoltage);
+void drawOutlookGraph(const outlook_view_t &view);
+void drawStatusBar(const status_bar_view_t &view);
 void drawError(const uint8_t *bitmap_196x196, const String &errMsgLn1, const String &errMsgLn2 = "");
-void drawCurrentAirQuality(const air_quality_t &air_quality);
-void drawCurrentHumidity(const current_t &current);
-void drawCurrentMoonphase(const moon_state_t &moon);
-void drawCurrentMoonrise(const moon_state_t &moon);
-void drawCurrentMoonset(const moon_state_t &moon);
-void drawCurrentPressure(const current_t &current);
-void drawCurrentSunrise(const current_t &current);
-void drawCurrentSunset(const current_t &current);
-void drawCurrentUVI(const current_t &current);
-void drawCurrentVisibility(const current_t &current);
-void drawCurrentWind(const current_t &current);
-void drawCurrentDewpoint(const current_t &current);
-void drawCurrentInPressure(std::optional<float> inPressure);
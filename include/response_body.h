@@ -0,0 +1,124 @@
+/* Response body delivered as contiguous chunks.
+ * Copyright (C) 2026  Lumixen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/*
+ * Every parser reads its HTTP response through this interface: the body
+ * arrives as (pointer, length) chunks taken by one bulk read from the
+ * transport (HTTPClient's socket, esp_http_client, or the inflater window
+ * of a compressed body), and parsers walk each chunk in place. The only
+ * virtual call is the refill, once per chunk, instead of a virtual Stream
+ * call plus the client's timeout bookkeeping per byte.
+ *
+ * read() and readBytes() make a body an ArduinoJson custom reader as well,
+ * so deserializeJson(doc, body) reads from the same chunks.
+ */
+class ResponseBody {
+ public:
+  virtual ~ResponseBody() = default;
+
+  /* Next contiguous chunk of the body (the unread rest of the current one
+   * first), valid until the next call. Returns false once the body ended:
+   * closed, declared length read, timed out or failed to decode. */
+  bool next(const char *&data, size_t &len) {
+    if (pos_ >= len_ && !refill()) {
+      return false;
+    }
+    data = data_ + pos_;
+    len = len_ - pos_;
+    pos_ = len_;
+    return true;
+  }
+
+  // Single byte (0..255), -1 at the end of the body.
+  int read() {
+    if (pos_ >= len_ && !refill()) {
+      return -1;
+    }
+    return static_cast<uint8_t>(data_[pos_++]);
+  }
+
+  // Byte read() would return next, without consuming it.
+  int peek() {
+    if (pos_ >= len_ && !refill()) {
+      return -1;
+    }
+    return static_cast<uint8_t>(data_[pos_]);
+  }
+
+  size_t readBytes(char *out, size_t length) {
+    size_t copied = 0;
+    while (copied < length && (pos_ < len_ || refill())) {
+      const size_t n = std::min(length - copied, len_ - pos_);
+      memcpy(out + copied, data_ + pos_, n);
+      pos_ += n;
+      copied += n;
+    }
+    return copied;
+  }
+
+  // Body bytes handed out so far.
+  size_t consumed() const { return total_ - (len_ - pos_); }
+
+ protected:
+  /* Point `data`/`len` at the next chunk (len > 0), valid until the next
+   * call. Returns false at the end of the body. */
+  virtual bool fill(const char *&data, size_t &len) = 0;
+
+ private:
+  bool refill() {
+    const char *data = nullptr;
+    size_t len = 0;
+    if (!fill(data, len) || len == 0) {
+      len_ = pos_ = 0;
+      return false;
+    }
+    data_ = data;
+    len_ = len;
+    pos_ = 0;
+    total_ += len;
+    return true;
+  }
+
+  const char *data_ = nullptr;
+  size_t len_ = 0;
+  size_t pos_ = 0;
+  size_t total_ = 0;
+};
+
+/* Body held in memory, handed out in chunks of at most `chunkSize` bytes
+ * (fixtures, benchmarks and cached payloads). */
+class MemoryBody : public ResponseBody {
+ public:
+  MemoryBody(const char *data, size_t len, size_t chunkSize = SIZE_MAX)
+      : data_(data), len_(len), chunkSize_(chunkSize > 0 ? chunkSize : 1) {}
+
+ protected:
+  bool fill(const char *&data, size_t &len) override {
+    if (pos_ >= len_) {
+      return false;
+    }
+    data = data_ + pos_;
+    len = std::min(chunkSize_, len_ - pos_);
+    pos_ += len;
+    return true;
+  }
+
+ private:
+  const char *data_;
+  size_t len_;
+  size_t chunkSize_;
+  size_t pos_ = 0;
+};
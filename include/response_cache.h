@@ -0,0 +1,188 @@
+/* Response cache — parsed provider results reused across deep sleep.
+ * Copyright (C) 2026  Lumixen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include "config.h"
+#include "data_models.h"
+#include "fetch_operation.h"
+
+/*
+ * Every successful fetch leaves its parsed result (not the raw response) in
+ * the spare "spiffs" data partition together with an expiry time. On the next
+ * wakes a FetchOperation whose result is still fresh is not scheduled at all:
+ * the model is restored from flash instead of paying for another TLS
+ * handshake and download.
+ *
+ * The freshness lifetime of each provider comes from the config (minutes) or,
+ * when unset there, from the Cache-Control max-age / Expires headers of the
+ * response. Records are bound to the firmware build: a reflash (new config,
+ * units or model layout) invalidates everything written before.
+ *
+ * The byte codecs, header parsing and freshness rules below work on
+ * buffers and timestamps passed in; only the front end declared at the end
+ * of the file touches flash.
+ */
+namespace response_cache {
+
+constexpr uint32_t SLOT_MAGIC = 0x52434831;  // "RCH1", bump on codec change
+constexpr size_t SLOT_SIZE = 8192;           // two flash sectors per record
+
+// Header written in front of every record. It is written last, so a record
+// interrupted by a reset never carries a valid magic.
+struct SlotHeader {
+  uint32_t magic;
+  uint32_t layout;     // layoutId() of the firmware that wrote the record
+  uint32_t sequence;   // increases with every record of the same kind
+  uint32_t length;     // payload bytes following the header
+  uint32_t crc;        // CRC-32 of the payload
+  uint8_t kind;        // FetchKind
+  uint8_t reserved[3];
+  int64_t fetchedAt;   // Unix time, UTC
+  int64_t expiresAt;   // Unix time, UTC
+};
+
+constexpr size_t MAX_PAYLOAD = SLOT_SIZE - sizeof(SlotHeader);
+
+// Appends fixed-size values and length-prefixed strings to a byte buffer.
+class Writer {
+ public:
+  explicit Writer(std::vector<uint8_t> &out) : out_(out) {}
+
+  void bytes(const void *data, size_t len) {
+    const uint8_t *p = static_cast<const uint8_t *>(data);
+    out_.insert(out_.end(), p, p + len);
+  }
+  template <typename T>
+  void value(const T &v) {
+    bytes(&v, sizeof(T));
+  }
+  void string(const String &s) {
+    value(static_cast<uint32_t>(s.length()));
+    bytes(s.c_str(), s.length());
+  }
+
+ private:
+  std::vector<uint8_t> &out_;
+};
+
+// Bounds-checked counterpart of Writer. Any read past the end fails and
+// leaves the reader failed, so decoders only need to check ok() once.
+class Reader {
+ public:
+  Reader(const uint8_t *data, size_t len) : data_(data), len_(len) {}
+
+  bool bytes(void *out, size_t len) {
+    if (!ok_ || len > len_ - pos_) {
+      ok_ = false;
+      return false;
+    }
+    memcpy(out, data_ + pos_, len);
+    pos_ += len;
+    return true;
+  }
+  template <typename T>
+  bool value(T &v) {
+    return bytes(&v, sizeof(T));
+  }
+  bool string(String &s) {
+    uint32_t len = 0;
+    if (!value(len) || len > len_ - pos_) {
+      ok_ = false;
+      return false;
+    }
+    s = "";
+    s.concat(reinterpret_cast<const char *>(data_ + pos_), len);
+    pos_ += len;
+    return true;
+  }
+
+  bool ok() const { return ok_; }
+  bool atEnd() const { return ok_ && pos_ == len_; }
+
+ private:
+  const uint8_t *data_;
+  size_t len_;
+  size_t pos_ = 0;
+  bool ok_ = true;
+};
+
+void encode(Writer &out, const forecast_t &forecast);
+void encode(Writer &out, const air_quality_t &airQuality);
+void encode(Writer &out, const std::vector<weather_alert_t> &alerts);
+
+// Decoders fail (returning false) on truncated or oversized input.
+bool decode(Reader &in, forecast_t &forecast);
+bool decode(Reader &in, air_quality_t &airQuality);
+bool decode(Reader &in, std::vector<weather_alert_t> &alerts);
+
+// Drop alerts that ended before `now`: a record may outlive some of them.
+void dropExpiredAlerts(std::vector<weather_alert_t> &alerts, int64_t now);
+
+// Parse an IMF-fixdate ("Sun, 06 Nov 1994 08:49:37 GMT"), the only HTTP-date
+// format senders generate. Returns -1 if `text` is not one.
+int64_t parseHttpDate(const char *text);
+
+/* Freshness lifetime (s) advertised by the response headers (any may be null
+ * when absent): no-store/no-cache give 0, max-age=N gives N, otherwise
+ * Expires minus Date (Date defaults to `now`). Returns -1 when the headers
+ * do not say. */
+int32_t maxAgeFromHeaders(const char *cacheControl, const char *expires, const char *date, int64_t now);
+
+// Lifetime (s) a record of this fetch gets: the configured TTL (minutes)
+// wins, a negative TTL defers to the response headers, unknown means 0.
+inline int32_t lifetimeSeconds(int32_t configuredMinutes, int32_t headerMaxAge) {
+  if (configuredMinutes >= 0) {
+    return configuredMinutes * 60;
+  }
+  return headerMaxAge > 0 ? headerMaxAge : 0;
+}
+
+// A record is fresh from its fetch time until its expiry. A clock that went
+// backwards (now < fetchedAt) invalidates it as well.
+inline bool isFresh(const SlotHeader &header, int64_t now) {
+  return now >= header.fetchedAt && now < header.expiresAt;
+}
+
+}  // namespace response_cache
+
+// True when the response cache is enabled by the config.
+inline bool responseCacheEnabled() {
+#if RESPONSE_CACHE
+  return true;
+#else
+  return false;
+#endif
+}
+
+// Configured TTL (minutes, negative = follow the response headers).
+int32_t responseCacheTtlMinutes(FetchKind kind);
+
+/* Restore the model from a fresh record. Returns false (leaving the model
+ * untouched) on a miss: disabled, no record, stale, corrupt or written by
+ * another build. Call after the clock was set. */
+bool responseCacheRestore(forecast_t &forecast);
+bool responseCacheRestore(air_quality_t &airQuality);
+bool responseCacheRestore(std::vector<weather_alert_t> &alerts);
+
+/* Keep a freshly fetched model for writing. `maxAge` is the lifetime the
+ * server advertised (ProviderResult::maxAge()). Safe to call from fetch
+ * workers: each kind has its own staging buffer. */
+void responseCacheStage(const forecast_t &forecast, int32_t maxAge);
+void responseCacheStage(const air_quality_t &airQuality, int32_t maxAge);
+void responseCacheStage(const std::vector<weather_alert_t> &alerts, int32_t maxAge);
+
+/* Write the staged records to flash. Call once all fetches are done (flash
+ * erases stall both cores, so never while a handshake is running). */
+void responseCacheFlush();
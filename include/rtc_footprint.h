@@ -0,0 +1,48 @@
+/* Combined size of the stores kept in RTC memory across deep sleep.
+ * Copyright (C) 2026  Lumixen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include "config.h"
+#include "fetch_schedule.h"
+#include "forecast_refresh.h"
+#include "stack_watermark.h"
+#include "tls_session_cache.h"
+#include "wake_profiler.h"
+#include "wifi_fast_connect.h"
+
+/*
+ * RTC_DATA_ATTR variables live in the 8 KB of RTC slow memory. The linker
+ * only reports an overflow of the whole segment; this sums the stores that
+ * can grow with the configuration so that a build that would not fit names
+ * them. The stores are defined next to their users (tls_session_client.cpp,
+ * wake_profiler.cpp, open_meteo_weather_provider.cpp, ...); add a new one
+ * here too.
+ */
+namespace rtc_footprint {
+
+constexpr size_t RTC_SLOW_MEM_BYTES = 8 * 1024;
+// Reserved for the ULP coprocessor at the start of RTC slow memory.
+constexpr size_t ULP_RESERVED_BYTES = 512;
+// The scalars kept across wakes (time_utils.cpp, MQTT) and ESP-IDF's own.
+constexpr size_t OTHER_BYTES = 512;
+
+constexpr size_t STORES_BYTES = sizeof(tls_session::Store) + sizeof(wake_profile::Ring) +
+                                sizeof(fetch_schedule::History) + sizeof(stack_watermark::Store) +
+                                sizeof(wifi_fast_connect::Record) + sizeof(wifi_fast_connect::Stats)
+#if WEATHER_API_FORECAST_REFRESH_EVERY > 1
+                                + sizeof(forecast_refresh::Store)
+#endif
+    ;
+
+static_assert(STORES_BYTES + ULP_RESERVED_BYTES + OTHER_BYTES <= RTC_SLOW_MEM_BYTES,
+              "RTC stores exceed the RTC slow memory: lower weatherAPI.forecastRefreshEvery or hourlyGraphMax");
+
+}  // namespace rtc_footprint
@@ -0,0 +1,100 @@
+/* Lock-free single-producer/single-consumer byte ring.
+ * Copyright (C) 2026  Lumixen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/*
+ * Carries a response body from the task receiving it (network core) to the
+ * task parsing it (other core), see parse_pipeline.h. One task writes, one
+ * reads: each side only stores its own counter (release) and loads the
+ * other's (acquire), so neither ever blocks the other. The consumer reads
+ * in place: it takes a contiguous span and releases it once parsed.
+ *
+ * Either side ends the stream: the producer closes it at the end of the
+ * body, the consumer abandons it when the parser stopped early. Waiting for
+ * data or space is left to the caller.
+ */
+class SpscRing {
+ public:
+  // `capacity` must be a power of two; the buffer is owned by the caller.
+  SpscRing(char *buffer, size_t capacity) : buffer_(buffer), mask_(capacity - 1) {}
+
+  SpscRing(const SpscRing &) = delete;
+  SpscRing &operator=(const SpscRing &) = delete;
+
+  size_t capacity() const { return mask_ + 1; }
+
+  // ---------------------------------------------------------------- producer
+
+  /* Copy as much of `data` as fits; returns the bytes taken (0 when full or
+   * abandoned). */
+  size_t write(const char *data, size_t len) {
+    if (abandoned()) {
+      return 0;
+    }
+    const size_t head = head_.load(std::memory_order_relaxed);
+    const size_t tail = tail_.load(std::memory_order_acquire);
+    const size_t n = std::min(len, capacity() - (head - tail));
+    const size_t index = head & mask_;
+    const size_t first = std::min(n, capacity() - index);
+    memcpy(buffer_ + index, data, first);
+    memcpy(buffer_, data + first, n - first);
+    head_.store(head + n, std::memory_order_release);
+    return n;
+  }
+
+  // No more data will be written.
+  void close() { closed_.store(true, std::memory_order_release); }
+
+  // The consumer stopped reading: further data would be dropped.
+  bool abandoned() const { return abandoned_.load(std::memory_order_acquire); }
+
+  // ---------------------------------------------------------------- consumer
+
+  /* Contiguous span of the unread data (up to the end of the buffer), valid
+   * until release(). Returns false when nothing is buffered. */
+  bool peek(const char *&data, size_t &len) const {
+    const size_t tail = tail_.load(std::memory_order_relaxed);
+    const size_t available = head_.load(std::memory_order_acquire) - tail;
+    if (available == 0) {
+      return false;
+    }
+    const size_t index = tail & mask_;
+    data = buffer_ + index;
+    len = std::min(available, capacity() - index);
+    return true;
+  }
+
+  // Hand `len` bytes of the peeked span back to the producer.
+  void release(size_t len) { tail_.store(tail_.load(std::memory_order_relaxed) + len, std::memory_order_release); }
+
+  /* The producer closed the stream and everything was read. Check after an
+   * empty peek(): closed() is loaded first, so data written before the
+   * close is never missed. */
+  bool drained() const {
+    const bool closed = closed_.load(std::memory_order_acquire);
+    return closed && head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_relaxed);
+  }
+
+  void abandon() { abandoned_.store(true, std::memory_order_release); }
+
+ private:
+  char *buffer_;
+  size_t mask_;
+  std::atomic<size_t> head_{0};  // bytes written, producer only
+  std::atomic<size_t> tail_{0};  // bytes released, consumer only
+  std::atomic<bool> closed_{false};
+  std::atomic<bool> abandoned_{false};
+};
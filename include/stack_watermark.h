@@ -0,0 +1,133 @@
+/* Task stack high-water marks, kept in RTC memory, and stack auto-sizing.
+ * Copyright (C) 2026  Lumixen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "config.h"
+#include "fetch_operation.h"
+
+/* Tasks whose stack use is tracked. Fetch workers are tracked per FetchKind
+ * of the operation they ran; values are persisted in RTC memory, append
+ * only. */
+enum class StackSlot : uint8_t {
+  FETCH_WEATHER = 0,  // = FetchKind::WEATHER
+  FETCH_AIR_QUALITY,
+  FETCH_ALERTS,
+  ENV_SENSOR,  // BME280 reading task
+  MQTT,        // esp-mqtt client task (size set by its Kconfig, reported only)
+  MAIN,        // Arduino loop task running setup() (reported only)
+  PARSE,       // body parse task of the core split (parse_pipeline.h)
+  COUNT,
+};
+
+inline StackSlot stackSlotForFetch(FetchKind kind) {
+  static_assert(static_cast<uint8_t>(StackSlot::FETCH_ALERTS) == static_cast<uint8_t>(FetchKind::ALERTS),
+                "fetch stack slots follow FetchKind");
+  return static_cast<StackSlot>(kind);
+}
+
+/*
+ * Every task samples its stack high-water mark (uxTaskGetStackHighWaterMark,
+ * bytes on the ESP32) when it ends. The deepest use seen per slot is kept
+ * across wakes so that, with `stackAutoSize`, tasks are created with the
+ * stack they need plus a margin instead of a hand-picked size: every byte
+ * over-provisioned is internal RAM missing from TLS and JSON documents.
+ *
+ * The recording front end, which samples the running task and owns the RTC
+ * copy, is declared below.
+ */
+namespace stack_watermark {
+
+constexpr uint32_t STORE_MAGIC = 0x53574D32;  // "SWM2", bump on layout change
+constexpr size_t SLOTS = static_cast<size_t>(StackSlot::COUNT);
+// Headroom above the deepest use seen: paths a few wakes did not take.
+constexpr uint32_t MARGIN_BYTES = 1024;
+constexpr uint32_t MIN_STACK_BYTES = 3072;
+constexpr uint32_t MAX_STACK_BYTES = 16384;
+// Auto-sized stacks are rounded up to this granularity.
+constexpr uint32_t STACK_ALIGN = 256;
+
+struct Entry {
+  uint32_t samples;
+  uint32_t stackBytes;    // size of the stack last sampled
+  uint32_t maxUsedBytes;  // deepest use seen since power-on
+  uint32_t lastUsedBytes;
+};
+
+struct Store {
+  uint32_t magic;
+  Entry entries[SLOTS];
+};
+
+const char *slotName(StackSlot slot);
+
+inline void ensureValid(Store &store) {
+  if (store.magic != STORE_MAGIC) {
+    store = Store{};
+    store.magic = STORE_MAGIC;
+  }
+}
+
+// Bytes used of a `stackBytes` stack that never had less than
+// `highWaterBytes` free.
+inline uint32_t usedBytes(uint32_t stackBytes, uint32_t highWaterBytes) {
+  return stackBytes > highWaterBytes ? stackBytes - highWaterBytes : 0;
+}
+
+inline void record(Store &store, StackSlot slot, uint32_t stackBytes, uint32_t highWaterBytes) {
+  const size_t index = static_cast<size_t>(slot);
+  if (index >= SLOTS) {
+    return;
+  }
+  Entry &entry = store.entries[index];
+  const uint32_t used = usedBytes(stackBytes, highWaterBytes);
+  entry.stackBytes = stackBytes;
+  entry.lastUsedBytes = used;
+  entry.maxUsedBytes = used > entry.maxUsedBytes ? used : entry.maxUsedBytes;
+  ++entry.samples;
+}
+
+/* Stack for a task of `slot`: the deepest use seen plus the margin, rounded
+ * up and bounded; `defaultBytes` until the slot was sampled. A stack that
+ * ran nearly full grows by the margin each wake until it has headroom. */
+inline uint32_t sizeFor(const Store &store, StackSlot slot, uint32_t defaultBytes) {
+  const size_t index = static_cast<size_t>(slot);
+  if (store.magic != STORE_MAGIC || index >= SLOTS || store.entries[index].samples == 0) {
+    return defaultBytes;
+  }
+  uint32_t bytes = store.entries[index].maxUsedBytes + MARGIN_BYTES;
+  bytes = (bytes + STACK_ALIGN - 1) / STACK_ALIGN * STACK_ALIGN;
+  return bytes < MIN_STACK_BYTES ? MIN_STACK_BYTES : (bytes > MAX_STACK_BYTES ? MAX_STACK_BYTES : bytes);
+}
+
+}  // namespace stack_watermark
+
+// True when tasks are created with auto-sized stacks (config `stackAutoSize`).
+inline bool stackAutoSizeEnabled() {
+#if STACK_AUTO_SIZE
+  return true;
+#else
+  return false;
+#endif
+}
+
+/* Sample the calling task's high-water mark for `slot` and record it, also
+ * into the wake profile. `stackBytes` is the size the task was created with.
+ * Call right before the task ends. */
+void stackWatermarkRecord(StackSlot slot, uint32_t stackBytes);
+
+// Same for another, still running task (e.g. a library's task before it is
+// stopped); a null handle is ignored.
+void stackWatermarkRecordTask(StackSlot slot, void *task, uint32_t stackBytes);
+
+// Stack to create a task of `slot` with: auto-sized when enabled, else
+// `defaultBytes`.
+uint32_t stackSizeFor(StackSlot slot, uint32_t defaultBytes);
@@ -0,0 +1,112 @@
+/* Compile-time trie of XML element names.
+ * Copyright (C) 2026  Lumixen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/*
+ * A streaming XML scanner sees a tag name one byte at a time, possibly split
+ * across chunks. Collecting it into a string to compare it with every known
+ * name once the tag ends costs an append per byte and a compare per name.
+ * A Trie recognizes the name while it streams by: the scanner keeps a node
+ * and steps it with each byte, and the node reached at the end of the name
+ * holds its tag. A name that leaves the trie falls into a dead node and
+ * stays there.
+ *
+ * The trie is built by the compiler from the list of known names. Nodes live
+ * in a fixed array of MAX_NODES; a list that does not fit fails the
+ * static_assert next to the trie (see built()). The tag type must have its
+ * "unknown" value at 0.
+ */
+namespace tag_trie {
+
+template <typename Tag>
+struct Name {
+  const char *name;
+  Tag tag;
+};
+
+template <typename Tag, size_t N, size_t MAX_NODES = 64>
+class Trie {
+ public:
+  static_assert(MAX_NODES < 0xFF, "node indices are 8-bit");
+
+  // The node a name starts from, and the one a stray byte leads to.
+  static constexpr uint8_t ROOT = 0;
+  static constexpr uint8_t DEAD = 0xFF;
+
+  constexpr explicit Trie(const Name<Tag> (&names)[N]) : nodes_() {
+    for (Node &node : nodes_) {
+      node = Node{0, NONE, NONE, Tag{}};
+    }
+    used_ = 1;  // the root
+    built_ = true;
+    for (size_t i = 0; i < N && built_; ++i) {
+      built_ = insert(names[i]);
+    }
+  }
+
+  // Whether every name fit; static_assert it on the trie.
+  constexpr bool built() const { return built_; }
+
+  // Node after `node` reads `c`; DEAD once the name left the trie.
+  uint8_t step(uint8_t node, char c) const {
+    if (node == DEAD) {
+      return DEAD;
+    }
+    for (uint8_t child = nodes_[node].child; child != NONE; child = nodes_[child].sibling) {
+      if (nodes_[child].c == c) {
+        return child;
+      }
+    }
+    return DEAD;
+  }
+
+  // Tag of the name ending at `node`; Tag{} for a prefix or unknown name.
+  Tag tag(uint8_t node) const { return node == DEAD ? Tag{} : nodes_[node].tag; }
+
+ private:
+  static constexpr uint8_t NONE = 0xFF;
+
+  struct Node {
+    char c;
+    uint8_t child;    // first child, NONE for a leaf
+    uint8_t sibling;  // next child of the parent, NONE for the last
+    Tag tag;
+  };
+
+  constexpr bool insert(const Name<Tag> &name) {
+    uint8_t node = ROOT;
+    for (const char *p = name.name; *p != '\0'; ++p) {
+      uint8_t child = nodes_[node].child;
+      while (child != NONE && nodes_[child].c != *p) {
+        child = nodes_[child].sibling;
+      }
+      if (child == NONE) {
+        if (used_ == MAX_NODES) {
+          return false;
+        }
+        child = static_cast<uint8_t>(used_++);
+        nodes_[child] = Node{*p, NONE, nodes_[node].child, Tag{}};
+        nodes_[node].child = child;
+      }
+      node = child;
+    }
+    nodes_[node].tag = name.tag;
+    return true;
+  }
+
+  Node nodes_[MAX_NODES];
+  size_t used_ = 0;
+  bool built_ = false;
+};
+
+}  // namespace tag_trie
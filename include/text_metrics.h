@@ -0,0 +1,108 @@
+/* Glyph metrics tables and single pass text measurement for esp32-weather-epd.
+ * Copyright (C) 2026  Lumixen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/*
+ * Measuring text with an Adafruit GFXfont reads a 7 byte GFXglyph per
+ * character and derives its box from width/height/offsets. The build
+ * (scripts/font_metrics.py, run with the config generation) emits
+ * font_metrics.h: for every FONT_*pt8b of the configured font a constexpr
+ * table of GlyphMetrics with the advance and the box already resolved, and a
+ * FONT_*pt8b_METRICS alias for each FontMetrics. Only the tables a
+ * translation unit names end up in flash.
+ *
+ * measure() walks a string once over such a table and returns its Extent:
+ * the box relative to the cursor, exactly what Adafruit_GFX::getTextBounds()
+ * reports (text size 1, no wrap, '\n' and '\r' skipped), and the cursor
+ * advance. An Extent is translation invariant, so a string measured to align
+ * it is printed with the same Extent instead of being measured again.
+ */
+namespace text_metrics {
+
+// One character: its advance and the inclusive box of its pixels relative to
+// the cursor. Blank glyphs have left > right.
+struct GlyphMetrics {
+  uint8_t advance;
+  int8_t left, right;
+  int8_t top, bottom;
+};
+
+struct FontMetrics {
+  const void *font;  // the GFXfont the table was generated from
+  const GlyphMetrics *glyphs;
+  uint16_t first, last;
+};
+
+// Box of a measured string relative to the cursor (maxX < minX when no glyph
+// has pixels) and the cursor advance.
+struct Extent {
+  int16_t minX, minY, maxX, maxY;
+  int16_t advance;
+
+  bool empty() const { return maxX < minX; }
+  uint16_t width() const { return empty() ? 0 : static_cast<uint16_t>(maxX - minX + 1); }
+  uint16_t height() const { return empty() ? 0 : static_cast<uint16_t>(maxY - minY + 1); }
+};
+
+inline constexpr Extent EMPTY_EXTENT = {INT16_MAX, INT16_MAX, -1, -1, 0};
+
+// GlyphMetrics of an Adafruit GFXglyph (or a struct with the same members).
+template <typename Glyph>
+constexpr GlyphMetrics fromGlyph(const Glyph &glyph) {
+  return glyph.width > 0 && glyph.height > 0
+             ? GlyphMetrics{glyph.xAdvance, glyph.xOffset, static_cast<int8_t>(glyph.xOffset + glyph.width - 1),
+                            glyph.yOffset, static_cast<int8_t>(glyph.yOffset + glyph.height - 1)}
+             : GlyphMetrics{glyph.xAdvance, 1, 0, 1, 0};
+}
+
+// Grow `extent` by a glyph drawn with the cursor at `x`.
+inline void grow(Extent &extent, int16_t x, const GlyphMetrics &glyph) {
+  if (glyph.left > glyph.right) {
+    return;
+  }
+  const int16_t left = static_cast<int16_t>(x + glyph.left);
+  const int16_t right = static_cast<int16_t>(x + glyph.right);
+  extent.minX = left < extent.minX ? left : extent.minX;
+  extent.maxX = right > extent.maxX ? right : extent.maxX;
+  extent.minY = glyph.top < extent.minY ? glyph.top : extent.minY;
+  extent.maxY = glyph.bottom > extent.maxY ? glyph.bottom : extent.maxY;
+}
+
+// `text` in one pass over the table; bytes outside the font are skipped.
+inline Extent measure(const FontMetrics &font, const char *text) {
+  Extent extent = EMPTY_EXTENT;
+  int16_t x = 0;
+  for (const char *p = text; *p != '\0'; ++p) {
+    const uint8_t c = static_cast<uint8_t>(*p);
+    if (c < font.first || c > font.last) {
+      continue;  // includes '\n' and '\r' for the 8 bit fonts
+    }
+    const GlyphMetrics &glyph = font.glyphs[c - font.first];
+    grow(extent, x, glyph);
+    x += glyph.advance;
+  }
+  extent.advance = x;
+  return extent;
+}
+
+// The table of `font` in `table`, nullptr when it has none.
+inline const FontMetrics *find(const FontMetrics *table, size_t count, const void *font) {
+  for (size_t i = 0; i < count; ++i) {
+    if (table[i].font == font) {
+      return &table[i];
+    }
+  }
+  return nullptr;
+}
+
+}  // namespace text_metrics
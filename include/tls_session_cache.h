@@ -0,0 +1,137 @@
+/* TLS session cache — per-host TLS sessions resumed across deep sleep.
+ * Copyright (C) 2026  Lumixen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include "config.h"
+
+/*
+ * After a full handshake the negotiated TLS session (session ID or ticket,
+ * serialized by mbedTLS) is kept in RTC memory, one slot per host. The next
+ * connection to that host, be it a retry in the same wake or the first
+ * request of a later wake, offers it back to the server: an abbreviated
+ * handshake skips the certificate chain and the key exchange, the bulk of a
+ * handshake at 80 MHz. A server that no longer knows the session simply
+ * answers with a full handshake, whose fresh session replaces the old one.
+ *
+ * This header only holds the session store and the handshake statistics;
+ * TlsSessionClient (tls_session_client.h) does the TLS side.
+ */
+namespace tls_session {
+
+constexpr uint32_t STORE_MAGIC = 0x544C5331;  // "TLS1", bump on layout change
+// One slot per HTTPS host a wake talks to (weather, air quality, alerts).
+constexpr size_t SLOTS = 4;
+// Serialized session bound. Without the peer certificate kept in the session
+// (CONFIG_MBEDTLS_SSL_KEEP_PEER_CERTIFICATE=n) a session is ~140 B plus the
+// ticket; larger ones are not kept.
+constexpr size_t SESSION_BYTES = 512;
+
+struct HandshakeStats {
+  uint32_t count;
+  uint32_t lastMs;
+  uint32_t avgMs;  // moving average
+};
+
+struct Slot {
+  uint32_t hostHash;  // hashHost() of the host the session belongs to
+  uint32_t used;      // Store::sequence at the last save, oldest is recycled
+  uint16_t length;    // serialized session bytes, 0 when none
+  uint8_t data[SESSION_BYTES];
+  HandshakeStats full;
+  HandshakeStats resumed;
+};
+
+struct Store {
+  uint32_t magic;
+  uint32_t sequence;
+  Slot slots[SLOTS];
+};
+
+// FNV-1a of the host name, so the store does not keep host strings.
+inline uint32_t hashHost(const char *host) {
+  uint32_t hash = 2166136261u;
+  for (; *host != '\0'; ++host) {
+    hash = (hash ^ static_cast<uint8_t>(*host)) * 16777619u;
+  }
+  return hash;
+}
+
+// Reset the store unless it carries the current layout (cold boot, reflash).
+inline void ensureValid(Store &store) {
+  if (store.magic != STORE_MAGIC) {
+    memset(&store, 0, sizeof(store));
+    store.magic = STORE_MAGIC;
+  }
+}
+
+// Slot of `hash`, nullptr when the host has none.
+inline Slot *find(Store &store, uint32_t hash) {
+  for (Slot &slot : store.slots) {
+    if (slot.hostHash == hash && slot.used != 0) {
+      return &slot;
+    }
+  }
+  return nullptr;
+}
+
+// Slot of `hash`, taking over the least recently saved one for a new host.
+inline Slot &acquire(Store &store, uint32_t hash) {
+  if (Slot *slot = find(store, hash)) {
+    return *slot;
+  }
+  Slot *oldest = &store.slots[0];
+  for (Slot &slot : store.slots) {
+    if (slot.used < oldest->used) {
+      oldest = &slot;
+    }
+  }
+  memset(oldest, 0, sizeof(*oldest));
+  oldest->hostHash = hash;
+  oldest->used = ++store.sequence;
+  return *oldest;
+}
+
+// Keep a serialized session. Returns false (dropping the previous one, which
+// the server just declined to resume) when it does not fit.
+inline bool save(Store &store, Slot &slot, const uint8_t *data, size_t len) {
+  slot.used = ++store.sequence;
+  if (len == 0 || len > SESSION_BYTES) {
+    slot.length = 0;
+    return false;
+  }
+  memcpy(slot.data, data, len);
+  slot.length = static_cast<uint16_t>(len);
+  return true;
+}
+
+inline void forget(Slot &slot) { slot.length = 0; }
+
+// Account one completed handshake. The average is an exponential moving
+// average (1/4 weight) seeded by the first sample.
+inline void recordHandshake(Slot &slot, bool resumed, uint32_t ms) {
+  HandshakeStats &s = resumed ? slot.resumed : slot.full;
+  s.avgMs = s.count == 0 ? ms : (s.avgMs * 3 + ms) / 4;
+  s.lastMs = ms;
+  ++s.count;
+}
+
+}  // namespace tls_session
+
+// True when TLS session resumption is enabled by the config.
+inline bool tlsSessionResumptionEnabled() {
+#if TLS_SESSION_RESUMPTION
+  return true;
+#else
+  return false;
+#endif
+}
@@ -0,0 +1,79 @@
+/* TLS client with session resumption, for HTTPClient.
+ * Copyright (C) 2026  Lumixen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include <WiFiClient.h>
+
+/*
+ * Drop-in replacement of WiFiClientSecure for the providers' HTTPS requests.
+ * WiFiClientSecure sets up and runs the whole handshake inside connect(),
+ * leaving no point to offer a cached session before the ClientHello, so this
+ * client drives mbedTLS itself over the TCP socket of its WiFiClient base:
+ * the session cached for the host (tls_session_cache.h) is offered on
+ * connect, and the session the handshake ended with is cached afterwards.
+ *
+ * Handshake durations are recorded in the wake profiler as TLS_FULL or
+ * TLS_RESUMED and kept per host in RTC memory (see logTlsSessionStats()).
+ */
+class TlsSessionClient : public WiFiClient {
+ public:
+  TlsSessionClient();
+  ~TlsSessionClient() override;
+  TlsSessionClient(const TlsSessionClient &) = delete;
+  TlsSessionClient &operator=(const TlsSessionClient &) = delete;
+
+  // Trust anchor (PEM) the server chain must verify against.
+  void setCACert(const char *rootCA) { rootCA_ = rootCA; }
+  // Skip server verification (HTTPS_NO_VERIFY builds).
+  void setInsecure() { rootCA_ = nullptr; }
+
+  int connect(IPAddress ip, uint16_t port) override;
+  int connect(IPAddress ip, uint16_t port, int32_t timeout) override;
+  int connect(const char *host, uint16_t port) override;
+  int connect(const char *host, uint16_t port, int32_t timeout) override;
+
+  size_t write(uint8_t data) override;
+  size_t write(const uint8_t *buf, size_t size) override;
+  int available() override;
+  int read() override;
+  // Non-blocking: -1 when no decrypted byte is pending.
+  int read(uint8_t *buf, size_t size) override;
+  // Blocking within the stream timeout, like Stream::readBytes.
+  size_t readBytes(char *buffer, size_t length) override;
+  int peek() override;
+  void flush() override;
+  void stop() override;
+  uint8_t connected() override;
+
+  // Whether the last handshake resumed a cached session, and its duration.
+  bool resumed() const { return resumed_; }
+  uint32_t handshakeMs() const { return handshakeMs_; }
+
+ private:
+  bool handshake(const char *host, int32_t timeout);
+  bool waitSocket(bool forWrite, uint32_t timeoutMs);
+  void release();
+
+  struct Contexts;
+
+  const char *rootCA_ = nullptr;
+  Contexts *tls_ = nullptr;  // mbedTLS state, heap, while connected
+  int socket_ = -1;
+  bool peerClosed_ = false;  // close_notify or a fatal read error
+  int peeked_ = -1;
+  bool resumed_ = false;
+  uint32_t handshakeMs_ = 0;
+  int32_t timeoutMs_ = 5000;
+};
+
+/* Log the per-host handshake counts and average durations (full vs
+ * resumed) kept in RTC memory. */
+void logTlsSessionStats();
@@ -0,0 +1,146 @@
+/* Render-ready view of one wake for esp32-weather-epd.
+ * Copyright (C) 2026  Lumixen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#pragma once
+
+#include <optional>
+#include <vector>
+#include <Arduino.h>
+#include <time.h>
+
+#include "config.h"
+#include "data_models.h"
+#include "moon_tools.h"
+
+/*
+ * Everything the renderer shows, computed once per wake between the
+ * providers and the draw functions: units converted and rounded, numbers
+ * formatted into fixed buffers, icons selected, the AQI computed, the
+ * outlook graph's axis bounds searched and its points scaled to pixels, and
+ * the alerts filtered. The draw functions in renderer.cpp only place text
+ * and bitmaps; what depends on font metrics (alignment, fitting a descriptor
+ * into its cell) stays there.
+ *
+ * Strings are truncated to their buffer; the sizes fit every locale with
+ * room to spare.
+ */
+
+constexpr int CONDITION_CELLS = 13;  // kinds of left panel cells (POS_*)
+constexpr int OUTLOOK_Y_TICKS = 5;   // major ticks of the outlook graph's y axis
+
+/*
+ * One cell of the current conditions grid: an icon, a label, and a value line
+ * of a 12pt value, an 8pt unit right after it and a 12pt suffix 6 px after
+ * that. A descriptor follows the value (or takes its place when there is no
+ * value) and is fitted to the cell by the renderer.
+ */
+typedef struct condition_cell_view {
+  int pos;               // POS_* slot, 0-9 (2 columns)
+  const uint8_t *icon;   // 48x48
+  const uint8_t *badge;  // 24x24 over the icon's right half, nullptr for none
+  const uint8_t *arrow;  // 24x24 before the value, nullptr for none
+  const char *label;
+  char value[16];
+  char unit[24];
+  char suffix[16];
+  const char *desc;      // nullptr for none
+} condition_cell_view_t;
+
+typedef struct current_view {
+  const uint8_t *icon;   // 196x196
+  char temp[8];          // FONT_48pt8b_temperature glyphs only
+  const char *tempUnit;
+  char feelsLike[48];
+  condition_cell_view_t cells[CONDITION_CELLS];  // the configured cells, in drawing order
+  int cellCount;
+} current_view_t;
+
+typedef struct forecast_day_view {
+  const uint8_t *icon;   // 64x64
+  char day[8];           // abbreviated weekday
+  char hi[8];
+  char lo[8];
+  char precip[24];       // empty when not shown
+} forecast_day_view_t;
+
+typedef struct outlook_segment_view {
+  int16_t x0, y0, x1, y1;
+  uint16_t color;
+} outlook_segment_view_t;
+
+typedef struct outlook_tick_view {
+  int16_t x;
+  char label[12];
+} outlook_tick_view_t;
+
+/*
+ * One hour of the outlook graph, drawn in this order: the temperature line
+ * from the previous hour (split at a color threshold), the hourly icon, the
+ * precipitation bar and the x axis tick.
+ */
+typedef struct outlook_hour_view {
+  outlook_segment_view_t segments[2];
+  uint8_t segmentCount;
+  const uint8_t *icon;  // 32x32, nullptr for none
+  int16_t iconX, iconY;
+  uint16_t iconColor;
+  int16_t barX0, barX1, barTop;  // hatched over [barX0, barX1) x (barTop, y1)
+  bool tick;
+  outlook_tick_view_t tickView;
+} outlook_hour_view_t;
+
+/*
+ * The outlook graph in pixels: the plot area from (x0, y0) to (x1, y1), the
+ * y axis labels per major tick, the hours, and the tick closing the x axis.
+ */
+typedef struct outlook_view {
+  int16_t x0, x1, y0, y1;
+  int16_t yTicks[OUTLOOK_Y_TICKS + 1];
+  char tempLabels[OUTLOOK_Y_TICKS + 1][8];
+  uint16_t tempColors[OUTLOOK_Y_TICKS + 1];
+  bool precipLabels;  // none when there is no precipitation at all
+  char precipLabelValues[OUTLOOK_Y_TICKS + 1][8];
+  char precipUnit[8];
+  outlook_hour_view_t hours[HOURLY_GRAPH_MAX];
+  bool lastTick;
+  outlook_tick_view_t lastTickView;
+} outlook_view_t;
+
+typedef struct alert_view {
+  const uint8_t *icon;  // 48x48 for a single alert, 32x32 for two
+  char event[96];       // title case
+} alert_view_t;
+
+typedef struct status_bar_view {
+  char batteryText[24];
+  const uint8_t *batteryIcon;
+  uint16_t batteryColor;
+  char wifiText[32];
+  const uint8_t *wifiIcon;
+  uint16_t wifiColor;
+  char refreshTime[32];
+  char status[64];  // empty for none
+} status_bar_view_t;
+
+typedef struct weather_view {
+  current_view_t current;
+  forecast_day_view_t days[5];
+  outlook_view_t outlook;
+  alert_view_t alerts[2];
+  int alertCount;       // 0, 1 or 2
+  char date[48];
+  status_bar_view_t statusBar;
+} weather_view_t;
+
+/* Fill `view` from the provider models. Filters (and lowercases) `alerts`
+ * like drawAlerts() used to. */
+void buildWeatherView(weather_view_t &view, const forecast_t &forecast, const air_quality_t &airQuality,
+                      std::optional<float> inPressure, const moon_state_t &moon, std::vector<weather_alert_t> &alerts,
+                      tm timeInfo, const String &date, const String &statusStr, const String &refreshTimeStr, int rssi,
+                      uint32_t batVoltage);
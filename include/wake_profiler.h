@@ -0,0 +1,198 @@
+/* Wake-cycle profiler — per-phase timing of every wake, kept in RTC memory.
+ * Copyright (C) 2026  Lumixen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include <cstddef>
+#include <cstdint>
+#include "config.h"
+#include "stack_watermark.h"
+
+/* Phases of a wake cycle. Values are persisted in RTC memory, append only. */
+enum class WakePhase : uint8_t {
+  BATTERY_ADC = 0,
+  WIFI_CONNECT,
+  TIME_SYNC,
+  FETCH,          // whole FetchOperation::execute(), tag = FetchKind
+  HTTP_CONNECT,   // TCP + TLS handshake, tag = FetchKind
+  HTTP_TTFB,      // request sent until the response headers were read
+  HTTP_BODY,      // time blocked waiting for body bytes
+  HTTP_PARSE,     // time spent deserializing the body
+  MQTT_PUBLISH,
+  DISPLAY_INIT,
+  DISPLAY_PAGE,   // page transfer and refresh without BUSY waits, tag = page index
+  DISPLAY_BUSY,   // panel BUSY wait (light sleep)
+  DEEP_SLEEP,     // sleep computation up to esp_deep_sleep_start()
+  TLS_FULL,       // full TLS handshake (part of HTTP_CONNECT), tag = FetchKind
+  TLS_RESUMED,    // abbreviated handshake of a cached session, tag = FetchKind
+  DISPLAY_RECORD, // recording the scene into the display list
+  DISPLAY_REPLAY, // replaying the display list onto a page, tag = page index
+  VIEW_BUILD,     // formatting the view model the scene is drawn from
+  COUNT,
+};
+
+constexpr uint8_t WAKE_TAG_NONE = 0xFF;
+
+/*
+ * Fixed-size wake records and the ring of the last WAKE_PROFILE_HISTORY
+ * wakes. They take timestamps as arguments; the recording front end that
+ * reads the clock and owns the RTC copy is declared below.
+ */
+namespace wake_profile {
+
+constexpr size_t MAX_SAMPLES = 40;
+constexpr size_t HISTORY = 4;
+constexpr uint32_t RING_MAGIC = 0x57504633;  // "WPF3", bump on layout change
+
+struct Sample {
+  uint8_t phase;        // WakePhase
+  uint8_t tag;          // FetchKind, page index or WAKE_TAG_NONE
+  uint16_t durationMs;  // saturated at UINT16_MAX
+  uint32_t startMs;     // millis() at phase start
+};
+
+struct Record {
+  uint32_t wakeIndex;   // wakes since power-on
+  uint32_t totalMs;     // millis() when the record was committed
+  uint8_t sampleCount;
+  uint8_t dropped;      // samples lost because the record was full
+  Sample samples[MAX_SAMPLES];
+  uint16_t stackUsedBytes[stack_watermark::SLOTS];  // deepest use per task this wake, 0 = not sampled
+};
+
+struct Ring {
+  uint32_t magic;
+  uint32_t wakeCount;   // committed records since power-on
+  Record records[HISTORY];
+};
+
+inline uint16_t saturateMs(uint32_t ms) { return ms > UINT16_MAX ? UINT16_MAX : static_cast<uint16_t>(ms); }
+
+inline void begin(Record &record, uint32_t wakeIndex) {
+  record.wakeIndex = wakeIndex;
+  record.totalMs = 0;
+  record.sampleCount = 0;
+  record.dropped = 0;
+  for (auto &used : record.stackUsedBytes) {
+    used = 0;
+  }
+}
+
+// Stack use of a task that ended; a slot sampled twice keeps the deeper use.
+inline void addStack(Record &record, StackSlot slot, uint32_t usedBytes) {
+  const size_t index = static_cast<size_t>(slot);
+  if (index < stack_watermark::SLOTS) {
+    const uint16_t used = usedBytes > UINT16_MAX ? UINT16_MAX : static_cast<uint16_t>(usedBytes);
+    record.stackUsedBytes[index] = used > record.stackUsedBytes[index] ? used : record.stackUsedBytes[index];
+  }
+}
+
+inline bool add(Record &record, WakePhase phase, uint8_t tag, uint32_t startMs, uint32_t durationMs) {
+  if (record.sampleCount >= MAX_SAMPLES) {
+    if (record.dropped < UINT8_MAX) {
+      ++record.dropped;
+    }
+    return false;
+  }
+  record.samples[record.sampleCount++] = {static_cast<uint8_t>(phase), tag, saturateMs(durationMs), startMs};
+  return true;
+}
+
+inline bool valid(const Ring &ring) { return ring.magic == RING_MAGIC; }
+
+inline void reset(Ring &ring) {
+  ring.magic = RING_MAGIC;
+  ring.wakeCount = 0;
+}
+
+inline void commit(Ring &ring, const Record &record) {
+  if (!valid(ring)) {
+    reset(ring);
+  }
+  ring.records[ring.wakeCount % HISTORY] = record;
+  ++ring.wakeCount;
+}
+
+// Committed record `age` wakes back (0 = most recent), nullptr if none.
+inline const Record *latest(const Ring &ring, size_t age = 0) {
+  if (!valid(ring) || age >= HISTORY || age >= ring.wakeCount) {
+    return nullptr;
+  }
+  return &ring.records[(ring.wakeCount - 1 - age) % HISTORY];
+}
+
+// Sum of the durations recorded for `phase` (any tag).
+inline uint32_t phaseTotalMs(const Record &record, WakePhase phase) {
+  uint32_t total = 0;
+  for (size_t i = 0; i < record.sampleCount; ++i) {
+    if (record.samples[i].phase == static_cast<uint8_t>(phase)) {
+      total += record.samples[i].durationMs;
+    }
+  }
+  return total;
+}
+
+const char *phaseName(WakePhase phase);
+
+/* Serialize a record as one flat JSON object: total_ms, wake, dropped, the
+ * summed duration (ms) per phase, keyed "<phase>" or "<phase>_<tag>"
+ * (e.g. "http_connect_weather", "display_page_1"), and the stack bytes used
+ * per sampled task, keyed "stack_<task>" (e.g. "stack_fetch_weather").
+ * Returns the length written, 0 if it did not fit into `len` bytes. */
+size_t formatJson(const Record &record, char *buf, size_t len);
+
+}  // namespace wake_profile
+
+// True when the wake profiler is enabled by the config.
+inline bool wakeProfilerEnabled() {
+#if WAKE_PROFILER
+  return true;
+#else
+  return false;
+#endif
+}
+
+// Start the record of this wake. Call first thing in setup().
+void wakeProfilerBegin();
+
+// Add a sample measured by the caller; `startMs` is millis() at phase start.
+void wakeProfilerRecord(WakePhase phase, uint8_t tag, uint32_t startMs, uint32_t durationMs);
+
+// Add the stack use of a task that ended (see stack_watermark.h).
+void wakeProfilerRecordStack(StackSlot slot, uint32_t usedBytes);
+
+// Tag the calling task with a FetchKind so the HTTP helpers can attribute
+// their sub-phases to the operation they run for. WAKE_TAG_NONE unbinds.
+void wakeProfilerBindTask(uint8_t tag);
+uint8_t wakeProfilerTaskTag();
+
+// Close the record of this wake into the RTC ring and dump the ring to
+// serial: one line per kept wake, then the samples of this one. Call right
+// before esp_deep_sleep_start().
+void wakeProfilerCommit();
+
+// Most recent committed wake (the previous wake while awake) as JSON, see
+// wake_profile::formatJson. Returns false if there is none.
+bool wakeProfilerLastJson(char *buf, size_t len);
+
+/* Records the lifetime of the scope as one sample. */
+class ScopedWakePhase {
+ public:
+  explicit ScopedWakePhase(WakePhase phase, uint8_t tag = WAKE_TAG_NONE)
+      : phase_(phase), tag_(tag), startMs_(millis()) {}
+  ~ScopedWakePhase() { wakeProfilerRecord(phase_, tag_, startMs_, millis() - startMs_); }
+  ScopedWakePhase(const ScopedWakePhase &) = delete;
+  ScopedWakePhase &operator=(const ScopedWakePhase &) = delete;
+
+ private:
+  WakePhase phase_;
+  uint8_t tag_;
+  uint32_t startMs_;
+};
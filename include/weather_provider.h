@@ -1,14 +1,17 @@
 #pragma once
 
 #include "data_models.h"
+#include "fetch_cancel.h"
 #include "provider_result.h"
+#include "response_body.h"
 
 /* Interface for weather forecast providers.
  *
  * Implementations are responsible for fetching provider-specific data and
  * mapping it into the generic forecast model. Each implementation owns its
- * own transport (WiFiClient / WiFiClientSecure) and opens and closes the
- * connection inside fetch().
+ * own transport (WiFiClient / TlsSessionClient) and opens and closes the
+ * connection inside fetch(), which must give up promptly once `cancel` is
+ * cancelled or expired (see fetch_cancel.h).
  *
  * Returns ProviderResult::ok() on success. On failure, detail() holds a
  * already-localized message suitable for the error screen.
@@ -17,5 +20,5 @@ class WeatherProvider {
  public:
   virtual ~WeatherProvider() = default;
   virtual const char *getApiName() const = 0;
-  virtual ProviderResult fetch(forecast_t &forecast) = 0;
+  virtual ProviderResult fetch(forecast_t &forecast, const FetchCancel &cancel) = 0;
 };
@@ -0,0 +1,133 @@
+/* WiFi fast connect — channel, BSSID and DHCP lease reused across deep sleep.
+ * Copyright (C) 2026  Lumixen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include "config.h"
+
+/*
+ * After a successful connection the access point (channel + BSSID) and the
+ * DHCP lease (IP, gateway, subnet, DNS) are kept in RTC memory. The next wake
+ * joins that access point directly on its channel, without scanning, and
+ * configures the lease statically, without a DHCP exchange. If the fast
+ * attempt does not connect in time, the record is dropped and startWiFi()
+ * falls back to the regular scan + DHCP path.
+ */
+namespace wifi_fast_connect {
+
+constexpr uint32_t RECORD_MAGIC = 0x57464332;  // "WFC2", bump on layout change
+// Budget of the fast attempt before falling back to scan + DHCP (ms).
+constexpr uint32_t FAST_TIMEOUT_MS = 3000;
+
+struct Record {
+  uint32_t magic;
+  uint32_t networkHash;  // hashNetwork() of the SSID/password it was made for
+  uint8_t bssid[6];
+  uint8_t channel;
+  uint8_t hasLease;      // 0 when the IP is static (config) or unknown
+  uint32_t ip;           // IPv4 addresses, as IPAddress' uint32_t
+  uint32_t gateway;
+  uint32_t subnet;
+  uint32_t dns1;
+  uint32_t dns2;
+  uint32_t leaseTime;    // lease time the DHCP server granted (s), 0 if unknown
+  int64_t leaseAt;       // Unix time the lease was obtained through DHCP
+};
+
+enum class Mode : uint8_t {
+  FULL = 0,  // scan (or plain begin) + DHCP
+  FAST,      // cached channel/BSSID (+ cached lease)
+};
+
+struct ModeStats {
+  uint32_t attempts;
+  uint32_t failures;
+  uint32_t lastMs;     // duration of the last successful connect
+  uint32_t avgMs;      // moving average of successful connects
+};
+
+struct Stats {
+  ModeStats modes[2];  // indexed by Mode
+};
+
+// FNV-1a over SSID and password: a record is only reused for the network it
+// was made for, without keeping the credentials themselves in RTC memory.
+inline uint32_t hashNetwork(const char *ssid, const char *password) {
+  uint32_t hash = 2166136261u;
+  for (const char *s : {ssid, "\n", password}) {
+    for (; *s != '\0'; ++s) {
+      hash = (hash ^ static_cast<uint8_t>(*s)) * 16777619u;
+    }
+  }
+  return hash;
+}
+
+inline void invalidate(Record &record) { record.magic = 0; }
+
+// True when the record can steer a fast connect to the network `hash`.
+inline bool usable(const Record &record, uint32_t hash) {
+  return record.magic == RECORD_MAGIC && record.networkHash == hash && record.channel != 0;
+}
+
+// True when the cached lease may still be configured statically at `now`:
+// for half the lease time the server granted, when a DHCP client would
+// renew it. An unknown lease time or a clock that went backwards
+// invalidates it as well.
+inline bool leaseFresh(const Record &record, int64_t now) {
+  return record.hasLease && record.ip != 0 && record.leaseTime != 0 && now >= record.leaseAt &&
+         now - record.leaseAt < static_cast<int64_t>(record.leaseTime / 2);
+}
+
+inline void fill(Record &record, uint32_t hash, const uint8_t bssid[6], uint8_t channel) {
+  record.magic = RECORD_MAGIC;
+  record.networkHash = hash;
+  memcpy(record.bssid, bssid, sizeof(record.bssid));
+  record.channel = channel;
+  record.hasLease = 0;
+}
+
+inline void setLease(Record &record, uint32_t ip, uint32_t gateway, uint32_t subnet, uint32_t dns1, uint32_t dns2,
+                     uint32_t leaseTime, int64_t leaseAt) {
+  record.hasLease = ip != 0 ? 1 : 0;
+  record.ip = ip;
+  record.gateway = gateway;
+  record.subnet = subnet;
+  record.dns1 = dns1;
+  record.dns2 = dns2;
+  record.leaseTime = leaseTime;
+  record.leaseAt = leaseAt;
+}
+
+// Account one attempt; `ms` only counts when it connected. The average is an
+// exponential moving average (1/4 weight) seeded by the first success.
+inline void recordAttempt(Stats &stats, Mode mode, bool connected, uint32_t ms) {
+  ModeStats &m = stats.modes[static_cast<size_t>(mode)];
+  ++m.attempts;
+  if (!connected) {
+    ++m.failures;
+    return;
+  }
+  m.avgMs = (m.attempts - m.failures == 1) ? ms : (m.avgMs * 3 + ms) / 4;
+  m.lastMs = ms;
+}
+
+}  // namespace wifi_fast_connect
+
+// True when WiFi fast connect is enabled by the config.
+inline bool wifiFastConnectEnabled() {
+#if WIFI_FAST_CONNECT
+  return true;
+#else
+  return false;
+#endif
+}
@@ -37,6 +37,7 @@ if yaml is None:
 
 from pydantic import ValidationError
 from schema import ConfigSchema, Color
+import font_metrics
 from re import sub
 from datetime import datetime
 
@@ -70,6 +71,54 @@ def format_bssid(bssid_str):
     return f"{{{formatted}}}"
 
 
+# Offline table of MeteoAlarm EMMA_ID regions, next to this script.
+METEOALARM_REGIONS = "meteoalarm_regions.csv"
+
+
+def emma_geocode(code):
+    """Pack an EMMA_ID ("NL004") into the integer the feed parser compares:
+    the two letters in the high bytes, the number in the low 16 bits (see
+    MeteoAlarmAlertProvider::geocodeFromEmmaId)."""
+    return (ord(code[0]) << 24) | (ord(code[1]) << 16) | int(code[2:])
+
+
+def point_in_ring(lat, lon, ring):
+    """Ray casting of (lat, lon) against a closed ring of (lat, lon) points,
+    as the firmware tests CAP polygons."""
+    inside = False
+    for (lat_a, lon_a), (lat_b, lon_b) in zip(ring, ring[1:] + ring[:1]):
+        if (lat_a > lat) != (lat_b > lat) and lon < (lon_b - lon_a) * (lat - lat_a) / (lat_b - lat_a) + lon_a:
+            inside = not inside
+    return inside
+
+
+def resolve_meteoalarm_geocodes(alerts_config, latitude, longitude, regions_path=None):
+    """EMMA_IDs of the MeteoAlarm regions containing the location: the
+    configured list if any, else the regions of the offline table whose
+    outline contains it (see meteoalarm_regions.py for the format)."""
+    if alerts_config.geocodes:
+        return list(alerts_config.geocodes)
+    if regions_path is None:
+        regions_path = os.path.join(_script_dir or ".", METEOALARM_REGIONS)
+    try:
+        lat, lon = float(latitude), float(longitude)
+    except ValueError:
+        return []
+    if not os.path.isfile(regions_path):
+        return []
+    codes = []
+    with open(regions_path, "r", encoding="utf-8") as regions_file:
+        for line in regions_file:
+            line = line.strip()
+            if not line or line.startswith("#"):
+                continue
+            code, _, outline = line.partition(";")
+            ring = [tuple(float(v) for v in point.split(",")) for point in outline.split()]
+            if len(ring) >= 3 and point_in_ring(lat, lon, ring):
+                codes.append(code.strip())
+    return sorted(set(codes))
+
+
 # Numeric value per log level name, matching the LogLevel enum in logger.h.
 _LOG_LEVEL_NUMBERS = {
     "TRACE": 0,
@@ -139,6 +188,7 @@ TYPED_TYPES = {
     "OWM_ONECALL_VERSION": "String",
     # alerts
     "METEOALARM_COUNTRY": "String",
+    "METEOALARM_GEOCODE_COUNT": "size_t",
     # location
     "LAT": "String",
     "LON": "String",
@@ -159,6 +209,12 @@ TYPED_TYPES = {
     "HOME_ASSISTANT_MQTT_PORT": "uint16_t",
     "HOME_ASSISTANT_MQTT_USERNAME": STRING,
     "HOME_ASSISTANT_MQTT_PASSWORD": STRING,
+    # response cache (minutes, -1 = follow the response headers)
+    "RESPONSE_CACHE_WEATHER_TTL": "int32_t",
+    "RESPONSE_CACHE_AIR_QUALITY_TTL": "int32_t",
+    "RESPONSE_CACHE_ALERTS_TTL": "int32_t",
+    # fetch budget (ms, 0 = none)
+    "FETCH_DEADLINE": "uint32_t",
     # colors (numeric thresholds; color tokens remain COLORS_* macros)
     "COLORS_OUTLOOK_LOW_THRESHOLD_TEMPERATURE": "int",
     "COLORS_OUTLOOK_HIGH_THRESHOLD_TEMPERATURE": "int",
@@ -299,11 +355,16 @@ def generate(config_path, header_path, write_header=True):
     header_lines.append("// weatherAPI configuration")
     emit_define(header_lines, f"WEATHER_API_PROVIDER_{config.weatherAPI.provider.name}")
     emit_define(header_lines, f"WEATHER_API_TRANSPORT_{config.weatherAPI.transport.name}")
+    emit_define(header_lines, "WEATHER_API_COMPRESSION", 1 if config.weatherAPI.compression else 0)
+    emit_define(header_lines, f"WEATHER_API_FORMAT_{config.weatherAPI.format.name}")
+    emit_define(header_lines, "WEATHER_API_FORECAST_REFRESH_EVERY", config.weatherAPI.forecastRefreshEvery)
 
     # airQualityAPI configuration
     header_lines.append("// airQualityAPI configuration")
     emit_define(header_lines, f"AIR_QUALITY_API_PROVIDER_{config.airQualityAPI.provider.name}")
     emit_define(header_lines, f"AIR_QUALITY_API_TRANSPORT_{config.airQualityAPI.transport.name}")
+    emit_define(header_lines, "AIR_QUALITY_API_COMPRESSION", 1 if config.airQualityAPI.compression else 0)
+    emit_define(header_lines, f"AIR_QUALITY_API_FORMAT_{config.airQualityAPI.format.name}")
 
     # ntp configuration
     header_lines.append("// ntp configuration")
@@ -344,13 +405,23 @@ def generate(config_path, header_path, write_header=True):
     header_lines.append("// alertsAPI configuration")
     if config.alertsAPI.provider == "None":
         emit_define(header_lines, "ALERTS_API_PROVIDER_NONE")
+        emit_define(header_lines, "ALERTS_API_COMPRESSION", 0)
     elif config.alertsAPI.provider == "OpenWeatherMap":
         emit_define(header_lines, "ALERTS_API_PROVIDER_OPEN_WEATHER_MAP")
         emit_define(header_lines, f"ALERTS_API_TRANSPORT_{config.alertsAPI.transport.name}")
+        emit_define(header_lines, "ALERTS_API_COMPRESSION", 1 if config.alertsAPI.compression else 0)
     else:  # MeteoAlarm
         emit_define(header_lines, "ALERTS_API_PROVIDER_METEOALARM")
+        emit_define(header_lines, "ALERTS_API_COMPRESSION", 1 if config.alertsAPI.compression else 0)
         header_lines.append("#if defined(ALERTS_API_PROVIDER_METEOALARM)")
         emit_typed(header_lines, "METEOALARM_COUNTRY", config.alertsAPI.country.value)
+        geocodes = resolve_meteoalarm_geocodes(config.alertsAPI, config.latitude, config.longitude)
+        if not geocodes:
+            print("MeteoAlarm: no EMMA_ID region known for the location, alerts are located by polygon")
+        emit_typed(header_lines, "METEOALARM_GEOCODE_COUNT", len(geocodes))
+        # zero-terminated, so the array is never empty
+        packed = ", ".join([f"0x{emma_geocode(code):08X}u /* {code} */" for code in geocodes] + ["0"])
+        header_lines.append(f"inline constexpr uint32_t METEOALARM_GEOCODES[] = {{{packed}}};")
         header_lines.append("#endif  // ALERTS_API_PROVIDER_METEOALARM")
 
     # status bar and debug configuration
@@ -363,6 +434,18 @@ def generate(config_path, header_path, write_header=True):
     header_lines.append("// log configuration")
     emit_define(header_lines, f"LOG_LEVEL_{config.logLevel.name}")
     emit_define(header_lines, "LOG_LEVEL", _LOG_LEVEL_NUMBERS[config.logLevel.name])
+    emit_define(header_lines, "WAKE_PROFILER", 1 if config.wakeProfiler else 0)
+
+    # response cache configuration (TTL in minutes, -1 = response headers)
+    header_lines.append("// response cache configuration")
+    emit_define(header_lines, "RESPONSE_CACHE", 1 if config.responseCache.enabled else 0)
+    for key in ("weatherTtl", "airQualityTtl", "alertsTtl"):
+        ttl = getattr(config.responseCache, key)
+        emit_typed(header_lines, f"RESPONSE_CACHE_{upper_snake(key)}", -1 if ttl is None else ttl)
+    emit_define(header_lines, "TLS_SESSION_RESUMPTION", 1 if config.tlsSessionResumption else 0)
+    emit_typed(header_lines, "FETCH_DEADLINE", config.fetchDeadline)
+    emit_define(header_lines, "STACK_AUTO_SIZE", 1 if config.stackAutoSize else 0)
+    emit_define(header_lines, "CORE_SPLIT", 1 if config.coreSplit else 0)
 
     # pin configuration
     header_lines.append("// pin configuration")
@@ -376,6 +459,7 @@ def generate(config_path, header_path, write_header=True):
     emit_typed(header_lines, "WIFI_PASSWORD", config.wifi.password)
     emit_typed(header_lines, "WIFI_TIMEOUT", config.wifi.timeout)
     emit_define(header_lines, "WIFI_SCAN", 1 if config.wifi.scan else 0)
+    emit_define(header_lines, "WIFI_FAST_CONNECT", 1 if config.wifi.fastConnect else 0)
     if config.wifi.bssid is not None:
         emit_define(header_lines, "WIFI_HAS_BSSID")
         header_lines.append(
@@ -478,18 +562,25 @@ def generate(config_path, header_path, write_header=True):
     print(f"Total defines: {len([l for l in header_lines if l.startswith('#define')])}")
     print(f"Total typed constants: {len([l for l in header_lines if l.startswith('inline const')])}")
 
+    font_metrics.generate(FONT_FILES[config.font], os.path.join(os.path.dirname(header_path), "font_metrics.h"))
+
 
 if env is not None:
     # PlatformIO extra_scripts hook: generate the header for the active env.
     config_path = resolve_config_path()
     generate(config_path, os.path.join("include", "config.h"))
 else:
-    # Standalone use: python scripts/config.py [--validate] <device-name|path>
+    # Standalone use: python scripts/config.py [--validate] [--header PATH] <device-name|path>
     import argparse
 
     parser = argparse.ArgumentParser(description="Validate and/or generate the config header.")
     parser.add_argument("config", help="device name (devices/<name>.yml) or path to a config YAML")
     parser.add_argument("--validate", action="store_true", help="validate only, do not write the header")
+    parser.add_argument(
+        "--header",
+        default=os.path.join("include", "config.h"),
+        help="header to write (default: include/config.h); font_metrics.h is written next to it",
+    )
     args = parser.parse_args(sys.argv[1:])
     config_path = resolve_config_path(args.config)
-    generate(config_path, os.path.join("include", "config.h"), write_header=not args.validate)
+    generate(config_path, args.header, write_header=not args.validate)
@@ -0,0 +1,101 @@
+"""Generate include/font_metrics.h: glyph metrics tables of the configured font.
+
+Called by config.py with the font header it selected (FONT_FILES). Every
+FONT_*pt8b alias of that header gets a constexpr text_metrics::GlyphMetrics
+table, read from the GFXglyph array of its size header, and a
+FONT_*pt8b_METRICS alias of its text_metrics::FontMetrics (see
+include/text_metrics.h). The tables are static constexpr: a translation unit
+that does not name one does not put it in flash.
+"""
+
+import os
+import re
+
+# Fonts and icons library, relative to the project directory like include/.
+ASSETS_DIR = os.path.join("lib", "esp32-weather-epd-assets")
+
+_INCLUDE = re.compile(r'#include\s+"([^"]+)"')
+_ALIAS = re.compile(r"#define\s+(FONT_\w+)\s+(\w+)")
+_GLYPHS = re.compile(r"GFXglyph\s+(\w+)Glyphs\[\]\s*(?:PROGMEM\s*)?=\s*\{(.*?)\};", re.S)
+_GLYPH = re.compile(r"\{\s*(\d+),\s*(\d+),\s*(\d+),\s*(\d+),\s*(-?\d+),\s*(-?\d+)\s*\}")
+_RANGE = re.compile(r"GFXfont\s+(\w+)\s*(?:PROGMEM\s*)?=\s*\{.*?,\s*(0x[0-9A-Fa-f]+|\d+),\s*(0x[0-9A-Fa-f]+|\d+),\s*\d+\s*\};", re.S)
+
+
+def int8(value, what):
+    if not -128 <= value <= 127:
+        raise SystemExit(f"font_metrics: {what} = {value} does not fit int8_t")
+    return value
+
+
+def glyph_metrics(width, height, advance, x_offset, y_offset, what):
+    """text_metrics::fromGlyph() of one GFXglyph, as an initializer."""
+    if advance > 255:
+        raise SystemExit(f"font_metrics: {what} advance {advance} does not fit uint8_t")
+    if width == 0 or height == 0:
+        return f"{{{advance}, 1, 0, 1, 0}}"
+    left = int8(x_offset, what)
+    right = int8(x_offset + width - 1, what)
+    top = int8(y_offset, what)
+    bottom = int8(y_offset + height - 1, what)
+    return f"{{{advance}, {left}, {right}, {top}, {bottom}}}"
+
+
+def read_font(path):
+    """(name, first, last, [GFXglyph tuples]) of one generated size header."""
+    with open(path, "r", encoding="latin-1") as f:  # glyph comments are ISO-8859-1
+        source = f.read()
+    glyphs = _GLYPHS.search(source)
+    bounds = _RANGE.search(source)
+    if glyphs is None or bounds is None:
+        raise SystemExit(f"font_metrics: no GFXfont in {path}")
+    name = bounds.group(1)
+    first, last = int(bounds.group(2), 0), int(bounds.group(3), 0)
+    entries = [tuple(int(v) for v in m.groups()) for m in _GLYPH.finditer(glyphs.group(2))]
+    if len(entries) != last - first + 1:
+        raise SystemExit(f"font_metrics: {path} has {len(entries)} glyphs for 0x{first:02X}..0x{last:02X}")
+    return name, first, last, entries
+
+
+def generate(font_header, header_path, assets_dir=ASSETS_DIR):
+    """Write the metrics header for `font_header` (a FONT_FILES value)."""
+    umbrella = os.path.join(assets_dir, font_header)
+    with open(umbrella, "r", encoding="utf-8") as f:
+        source = f.read()
+    aliases = _ALIAS.findall(source)
+    fonts = {}
+    for include in _INCLUDE.findall(source):
+        name, first, last, entries = read_font(os.path.join(os.path.dirname(umbrella), include))
+        fonts[name] = (first, last, entries)
+
+    lines = [
+        "// Auto-generated glyph metrics (scripts/font_metrics.py)",
+        f"// Font: {font_header}",
+        "#pragma once",
+        "",
+        "#include <Adafruit_GFX.h>",
+        '#include "config.h"',
+        '#include "text_metrics.h"',
+        "#include FONT_HEADER",
+        "",
+    ]
+    for alias, name in aliases:
+        if name not in fonts:
+            raise SystemExit(f"font_metrics: {alias} names {name}, not included by {umbrella}")
+        first, last, entries = fonts[name]
+        lines.append(f"static constexpr text_metrics::GlyphMetrics {name}Metrics[] = {{")
+        for i, (_, width, height, advance, x_offset, y_offset) in enumerate(entries):
+            what = f"{name} 0x{first + i:02X}"
+            lines.append(f"    {glyph_metrics(width, height, advance, x_offset, y_offset, what)},  // 0x{first + i:02X}")
+        lines.append("};")
+        lines.append(
+            f"static constexpr text_metrics::FontMetrics {name}FontMetrics = "
+            f"{{&{name}, {name}Metrics, 0x{first:02X}, 0x{last:02X}}};"
+        )
+        lines.append(f"#define {alias}_METRICS {name}FontMetrics")
+        lines.append("")
+
+    os.makedirs(os.path.dirname(header_path), exist_ok=True)
+    with open(header_path, "w", encoding="utf-8") as header_file:
+        header_file.write("\n".join(lines))
+
+    print(f"Generated font metrics header: {header_path} ({len(aliases)} fonts)")
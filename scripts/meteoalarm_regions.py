@@ -0,0 +1,101 @@
+"""Collect MeteoAlarm EMMA_ID region outlines into meteoalarm_regions.csv.
+
+scripts/config.py resolves the configured location into the EMMA_ID regions
+that contain it from that table, so the firmware can match feed entries by
+geocode instead of by polygon. Its rows come from the feeds themselves: an
+entry that covers exactly one EMMA_ID region and carries one <cap:polygon>
+gives that region's outline. A region only shows up in a feed while it is
+under a warning, so a run collects the regions warned at that time; rows
+already in the table are kept.
+
+Usage:
+    python scripts/meteoalarm_regions.py COUNTRY [COUNTRY...]
+
+COUNTRY is the feed slug of alertsAPI.country, e.g. netherlands.
+"""
+
+import os
+import sys
+import urllib.request
+import xml.etree.ElementTree as ElementTree
+
+FEED_URL = "https://feeds.meteoalarm.org/feeds/meteoalarm-legacy-atom-{country}"
+TABLE = os.path.join(os.path.dirname(os.path.abspath(__file__)), "meteoalarm_regions.csv")
+
+HEADER = """\
+# MeteoAlarm EMMA_ID regions, resolved against the configured location at
+# build time (scripts/config.py, resolve_meteoalarm_geocodes). Collected
+# from the live feeds by scripts/meteoalarm_regions.py.
+#
+# One region per line: its EMMA_ID, a ';', then its outline as a ring of
+# space-separated "lat,lon" pairs in WGS84 decimal degrees, the format of
+# the feed's <cap:polygon>. A location inside no listed region leaves the
+# parser on polygon tests; alertsAPI.geocodes overrides this table.
+#
+# emma_id;outline
+"""
+
+
+def local_name(tag):
+    return tag.rsplit("}", 1)[-1]
+
+
+def regions_of_feed(xml_text):
+    """(EMMA_ID, outline) of every entry with one EMMA_ID and one polygon."""
+    regions = {}
+    root = ElementTree.fromstring(xml_text)
+    for entry in root:
+        if local_name(entry.tag) != "entry":
+            continue
+        polygons = []
+        codes = []
+        for element in entry.iter():
+            name = local_name(element.tag)
+            if name == "polygon" and element.text and element.text.strip():
+                polygons.append(" ".join(element.text.split()))
+            elif name == "geocode":
+                fields = {local_name(child.tag): (child.text or "").strip() for child in element}
+                if fields.get("valueName") == "EMMA_ID" and fields.get("value"):
+                    codes.append(fields["value"])
+        if len(set(codes)) == 1 and len(polygons) == 1:
+            regions[codes[0]] = polygons[0]
+    return regions
+
+
+def read_table(path):
+    regions = {}
+    if os.path.isfile(path):
+        with open(path, "r", encoding="utf-8") as table:
+            for line in table:
+                line = line.strip()
+                if line and not line.startswith("#"):
+                    code, _, outline = line.partition(";")
+                    regions[code.strip()] = outline.strip()
+    return regions
+
+
+def write_table(path, regions):
+    with open(path, "w", encoding="utf-8") as table:
+        table.write(HEADER)
+        for code in sorted(regions):
+            table.write(f"{code};{regions[code]}\n")
+
+
+def main(countries):
+    if not countries:
+        print(__doc__)
+        return 2
+    regions = read_table(TABLE)
+    known = len(regions)
+    for country in countries:
+        with urllib.request.urlopen(FEED_URL.format(country=country), timeout=60) as response:
+            found = regions_of_feed(response.read())
+        print(f"{country}: {len(found)} regions with an outline")
+        regions.update(found)
+    write_table(TABLE, regions)
+    print(f"{TABLE}: {len(regions)} regions ({len(regions) - known} new)")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv[1:]))
@@ -62,6 +62,13 @@ class Transport(str, Enum):
     HTTPS_VERIFY = "HTTPS_VERIFY"
 
 
+class ResponseFormat(str, Enum):
+    """Response format requested from the API"""
+
+    JSON = "JSON"
+    FLATBUFFERS = "FlatBuffers"
+
+
 class UnitsTemp(str, Enum):
     """Temperature units"""
 
@@ -248,11 +255,47 @@ class MeteoAlarmCountry(DocEnum):
 class WeatherAPIConfig(BaseModel):
     provider: WeatherAPI
     transport: Transport = Transport.HTTPS_VERIFY
+    # Ask for a gzip/deflate compressed response and decode it on the fly
+    # (fewer bytes on air; costs ~43 KB of heap while the body is read).
+    compression: bool = False
+    # Open-Meteo only: ask for the binary FlatBuffers format instead of JSON
+    # (no keys, 4 bytes per value, read in place without a parser). Falls
+    # back to JSON when a response cannot be decoded.
+    format: ResponseFormat = ResponseFormat.JSON
+    # Open-Meteo only: request the hourly and daily forecast every N wakes and
+    # only the current conditions in between, merged with the forecast kept
+    # in RTC memory (1 = everything on every wake).
+    forecastRefreshEvery: int = Field(default=1, ge=1, le=48)
+
+    @model_validator(mode="after")
+    def validate_format(self):
+        if self.format == ResponseFormat.FLATBUFFERS and self.provider != WeatherAPI.OPEN_METEO:
+            raise ValueError("format FlatBuffers is only supported by the Open-Meteo provider")
+        return self
+
+    @model_validator(mode="after")
+    def validate_forecast_refresh(self):
+        if self.forecastRefreshEvery > 1 and self.provider != WeatherAPI.OPEN_METEO:
+            raise ValueError("forecastRefreshEvery is only supported by the Open-Meteo provider")
+        return self
 
 
 class AirQualityAPIConfig(BaseModel):
     provider: AirQualityAPI
     transport: Transport = Transport.HTTPS_VERIFY
+    # Ask for a gzip/deflate compressed response and decode it on the fly
+    # (fewer bytes on air; costs ~43 KB of heap while the body is read).
+    compression: bool = False
+    # Open-Meteo only: ask for the binary FlatBuffers format instead of JSON
+    # (no keys, 4 bytes per value, read in place without a parser). Falls
+    # back to JSON when a response cannot be decoded.
+    format: ResponseFormat = ResponseFormat.JSON
+
+    @model_validator(mode="after")
+    def validate_format(self):
+        if self.format == ResponseFormat.FLATBUFFERS and self.provider != AirQualityAPI.OPEN_METEO:
+            raise ValueError("format FlatBuffers is only supported by the Open-Meteo provider")
+        return self
 
 
 class NoAlertsConfig(BaseModel):
@@ -273,6 +316,9 @@ class OpenWeatherMapAlertConfig(BaseModel):
 
     provider: Literal["OpenWeatherMap"] = "OpenWeatherMap"
     transport: Transport = Transport.HTTPS_VERIFY
+    # Ask for a gzip/deflate compressed response and decode it on the fly
+    # (fewer bytes on air; costs ~43 KB of heap while the body is read).
+    compression: bool = False
 
     def provider_to_config_value(self):
         return "#define ALERTS_API_PROVIDER_OPEN_WEATHER_MAP"
@@ -292,6 +338,22 @@ class MeteoAlarmAlertConfig(BaseModel):
     # "united-kingdom", "austria". The value is validated against the feeds
     # listed at https://feeds.meteoalarm.org/.
     country: MeteoAlarmCountry
+    # Ask for a gzip/deflate compressed response and decode it on the fly
+    # (fewer bytes on air; costs ~43 KB of heap while the body is read).
+    compression: bool = False
+    # EMMA_ID region codes of the location, e.g. ["NL004"]. Entries tagged
+    # with EMMA_ID geocodes are then kept or dropped by code instead of by
+    # their polygon. Empty: resolved from the location with the region table
+    # scripts/meteoalarm_regions.csv; with no region found there, every
+    # entry is located by its polygon.
+    geocodes: list[str] = Field(default_factory=list)
+
+    @model_validator(mode="after")
+    def validate_geocodes(self):
+        for code in self.geocodes:
+            if not re.fullmatch(r"[A-Z]{2}[0-9]{1,4}", code):
+                raise ValueError(f"geocodes: '{code}' is not an EMMA_ID (two letters, up to 4 digits)")
+        return self
 
     def provider_to_config_value(self):
         return "#define ALERTS_API_PROVIDER_METEOALARM"
@@ -372,6 +434,11 @@ class Wifi(BaseModel):
     scan: bool = False
     bssid: Optional[str] = None
     staticIp: Optional[StaticIpConfig] = None
+    # Rejoin the access point of the previous wake on its channel, without a
+    # scan, and reuse its DHCP lease (renewed every 8 hours) instead of asking
+    # DHCP again. Falls back to the regular scan/DHCP connect when that fails.
+    # With scan enabled, the scan only runs on that fallback.
+    fastConnect: bool = True
 
     @model_validator(mode="after")
     def validate_scan_and_bssid(self):
@@ -451,6 +518,21 @@ class NTPConfig(BaseModel):
     timeout: int = 20000  # ms
 
 
+class ResponseCacheConfig(BaseModel):
+    # Keep the parsed result of every successful fetch in the spare "spiffs"
+    # flash partition and skip that fetch on the following wakes while the
+    # result is still fresh (one TLS handshake and download less per skipped
+    # provider). Records are dropped whenever new firmware is flashed.
+    enabled: bool = True
+    # Freshness lifetime per provider, in minutes. 0 always fetches. Leave
+    # unset (null) to follow the Cache-Control max-age / Expires headers of
+    # the response; without those headers the result is not reused.
+    # Open-Meteo air quality models update hourly at most.
+    weatherTtl: Optional[int] = Field(default=None, ge=0)
+    airQualityTtl: Optional[int] = Field(default=60, ge=0)
+    alertsTtl: Optional[int] = Field(default=None, ge=0)
+
+
 class Colors(BaseModel):
     outlookLowThresholdTemperature: int = 0
     outlookHighThresholdTemperature: int = 35
@@ -547,6 +629,30 @@ class ConfigSchema(BaseModel):
     statusBarExtrasWifiRSSI: bool = False
     batteryMonitoring: bool = True
     logLevel: LogLevel = LogLevel.INFO
+    # Record the duration of every wake phase (WiFi, time sync, each fetch
+    # split into connect/TTFB/body/parse, display paging and BUSY waits) in
+    # RTC memory. The last wakes are dumped to serial before deep sleep and
+    # the previous wake is published over Home Assistant MQTT when enabled.
+    wakeProfiler: bool = True
+    responseCache: ResponseCacheConfig = Field(default_factory=ResponseCacheConfig)
+    # Keep the TLS session of every HTTPS host in RTC memory and resume it on
+    # the next connection (retries and later wakes) with an abbreviated
+    # handshake. Servers that do not resume fall back to a full handshake.
+    tlsSessionResumption: bool = True
+    # Budget (ms) of all API requests of a wake. Requests still running when
+    # it ends are abandoned and their connections closed, which bounds the
+    # awake time on bad networks. 0 = no budget.
+    fetchDeadline: int = Field(default=60000, ge=0)
+    # Create the fetch workers and the sensor task with the deepest stack use
+    # seen since power-on plus a margin (the high-water mark of every task is
+    # always recorded and reported with the wake profile) instead of the
+    # fixed sizes, returning the unused stack to TLS and JSON documents.
+    stackAutoSize: bool = False
+    # Split fetches over both cores: the fetch workers (socket reads, TLS)
+    # run on core 0 next to the WiFi stack and hand the body through a ring
+    # buffer to a parse task on core 1, so receiving and parsing overlap.
+    # Ignored on single-core chips.
+    coreSplit: bool = False
     pin: PinsConfig = Field(default_factory=PinsConfig)
     wifi: Wifi = Field(default_factory=Wifi)
     owmApikey: str | None = None
@@ -591,6 +697,21 @@ class ConfigSchema(BaseModel):
             raise ValueError("The API key is required on OpenWeatherMap")
         return self
 
+    @model_validator(mode="after")
+    def validate_forecast_store(self):
+        # forecastRefreshEvery keeps hourlyGraphMax rows plus the hours slept
+        # until the next full request (at most a day) in RTC memory, 72 B a
+        # row. 36 rows fit next to the other RTC stores (rtc_footprint.h).
+        every = self.weatherAPI.forecastRefreshEvery
+        if every > 1:
+            rows = self.hourlyGraphMax + min((every * self.sleepDuration + 59) // 60, 24)
+            if rows > 36:
+                raise ValueError(
+                    f"forecastRefreshEvery {every} keeps {rows} hourly rows in RTC memory, at most 36 fit: "
+                    f"lower forecastRefreshEvery, sleepDuration or hourlyGraphMax"
+                )
+        return self
+
     @model_validator(mode="after")
     def validate_left_panel_layout(self):
         allowed_left_panel_keys = {
@@ -16,6 +16,7 @@
  */
 
 // built-in C++ libraries
+#include <algorithm>
 #include <cstring>
 #include <vector>
 
@@ -25,6 +26,8 @@
 #include <SPI.h>
 #include <time.h>
 #include <WiFi.h>
+#include <esp_netif.h>
+#include <lwip/dhcp.h>
 
 // additional libraries
 
@@ -33,15 +36,216 @@
 #include "client_utils.h"
 #include "config.h"
 #include "display_utils.h"
+#include "fetch_cancel.h"
+#include "fetch_executor.h"
+#include "inflate_stream.h"
 #include "logger.h"
+#include "parse_pipeline.h"
+#include "response_body.h"
+#include "response_cache.h"
+#include "wake_profiler.h"
+#include "wifi_fast_connect.h"
+
+namespace {
+
+/* Response body read from the HTTPClient stream in bulk: each chunk is one
+ * readBytes() of whatever the client already has available, never past the
+ * declared content length. While nothing is available the body polls,
+ * checking the cancellation token, so a cancelled fetch stops within a poll
+ * interval instead of blocking for the whole read timeout. The time spent
+ * waiting is accounted so the profiler can split transfer time from parse
+ * time; the clock is only read once per chunk, not per byte. */
+class StreamBody : public ResponseBody {
+ public:
+  StreamBody(WiFiClient &source, size_t expectedLen, uint32_t timeoutMs, const FetchCancel &cancel)
+      : source_(source),
+        remaining_(expectedLen),
+        bounded_(expectedLen > 0),
+        timeoutMs_(timeoutMs),
+        cancel_(cancel) {}
+
+  uint32_t waitMs() const { return waitMs_; }
+  // The body ended because the fetch was cancelled or ran out of budget.
+  bool cancelled() const { return cancelled_; }
+
+ protected:
+  bool fill(const char *&data, size_t &len) override {
+    if (bounded_ && remaining_ == 0) {
+      return false;
+    }
+    const uint32_t t0 = millis();
+    int avail = source_.available();
+    while (avail <= 0) {
+      const uint32_t now = millis();
+      if (cancel_.cancelled(now)) {
+        cancelled_ = true;
+        break;
+      }
+      if (!source_.connected() || now - t0 >= timeoutMs_) {
+        break;
+      }
+      delay(POLL_MS);
+      avail = source_.available();
+    }
+    len = 0;
+    if (avail > 0) {
+      size_t want = std::min(static_cast<size_t>(avail), sizeof(buffer_));
+      if (bounded_) {
+        want = std::min(want, remaining_);
+      }
+      len = source_.readBytes(buffer_, want);
+    }
+    waitMs_ += millis() - t0;
+    remaining_ -= bounded_ ? len : 0;
+    fetchHeapSample();
+    data = buffer_;
+    return len > 0;
+  }
+
+ private:
+  static constexpr uint32_t POLL_MS = 5;
+
+  WiFiClient &source_;
+  char buffer_[512];
+  size_t remaining_;
+  bool bounded_;
+  uint32_t timeoutMs_;
+  const FetchCancel &cancel_;
+  uint32_t waitMs_ = 0;
+  bool cancelled_ = false;
+};
+
+}  // namespace
+
+// Fast-connect record and connect-time statistics (RTC memory, survive deep
+// sleep; cleared by a power-on reset).
+static RTC_DATA_ATTR wifi_fast_connect::Record wifiFastRecord = {};
+static RTC_DATA_ATTR wifi_fast_connect::Stats wifiConnectStats = {};
+
+namespace {
+
+/* Poll the connection status until connected or `timeoutMs` elapsed. */
+wl_status_t waitForConnection(uint32_t timeoutMs, uint32_t pollMs) {
+  const unsigned long start = millis();
+  wl_status_t connection_status = WiFi.status();
+  while ((connection_status != WL_CONNECTED) && (millis() - start < timeoutMs)) {
+    delay(pollMs);
+    connection_status = WiFi.status();
+  }
+  return connection_status;
+}
+
+/* Join the access point of the last wake on its channel (no scan) and, when
+ * still fresh, with its DHCP lease configured statically (no DHCP exchange).
+ * On failure the record is dropped and DHCP restored for the full path. */
+wl_status_t fastConnect() {
+  using namespace wifi_fast_connect;
+  bool reuseLease = false;
+#ifndef WIFI_STATIC_IP_ENABLED
+  reuseLease = leaseFresh(wifiFastRecord, time(nullptr));
+  if (reuseLease) {
+    WiFi.config(IPAddress(wifiFastRecord.ip), IPAddress(wifiFastRecord.gateway), IPAddress(wifiFastRecord.subnet),
+                IPAddress(wifiFastRecord.dns1), IPAddress(wifiFastRecord.dns2));
+  }
+#endif
+  const uint8_t *bssid = wifiFastRecord.bssid;
+  LOG_DEBUG("Fast connect: channel %u, BSSID %02X:%02X:%02X:%02X:%02X:%02X, %s", wifiFastRecord.channel, bssid[0],
+            bssid[1], bssid[2], bssid[3], bssid[4], bssid[5], reuseLease ? "cached lease" : "DHCP");
+  WiFi.begin(WIFI_SSID, WIFI_PASSWORD, wifiFastRecord.channel, wifiFastRecord.bssid);
+  // Association on a known channel takes a few hundred ms: poll finer than
+  // the full path so the wait does not round it up.
+  const wl_status_t connection_status = waitForConnection(FAST_TIMEOUT_MS, 10);
+  if (connection_status != WL_CONNECTED) {
+    LOG_WARNING("Fast connect failed (status %d), falling back to scan + DHCP", static_cast<int>(connection_status));
+    invalidate(wifiFastRecord);
+    WiFi.disconnect();
+#ifndef WIFI_STATIC_IP_ENABLED
+    if (reuseLease) {
+      WiFi.config(IPAddress(), IPAddress(), IPAddress());  // back to DHCP
+    }
+#endif
+  }
+  return connection_status;
+}
+
+/* Regular connect: scan for the best access point (WIFI_SCAN), or join the
+ * configured BSSID, or let the driver pick one. */
+void beginFullConnect() {
+#if WIFI_SCAN
+  // Scan for networks, if there are multiple with the same SSID, connect to the one
+  // with the best RSSI.
+  LOG_INFO("Scanning for WiFi networks...");
+  int numNetworks = WiFi.scanNetworks();
+  int bestRSSI = -100;
+  uint8_t bestBSSID[6];
+  bool foundNetwork = false;
+
+  for (int i = 0; i < numNetworks; i++) {
+    if (WiFi.SSID(i) == WIFI_SSID) {
+      if (WiFi.RSSI(i) > bestRSSI) {
+        bestRSSI = WiFi.RSSI(i);
+        memcpy(bestBSSID, WiFi.BSSID(i), 6);
+        LOG_DEBUG("Found SSID '%s', BSSID %02X:%02X:%02X:%02X:%02X:%02X with RSSI %d dBm", WIFI_SSID, bestBSSID[0],
+                  bestBSSID[1], bestBSSID[2], bestBSSID[3], bestBSSID[4], bestBSSID[5], WiFi.RSSI(i));
+        foundNetwork = true;
+      }
+    }
+  }
+  if (foundNetwork) {
+    WiFi.begin(WIFI_SSID, WIFI_PASSWORD, 0, bestBSSID);
+  } else {
+    WiFi.begin(WIFI_SSID, WIFI_PASSWORD);
+  }
+#else
+#ifdef WIFI_HAS_BSSID
+  WiFi.begin(WIFI_SSID, WIFI_PASSWORD, 0, WIFI_BSSID);
+#else
+  WiFi.begin(WIFI_SSID, WIFI_PASSWORD);
+#endif
+#endif
+}
+
+/* Lease time (s) the DHCP server granted the station interface, 0 when it is
+ * not known (no DHCP client running). */
+uint32_t grantedLeaseTime() {
+  esp_netif_t *sta = esp_netif_get_handle_from_ifkey("WIFI_STA_DEF");
+  struct netif *lwip = sta != nullptr ? static_cast<struct netif *>(esp_netif_get_netif_impl(sta)) : nullptr;
+  const struct dhcp *dhcp = lwip != nullptr ? netif_dhcp_data(lwip) : nullptr;
+  return dhcp != nullptr ? dhcp->offered_t0_lease : 0;
+}
+
+/* Remember the access point and, when it came from DHCP, the lease of this
+ * connection for the next wake. A lease that was itself reused keeps its
+ * original timestamp and lease time so it is renewed in time. */
+void rememberConnection(uint32_t networkHash, bool leaseReused) {
+  using namespace wifi_fast_connect;
+  const Record previous = wifiFastRecord;
+  fill(wifiFastRecord, networkHash, WiFi.BSSID(), static_cast<uint8_t>(WiFi.channel()));
+#ifndef WIFI_STATIC_IP_ENABLED
+  if (leaseReused) {
+    setLease(wifiFastRecord, previous.ip, previous.gateway, previous.subnet, previous.dns1, previous.dns2,
+             previous.leaseTime, previous.leaseAt);
+  } else {
+    setLease(wifiFastRecord, WiFi.localIP(), WiFi.gatewayIP(), WiFi.subnetMask(), WiFi.dnsIP(0), WiFi.dnsIP(1),
+             grantedLeaseTime(), time(nullptr));
+  }
+#endif
+}
+
+}  // namespace
 
 /* Power-on and connect WiFi.
  * Takes int parameter to store WiFi RSSI, or “Received Signal Strength
  * Indicator"
  *
+ * With WIFI_FAST_CONNECT, the access point and DHCP lease of the last wake
+ * are tried first (see wifi_fast_connect.h); the regular scan + DHCP path is
+ * the fallback.
+ *
  * Returns WiFi status.
  */
 wl_status_t startWiFi(int8_t &wifiRSSI) {
+  using namespace wifi_fast_connect;
   // Set hostname with MAC address suffix
   String macAddress = WiFi.macAddress();
   macAddress.replace(":", "");
@@ -50,6 +254,9 @@ wl_status_t startWiFi(int8_t &wifiRSSI) {
   String hostname = "esp32_weather_display_" + macSuffix;
   WiFi.setHostname(hostname.c_str());
 
+  // Credentials come from config.h: skip the NVS write of the station config
+  // that every WiFi.begin() would otherwise do.
+  WiFi.persistent(false);
   WiFi.mode(WIFI_STA);
   LOG_INFO("%s '%s'", TXT_CONNECTING_TO, WIFI_SSID);
 
@@ -83,59 +290,55 @@ wl_status_t startWiFi(int8_t &wifiRSSI) {
   }
 #endif
 
-#if WIFI_SCAN
-  // Scan for networks, if there are multiple with the same SSID, connect to the one
-  // with the best RSSI.
-  LOG_INFO("Scanning for WiFi networks...");
-  int numNetworks = WiFi.scanNetworks();
-  int bestRSSI = -100;
-  uint8_t bestBSSID[6];
-  bool foundNetwork = false;
-
-  for (int i = 0; i < numNetworks; i++) {
-    if (WiFi.SSID(i) == WIFI_SSID) {
-      if (WiFi.RSSI(i) > bestRSSI) {
-        bestRSSI = WiFi.RSSI(i);
-        memcpy(bestBSSID, WiFi.BSSID(i), 6);
-        LOG_DEBUG("Found SSID '%s', BSSID %02X:%02X:%02X:%02X:%02X:%02X with RSSI %d dBm", WIFI_SSID, bestBSSID[0],
-                  bestBSSID[1], bestBSSID[2], bestBSSID[3], bestBSSID[4], bestBSSID[5], WiFi.RSSI(i));
-        foundNetwork = true;
-      }
-    }
-  }
-  if (foundNetwork) {
-    WiFi.begin(WIFI_SSID, WIFI_PASSWORD, 0, bestBSSID);
-  } else {
-    WiFi.begin(WIFI_SSID, WIFI_PASSWORD);
-  }
-#else
-#ifdef WIFI_HAS_BSSID
-  WiFi.begin(WIFI_SSID, WIFI_PASSWORD, 0, WIFI_BSSID);
-#else
-  WiFi.begin(WIFI_SSID, WIFI_PASSWORD);
-#endif
+  const uint32_t networkHash = hashNetwork(WIFI_SSID, WIFI_PASSWORD);
+  wl_status_t connection_status = WL_DISCONNECTED;
+  Mode mode = Mode::FULL;
+  bool leaseReused = false;
+  unsigned long attemptStart = millis();
+  if (wifiFastConnectEnabled() && usable(wifiFastRecord, networkHash)) {
+    mode = Mode::FAST;
+#ifndef WIFI_STATIC_IP_ENABLED
+    leaseReused = leaseFresh(wifiFastRecord, time(nullptr));
 #endif
+    connection_status = fastConnect();
+    recordAttempt(wifiConnectStats, Mode::FAST, connection_status == WL_CONNECTED, millis() - attemptStart);
+  }
 
-  // timeout if WiFi does not connect in WIFI_TIMEOUT ms from now
-  unsigned long timeout = millis() + WIFI_TIMEOUT;
-  wl_status_t connection_status = WiFi.status();
-
-  LOG_DEBUG("Waiting for WiFi connection (timeout %d ms)", WIFI_TIMEOUT);
-  while ((connection_status != WL_CONNECTED) && (millis() < timeout)) {
-    delay(50);
-    connection_status = WiFi.status();
+  if (connection_status != WL_CONNECTED) {
+    mode = Mode::FULL;
+    leaseReused = false;
+    attemptStart = millis();
+    beginFullConnect();
+    // timeout if WiFi does not connect in WIFI_TIMEOUT ms from now
+    LOG_DEBUG("Waiting for WiFi connection (timeout %d ms)", WIFI_TIMEOUT);
+    connection_status = waitForConnection(WIFI_TIMEOUT, 50);
+    recordAttempt(wifiConnectStats, Mode::FULL, connection_status == WL_CONNECTED, millis() - attemptStart);
   }
 
   if (connection_status == WL_CONNECTED) {
     wifiRSSI = WiFi.RSSI();  // get WiFi signal strength now, because the WiFi
                              // will be turned off to save power!
     LOG_INFO("IP: %s", WiFi.localIP().toString().c_str());
+    if (wifiFastConnectEnabled()) {
+      rememberConnection(networkHash, leaseReused);
+    }
+    const ModeStats &fast = wifiConnectStats.modes[static_cast<size_t>(Mode::FAST)];
+    const ModeStats &full = wifiConnectStats.modes[static_cast<size_t>(Mode::FULL)];
+    LOG_INFO("WiFi %s connect in %u ms (fast: avg %u ms, %u/%u failed; full: avg %u ms, %u/%u failed)",
+             mode == Mode::FAST ? "fast" : "full", static_cast<unsigned>(millis() - attemptStart),
+             static_cast<unsigned>(fast.avgMs), static_cast<unsigned>(fast.failures),
+             static_cast<unsigned>(fast.attempts), static_cast<unsigned>(full.avgMs),
+             static_cast<unsigned>(full.failures), static_cast<unsigned>(full.attempts));
   } else {
     LOG_WARNING("%s '%s'", TXT_COULD_NOT_CONNECT_TO, WIFI_SSID);
   }
   return connection_status;
 }  // startWiFi
 
+/* Drop the fast-connect record, so the next wake scans and asks DHCP again.
+ */
+void forgetWiFiFastConnect() { wifi_fast_connect::invalidate(wifiFastRecord); }
+
 /* Disconnect and power-off WiFi.
  */
 void killWiFi() {
@@ -144,9 +347,13 @@ void killWiFi() {
 }  // killWiFi
 
 /* Perform an HTTP GET request with retry.
- * The `parse` callback is invoked with the response stream to deserialize
+ * The `parse` callback is invoked with the response body to deserialize
  * and map the provider response into the output model.
  *
+ * Failures are retried up to 3 attempts, except permanent ones
+ * (ProviderResult::isPermanent(), e.g. an unsupported Content-Encoding or a
+ * parse callback that marks its result so), which end the loop at once.
+ *
  * Returns ProviderResult::ok() once the response was received and parsed
  * successfully. Failure detail is already localized: HTTP and WiFi errors
  * are phrased from the numeric status by this function, parse errors carry
@@ -155,41 +362,104 @@ void killWiFi() {
  * codes reach the caller.
  */
 ProviderResult httpGetWithRetry(WiFiClient &client, const String &host, uint16_t port, const String &uri,
-                                const String &sanitizedUri, bool useHttp10, uint32_t timeoutMs,
-                                std::function<ProviderResult(Stream &, size_t)> parse) {
+                                const String &sanitizedUri, bool useHttp10, bool acceptCompressed, uint32_t timeoutMs,
+                                const FetchCancel &cancel, std::function<ProviderResult(ResponseBody &, size_t)> parse) {
   int attempts = 0;
   ProviderResult result;
 
   LOG_INFO("%s: %s", TXT_ATTEMPTING_HTTP_REQ, sanitizedUri.c_str());
   int httpResponse = 0;
-  while (!result.isOk() && attempts < 3) {
+  while (!result.isOk() && !result.isPermanent() && attempts < 3) {
+    if (cancel.cancelled(millis())) {
+      LOG_WARNING("%s: fetch %s", host.c_str(),
+                  cancel.cause() != FetchCancel::NO_CAUSE ? "cancelled" : "deadline passed");
+      return ProviderResult::error(getHttpResponsePhrase(HTTPC_ERROR_READ_TIMEOUT));
+    }
+    // No step may outlast the fetch budget.
+    const uint32_t stepTimeoutMs = cancel.clamp(timeoutMs, millis());
     wl_status_t connection_status = WiFi.status();
     if (connection_status != WL_CONNECTED) {
       // The -512 offset stays private here: it only feeds the phrase lookup.
       return ProviderResult::error(getHttpResponsePhrase(-512 - static_cast<int>(connection_status)));
     }
 
+    const uint8_t profileTag = wakeProfilerTaskTag();
     HTTPClient http;
-    http.setConnectTimeout(timeoutMs);
-    http.setTimeout(timeoutMs);
-    if (useHttp10) {
+    http.setConnectTimeout(stepTimeoutMs);
+    http.setTimeout(stepTimeoutMs);
+    if (useHttp10 || acceptCompressed) {
       http.useHTTP10(true);
     }
     http.begin(client, host, port, uri);
-    httpResponse = http.GET();
+    if (acceptCompressed) {
+      http.addHeader("Accept-Encoding", inflate::ACCEPT_ENCODING);
+    }
+    // Freshness headers, for the response cache TTL, and the body coding.
+    static const char *responseHeaders[] = {"Cache-Control", "Expires", "Date", "Content-Encoding"};
+    http.collectHeaders(responseHeaders, 4);
+    // Connect (TCP + TLS handshake) up front so it is timed apart from the
+    // request: HTTPClient reuses an already connected client.
+    uint32_t phaseStart = millis();
+    if (!client.connect(host.c_str(), port, stepTimeoutMs)) {
+      httpResponse = HTTPC_ERROR_CONNECTION_REFUSED;
+    } else {
+      wakeProfilerRecord(WakePhase::HTTP_CONNECT, profileTag, phaseStart, millis() - phaseStart);
+      fetchHeapSample();  // TLS record buffers are allocated by now
+      phaseStart = millis();
+      httpResponse = http.GET();
+      wakeProfilerRecord(WakePhase::HTTP_TTFB, profileTag, phaseStart, millis() - phaseStart);
+    }
     if (httpResponse == HTTP_CODE_OK) {
       // Pass the response content length so parsers can stop reading exactly
       // at the end of the body instead of reading past it into the (already
       // closed) connection.
       const int size = http.getSize();
       const size_t expectedLen = size > 0 ? static_cast<size_t>(size) : 0;
-      // Make the parser's per-byte read window match the configured timeout:
+      // Make the body's per-read window match the configured timeout:
       // HTTPClient::setTimeout only forwards to the client while connected,
-      // so the Stream the parser reads from would otherwise keep its default
+      // so the Stream the body reads from would otherwise keep its default
       // 1 s window (too short for large, intermittently delivered bodies).
       http.getStream().setTimeout(timeoutMs);
-      result = parse(http.getStream(), expectedLen);
-      if (!result.isOk()) {
+      StreamBody body(http.getStream(), expectedLen, timeoutMs, cancel);
+      const String contentEncoding = http.header("Content-Encoding");
+      const inflate::Encoding encoding = inflate::contentEncoding(contentEncoding.c_str());
+      auto decodeAndParse = [&](ResponseBody &received) -> ProviderResult {
+        if (encoding == inflate::Encoding::IDENTITY) {
+          return parse(received, expectedLen);
+        }
+        // The content length counts compressed bytes: the parser reads the
+        // decompressed body to its end instead.
+        InflateBody inflated(received, encoding);
+        ProviderResult parsed = parse(inflated, 0);
+        LOG_INFO("%u B body inflated from %u B", static_cast<unsigned>(inflated.consumed()),
+                 static_cast<unsigned>(inflated.compressedBytes()));
+        return parsed;
+      };
+      phaseStart = millis();
+      if (encoding == inflate::Encoding::UNSUPPORTED) {
+        // The server answers every attempt with the same coding.
+        result = ProviderResult::error(getHttpResponsePhrase(HTTPC_ERROR_ENCODING)).setPermanent();
+      } else if (coreSplitEnabled()) {
+        // Inflate and parse on the parse core while this task receives.
+        result = pipelinedParse(body, decodeAndParse);
+      } else {
+        result = decodeAndParse(body);
+      }
+      if (body.cancelled()) {
+        // Whatever the parser made of a cut body, the fetch was abandoned.
+        result = ProviderResult::error(getHttpResponsePhrase(HTTPC_ERROR_READ_TIMEOUT));
+      }
+      const uint32_t parseTotal = millis() - phaseStart;
+      // Split over the cores, the parse time left is what did not overlap
+      // receiving (waits for ring space and the parse of the last bytes).
+      wakeProfilerRecord(WakePhase::HTTP_BODY, profileTag, phaseStart, body.waitMs());
+      wakeProfilerRecord(WakePhase::HTTP_PARSE, profileTag, phaseStart, parseTotal - body.waitMs());
+      if (result.isOk()) {
+        result.setMaxAge(response_cache::maxAgeFromHeaders(
+            http.hasHeader("Cache-Control") ? http.header("Cache-Control").c_str() : nullptr,
+            http.hasHeader("Expires") ? http.header("Expires").c_str() : nullptr,
+            http.hasHeader("Date") ? http.header("Date").c_str() : nullptr, time(nullptr)));
+      } else {
         LOG_WARNING("stream: read timeout %u ms, advertised size %d B, http.connected()=%u, live stream ptr=%u",
                     http.getStream().getTimeout(), size, http.connected(), http.getStreamPtr() != nullptr);
       }
@@ -201,7 +471,7 @@ ProviderResult httpGetWithRetry(WiFiClient &client, const String &host, uint16_t
     LOG_INFO("%d %s %s", httpResponse, result.isOk() ? getHttpResponsePhrase(httpResponse) : result.detail().c_str(),
              host.c_str());
     ++attempts;
-    if (!result.isOk()) {
+    if (!result.isOk() && !result.isPermanent() && !cancel.cancelled(millis())) {
       delay(100);
     }
   }
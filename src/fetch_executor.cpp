@@ -10,44 +10,184 @@
 #include "fetch_executor.h"
 
 #include <Arduino.h>
-#include <atomic>
+#include <algorithm>
 #include <freertos/FreeRTOS.h>
 #include <freertos/semphr.h>
 #include <freertos/task.h>
 
 #include "client_utils.h"
+#include "fetch_schedule.h"
 #include "logger.h"
+#include "parse_pipeline.h"
+#include "stack_watermark.h"
+#include "wake_profiler.h"
+
+// Duration and peak heap of every kind of operation over recent wakes (RTC
+// memory, survives deep sleep; cleared by a power-on reset).
+static RTC_DATA_ATTR fetch_schedule::History fetchHistory = {};
+
+// Fetch workers record and claim concurrently: the history, the claim state
+// and the heap samples are guarded by a spinlock (short, non-blocking
+// critical sections only).
+static portMUX_TYPE fetchScheduleMux = portMUX_INITIALIZER_UNLOCKED;
+
+// Lowest free heap seen by each task running an operation (workers, or the
+// calling task when operations run sequentially).
+static constexpr size_t HEAP_SLOTS = FETCH_MAX_CONCURRENCY + 1;
+static struct {
+  TaskHandle_t task;
+  uint32_t minFree;
+} heapSlots[HEAP_SLOTS] = {};
 
 namespace {
 
+// How often a worker looks again when every unclaimed operation still waits
+// for a dependency or for heap.
+constexpr uint32_t CLAIM_POLL_MS = 5;
+
 struct WorkerContext {
   std::vector<std::unique_ptr<FetchOperation>> *ops;
   std::vector<ProviderResult> *results;
   size_t operationCount;
-  std::atomic<size_t> nextIndex{0};
+  const uint8_t *order;      // start order, indices into ops
+  const uint32_t *waitsFor;  // bit j: ops[j] must finish first
+  const uint32_t *peakHeap;  // expected peak heap of each op
+  bool *claimed;
+  bool *done;
+  size_t inFlight;
+  uint32_t stackBytes;  // of every worker
   SemaphoreHandle_t doneSem;
+  FetchCancel *cancel;
 };
 
-bool claimNext(WorkerContext &context, size_t &index) {
-  size_t candidate = context.nextIndex.load(std::memory_order_relaxed);
-  while (candidate < context.operationCount &&
-         !context.nextIndex.compare_exchange_weak(candidate, candidate + 1, std::memory_order_relaxed,
-                                                  std::memory_order_relaxed)) {
+// Start sampling the free heap on behalf of the calling task.
+void bindHeapSlot(uint32_t freeHeap) {
+  const TaskHandle_t self = xTaskGetCurrentTaskHandle();
+  portENTER_CRITICAL(&fetchScheduleMux);
+  for (auto &slot : heapSlots) {
+    if (slot.task == nullptr || slot.task == self) {
+      slot.task = self;
+      slot.minFree = freeHeap;
+      break;
+    }
+  }
+  portEXIT_CRITICAL(&fetchScheduleMux);
+}
+
+// Stop sampling for the calling task; returns the lowest free heap seen.
+uint32_t releaseHeapSlot(uint32_t freeHeap) {
+  const TaskHandle_t self = xTaskGetCurrentTaskHandle();
+  uint32_t minFree = freeHeap;
+  portENTER_CRITICAL(&fetchScheduleMux);
+  for (auto &slot : heapSlots) {
+    if (slot.task == self) {
+      minFree = std::min(minFree, slot.minFree);
+      slot.task = nullptr;
+      break;
+    }
+  }
+  portEXIT_CRITICAL(&fetchScheduleMux);
+  return minFree;
+}
+
+/* Run operation `index` on the calling task, tagging its profiler samples
+ * with the operation kind. A failure that aborts the wake cancels the
+ * other operations; a success updates the duration and heap history. */
+ProviderResult runOperation(FetchOperation &op, size_t index, FetchCancel &cancel) {
+  const uint8_t tag = static_cast<uint8_t>(op.kind());
+  const uint32_t start = millis();
+  const uint32_t freeAtStart = ESP.getFreeHeap();
+  const uint32_t lowWaterAtStart = ESP.getMinFreeHeap();
+  bindHeapSlot(freeAtStart);
+  wakeProfilerBindTask(tag);
+  ScopedWakePhase phase(WakePhase::FETCH, tag);
+  ProviderResult result = op.execute(cancel);
+  wakeProfilerBindTask(WAKE_TAG_NONE);
+  uint32_t minFree = releaseHeapSlot(ESP.getFreeHeap());
+  // The samples miss transient peaks inside the TLS handshake. A new heap
+  // low water mark set meanwhile catches them: exact when the operation ran
+  // alone, an over-estimate next to others (which only costs parallelism).
+  const uint32_t lowWater = ESP.getMinFreeHeap();
+  if (lowWater < lowWaterAtStart) {
+    minFree = std::min(minFree, lowWater);
+  }
+  const uint32_t peakHeap = freeAtStart > minFree ? freeAtStart - minFree : 0;
+  LOG_INFO("FetchExecutor: %s took %ums, peak heap %u B", op.name(), static_cast<unsigned>(millis() - start),
+           static_cast<unsigned>(peakHeap));
+  if (result.isOk()) {
+    // Failures end early or at a timeout: they say nothing about how long
+    // the operation takes or how much heap it needs.
+    portENTER_CRITICAL(&fetchScheduleMux);
+    fetch_schedule::ensureValid(fetchHistory);
+    fetch_schedule::record(fetchHistory, op.kind(), millis() - start);
+    fetch_schedule::recordHeap(fetchHistory, op.kind(), peakHeap);
+    portEXIT_CRITICAL(&fetchScheduleMux);
   }
-  if (candidate >= context.operationCount) {
-    return false;
+  if (!result.isOk() && op.shouldAbortOnFailure() && cancel.cause() == FetchCancel::NO_CAUSE) {
+    LOG_INFO("FetchExecutor: %s failed, cancelling the other fetches", op.name());
+    cancel.cancel(static_cast<int>(index));
   }
-  index = candidate;
-  return true;
+  return result;
+}
+
+enum class Claim : uint8_t { CLAIMED, WAIT, NONE_LEFT };
+
+/* First unclaimed operation in schedule order whose dependencies finished
+ * and whose expected peak heap fits next to the operations in flight. */
+Claim claimNext(WorkerContext &context, size_t &index) {
+  Claim claim = Claim::NONE_LEFT;
+  // Heap queries take the heap lock: not inside the critical section.
+  const uint32_t largestFreeBlock = ESP.getMaxAllocHeap();
+  portENTER_CRITICAL(&fetchScheduleMux);
+  for (size_t pos = 0; pos < context.operationCount; ++pos) {
+    const size_t candidate = context.order[pos];
+    if (context.claimed[candidate]) {
+      continue;
+    }
+    bool ready = true;
+    for (size_t j = 0; j < context.operationCount && ready; ++j) {
+      ready = !((context.waitsFor[candidate] >> j) & 1u) || context.done[j];
+    }
+    ready = ready && fetch_schedule::admits(largestFreeBlock, context.peakHeap[candidate], context.inFlight);
+    if (ready) {
+      context.claimed[candidate] = true;
+      ++context.inFlight;
+      index = candidate;
+      claim = Claim::CLAIMED;
+      break;
+    }
+    claim = Claim::WAIT;
+  }
+  portEXIT_CRITICAL(&fetchScheduleMux);
+  return claim;
+}
+
+void finishOperation(WorkerContext &context, size_t index) {
+  portENTER_CRITICAL(&fetchScheduleMux);
+  context.done[index] = true;
+  --context.inFlight;
+  portEXIT_CRITICAL(&fetchScheduleMux);
 }
 
 void fetchWorker(void *pvParameters) {
   WorkerContext *context = static_cast<WorkerContext *>(pvParameters);
   size_t index = 0;
-  while (claimNext(*context, index)) {
+  for (;;) {
+    const Claim claim = claimNext(*context, index);
+    if (claim == Claim::NONE_LEFT) {
+      break;
+    }
+    if (claim == Claim::WAIT) {
+      vTaskDelay(pdMS_TO_TICKS(CLAIM_POLL_MS));
+      continue;
+    }
     FetchOperation *op = (*context->ops)[index].get();
     uint32_t t0 = millis();
-    (*context->results)[index] = op->execute();
+    (*context->results)[index] = runOperation(*op, index, *context->cancel);
+    finishOperation(*context, index);
+    // The high-water mark covers the worker's life so far: the deepest of
+    // the operations it ran, attributed to the last one.
+    stackWatermarkRecord(stackSlotForFetch(op->kind()), context->stackBytes);
     LOG_DEBUG("FetchWorker %s: done in %ums ok=%d", op->name(), static_cast<unsigned>(millis() - t0),
               (*context->results)[index].isOk());
   }
@@ -55,9 +195,63 @@ void fetchWorker(void *pvParameters) {
   vTaskDelete(nullptr);
 }
 
+/* Order `ops` longest-expected-first from the history, honouring declared
+ * dependencies, and fill `waitsFor` with the dependencies the workers wait
+ * on: only those ordered earlier, so a cycle cannot stall the pool.
+ * `peakHeap` receives the expected peak heap of each operation. */
+void planSchedule(const std::vector<std::unique_ptr<FetchOperation>> &ops, size_t workerCount, uint8_t *order,
+                  uint32_t *waitsFor, uint32_t *peakHeap) {
+  const size_t n = ops.size();
+  fetch_schedule::Job jobs[fetch_schedule::MAX_JOBS] = {};
+  portENTER_CRITICAL(&fetchScheduleMux);
+  fetch_schedule::ensureValid(fetchHistory);
+  for (size_t i = 0; i < n; ++i) {
+    jobs[i].expectedMs = fetch_schedule::expectedMs(fetchHistory, ops[i]->kind());
+    peakHeap[i] = fetch_schedule::expectedHeap(fetchHistory, ops[i]->kind());
+  }
+  portEXIT_CRITICAL(&fetchScheduleMux);
+  for (size_t i = 0; i < n; ++i) {
+    for (size_t j = 0; j < n; ++j) {
+      if (j != i && (ops[i]->dependsOn() & fetchKindBit(ops[j]->kind()))) {
+        jobs[i].dependsOn |= 1u << j;
+      }
+    }
+  }
+  const uint32_t makespan = fetch_schedule::longestFirst(jobs, n, workerCount, order);
+  uint32_t earlier = 0;
+  for (size_t pos = 0; pos < n; ++pos) {
+    waitsFor[order[pos]] = jobs[order[pos]].dependsOn & earlier;
+    earlier |= 1u << order[pos];
+  }
+
+  char trace[192];
+  size_t len = 0;
+  for (size_t pos = 0; pos < n && len < sizeof(trace); ++pos) {
+    len += snprintf(trace + len, sizeof(trace) - len, "%s%s(%ums %uB)", pos > 0 ? " > " : "",
+                    fetchKindName(ops[order[pos]]->kind()), static_cast<unsigned>(jobs[order[pos]].expectedMs),
+                    static_cast<unsigned>(peakHeap[order[pos]]));
+  }
+  const uint32_t staticMakespan = fetch_schedule::staticMakespan(jobs, n, workerCount);
+  LOG_INFO("FetchExecutor: schedule %s, predicted makespan %ums (static order %ums)", trace,
+           static_cast<unsigned>(makespan), static_cast<unsigned>(staticMakespan));
+}
+
 }  // namespace
 
-std::vector<ProviderResult> executeParallel(std::vector<std::unique_ptr<FetchOperation>> &ops) {
+void fetchHeapSample() {
+  const TaskHandle_t self = xTaskGetCurrentTaskHandle();
+  const uint32_t freeHeap = ESP.getFreeHeap();
+  portENTER_CRITICAL(&fetchScheduleMux);
+  for (auto &slot : heapSlots) {
+    if (slot.task == self) {
+      slot.minFree = std::min(slot.minFree, freeHeap);
+      break;
+    }
+  }
+  portEXIT_CRITICAL(&fetchScheduleMux);
+}
+
+std::vector<ProviderResult> executeParallel(std::vector<std::unique_ptr<FetchOperation>> &ops, FetchCancel &cancel) {
   const size_t n = ops.size();
   LOG_DEBUG("FetchExecutor: n=%u pool=%u", static_cast<unsigned>(n), static_cast<unsigned>(FETCH_MAX_CONCURRENCY));
   std::vector<ProviderResult> results(n);
@@ -65,50 +259,87 @@ std::vector<ProviderResult> executeParallel(std::vector<std::unique_ptr<FetchOpe
     return results;
   }
   if (n == 1) {
-    results[0] = ops[0]->execute();
+    results[0] = runOperation(*ops[0], 0, cancel);
     return results;
   }
 
   const size_t workerCount = n < FETCH_MAX_CONCURRENCY ? n : FETCH_MAX_CONCURRENCY;
+  uint8_t order[fetch_schedule::MAX_JOBS] = {};
+  uint32_t waitsFor[fetch_schedule::MAX_JOBS] = {};
+  uint32_t peakHeap[fetch_schedule::MAX_JOBS] = {};
+  bool claimed[fetch_schedule::MAX_JOBS] = {};
+  bool done[fetch_schedule::MAX_JOBS] = {};
+  if (n > fetch_schedule::MAX_JOBS) {
+    LOG_WARNING("FetchExecutor: %u operations exceed the schedule, running them sequentially",
+                static_cast<unsigned>(n));
+    for (size_t i = 0; i < n; ++i) {
+      results[i] = runOperation(*ops[i], i, cancel);
+    }
+    return results;
+  }
+  planSchedule(ops, workerCount, order, waitsFor, peakHeap);
+  const uint32_t start = millis();
+
   SemaphoreHandle_t doneSem = xSemaphoreCreateCounting(workerCount, 0);
 
   if (doneSem == nullptr) {
     LOG_WARNING("FetchExecutor: semaphore create failed, falling back to sequential");
-    for (size_t i = 0; i < n; ++i) {
-      results[i] = ops[i]->execute();
+    // Schedule order runs every dependency before its dependents.
+    for (size_t pos = 0; pos < n; ++pos) {
+      results[order[pos]] = runOperation(*ops[order[pos]], order[pos], cancel);
     }
     return results;
   }
 
-  // Keep the number of task stacks bounded: workers claim operations until none remain.
-  WorkerContext context{&ops, &results, n, 0, doneSem};
+  /* Keep the number of task stacks bounded: workers claim operations until
+   * none remain. Another worker is only started while the largest free
+   * block holds its stack and the peak of the operation it would take. */
+  // Workers may run any of the operations: size them for the deepest.
+  uint32_t stackBytes = 0;
+  for (const auto &op : ops) {
+    stackBytes = std::max(stackBytes, stackSizeFor(stackSlotForFetch(op->kind()), FETCH_STACK_BYTES));
+  }
+  WorkerContext context{&ops, &results, n, order, waitsFor, peakHeap, claimed, done, 0, stackBytes, doneSem, &cancel};
   size_t created = 0;
   for (size_t i = 0; i < workerCount; ++i) {
+    const uint32_t largestFreeBlock = ESP.getMaxAllocHeap();
+    if (i > 0 && largestFreeBlock < stackBytes + peakHeap[order[i]] + fetch_schedule::HEAP_MARGIN) {
+      LOG_INFO("FetchExecutor: %u of %u workers, largest free block %u B", static_cast<unsigned>(created),
+               static_cast<unsigned>(workerCount), static_cast<unsigned>(largestFreeBlock));
+      break;
+    }
     char taskName[16];
     snprintf(taskName, sizeof(taskName), "FetchWorker%u", static_cast<unsigned>(i));
-    BaseType_t ok = xTaskCreate(fetchWorker, taskName, FETCH_STACK_BYTES, &context, FETCH_TASK_PRIORITY, nullptr);
+    // Split over the cores, workers receive next to the WiFi stack and hand
+    // the parsing to the other core (parse_pipeline.h).
+    BaseType_t ok;
+    if (coreSplitEnabled()) {
+      ok = xTaskCreatePinnedToCore(fetchWorker, taskName, stackBytes, &context, FETCH_TASK_PRIORITY, nullptr,
+                                   NETWORK_CORE);
+    } else {
+      ok = xTaskCreate(fetchWorker, taskName, stackBytes, &context, FETCH_TASK_PRIORITY, nullptr);
+    }
     if (ok != pdPASS) {
-      LOG_WARNING("FetchExecutor: worker task creation failed, running remainder sequentially");
-      // Wait for existing workers before accessing results or destroying doneSem.
-      for (size_t j = 0; j < created; ++j) {
-        xSemaphoreTake(doneSem, portMAX_DELAY);
-      }
-      // Workers claim indices monotonically; after they finish, all claimed operations
-      // are complete and the unclaimed suffix can run sequentially.
-      const size_t firstUnclaimed = context.nextIndex.load(std::memory_order_acquire);
-      for (size_t k = firstUnclaimed; k < n; ++k) {
-        results[k] = ops[k]->execute();
-      }
-      vSemaphoreDelete(doneSem);
-      return results;
+      LOG_WARNING("FetchExecutor: worker task creation failed, %u workers", static_cast<unsigned>(created));
+      break;
     }
     ++created;
   }
+  if (created == 0) {
+    // Schedule order runs every dependency before its dependents.
+    for (size_t pos = 0; pos < n; ++pos) {
+      results[order[pos]] = runOperation(*ops[order[pos]], order[pos], cancel);
+    }
+    vSemaphoreDelete(doneSem);
+    return results;
+  }
 
-  // Wait indefinitely for all workers. Provider-level HTTP timeouts bound execution time.
+  // Wait for all workers: they return promptly once the token is cancelled
+  // or expired, so the fetch budget bounds the wait.
   for (size_t i = 0; i < created; ++i) {
     xSemaphoreTake(doneSem, portMAX_DELAY);
   }
+  LOG_INFO("FetchExecutor: makespan %ums", static_cast<unsigned>(millis() - start));
 
   vSemaphoreDelete(doneSem);
   return results;
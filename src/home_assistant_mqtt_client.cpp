@@ -3,8 +3,18 @@
 #include <WiFi.h>
 #include <ESP32MQTTClient.h>
 #include "logger.h"
+#include "stack_watermark.h"
+#include "wake_profiler.h"
 
 ESP32MQTTClient haMqttClient;
+
+// The client runs on the esp-mqtt task, sized by its Kconfig option.
+#ifdef CONFIG_MQTT_TASK_STACK_SIZE
+static constexpr uint32_t MQTT_TASK_STACK_BYTES = CONFIG_MQTT_TASK_STACK_SIZE;
+#else
+static constexpr uint32_t MQTT_TASK_STACK_BYTES = 6144;  // esp-mqtt default
+#endif
+
 SemaphoreHandle_t haMqttConnectSemaphore = NULL;
 RTC_DATA_ATTR bool publishedMqttConfig = false;
 
@@ -94,7 +104,9 @@ void sendMQTTStatus(const mqtt_status_params_t &params) {
   const char *clientId = clientIdStr.c_str();
   haMqttClient.setURL(HOME_ASSISTANT_MQTT_SERVER, HOME_ASSISTANT_MQTT_PORT, HOME_ASSISTANT_MQTT_USERNAME,
                       HOME_ASSISTANT_MQTT_PASSWORD);
-  haMqttClient.setMaxPacketSize(768);
+  // Room for the wake profile JSON (flat object, about 30 phase keys and the
+  // stack use per task).
+  haMqttClient.setMaxPacketSize(WAKE_PROFILER ? 1536 : 768);
   haMqttClient.setMqttClientName(clientId);
   haMqttClient.setAutoReconnect(false);
   haMqttClient.loopStart();
@@ -129,6 +141,10 @@ void sendMQTTStatus(const mqtt_status_params_t &params) {
       publishSuccess &= publishMQTTSensorDiscovery("Pressure", clientId, HOME_ASSISTANT_MQTT_PRESSURE_TOPIC,
                                                    HOME_ASSISTANT_MQTT_PRESSURE_PAYLOAD);
 #endif  // BME_TYPE_NONE
+#if WAKE_PROFILER
+      publishSuccess &= publishMQTTSensorDiscovery("Wake profile", clientId, HOME_ASSISTANT_MQTT_WAKE_PROFILE_TOPIC,
+                                                   HOME_ASSISTANT_MQTT_WAKE_PROFILE_PAYLOAD);
+#endif  // WAKE_PROFILER
       publishedMqttConfig = publishSuccess;
     } else {
       LOG_INFO("Discovery messages already published, skipping...");
@@ -171,7 +187,16 @@ void sendMQTTStatus(const mqtt_status_params_t &params) {
         publishMQTTSensorState("Pressure", clientId, MQTT_STATE_TOPIC_PRESSURE, valueStr);
       }
 #endif
+#if WAKE_PROFILER
+      // 8. Publish the profile of the previous wake (the current one is
+      // still running and only complete right before deep sleep)
+      char profileJson[1280];
+      if (wakeProfilerLastJson(profileJson, sizeof(profileJson))) {
+        publishMQTTSensorState("Wake profile", clientId, MQTT_STATE_TOPIC_WAKE_PROFILE, profileJson);
+      }
+#endif  // WAKE_PROFILER
     }
+    stackWatermarkRecordTask(StackSlot::MQTT, xTaskGetHandle("mqtt_task"), MQTT_TASK_STACK_BYTES);
     if (!(haMqttClient.loopStop())) {
       LOG_WARNING("MQTT loop did not stop cleanly.");
     }
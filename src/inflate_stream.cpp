@@ -0,0 +1,145 @@
+/* Streaming gzip/deflate decoding of HTTP response bodies.
+ * Copyright (C) 2026  Lumixen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#include "inflate_stream.h"
+
+#include <cstdlib>
+#include "miniz.h"  // tinfl, in the ESP32 ROM
+
+#include "logger.h"
+
+namespace {
+
+// tinfl writes into a circular window of exactly the deflate window size.
+constexpr size_t WINDOW = TINFL_LZ_DICT_SIZE;
+
+}  // namespace
+
+Inflater::Inflater(inflate::Encoding encoding)
+    : stage_(encoding == inflate::Encoding::GZIP ? Stage::GZIP_HEADER : Stage::ZLIB_DETECT) {
+  if (encoding != inflate::Encoding::GZIP && encoding != inflate::Encoding::DEFLATE) {
+    failed_ = true;
+    return;
+  }
+  decompressor_ = static_cast<tinfl_decompressor *>(malloc(sizeof(tinfl_decompressor)));
+  window_ = static_cast<uint8_t *>(malloc(WINDOW));
+  if (decompressor_ == nullptr || window_ == nullptr) {
+    LOG_ERROR("inflate: cannot allocate %u B", static_cast<unsigned>(sizeof(tinfl_decompressor) + WINDOW));
+    failed_ = true;
+    return;
+  }
+  tinfl_init(decompressor_);
+}
+
+Inflater::~Inflater() {
+  free(decompressor_);
+  free(window_);
+}
+
+bool Inflater::step(const uint8_t *in, size_t &inLen, const uint8_t *&out, size_t &outLen, bool moreInput) {
+  out = nullptr;
+  outLen = 0;
+  if (failed_) {
+    inLen = 0;
+    return false;
+  }
+  if (done_) {
+    return true;  // trailer (gzip CRC/size, zlib Adler-32) and beyond
+  }
+
+  // Skip the gzip header, or tell zlib-wrapped from raw deflate: servers
+  // answering "deflate" send either. The zlib header is left to tinfl.
+  size_t consumed = 0;
+  while (stage_ == Stage::GZIP_HEADER && consumed < inLen) {
+    const inflate::GzipHeader::Status status = gzipHeader_.push(in[consumed++]);
+    if (status == inflate::GzipHeader::Status::INVALID) {
+      inLen = consumed;
+      return fail();
+    }
+    if (status == inflate::GzipHeader::Status::DONE) {
+      stage_ = Stage::DATA;
+    }
+  }
+  if (stage_ == Stage::ZLIB_DETECT && consumed < inLen) {
+    if (!haveZlibFirst_ && inLen - consumed < 2) {
+      zlibFirst_ = in[consumed++];
+      haveZlibFirst_ = true;
+    } else {
+      const uint8_t first = haveZlibFirst_ ? zlibFirst_ : in[consumed];
+      const uint8_t second = haveZlibFirst_ ? in[consumed] : in[consumed + 1];
+      flags_ = inflate::isZlibHeader(first, second) ? TINFL_FLAG_PARSE_ZLIB_HEADER : 0;
+      stage_ = Stage::DATA;
+      if (haveZlibFirst_) {
+        // A single byte never completes a block: this yields no output.
+        size_t one = 1;
+        size_t room = WINDOW - windowPos_;
+        const tinfl_status status =
+            tinfl_decompress(decompressor_, &zlibFirst_, &one, window_, window_ + windowPos_, &room,
+                             flags_ | TINFL_FLAG_HAS_MORE_INPUT);
+        if (status < TINFL_STATUS_DONE) {
+          inLen = consumed;
+          return fail();
+        }
+      }
+    }
+  }
+  if (stage_ != Stage::DATA) {
+    inLen = consumed;
+    return moreInput ? true : fail();
+  }
+
+  size_t available = inLen - consumed;
+  size_t room = WINDOW - windowPos_;
+  const tinfl_status status =
+      tinfl_decompress(decompressor_, in + consumed, &available, window_, window_ + windowPos_, &room,
+                       flags_ | (moreInput ? TINFL_FLAG_HAS_MORE_INPUT : 0));
+  inLen = consumed + available;
+  out = window_ + windowPos_;
+  outLen = room;
+  windowPos_ = (windowPos_ + room) & (WINDOW - 1);
+  if (status < TINFL_STATUS_DONE) {
+    LOG_WARNING("inflate: corrupt stream (%d)", static_cast<int>(status));
+    return fail();
+  }
+  if (status == TINFL_STATUS_DONE) {
+    done_ = true;
+  } else if (status == TINFL_STATUS_NEEDS_MORE_INPUT && !moreInput) {
+    LOG_WARNING("inflate: truncated stream");
+    return fail();
+  }
+  return true;
+}  // Inflater::step
+
+// Decompress until some output is pending, taking the source chunk by chunk.
+bool InflateBody::fill(const char *&data, size_t &len) {
+  for (;;) {
+    if (inflater_.done() || inflater_.failed()) {
+      return false;
+    }
+    if (inLen_ == 0 && !sourceEnded_) {
+      sourceEnded_ = !source_.next(in_, inLen_);
+    }
+    size_t used = inLen_;
+    const uint8_t *out = nullptr;
+    size_t outLen = 0;
+    if (!inflater_.step(reinterpret_cast<const uint8_t *>(in_), used, out, outLen, !sourceEnded_)) {
+      return false;
+    }
+    in_ += used;
+    inLen_ -= used;
+    if (outLen > 0) {
+      data = reinterpret_cast<const char *>(out);
+      len = outLen;
+      return true;
+    }
+    if (sourceEnded_) {
+      return false;
+    }
+  }
+}
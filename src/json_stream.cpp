@@ -0,0 +1,77 @@
+/* Streaming JSON decoding of response bodies with json-streaming-parser2.
+ * Copyright (C) 2026  Lumixen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#include "config.h"
+#include "logger.h"
+
+#include "json_stream.h"
+
+#include <algorithm>
+#include "_locale.h"
+
+namespace json_stream {
+
+namespace {
+
+// Bytes after which the handler may stop or take over the stream: the root
+// document closes on '}' or ']', a diverted column opens on '['.
+inline bool isBoundary(char c) { return c == '}' || c == ']' || c == '['; }
+
+}  // namespace
+
+/* Bodies without a Content-Length (Open-Meteo answers close-delimited
+ * HTTP/1.0) have no declared size to read up to. A chunk is only what the
+ * transport already had, or a single byte to wait for, and the loop exits
+ * the moment the document is complete, so reading never blocks on bytes
+ * past its end and anything trailing it never reaches the parser. The
+ * parser gets each chunk in runs cut at the boundary bytes rather than one
+ * call per byte; a run past a parse error is still written, the error
+ * stands. */
+ProviderResult parse(ResponseBody &body, DocumentHandler &handler, const char *source) {
+  ArduinoStreamParser parser;
+  parser.setHandler(&handler);
+  const char *data;
+  size_t len;
+  bool divertFailed = false;
+  while (!parser.hasParseError() && !divertFailed && !handler.finishedDocument() && body.next(data, len)) {
+    size_t i = 0;
+    while (i < len && !parser.hasParseError() && !handler.finishedDocument()) {
+      if (handler.diverting()) {
+        i += handler.divert(data + i, len - i, divertFailed);
+        if (divertFailed) {
+          break;
+        }
+        continue;
+      }
+      // One bulk write per run of bytes up to and including the next
+      // boundary, the only bytes the document can close or a column open on.
+      size_t end = i;
+      while (end < len && !isBoundary(data[end])) {
+        ++end;
+      }
+      end = std::min(end + 1, len);
+      parser.write(reinterpret_cast<const uint8_t *>(data + i), end - i);
+      i = end;
+    }
+  }
+  if (divertFailed) {
+    return ProviderResult::error(TXT_DESERIALIZATION_ERROR_INVALID_INPUT);
+  }
+  if (parser.hasParseError()) {
+    LOG_WARNING("%s JSON parse error: %s", source, parser.getErrorMessage());
+    return ProviderResult::error(TXT_DESERIALIZATION_ERROR_INVALID_INPUT);
+  }
+  if (!handler.finishedDocument()) {
+    return ProviderResult::error(handler.sawStart() ? TXT_DESERIALIZATION_ERROR_INCOMPLETE_INPUT
+                                                    : TXT_DESERIALIZATION_ERROR_EMPTY_INPUT);
+  }
+  return ProviderResult::ok();
+}  // parse
+
+}  // namespace json_stream
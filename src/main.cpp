@@ -38,7 +38,13 @@
 #include "fetch_executor.h"
 #include "provider_fetch_operations.h"
 #include "renderer.h"
+#include "response_cache.h"
 #include "moon_tools.h"
+#include "rtc_footprint.h"
+#include "stack_watermark.h"
+#include "tls_session_client.h"
+#include "view_model.h"
+#include "wake_profiler.h"
 #if defined(HOME_ASSISTANT_MQTT_ENABLED) && HOME_ASSISTANT_MQTT_ENABLED
 #include "home_assistant_mqtt_client.h"
 #endif
@@ -53,6 +59,7 @@
 static forecast_t environment_data;
 static air_quality_t air_pollution;
 static std::vector<weather_alert_t> alerts;
+static weather_view_t view;
 
 Preferences prefs;
 
@@ -73,6 +80,7 @@ void toggleBuiltinLED(bool state) {
  * Aligns wake time to the minute. Sleep times defined in config.
  */
 void beginDeepSleep(unsigned long startTime, tm *timeInfo) {
+  const uint32_t sleepPhaseStart = millis();
   if (!getLocalTime(timeInfo)) {
     LOG_WARNING("%s", TXT_REFERENCING_OLDER_TIME_NOTICE);
   }
@@ -124,6 +132,9 @@ void beginDeepSleep(unsigned long startTime, tm *timeInfo) {
   esp_sleep_enable_timer_wakeup(rtcDriftScaleSleepUs(sleepDuration * 1000000ULL));
   LOG_INFO("%s %ss", TXT_AWAKE_FOR, String((millis() - startTime) / 1000.0, 3).c_str());
   LOG_INFO("%s %llus", TXT_ENTERING_DEEP_SLEEP_FOR, sleepDuration);
+  wakeProfilerRecord(WakePhase::DEEP_SLEEP, WAKE_TAG_NONE, sleepPhaseStart, millis() - sleepPhaseStart);
+  stackWatermarkRecord(StackSlot::MAIN, getArduinoLoopTaskStackSize());
+  wakeProfilerCommit();
   esp_deep_sleep_start();
 }  // end beginDeepSleep
 
@@ -151,6 +162,7 @@ sensor_readings getSensorReadings() {
 #if defined(HOME_ASSISTANT_MQTT_ENABLED) && HOME_ASSISTANT_MQTT_ENABLED
 void publishMqtt(uint32_t batteryVoltage, uint8_t batteryPercent, int8_t wifiRSSI, unsigned long apiActivityDuration) {
   sensor_readings sensorReadings = getSensorReadings();
+  ScopedWakePhase phase(WakePhase::MQTT_PUBLISH);
   if (WiFi.status() == WL_CONNECTED) {
     sendMQTTStatus({.batteryVoltage = batteryVoltage,
                     .batteryPercentage = batteryPercent,
@@ -171,15 +183,20 @@ void handleNetworkError(const unsigned char *icon, const String &statusStr, cons
 #endif
 
   killWiFi();
+  // The failure may come from a reused lease that went stale.
+  forgetWiFiFastConnect();
   initDisplay();
-  do {
+  if (beginScene()) {
     drawError(icon, statusStr, tmpStr);
-  } while (display.nextPage());
+    renderScene();
+  }
   powerOffDisplay();
   beginDeepSleep(startTime, timeInfo);
 }
 
 #ifndef BME_TYPE_NONE
+static uint32_t envSensorStackBytes = 4096;
+
 void envSensorReadingTask(void *pvParameters) {
 #ifdef BME_TYPE_BME280
   EnvSensor *sensor = new BME280EnvSensor();
@@ -195,6 +212,7 @@ void envSensorReadingTask(void *pvParameters) {
     LOG_CRITICAL("Failed to initialize BME sensor");
   }
   delete sensor;
+  stackWatermarkRecord(StackSlot::ENV_SENSOR, envSensorStackBytes);
   xSemaphoreGive(sensorReadingDoneSemaphore);  // Signal completion
   vTaskDelete(NULL);                           // Delete this task when done
 }
@@ -208,6 +226,7 @@ void setup() {
   unsigned long startTime = millis();
   Serial.begin(115200);
   toggleBuiltinLED(true);
+  wakeProfilerBegin();
 
   printHeapUsage();
 
@@ -222,7 +241,9 @@ void setup() {
 
 #if BATTERY_MONITORING
   uint32_t batteryVoltage = 0;
+  const uint32_t adcStart = millis();
   bool batteryVoltageValid = readBatteryVoltage(batteryVoltage);
+  wakeProfilerRecord(WakePhase::BATTERY_ADC, WAKE_TAG_NONE, adcStart, millis() - adcStart);
   uint8_t batteryPercent;
   if (batteryVoltageValid) {
     batteryPercent = calcBatPercent(batteryVoltage, MIN_BATTERY_VOLTAGE, MAX_BATTERY_VOLTAGE);
@@ -240,9 +261,10 @@ void setup() {
         prefs.putBool("lowBat", true);
         prefs.end();
         initDisplay();
-        do {
+        if (beginScene()) {
           drawError(battery_alert_0deg_196x196, TXT_LOW_BATTERY);
-        } while (display.nextPage());
+          renderScene();
+        }
         powerOffDisplay();
       }
 
@@ -260,6 +282,7 @@ void setup() {
         LOG_WARNING("%s", TXT_LOW_BATTERY_VOLTAGE);
         LOG_WARNING("%s %umin", TXT_ENTERING_DEEP_SLEEP_FOR, LOW_BATTERY_SLEEP_INTERVAL);
       }
+      wakeProfilerCommit();
       esp_deep_sleep_start();
     }
     // battery is no longer low, reset variable in non-volatile storage
@@ -287,11 +310,12 @@ void setup() {
 
 #ifndef BME_TYPE_NONE
   sensorReadingDoneSemaphore = xSemaphoreCreateBinary();
+  envSensorStackBytes = stackSizeFor(StackSlot::ENV_SENSOR, envSensorStackBytes);
   xTaskCreate(envSensorReadingTask, "EnvSensorReadingTask",
-              4096,  // Stack size
-              NULL,  // Parameters
-              1,     // Priority
-              NULL   // Task handle
+              envSensorStackBytes,  // Stack size
+              NULL,                 // Parameters
+              1,                    // Priority
+              NULL                  // Task handle
   );
 #endif
 
@@ -300,26 +324,29 @@ void setup() {
 
   // START WIFI
   int8_t wifiRSSI = 0;  // “Received Signal Strength Indicator"
+  uint32_t phaseStart = millis();
   wl_status_t wifiStatus = startWiFi(wifiRSSI);
+  wakeProfilerRecord(WakePhase::WIFI_CONNECT, WAKE_TAG_NONE, phaseStart, millis() - phaseStart);
   if (wifiStatus != WL_CONNECTED) {  // WiFi Connection Failed
     killWiFi();
     initDisplay();
     if (wifiStatus == WL_NO_SSID_AVAIL) {
       LOG_WARNING("%s", TXT_NETWORK_NOT_AVAILABLE);
-      do {
-        drawError(wifi_x_196x196, TXT_NETWORK_NOT_AVAILABLE);
-      } while (display.nextPage());
     } else {
       LOG_WARNING("%s", TXT_WIFI_CONNECTION_FAILED);
-      do {
-        drawError(wifi_x_196x196, TXT_WIFI_CONNECTION_FAILED);
-      } while (display.nextPage());
+    }
+    if (beginScene()) {
+      drawError(wifi_x_196x196,
+                wifiStatus == WL_NO_SSID_AVAIL ? TXT_NETWORK_NOT_AVAILABLE : TXT_WIFI_CONNECTION_FAILED);
+      renderScene();
     }
     powerOffDisplay();
     beginDeepSleep(startTime, &timeInfo);
   }
 
+  phaseStart = millis();
   bool timeConfigured = configureTime(&timeInfo);
+  wakeProfilerRecord(WakePhase::TIME_SYNC, WAKE_TAG_NONE, phaseStart, millis() - phaseStart);
 
   if (!timeConfigured) {
     LOG_WARNING("%s", TXT_TIME_SYNCHRONIZATION_FAILED);
@@ -329,9 +356,21 @@ void setup() {
 
 
   unsigned long apiRequestsStartTime = millis();
-// MAKE API REQUESTS — parallel with bounded pool (max 2 concurrent), alerts first
+// MAKE API REQUESTS — bounded pool, longest expected first, admitted by free heap
   auto fetchBundle = createFetchBundle(environment_data, air_pollution, alerts);
-  auto results = executeParallel(fetchBundle.ops);
+  skipCachedFetchOperations(fetchBundle.ops);
+  // The budget bounds the awake time on bad networks: fetches still running
+  // when it ends are abandoned.
+  FetchCancel fetchCancel(apiRequestsStartTime, FETCH_DEADLINE);
+  auto results = executeParallel(fetchBundle.ops, fetchCancel);
+  // Report the failure that cancelled the round, not the fetches it stopped.
+  const int cause = fetchCancel.cause();
+  if (cause != FetchCancel::NO_CAUSE) {
+    statusStr = fetchBundle.ops[cause]->name();
+    tmpStr = results[cause].detail();
+    handleNetworkError(wi_cloud_down_196x196, statusStr, tmpStr, startTime, &timeInfo, batteryVoltage, batteryPercent,
+                       wifiRSSI);
+  }
   for (size_t i = 0; i < fetchBundle.ops.size(); ++i) {
     if (!results[i].isOk() && fetchBundle.ops[i]->shouldAbortOnFailure()) {
       statusStr = fetchBundle.ops[i]->name();
@@ -347,6 +386,8 @@ void setup() {
 #endif
 
   killWiFi();  // WiFi no longer needed
+  responseCacheFlush();
+  logTlsSessionStats();
   long networkDuration = millis() - networkStartTime;
   LOG_INFO("Network operations took %ss", String(networkDuration / 1000.0, 3).c_str());
 
@@ -359,20 +400,31 @@ void setup() {
 
   sensor_readings sensorReadings = getSensorReadings();
 
+  // Everything shown is formatted once, the draw functions only place it.
+  phaseStart = millis();
+  buildWeatherView(view, environment_data, air_pollution, sensorReadings.pressure, moon, alerts, timeInfo, dateStr,
+                   statusStr, refreshTimeStr, wifiRSSI, batteryVoltage);
+  wakeProfilerRecord(WakePhase::VIEW_BUILD, WAKE_TAG_NONE, phaseStart, millis() - phaseStart);
+
   // RENDER FULL REFRESH
+  phaseStart = millis();
   initDisplay();
-  do {
-    drawCurrentConditions(environment_data.current, air_pollution, sensorReadings.pressure, moon);
+  wakeProfilerRecord(WakePhase::DISPLAY_INIT, WAKE_TAG_NONE, phaseStart, millis() - phaseStart);
+  // The scene is recorded once, then replayed onto each page.
+  // A scene that does not fit is not drawn, the display keeps its last image.
+  if (beginScene()) {
+    drawCurrentConditions(view.current);
     LOG_INFO("Drawing current conditions");
-    drawOutlookGraph(environment_data.hourly, environment_data.daily, timeInfo, moon);
+    drawOutlookGraph(view.outlook);
     LOG_INFO("Drawing outlook graph");
-    drawForecast(environment_data.daily, timeInfo);
+    drawForecast(view.days);
     LOG_INFO("Drawing forecast");
-    drawLocationDate(CITY_STRING, dateStr);
+    drawLocationDate(CITY_STRING, view.date);
     LOG_INFO("Drawing location and date");
-    drawAlerts(alerts, CITY_STRING, dateStr);
-    drawStatusBar(statusStr, refreshTimeStr, wifiRSSI, batteryVoltage);
-  } while (display.nextPage());
+    drawAlerts(view.alerts, view.alertCount, CITY_STRING, view.date);
+    drawStatusBar(view.statusBar);
+    renderScene();
+  }
   powerOffDisplay();
 
   // DEEP SLEEP
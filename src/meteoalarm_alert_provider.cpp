@@ -5,12 +5,21 @@
 
 #include <Arduino.h>
 #include <cmath>
+#include <memory>
 #include <WiFi.h>
 #include "esp_http_client.h"
 #include "cert.h"
 #include "_locale.h"
 #include "display_utils.h"
+#include "fetch_cancel.h"
+#include "fetch_executor.h"
+#include "inflate_stream.h"
 #include "meteoalarm_alert_provider.h"
+#include "parse_pipeline.h"
+#include "response_body.h"
+#include "response_cache.h"
+#include "tag_trie.h"
+#include "wake_profiler.h"
 
 // The renderer displays at most 2 alerts: parsing stops once that many
 // matching warnings of distinct hazards were collected and the connection
@@ -31,6 +40,11 @@ namespace {
 
 constexpr int kHttpStatusOk = 200;
 constexpr int kHttpStatusNotFound = 404;
+// The feed may stall for long on slow links; a read gives up after this
+// long without data.
+constexpr uint32_t kReadTimeoutMs = 30000;
+// Blocking read slice, the latency of a cancellation while the body stalls.
+constexpr int kReadSliceMs = 250;
 
 /* Severity rank of an alert event text, derived from its leading awareness
  * color word (see colorFromSeverity: "Red/Orange/Yellow <hazard> Warning",
@@ -48,6 +62,27 @@ int severityRankFromEvent(const String &event) {
   return METEOALARM_SEVERITY_RANK_NONE;
 }
 
+using Tag = MeteoAlarmAlertProvider::FeedParser::Tag;
+
+// Local names of the elements FeedParser acts on: the entry, the fields it
+// captures from it and the name/value pairs of its <cap:geocode>s.
+constexpr tag_trie::Name<Tag> kFeedTags[] = {
+    {"entry", Tag::ENTRY}, {"event", Tag::EVENT},     {"severity", Tag::SEVERITY}, {"effective", Tag::EFFECTIVE},
+    {"onset", Tag::ONSET}, {"expires", Tag::EXPIRES}, {"polygon", Tag::POLYGON}, {"valueName", Tag::VALUE_NAME},
+    {"value", Tag::VALUE},
+};
+constexpr tag_trie::Trie<Tag, sizeof(kFeedTags) / sizeof(kFeedTags[0])> kFeedTagTrie(kFeedTags);
+static_assert(kFeedTagTrie.built(), "feed tag names do not fit the trie");
+
+const char *tagName(Tag tag) {
+  for (const tag_trie::Name<Tag> &name : kFeedTags) {
+    if (name.tag == tag) {
+      return name.name;
+    }
+  }
+  return "";
+}
+
 /* Days from civil epoch (1970-01-01), from Howard Hinnant's date algorithms. */
 int64_t daysFromCivil(int y, unsigned m, unsigned d) {
   y -= (m <= 2);
@@ -58,84 +93,150 @@ int64_t daysFromCivil(int y, unsigned m, unsigned d) {
   return static_cast<int64_t>(era) * 146097 + static_cast<int64_t>(doe) - 719468;
 }
 
-/* No event handler is used: fetch() reads via esp_http_client_read in a
- * loop and feeds the parser directly, so it can close the connection as
- * soon as METEOALARM_NUM_ALERTS distinct hazards are collected. */
+/* fetch() reads via esp_http_client_read in a loop and feeds the parser
+ * directly, so it can close the connection as soon as METEOALARM_NUM_ALERTS
+ * distinct hazards are collected. The event handler only captures the
+ * freshness headers for the response cache and the body coding:
+ * esp_http_client exposes response headers through events alone. */
+struct CacheHeaders {
+  String cacheControl;
+  String expires;
+  String date;
+  String contentEncoding;
+};
+
+esp_err_t onHttpEvent(esp_http_client_event_t *event) {
+  if (event->event_id != HTTP_EVENT_ON_HEADER || event->user_data == nullptr) {
+    return ESP_OK;
+  }
+  CacheHeaders *headers = static_cast<CacheHeaders *>(event->user_data);
+  if (strcasecmp(event->header_key, "Cache-Control") == 0) {
+    headers->cacheControl = event->header_value;
+  } else if (strcasecmp(event->header_key, "Expires") == 0) {
+    headers->expires = event->header_value;
+  } else if (strcasecmp(event->header_key, "Date") == 0) {
+    headers->date = event->header_value;
+  } else if (strcasecmp(event->header_key, "Content-Encoding") == 0) {
+    headers->contentEncoding = event->header_value;
+  }
+  return ESP_OK;
+}
+
+/* Response body read with esp_http_client_read: each chunk is one read of up
+ * to 1024 B (balancing the ~1.4 KB TLS record size and heap use; the buffer
+ * is on the heap to spare the task stack). Reads time out after a short
+ * slice and are retried until `idleTimeoutMs` passed without data, checking
+ * the cancellation token in between, so a cancelled fetch stops within a
+ * slice. The time spent blocked in the client is accounted apart from
+ * parsing. */
+class EspHttpBody : public ResponseBody {
+ public:
+  EspHttpBody(esp_http_client_handle_t client, uint32_t idleTimeoutMs, const FetchCancel &cancel)
+      : client_(client), idleTimeoutMs_(idleTimeoutMs), cancel_(cancel), buffer_(1024) {}
+
+  // ESP_OK, or why the body ended early (timeout, cancellation, error).
+  esp_err_t error() const { return error_; }
+  bool cancelled() const { return cancelled_; }
+  uint32_t waitMs() const { return waitMs_; }
+
+ protected:
+  bool fill(const char *&data, size_t &len) override {
+    const uint32_t t0 = millis();
+    int n = -ESP_ERR_HTTP_EAGAIN;
+    while (n == -ESP_ERR_HTTP_EAGAIN) {
+      const uint32_t now = millis();
+      if (cancel_.cancelled(now)) {
+        cancelled_ = true;
+        error_ = ESP_ERR_TIMEOUT;
+        break;
+      }
+      if (now - t0 >= idleTimeoutMs_) {
+        error_ = ESP_ERR_HTTP_EAGAIN;
+        break;
+      }
+      n = esp_http_client_read(client_, buffer_.data(), buffer_.size());
+    }
+    waitMs_ += millis() - t0;
+    fetchHeapSample();
+    if (n < 0) {
+      if (error_ == ESP_OK) {
+        error_ = ESP_FAIL;
+      }
+      return false;
+    }
+    data = buffer_.data();
+    len = static_cast<size_t>(n);
+    return n > 0;
+  }
+
+ private:
+  esp_http_client_handle_t client_;
+  uint32_t idleTimeoutMs_;
+  const FetchCancel &cancel_;
+  std::vector<char> buffer_;
+  esp_err_t error_ = ESP_OK;
+  bool cancelled_ = false;
+  uint32_t waitMs_ = 0;
+};
 
 }  // namespace
 
-void MeteoAlarmAlertProvider::FeedParser::EntryData::reset() {
-  event = "";
-  severity = "";
-  effective = "";
-  onset = "";
-  expires = "";
-  polygon = "";
+void MeteoAlarmAlertProvider::FeedParser::EntryData::reset(double lat, double lon) {
+  used = 0;
+  for (int16_t &offset : field) {
+    offset = -1;
+  }
+  polygon = polygon_scan::PointInPolygon(lat, lon);
+  geocoded = false;
+  geocodeMatch = false;
   any = false;
 }
 
+// Captured text of `tag`, "" if the entry has none.
+const char *MeteoAlarmAlertProvider::FeedParser::EntryData::text(Tag tag) const {
+  const int16_t offset = field[static_cast<size_t>(tag) - static_cast<size_t>(Tag::EVENT)];
+  return offset < 0 ? "" : arena + offset;
+}
+
 MeteoAlarmAlertProvider::FeedParser::FeedParser(std::vector<weather_alert_t> &alerts, int64_t now, double lat,
                                                 double lon)
-    : alerts_(alerts), now_(now), lat_(lat), lon_(lon), tStart_(millis()) {}
+    : alerts_(alerts), now_(now), lat_(lat), lon_(lon), tStart_(millis()) {
+  entry_.reset(lat_, lon_);
+}
+
+void MeteoAlarmAlertProvider::FeedParser::setGeocodes(const uint32_t *codes, size_t count) {
+  geocodes_ = codes;
+  geocodeCount_ = count;
+}
 
 /* Returns true if (lat, lon) lies inside the polygon given as space-separated
  * "lat,lon" pairs in WGS84 decimal degrees (CAP format, ray casting, closed
  * ring). A polygon with fewer than 3 valid points can not be evaluated: true
- * is returned so the alert is kept. Boundary points count as inside. */
+ * is returned so the alert is kept. Boundary points count as inside. The
+ * feed parser runs the same test on the polygon text as it streams in. */
 bool MeteoAlarmAlertProvider::pointInPolygon(double lat, double lon, const String &polygon) {
-  const char *p = polygon.c_str();
-  const char *end = p + polygon.length();
-
-  double firstLat = 0, firstLon = 0;
-  double prevLat = 0, prevLon = 0;
-  unsigned numPoints = 0;
-  bool inside = false;
-
-  while (p < end) {
-    char *next = nullptr;
-    const double y = strtod(p, &next);  // CAP polygon points are "lat,lon"
-    if (next == p) {
-      p += 1;  // skip a stray separator
-      continue;
-    }
-    p = next;
-    while (p < end && *p == ',') {
-      ++p;  // skip the lat/lon separator
-    }
-    const double x = strtod(p, &next);
-    if (next == p) {
-      break;  // malformed trailing token
-    }
-    p = next;
-
-    if (numPoints == 0) {
-      firstLat = y;
-      firstLon = x;
-    } else {
-      // Ray casting crossing test for the edge (prev -> cur)
-      if ((prevLat > lat) != (y > lat) && lon < (x - prevLon) * (lat - prevLat) / (y - prevLat) + prevLon) {
-        inside = !inside;
-      }
-    }
-    prevLat = y;
-    prevLon = x;
-    ++numPoints;
-  }
+  polygon_scan::PointInPolygon ring(lat, lon);
+  ring.feed(polygon.c_str(), polygon.length());
+  return ring.inside();
+}  // MeteoAlarmAlertProvider::pointInPolygon
 
-  if (numPoints < 3) {
-    return true;  // not a usable polygon, keep the alert
+uint32_t MeteoAlarmAlertProvider::geocodeFromEmmaId(const char *id) {
+  if (id[0] < 'A' || id[0] > 'Z' || id[1] < 'A' || id[1] > 'Z') {
+    return 0;
   }
-
-  // Closing edge (last -> first) if the ring is not explicitly closed
-  if (prevLat != firstLat || prevLon != firstLon) {
-    if ((prevLat > lat) != (firstLat > lat) &&
-        lon < (firstLon - prevLon) * (lat - prevLat) / (firstLat - prevLat) + prevLon) {
-      inside = !inside;
+  uint32_t number = 0;
+  size_t digits = 0;
+  for (const char *p = id + 2; *p != '\0'; ++p, ++digits) {
+    if (*p < '0' || *p > '9' || digits == 4) {
+      return 0;
     }
+    number = number * 10 + static_cast<uint32_t>(*p - '0');
   }
-
-  return inside;
-}  // MeteoAlarmAlertProvider::pointInPolygon
+  if (digits == 0) {
+    return 0;
+  }
+  return (static_cast<uint32_t>(id[0]) << 24) | (static_cast<uint32_t>(id[1]) << 16) | number;
+}  // MeteoAlarmAlertProvider::geocodeFromEmmaId
 
 int64_t MeteoAlarmAlertProvider::parseIso8601(const String &s) {
   if (s.length() < 19) {
@@ -250,8 +351,10 @@ String MeteoAlarmAlertProvider::colorFromSeverity(const String &severity) {
  * the remainder to save time/bandwidth.
  *
  * The feed (up to several hundred KB) needs far more than a short read
- * window, hence the explicit 30 s timeout. */
-ProviderResult MeteoAlarmAlertProvider::fetch(std::vector<weather_alert_t> &alerts) {
+ * window, hence reads only give up after 30 s without data. A cancelled
+ * fetch (a critical sibling failed, or the fetch budget ran out) still
+ * closes the connection within a read slice. */
+ProviderResult MeteoAlarmAlertProvider::fetch(std::vector<weather_alert_t> &alerts, const FetchCancel &cancel) {
   if (METEOALARM_COUNTRY.isEmpty()) {
     return ProviderResult::error(getHttpResponsePhrase(kHttpStatusNotFound));
   }
@@ -270,9 +373,15 @@ ProviderResult MeteoAlarmAlertProvider::fetch(std::vector<weather_alert_t> &aler
   LOG_INFO("%s: %s", TXT_ATTEMPTING_HTTP_REQ, url.c_str());
 
   const uint32_t t0 = millis();
+  const uint8_t profileTag = wakeProfilerTaskTag();
   int attempts = 0;
   ProviderResult result;
   while (!result.isOk() && attempts < 3) {
+    if (cancel.cancelled(millis())) {
+      LOG_WARNING("MeteoAlarm: fetch %s", cancel.cause() != FetchCancel::NO_CAUSE ? "cancelled" : "deadline passed");
+      result = ProviderResult::error(esp_err_to_name(ESP_ERR_TIMEOUT));
+      break;
+    }
     const wl_status_t connectionStatus = WiFi.status();
     if (connectionStatus != WL_CONNECTED) {
       // The -512 offset stays private here: it only feeds the phrase lookup.
@@ -282,12 +391,18 @@ ProviderResult MeteoAlarmAlertProvider::fetch(std::vector<weather_alert_t> &aler
 
     alerts.clear();
     FeedParser parser(alerts, time(nullptr), lat, lon);
+    parser.setGeocodes(METEOALARM_GEOCODES, METEOALARM_GEOCODE_COUNT);
+    CacheHeaders cacheHeaders;
 
     esp_http_client_config_t config = {};
     config.url = url.c_str();
     config.cert_pem = cert_GEANT_TLS_RSA_1;
-    config.timeout_ms = 30000;
+    // Connect and headers within the budget left; the body is read in
+    // slices (see EspHttpBody).
+    config.timeout_ms = cancel.clamp(kReadTimeoutMs, millis());
     config.method = HTTP_METHOD_GET;
+    config.event_handler = onHttpEvent;
+    config.user_data = &cacheHeaders;
 
     esp_http_client_handle_t client = esp_http_client_init(&config);
     if (client == nullptr) {
@@ -299,8 +414,16 @@ ProviderResult MeteoAlarmAlertProvider::fetch(std::vector<weather_alert_t> &aler
       }
       continue;
     }
+#if ALERTS_API_COMPRESSION
+    // esp_http_client does not decode content codings: the body is inflated
+    // below, on its way into the parser.
+    esp_http_client_set_header(client, "Accept-Encoding", inflate::ACCEPT_ENCODING);
+#endif
 
+    uint32_t phaseStart = millis();
     esp_err_t openErr = esp_http_client_open(client, 0);
+    wakeProfilerRecord(WakePhase::HTTP_CONNECT, profileTag, phaseStart, millis() - phaseStart);
+    fetchHeapSample();  // TLS record buffers are allocated by now
     int status = 0;
     if (openErr != ESP_OK) {
       result = ProviderResult::error(esp_err_to_name(openErr));
@@ -315,11 +438,16 @@ ProviderResult MeteoAlarmAlertProvider::fetch(std::vector<weather_alert_t> &aler
 
     // Fetch headers to obtain the status code; content length is ignored
     // (the feed is chunked / close-delimited).
+    phaseStart = millis();
     esp_http_client_fetch_headers(client);
+    wakeProfilerRecord(WakePhase::HTTP_TTFB, profileTag, phaseStart, millis() - phaseStart);
     status = esp_http_client_get_status_code(client);
+    const inflate::Encoding encoding = inflate::contentEncoding(cacheHeaders.contentEncoding.c_str());
 
-    if (status != kHttpStatusOk) {
-      if (status > 0) {
+    if (status != kHttpStatusOk || encoding == inflate::Encoding::UNSUPPORTED) {
+      if (status == kHttpStatusOk) {
+        result = ProviderResult::error(esp_err_to_name(ESP_ERR_NOT_SUPPORTED));  // unknown content coding
+      } else if (status > 0) {
         result = ProviderResult::error(getHttpResponsePhrase(status));
       } else {
         result = ProviderResult::error(esp_err_to_name(ESP_ERR_HTTP_FETCH_HEADER));
@@ -334,31 +462,43 @@ ProviderResult MeteoAlarmAlertProvider::fetch(std::vector<weather_alert_t> &aler
       continue;
     }
 
-    // Stream the body in bounded chunks directly into the parser.
-    // Close early once the alert cap is reached. Buffer is heap-allocated
-    // (vector) to avoid 1 KB stack pressure; 1024 B balances TLS record
-    // size (~1.4 KB) and heap usage.
-    std::vector<char> buf(1024);
-    bool readFailed = false;
-    esp_err_t readErr = ESP_OK;
-    while (!parser.isAlertCapReached()) {
-      int n = esp_http_client_read(client, buf.data(), buf.size());
-      if (n > 0) {
-        parser.feed(buf.data(), static_cast<size_t>(n));
-      } else if (n == 0) {
-        break;
-      } else {
-        // n < 0: error or timeout (-ESP_ERR_HTTP_EAGAIN etc.)
-        readFailed = true;
-        if (n == -ESP_ERR_HTTP_EAGAIN) {
-          readErr = ESP_ERR_HTTP_EAGAIN;
-        } else {
-          readErr = ESP_FAIL;
-        }
-        break;
+    // Stream the body chunk by chunk directly into the parser. Close early
+    // once the alert cap is reached.
+    esp_http_client_set_timeout_ms(client, kReadSliceMs);
+    EspHttpBody raw(client, kReadTimeoutMs, cancel);
+    bool inflateFailed = false;
+    auto feedParser = [&](ResponseBody &received) -> ProviderResult {
+      // A compressed body is inflated chunk by chunk into the parser; the
+      // inflater only lives (with its 32 KB window) while the body is read.
+      std::unique_ptr<InflateBody> inflated;
+      if (encoding != inflate::Encoding::IDENTITY) {
+        inflated.reset(new InflateBody(received, encoding));
+      }
+      ResponseBody &body = inflated ? static_cast<ResponseBody &>(*inflated) : received;
+      const char *data;
+      size_t len;
+      while (!parser.isAlertCapReached() && body.next(data, len)) {
+        parser.feed(data, len);
       }
+      inflateFailed = inflated && inflated->failed();
+      return ProviderResult::ok();
+    };
+    const uint32_t bodyStart = millis();
+    if (coreSplitEnabled()) {
+      // Inflate and parse on the parse core while this task receives.
+      pipelinedParse(raw, feedParser);
+    } else {
+      feedParser(raw);
     }
+    esp_err_t readErr = raw.error();
+    if (readErr == ESP_OK && inflateFailed) {
+      readErr = ESP_ERR_INVALID_RESPONSE;
+    }
+    const bool readFailed = readErr != ESP_OK;
+    const uint32_t bodyMs = millis() - bodyStart;
 
+    wakeProfilerRecord(WakePhase::HTTP_BODY, profileTag, bodyStart, raw.waitMs());
+    wakeProfilerRecord(WakePhase::HTTP_PARSE, profileTag, bodyStart, bodyMs - raw.waitMs());
     if (parser.isAlertCapReached()) {
       LOG_INFO("MeteoAlarm: alert cap reached, closing connection early");
     }
@@ -370,6 +510,12 @@ ProviderResult MeteoAlarmAlertProvider::fetch(std::vector<weather_alert_t> &aler
     } else {
       result = parser.finish();
     }
+    if (result.isOk()) {
+      result.setMaxAge(response_cache::maxAgeFromHeaders(
+          cacheHeaders.cacheControl.isEmpty() ? nullptr : cacheHeaders.cacheControl.c_str(),
+          cacheHeaders.expires.isEmpty() ? nullptr : cacheHeaders.expires.c_str(),
+          cacheHeaders.date.isEmpty() ? nullptr : cacheHeaders.date.c_str(), time(nullptr)));
+    }
 
     LOG_INFO("%d %s", status, result.isOk() ? getHttpResponsePhrase(status) : result.detail().c_str());
     ++attempts;
@@ -400,16 +546,17 @@ void MeteoAlarmAlertProvider::FeedParser::addEntry() {
     return;
   }
 
-  String hazard = hazardFromEvent(entry_.event);
+  String hazard = hazardFromEvent(entry_.text(Tag::EVENT));
   if (hazard.isEmpty()) {
     return;
   }
 
-  const String color = colorFromSeverity(entry_.severity);
+  const String color = colorFromSeverity(entry_.text(Tag::SEVERITY));
   weather_alert_t alert = {};
   alert.event = color.isEmpty() ? (hazard + " Warning") : (color + " " + hazard + " Warning");
-  alert.start = parseIso8601(!entry_.onset.isEmpty() ? entry_.onset : entry_.effective);
-  alert.end = parseIso8601(entry_.expires);
+  const char *onset = entry_.text(Tag::ONSET);
+  alert.start = parseIso8601(*onset != '\0' ? onset : entry_.text(Tag::EFFECTIVE));
+  alert.end = parseIso8601(entry_.text(Tag::EXPIRES));
 
   // Skip warnings that have already expired, unless the clock is not
   // synchronized yet (epoch < 2021).
@@ -417,9 +564,14 @@ void MeteoAlarmAlertProvider::FeedParser::addEntry() {
     return;
   }
 
-  // Skip warnings whose polygon does not contain the configured location.
-  if (!std::isnan(lat_) && !std::isnan(lon_) && !entry_.polygon.isEmpty() &&
-      !pointInPolygon(lat_, lon_, entry_.polygon)) {
+  // Skip warnings of other regions: by geocode when the entry has one and
+  // the location's regions are known, else when the polygon does not
+  // contain the location (tested as it streamed in; none counts as inside).
+  if (geocodeCount_ > 0 && entry_.geocoded) {
+    if (!entry_.geocodeMatch) {
+      return;
+    }
+  } else if (!std::isnan(lat_) && !std::isnan(lon_) && !entry_.polygon.inside()) {
     return;
   }
 
@@ -448,12 +600,117 @@ void MeteoAlarmAlertProvider::FeedParser::addEntry() {
   alerts_.push_back(alert);
 }  // MeteoAlarmAlertProvider::FeedParser::addEntry
 
+/* Start capturing the text of entry element `tag`. Its text goes to the
+ * arena after the fields finished so far (a capture left open by a nested
+ * capture is dropped, like its text), the polygon's to the ring test. */
+void MeteoAlarmAlertProvider::FeedParser::openCapture(Tag tag) {
+  capture_ = tag;
+  captureLen_ = 0;
+  if (tag == Tag::POLYGON) {
+    entry_.polygon = polygon_scan::PointInPolygon(lat_, lon_);
+  }
+}
+
+void MeteoAlarmAlertProvider::FeedParser::appendText(const char *data, size_t len) {
+  if (capture_ == Tag::POLYGON) {
+    // Only entries without geocodes are located by their polygon. An entry
+    // whose geocodes were already read (matched or not) skips the text; one
+    // whose polygon comes first is scanned, a later geocode overrides it.
+    if (!std::isnan(lat_) && !std::isnan(lon_) && !(geocodeCount_ > 0 && entry_.geocoded)) {
+      entry_.polygon.feed(data, len);
+    }
+    return;
+  }
+  // Keep room for the NUL; the excess of an oversized field is dropped.
+  const size_t taken = entry_.used + captureLen_;
+  const size_t room = taken < TEXT_ARENA_BYTES - 1 ? TEXT_ARENA_BYTES - 1 - taken : 0;
+  if (len > room) {
+    len = room;
+  }
+  memcpy(entry_.arena + entry_.used + captureLen_, data, len);
+  captureLen_ += len;
+}
+
+void MeteoAlarmAlertProvider::FeedParser::closeCapture() {
+  if (capture_ == Tag::VALUE_NAME || capture_ == Tag::VALUE) {
+    // A geocode pair is checked as it closes; its text is scratch at the
+    // arena's end and does not count as entry data.
+    const char *text = entry_.arena + entry_.used;
+    const bool stored = entry_.used < TEXT_ARENA_BYTES;
+    if (stored) {
+      entry_.arena[entry_.used + captureLen_] = '\0';
+    }
+    if (capture_ == Tag::VALUE_NAME) {
+      emmaIdValue_ = stored && strcmp(text, "EMMA_ID") == 0;
+    } else if (emmaIdValue_ && stored) {
+      const uint32_t code = geocodeFromEmmaId(text);
+      if (code != 0) {
+        entry_.geocoded = true;
+        for (size_t i = 0; i < geocodeCount_; ++i) {
+          entry_.geocodeMatch |= geocodes_[i] == code;
+        }
+      }
+      emmaIdValue_ = false;
+    }
+    capture_ = Tag::NONE;
+    captureLen_ = 0;
+    return;
+  }
+  if (capture_ != Tag::POLYGON && entry_.used < TEXT_ARENA_BYTES) {
+    entry_.arena[entry_.used + captureLen_] = '\0';
+    entry_.field[static_cast<size_t>(capture_) - static_cast<size_t>(Tag::EVENT)] =
+        static_cast<int16_t>(entry_.used);
+    entry_.used += captureLen_ + 1;
+  }
+  entry_.any = true;
+  capture_ = Tag::NONE;
+  captureLen_ = 0;
+}
+
+/* Act on the tag just read: entries open and close, captured elements
+ * start and end. Sets alertCapReached_ once enough alerts are collected. */
+void MeteoAlarmAlertProvider::FeedParser::finishTag() {
+  const Tag tag = kFeedTagTrie.tag(tagNode_);
+  if (endTag_) {
+    if (tag == Tag::ENTRY) {
+      if (inEntry_) {
+        addEntry();
+        inEntry_ = false;
+        entry_.reset(lat_, lon_);
+        alertCapReached_ = alerts_.size() >= METEOALARM_NUM_ALERTS;
+      }
+    } else if (inEntry_ && tag != Tag::NONE && tag == capture_) {
+      closeCapture();
+    }
+  } else if (tag == Tag::ENTRY) {
+    if (inEntry_) {
+      // previous entry closed implicitly by a new one
+      addEntry();
+      if (alerts_.size() >= METEOALARM_NUM_ALERTS) {
+        alertCapReached_ = true;
+        return;
+      }
+    }
+    inEntry_ = !selfClosing_;
+    entry_.reset(lat_, lon_);
+  } else if (inEntry_ && tag != Tag::NONE) {
+    openCapture(tag);
+  }
+}  // MeteoAlarmAlertProvider::FeedParser::finishTag
+
 /* Streaming XML scanner for the MeteoAlarm Atom feed, fed in chunks by
  * esp_http_client_read as the body is streamed. Each <entry> repeats the
  * CAP summary of a warning; only event, severity, effective, onset, expires
  * and polygon are captured, everything else is skipped, so the document is
  * never buffered in full.
  *
+ * Most of the feed is text nobody reads (titles, area names, other CAP
+ * fields): outside a captured element the scanner jumps to the next '<'
+ * with memchr, and quoted attribute values and declarations are skipped the
+ * same way. Tag names are matched by the tag trie byte by byte as they are
+ * read, with the namespace prefix dropped at its ':'. Captured text is
+ * copied in runs into the entry's arena.
+ *
  * feed() becomes a no-op once METEOALARM_NUM_ALERTS matching warnings have
  * been collected; the caller checks isAlertCapReached() and closes the connection
  * without reading the remainder (see fetch()). */
@@ -462,55 +719,76 @@ void MeteoAlarmAlertProvider::FeedParser::feed(const char *data, size_t len) {
     return;
   }
 
-  for (size_t i = 0; i < len; ++i) {
-    const char c = data[i];
-    ++total_;
+  const char *p = data;
+  const char *const end = data + len;
+  while (p < end) {
     switch (state_) {
       case St::TEXT: {
-        if (c == '<') {
-          state_ = St::TAG_NAME;
-          tagName_ = "";
-          endTag_ = false;
-          selfClosing_ = false;
-        } else if (c == '&') {
-          entity_ = "";
-          state_ = St::ENTITY;
-        } else if (!capture_.isEmpty()) {
-          text_ += c;
+        if (capture_ == Tag::NONE) {
+          const char *lt = static_cast<const char *>(memchr(p, '<', static_cast<size_t>(end - p)));
+          if (lt == nullptr) {
+            p = end;
+            break;
+          }
+          p = lt;
+        } else {
+          const char *run = p;
+          while (p < end && *p != '<' && *p != '&') {
+            ++p;
+          }
+          appendText(run, static_cast<size_t>(p - run));
+          if (p == end) {
+            break;
+          }
+          if (*p == '&') {
+            ++p;
+            entityLen_ = 0;
+            state_ = St::ENTITY;
+            break;
+          }
         }
+        ++p;  // '<'
+        state_ = St::TAG_NAME;
+        tagNode_ = kFeedTagTrie.ROOT;
+        endTag_ = false;
+        selfClosing_ = false;
         break;
       }
       case St::ENTITY: {
+        const char c = *p++;
         if (c == ';') {
-          if (entity_ == "amp") {
-            text_ += '&';
-          } else if (entity_ == "lt") {
-            text_ += '<';
-          } else if (entity_ == "gt") {
-            text_ += '>';
-          } else if (entity_ == "quot") {
-            text_ += '"';
-          } else if (entity_ == "apos") {
-            text_ += '\'';
+          static const struct {
+            const char *name;
+            char c;
+          } kEntities[] = {{"amp", '&'}, {"lt", '<'}, {"gt", '>'}, {"quot", '"'}, {"apos", '\''}};
+          entity_[entityLen_] = '\0';
+          char decoded = 0;
+          for (const auto &entity : kEntities) {
+            if (strcmp(entity_, entity.name) == 0) {
+              decoded = entity.c;
+            }
+          }
+          if (decoded != 0) {
+            appendText(&decoded, 1);
           } else {
-            text_ += '&';
-            text_ += entity_;
-            text_ += ';';
+            appendText("&", 1);
+            appendText(entity_, entityLen_);
+            appendText(";", 1);
           }
           state_ = St::TEXT;
-        } else if (entity_.length() >= 8) {
+        } else if (entityLen_ >= sizeof(entity_) - 1) {
           // too long to be a named entity, keep it as raw text
-          text_ += '&';
-          text_ += entity_;
-          text_ += c;
-          entity_ = "";
+          appendText("&", 1);
+          appendText(entity_, entityLen_);
+          --p;  // rescanned as text
           state_ = St::TEXT;
         } else {
-          entity_ += c;
+          entity_[entityLen_++] = c;
         }
         break;
       }
       case St::TAG_NAME: {
+        const char c = *p++;
         if (c == '?' || c == '!') {
           // <?xml ...?> declaration or <!DOCTYPE ...>/<!-- ... -->, skip
           state_ = St::SKIP;
@@ -519,95 +797,54 @@ void MeteoAlarmAlertProvider::FeedParser::feed(const char *data, size_t len) {
         } else if (c == ' ' || c == '\t' || c == '\r' || c == '\n') {
           state_ = St::TAG_ATTR;
         } else if (c == '>') {
-          // tag complete
-          goto finish_tag;  // NOLINT(bugprone-branch-clone)
+          state_ = St::TEXT;  // a finished tag is always followed by text
+          finishTag();
+        } else if (c == ':') {
+          tagNode_ = kFeedTagTrie.ROOT;  // the local name follows the prefix
         } else {
-          tagName_ += c;
+          tagNode_ = kFeedTagTrie.step(tagNode_, c);
         }
         break;
       }
       case St::TAG_ATTR: {
+        const char c = *p++;
         if (c == '"' || c == '\'') {
           quote_ = c;
           state_ = St::TAG_ATTR_QUOTED;
         } else if (c == '/') {
           selfClosing_ = true;
         } else if (c == '>') {
-          goto finish_tag;  // NOLINT(bugprone-branch-clone)
+          state_ = St::TEXT;
+          finishTag();
         }
         break;
       }
       case St::TAG_ATTR_QUOTED: {
-        if (c == quote_) {
+        const char *close = static_cast<const char *>(memchr(p, quote_, static_cast<size_t>(end - p)));
+        if (close == nullptr) {
+          p = end;
+        } else {
+          p = close + 1;
           state_ = St::TAG_ATTR;
         }
         break;
       }
       case St::SKIP: {
-        if (c == '>') {
+        const char *gt = static_cast<const char *>(memchr(p, '>', static_cast<size_t>(end - p)));
+        if (gt == nullptr) {
+          p = end;
+        } else {
+          p = gt + 1;
           state_ = St::TEXT;
         }
         break;
       }
     }
-
-    continue;
-
-  finish_tag:;
-    state_ = St::TEXT;  // a finished tag is always followed by text
-    const String local = tagName_.substring(tagName_.indexOf(':') + 1);
-
-    if (endTag_) {
-      if (local == "entry") {
-        if (inEntry_) {
-          addEntry();
-          inEntry_ = false;
-          entry_.reset();
-          if (alerts_.size() >= METEOALARM_NUM_ALERTS) {
-            alertCapReached_ = true;
-            return;
-          }
-        }
-      } else if (inEntry_ && local == capture_) {
-        if (local == "event") {
-          entry_.event = text_;
-        } else if (local == "severity") {
-          entry_.severity = text_;
-        } else if (local == "effective") {
-          entry_.effective = text_;
-        } else if (local == "onset") {
-          entry_.onset = text_;
-        } else if (local == "expires") {
-          entry_.expires = text_;
-        } else if (local == "polygon") {
-          entry_.polygon = text_;
-        }
-        entry_.any = true;
-        capture_ = "";
-        text_ = "";
-      }
-    } else {
-      if (local == "entry") {
-        if (inEntry_) {
-          // previous entry closed implicitly by a new one
-          addEntry();
-          if (alerts_.size() >= METEOALARM_NUM_ALERTS) {
-            alertCapReached_ = true;
-            return;
-          }
-        }
-        inEntry_ = true;
-        entry_.reset();
-        if (selfClosing_) {
-          inEntry_ = false;
-        }
-      } else if (inEntry_ && (local == "event" || local == "severity" || local == "effective" || local == "onset" ||
-                              local == "expires" || local == "polygon")) {
-        capture_ = local;
-        text_ = "";
-      }
+    if (alertCapReached_) {
+      break;
     }
   }
+  total_ += static_cast<size_t>(p - data);
 }  // MeteoAlarmAlertProvider::FeedParser::feed
 
 /* Call once after the whole body has been fed (or the connection ended).
@@ -620,10 +857,11 @@ ProviderResult MeteoAlarmAlertProvider::FeedParser::finish() {
     return ProviderResult::ok();
   }
 
-  if (inEntry_ || !capture_.isEmpty()) {
+  if (inEntry_ || capture_ != Tag::NONE) {
     LOG_WARNING("MeteoAlarm: feed ended early after %u bytes, scanner in state %d (inEntry=%u, capture='%s', "
-                "tagName='%s')",
-                static_cast<unsigned>(total_), static_cast<int>(state_), inEntry_, capture_.c_str(), tagName_.c_str());
+                "tag='%s')",
+                static_cast<unsigned>(total_), static_cast<int>(state_), inEntry_, tagName(capture_),
+                tagName(kFeedTagTrie.tag(tagNode_)));
     return ProviderResult::error(TXT_DESERIALIZATION_ERROR_INCOMPLETE_INPUT);
   }
   LOG_DEBUG("feed: %u bytes -> %u alerts in %u ms", static_cast<unsigned>(total_),
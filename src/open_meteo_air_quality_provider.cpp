@@ -4,94 +4,185 @@
 #if defined(AIR_QUALITY_API_PROVIDER_OPEN_METEO)
 
 #include <Arduino.h>
-#include <ArduinoJson.h>
 #include <WiFiClient.h>
+#include <cstring>
 #if !defined(AIR_QUALITY_API_TRANSPORT_HTTP)
-#include <WiFiClientSecure.h>
+#include "tls_session_client.h"
 #endif
 #if defined(AIR_QUALITY_API_TRANSPORT_HTTPS_VERIFY)
 #include "cert.h"
 #endif
 #include <time.h>
+#include <algorithm>
+#include <cmath>
 #include "_locale.h"
+#include "air_quality_window.h"
 #include "client_utils.h"
-#include "provider_result_utils.h"
+#include "json_stream.h"
 #include "open_meteo_air_quality_provider.h"
+#include "open_meteo_flatbuffers.h"
+
+namespace {
+
+struct HourlyColumn {
+  const char *key;
+  AirQualityWindow::Pollutant pollutant;
+};
+
+// In query order: a FlatBuffers response identifies columns by position.
+const HourlyColumn HOURLY_COLUMNS[] = {
+    {"pm2_5", AirQualityWindow::Pollutant::PM2_5},         {"carbon_monoxide", AirQualityWindow::Pollutant::CO},
+    {"nitrogen_dioxide", AirQualityWindow::Pollutant::NO2}, {"sulphur_dioxide", AirQualityWindow::Pollutant::SO2},
+    {"ammonia", AirQualityWindow::Pollutant::NH3},          {"nitrogen_monoxide", AirQualityWindow::Pollutant::NO},
+    {"ozone", AirQualityWindow::Pollutant::O3},             {"pm10", AirQualityWindow::Pollutant::PM10},
+};
+constexpr size_t NUM_HOURLY_COLUMNS = sizeof(HOURLY_COLUMNS) / sizeof(HOURLY_COLUMNS[0]);
+
+/* SAX event handler: hands hourly.<column>[i] to the rolling window as the
+ * bytes stream in, instead of building a JsonDocument of all rows first.
+ * Only depth-3 values under "hourly" are looked at; null concentrations (the
+ * API sends null for pollutants it has no model for) count as 0. */
+class AirQualityHandler : public json_stream::DocumentHandler {
+ public:
+  explicit AirQualityHandler(AirQualityWindow &window) : window_(window) {}
+
+  void value(ElementPath path, ElementValue value) override {
+    if (path.getCount() != 3) {
+      return;
+    }
+    const char *section = path.get(0)->getKey();
+    const char *column = path.getParent()->getKey();
+    const int row = path.getCurrent()->getIndex();
+    if (section == nullptr || strcmp(section, "hourly") != 0 || column == nullptr || row < 0) {
+      return;
+    }
+    const bool number = value.isInt() || value.isFloat();
+    if (strcmp(column, "time") == 0) {
+      if (number) {
+        window_.time(static_cast<size_t>(row), static_cast<int64_t>(value.getDouble()));
+      }
+      return;
+    }
+    for (const HourlyColumn &hourly : HOURLY_COLUMNS) {
+      if (strcmp(column, hourly.key) == 0) {
+        const float concentration = number ? static_cast<float>(value.getDouble()) : 0.0f;
+        window_.value(hourly.pollutant, static_cast<size_t>(row), concentration);
+        return;
+      }
+    }
+  }
+
+ private:
+  AirQualityWindow &window_;
+};
+
+}  // namespace
 
 /* Perform an HTTP GET request to Open-Meteo's air quality API and map the
  * response into the generic air quality model.
  *
  */
-ProviderResult OpenMeteoAirQualityProvider::fetch(air_quality_t &airQuality) {
+ProviderResult OpenMeteoAirQualityProvider::fetch(air_quality_t &airQuality, const FetchCancel &cancel) {
 #if defined(AIR_QUALITY_API_TRANSPORT_HTTP)
   WiFiClient client;
   const uint16_t port = 80;
 #elif defined(AIR_QUALITY_API_TRANSPORT_HTTPS_NO_VERIFY)
-  WiFiClientSecure client;
+  TlsSessionClient client;
   client.setInsecure();
   const uint16_t port = 443;
 #else  // AIR_QUALITY_API_TRANSPORT_HTTPS_VERIFY
-  WiFiClientSecure client;
+  TlsSessionClient client;
   client.setCACert(cert_ISRG_Root_X1);
   const uint16_t port = 443;
 #endif
-  String uri = "/v1/air-quality?latitude=" + LAT + "&longitude=" + LON +
-               "&hourly=pm2_5,carbon_monoxide,nitrogen_dioxide,sulphur_dioxide,ammonia,nitrogen_monoxide,ozone,pm10&"
-               "past_days=1&forecast_days=1&timeformat=unixtime";
+  String uri = "/v1/air-quality?latitude=" + LAT + "&longitude=" + LON + "&hourly=";
+  for (size_t c = 0; c < NUM_HOURLY_COLUMNS; ++c) {
+    uri += c > 0 ? "," : "";
+    uri += HOURLY_COLUMNS[c].key;
+  }
+  // The NUM_AIR_POLLUTION hours up to the current one, not the whole past
+  // and forecast day (48 rows).
+  uri += "&past_hours=" + String(NUM_AIR_POLLUTION - 1) + "&forecast_hours=1&timeformat=unixtime";
+
+#if defined(AIR_QUALITY_API_FORMAT_FLATBUFFERS)
+  // FlatBuffers first, JSON when a response does not decode (see the
+  // forecast provider).
+  const String fbUri = uri + "&format=flatbuffers";
+  bool undecodable = false;
+  ProviderResult result =
+      httpGetWithRetry(client, OM_AIR_QUALITY_ENDPOINT, port, fbUri, OM_AIR_QUALITY_ENDPOINT + fbUri, true,
+                       AIR_QUALITY_API_COMPRESSION, HTTP_CLIENT_TCP_TIMEOUT, cancel,
+                       [&airQuality, &undecodable](ResponseBody &body, size_t) {
+                         ProviderResult decoded = deserializeFlatBuffers(body, airQuality);
+                         undecodable = !decoded.isOk();
+                         if (undecodable) {
+                           decoded.setPermanent();  // go to JSON, not another download
+                         }
+                         return decoded;
+                       });
+  if (result.isOk() || !undecodable) {
+    return result;
+  }
+  LOG_WARNING("Open-Meteo air quality FlatBuffers response not decodable (%s), falling back to JSON",
+              result.detail().c_str());
+#endif
+
   String sanitizedUri = OM_AIR_QUALITY_ENDPOINT + uri;
 
-  return httpGetWithRetry(client, OM_AIR_QUALITY_ENDPOINT, port, uri, sanitizedUri, true, HTTP_CLIENT_TCP_TIMEOUT,
-                          [&airQuality](Stream &json, size_t) { return deserializeAirQuality(json, airQuality); });
+  return httpGetWithRetry(client, OM_AIR_QUALITY_ENDPOINT, port, uri, sanitizedUri, true, AIR_QUALITY_API_COMPRESSION,
+                          HTTP_CLIENT_TCP_TIMEOUT, cancel,
+                          [&airQuality](ResponseBody &json, size_t) {
+                            return deserializeAirQuality(json, airQuality);
+                          });
 }  // OpenMeteoAirQualityProvider::fetch
 
-ProviderResult OpenMeteoAirQualityProvider::deserializeAirQuality(Stream &json, air_quality_t &airQuality) {
-  JsonDocument doc;
-  DeserializationError error = deserializeJson(doc, json);
-  LOG_DEBUG("doc.overflowed() : %s", doc.overflowed() ? "true" : "false");
-  if (LogLevel::TRACE >= g_logLevel) {
-    LOG_TRACE("pretty JSON dump:");
-    serializeJsonPretty(doc, Serial);
-    Serial.println();
-  }
-  if (error) {
-    return mapDeserializationError(error);
+/* Map the response into the NUM_AIR_POLLUTION hourly rows ending at the
+ * closest timestamp at or before now (closest and 23 previous). The model is
+ * only written once the document closed, so a rejected body leaves the
+ * previous one untouched. */
+ProviderResult OpenMeteoAirQualityProvider::deserializeAirQuality(ResponseBody &json, air_quality_t &airQuality) {
+  AirQualityWindow window(time(nullptr));
+  AirQualityHandler handler(window);
+  const ProviderResult parsed = json_stream::parse(json, handler, "Open-Meteo air quality");
+  if (!parsed.isOk()) {
+    return parsed;
   }
+  const size_t rows = window.resolve(airQuality);
+  LOG_DEBUG("Open-Meteo air quality: %u hourly rows up to now", static_cast<unsigned>(rows));
+  return ProviderResult::ok();
+}  // OpenMeteoAirQualityProvider::deserializeAirQuality
 
-  JsonObject hourly = doc["hourly"];
-  int count = hourly["time"].size();
-
-  // Find index of closest timestamp below 'now'
-  int closest_idx = -1;
-  int64_t now = time(nullptr);
-  for (int i = 0; i < count; i++) {
-    int64_t ts = hourly["time"][i].as<int64_t>();
-    if (ts <= now) {
-      closest_idx = i;
-    } else {
-      break;
-    }
+/* Same window as the JSON decoder, fed from the hourly section of a
+ * FlatBuffers response: all timestamps, then each column in query order.
+ * NaN (no model for the pollutant) counts as 0, like a JSON null. */
+ProviderResult OpenMeteoAirQualityProvider::deserializeFlatBuffers(ResponseBody &body, air_quality_t &airQuality) {
+  open_meteo_fb::Message message;
+  const open_meteo_fb::ReadStatus status = message.read(body);
+  if (status != open_meteo_fb::ReadStatus::OK) {
+    LOG_WARNING("Open-Meteo air quality FlatBuffers message unreadable (%u B read)",
+                static_cast<unsigned>(message.size()));
+    return ProviderResult::error(open_meteo_fb::readError(status));
   }
-
-  // Pick 24 entries: closest below and 23 previous
-  int start_idx = closest_idx - NUM_AIR_POLLUTION + 1;
-  if (start_idx < 0)
-    start_idx = 0;
-  int actual_count = closest_idx - start_idx + 1;
-  if (actual_count > NUM_AIR_POLLUTION)
-    actual_count = NUM_AIR_POLLUTION;
-  for (int i = 0; i < actual_count; i++) {
-    int idx = start_idx + i;
-    airQuality.dt[i] = hourly["time"][idx].as<int64_t>();
-    airQuality.components.pm2_5[i] = hourly["pm2_5"][idx].as<float>();
-    airQuality.components.pm10[i] = hourly["pm10"][idx].as<float>();
-    airQuality.components.co[i] = hourly["carbon_monoxide"][idx].as<float>();
-    airQuality.components.no[i] = hourly["nitrogen_monoxide"][idx].as<float>();
-    airQuality.components.no2[i] = hourly["nitrogen_dioxide"][idx].as<float>();
-    airQuality.components.o3[i] = hourly["ozone"][idx].as<float>();
-    airQuality.components.so2[i] = hourly["sulphur_dioxide"][idx].as<float>();
-    airQuality.components.nh3[i] = hourly["ammonia"][idx].as<float>();
+  const flatbuffer::Table hourly = message.root().table(open_meteo_fb::response::HOURLY);
+  if (!hourly.valid()) {
+    return ProviderResult::error(String(TXT_DESERIALIZATION_ERROR_INVALID_INPUT) + " (missing hourly)");
   }
-  return mapDeserializationError(error);
-}  // OpenMeteoAirQualityProvider::deserializeAirQuality
+  const open_meteo_fb::Series series(hourly);
+  AirQualityWindow window(time(nullptr));
+  for (uint32_t row = 0; row < series.steps(); ++row) {
+    window.time(row, series.at(row));
+  }
+  const uint32_t columns = std::min<uint32_t>(series.variables.size(), NUM_HOURLY_COLUMNS);
+  for (uint32_t c = 0; c < columns; ++c) {
+    const flatbuffer::Vector<float> values = series.variables[c].vector<float>(open_meteo_fb::variable::VALUES);
+    for (uint32_t row = 0; row < values.size(); ++row) {
+      const float concentration = values[row];
+      window.value(HOURLY_COLUMNS[c].pollutant, row, std::isnan(concentration) ? 0.0f : concentration);
+    }
+  }
+  const size_t rows = window.resolve(airQuality);
+  LOG_DEBUG("Open-Meteo air quality: %u hourly rows up to now", static_cast<unsigned>(rows));
+  return ProviderResult::ok();
+}  // OpenMeteoAirQualityProvider::deserializeFlatBuffers
 
 #endif  // AIR_QUALITY_API_PROVIDER_OPEN_METEO
@@ -5,19 +5,214 @@
 
 #include <Arduino.h>
 #include <WiFiClient.h>
+#include <time.h>
 #if !defined(WEATHER_API_TRANSPORT_HTTP)
-#include <WiFiClientSecure.h>
+#include "tls_session_client.h"
 #endif
 #if defined(WEATHER_API_TRANSPORT_HTTPS_VERIFY)
 #include "cert.h"
 #endif
+#include <algorithm>
+#include <cmath>
 #include <cstdint>
 #include <cstring>
-#include <ArduinoStreamParser.h>
 #include "_locale.h"
 #include "client_utils.h"
+#include "column_scanner.h"
+#include "forecast_refresh.h"
+#include "json_stream.h"
+#include "open_meteo_fields.h"
+#include "open_meteo_flatbuffers.h"
+#include "open_meteo_query_plan.h"
 #include "open_meteo_weather_provider.h"
 
+using namespace open_meteo_fields;
+using open_meteo_plan::CURRENT_QUERY;
+using open_meteo_plan::DAILY_QUERY;
+using open_meteo_plan::HOURLY_QUERY;
+
+/* Stores the value of a known field into the forecast model, for both the
+ * JSON handler and the FlatBuffers decoder. Hourly rows go to `hourly`
+ * (`hourlyRows` of them) when given, else to the model. Also tracks the
+ * time keys a response must carry to count as a forecast (see
+ * isComplete()). */
+class ForecastWriter {
+ public:
+  ForecastWriter(forecast_t &forecast, hourly_t *hourly, size_t hourlyRows)
+      : forecast_(forecast),
+        hourly_(hourly != nullptr ? hourly : forecast.hourly),
+        hourlyRows_(hourly != nullptr ? hourlyRows : NUM_HOURLY) {}
+
+  void storeCurrent(CurrentField field, double value) {
+    current_t &current = forecast_.current;
+    switch (field) {
+      case CurrentField::TIME:
+        current.dt = static_cast<int64_t>(value);
+        sawCurrentTime_ = true;
+        break;
+      case CurrentField::TEMPERATURE:
+        current.temp = static_cast<float>(value);
+        break;
+      case CurrentField::APPARENT_TEMPERATURE:
+        current.feels_like = static_cast<float>(value);
+        break;
+      case CurrentField::HUMIDITY:
+        current.humidity = static_cast<int>(value);
+        break;
+      case CurrentField::DEW_POINT:
+        current.dew_point = static_cast<float>(value);
+        break;
+      case CurrentField::WEATHER_CODE:
+        current.weather.condition = OpenMeteoWeatherProvider::mapWeatherCode(static_cast<int>(value));
+        break;
+      case CurrentField::CLOUD_COVER:
+        current.clouds = static_cast<int>(value);
+        break;
+      case CurrentField::VISIBILITY:
+        current.visibility = static_cast<int>(value);
+        break;
+      case CurrentField::PRESSURE:
+        current.pressure = static_cast<int>(value);
+        break;
+      case CurrentField::WIND_SPEED:
+        current.wind_speed = static_cast<float>(value);
+        break;
+      case CurrentField::WIND_DIRECTION:
+        current.wind_deg = static_cast<int>(value);
+        break;
+      case CurrentField::WIND_GUSTS:
+        current.wind_gust = static_cast<float>(value);
+        break;
+      case CurrentField::IS_DAY:
+        current.is_day = value != 0.0;
+        break;
+    }
+  }
+
+  void storeHourly(HourlyField field, size_t idx, double value) {
+    if (idx >= hourlyRows_) {
+      return;
+    }
+    hourly_t &hourly = hourly_[idx];
+    switch (field) {
+      case HourlyField::TIME:
+        hourly.dt = static_cast<int64_t>(value);
+        if (idx == 0) {
+          sawHourlyTime_ = true;
+        }
+        break;
+      case HourlyField::TEMPERATURE:
+        hourly.temp = static_cast<float>(value);
+        break;
+      case HourlyField::CLOUD_COVER:
+        hourly.clouds = static_cast<int>(value);
+        break;
+      case HourlyField::WIND_SPEED:
+        hourly.wind_speed = static_cast<float>(value);
+        break;
+      case HourlyField::WIND_GUSTS:
+        hourly.wind_gust = static_cast<float>(value);
+        break;
+      case HourlyField::PRECIPITATION_PROBABILITY:
+        hourly.pop = static_cast<int>(value);
+        break;
+      case HourlyField::RAIN:
+        hourly.rain_1h = static_cast<float>(value);
+        break;
+      case HourlyField::SNOWFALL:
+        hourly.snow_1h = static_cast<float>(value);
+        break;
+      case HourlyField::WEATHER_CODE:
+        hourly.weather.condition = OpenMeteoWeatherProvider::mapWeatherCode(static_cast<int>(value));
+        break;
+      case HourlyField::IS_DAY:
+        hourly.is_day = value != 0.0;
+        break;
+      case HourlyField::SOIL_TEMPERATURE:
+        if (idx == 0) {
+          forecast_.current.soil_temperature_18cm = static_cast<float>(value);
+        }
+        break;
+    }
+  }
+
+  void storeDaily(DailyField field, size_t idx, double value) {
+    if (idx >= NUM_DAILY) {
+      return;
+    }
+    daily_t &daily = forecast_.daily[idx];
+    switch (field) {
+      case DailyField::TIME:
+        daily.dt = static_cast<int64_t>(value);
+        if (idx == 0) {
+          sawDailyTime_ = true;
+        }
+        break;
+      case DailyField::TEMPERATURE_MAX:
+        daily.temp.max = static_cast<float>(value);
+        break;
+      case DailyField::TEMPERATURE_MIN:
+        daily.temp.min = static_cast<float>(value);
+        break;
+      case DailyField::SUNRISE:
+        if (idx == 0) {
+          forecast_.current.sunrise = static_cast<int64_t>(value);
+        }
+        daily.sunrise = static_cast<int64_t>(value);
+        break;
+      case DailyField::SUNSET:
+        if (idx == 0) {
+          forecast_.current.sunset = static_cast<int64_t>(value);
+        }
+        daily.sunset = static_cast<int64_t>(value);
+        break;
+      case DailyField::UV_INDEX_MAX:
+        if (idx == 0) {
+          forecast_.current.uvi = static_cast<float>(value);
+        }
+        daily.uvi = static_cast<float>(value);
+        break;
+      case DailyField::RAIN_SUM:
+        daily.rain = static_cast<float>(value);
+        break;
+      case DailyField::SNOWFALL_SUM:
+        daily.snow = static_cast<float>(value);
+        break;
+      case DailyField::PRECIPITATION_PROBABILITY_MAX:
+        daily.pop = static_cast<int>(value);
+        break;
+      case DailyField::WIND_SPEED_MAX:
+        daily.wind_speed = static_cast<float>(value);
+        break;
+      case DailyField::WIND_GUSTS_MAX:
+        daily.wind_gust = static_cast<float>(value);
+        break;
+      case DailyField::WEATHER_CODE:
+        daily.weather.condition = OpenMeteoWeatherProvider::mapWeatherCode(static_cast<int>(value));
+        break;
+      case DailyField::SHORTWAVE_RADIATION_SUM:
+        daily.shortwave_radiation_sum = static_cast<float>(value);
+        break;
+    }
+  }
+
+  size_t hourlyRows() const { return hourlyRows_; }
+
+  // A current-only response needs no hourly or daily time.
+  bool isComplete(OpenMeteoWeatherProvider::Sections sections) const {
+    return sawCurrentTime_ && (sections == OpenMeteoWeatherProvider::Sections::CURRENT ||
+                               (sawHourlyTime_ && sawDailyTime_));
+  }
+
+ private:
+  forecast_t &forecast_;
+  hourly_t *hourly_;
+  size_t hourlyRows_;
+  bool sawCurrentTime_ = false;
+  bool sawHourlyTime_ = false;
+  bool sawDailyTime_ = false;
+};
+
 /* SAX event handler: maps the Open-Meteo forecast response directly into
  * the provider-agnostic forecast model as the bytes stream in. Only the
  * `current`, `hourly` and `daily` sections are captured; everything else
@@ -32,27 +227,41 @@
  *   - `hourly`/`daily` array elements arrive at depth 3: the grandparent
  *     selector carries the section key, the parent selector the field key,
  *     and the current selector the array index.
- * Dispatch below mirrors that shape. Everything else (non-matching depths,
- * unknown keys, string values) is ignored.
+ * Dispatch below mirrors that shape. Section and field keys are looked up
+ * in the perfect hashes of open_meteo_fields.h: one hash and one strcmp per
+ * value rather than a strcmp per candidate field. Everything else
+ * (non-matching depths, unknown keys, string values) is ignored.
+ *
+ * Known hourly/daily columns skip the per-element events: startArray()
+ * arms the column scanner (column_scanner.h), and json_stream::parse()
+ * hands the array's bytes to divert() instead of the parser until its ']'.
  *
  * A payload only counts as a forecast once the three required time keys
  * were actually seen: current.time, plus non-empty hourly.time and
- * daily.time arrays. Any syntactically valid JSON that lacks them (e.g. an
- * Open-Meteo {"error": ...} response) makes isComplete() report false, and
+ * daily.time arrays unless only the current section was asked for. Any
+ * syntactically valid JSON that lacks them (e.g. an Open-Meteo
+ * {"error": ...} response) makes isComplete() report false, and
  * deserializeCall() rejects it with InvalidInput so the caller's retry and
  * error handling can engage instead of trusting stale forecast values.
  */
-class WeatherHandler : public JsonHandler {
+class WeatherHandler : public json_stream::DocumentHandler {
  public:
-  explicit WeatherHandler(forecast_t &forecast) : forecast_(forecast) {}
+  WeatherHandler(forecast_t &forecast, hourly_t *hourly, size_t hourlyRows) : writer_(forecast, hourly, hourlyRows) {}
 
-  void startDocument() override { sawStart_ = true; }
-  void endDocument() override { documentDone_ = true; }
-  void startObject(ElementPath) override {}
-  void endObject(ElementPath) override {}
-  void startArray(ElementPath) override {}
-  void endArray(ElementPath) override {}
-  void whitespace(char) override {}
+  void startArray(ElementPath path) override {
+    // hourly.<field> or daily.<field>: the array of one column.
+    Section section;
+    if (path.getCount() != 2 || !SECTION_KEYS.find(keyOf(path.getParent()), section)) {
+      return;
+    }
+    const char *key = keyOf(path.getCurrent());
+    if ((section == Section::HOURLY && HOURLY_KEYS.find(key, hourlyColumn_)) ||
+        (section == Section::DAILY && DAILY_KEYS.find(key, dailyColumn_))) {
+      columnSection_ = section;
+      diverting_ = true;
+      scanner_.reset();
+    }
+  }
 
   void value(ElementPath path, ElementValue value) override {
     // All captured Open-Meteo values are numbers; ignore strings ("units"
@@ -64,153 +273,131 @@ class WeatherHandler : public JsonHandler {
     const double d = value.getDouble();
     const int depth = path.getCount();
     if (depth == 2) {
-      const char *section = path.getParent() != nullptr ? path.getParent()->getKey() : nullptr;
-      const char *field = path.getCurrent() != nullptr ? path.getCurrent()->getKey() : nullptr;
-      if (keyIs(section, "current")) {
-        storeCurrent(field, d);
+      Section section;
+      CurrentField field;
+      if (SECTION_KEYS.find(keyOf(path.getParent()), section) && section == Section::CURRENT &&
+          CURRENT_KEYS.find(keyOf(path.getCurrent()), field)) {
+        writer_.storeCurrent(field, d);
       }
     } else if (depth == 3) {
-      const char *section = path.get(-2) != nullptr ? path.get(-2)->getKey() : nullptr;
-      const char *field = path.getParent() != nullptr ? path.getParent()->getKey() : nullptr;
       const int idx = path.getCurrent() != nullptr ? path.getCurrent()->getIndex() : -1;
-      if (idx < 0) {
+      Section section;
+      if (idx < 0 || !SECTION_KEYS.find(keyOf(path.get(-2)), section)) {
         return;
       }
-      if (keyIs(section, "hourly")) {
-        storeHourly(field, static_cast<size_t>(idx), d);
-      } else if (keyIs(section, "daily")) {
-        storeDaily(field, static_cast<size_t>(idx), d);
+      const char *key = keyOf(path.getParent());
+      HourlyField hourly;
+      DailyField daily;
+      if (section == Section::HOURLY && HOURLY_KEYS.find(key, hourly)) {
+        writer_.storeHourly(hourly, static_cast<size_t>(idx), d);
+      } else if (section == Section::DAILY && DAILY_KEYS.find(key, daily)) {
+        writer_.storeDaily(daily, static_cast<size_t>(idx), d);
       }
     }
   }
 
  public:
-  bool sawStart() const { return sawStart_; }
-  bool finishedDocument() const { return documentDone_; }
-  bool isComplete() const { return sawCurrentTime_ && sawHourlyTime_ && sawDailyTime_; }
+  bool isComplete(OpenMeteoWeatherProvider::Sections sections) const { return writer_.isComplete(sections); }
+
+  // The bytes of a known column the parser just opened, up to its ']'.
+  size_t divert(const char *data, size_t len, bool &failed) override {
+    size_t used;
+    const column_scanner::ColumnScanner::Status status =
+        scanner_.scan(data, len, used, [this](size_t idx, double value) {
+          if (columnSection_ == Section::HOURLY) {
+            writer_.storeHourly(hourlyColumn_, idx, value);
+          } else {
+            writer_.storeDaily(dailyColumn_, idx, value);
+          }
+        });
+    diverting_ = status == column_scanner::ColumnScanner::Status::MORE;
+    if (status == column_scanner::ColumnScanner::Status::ERROR) {
+      LOG_WARNING("Open-Meteo JSON parse error: unexpected element in an hourly/daily array");
+      failed = true;
+    }
+    return used;
+  }
 
  private:
-  static bool keyIs(const char *str, const char *key) {
-    return str != nullptr && strcmp(str, key) == 0;
+  static const char *keyOf(ElementSelector *selector) {
+    return selector != nullptr ? selector->getKey() : nullptr;
   }
 
-  void storeCurrent(const char *field, double value) {
-    if (keyIs(field, "time")) {
-      forecast_.current.dt = static_cast<int64_t>(value);
-      sawCurrentTime_ = true;
-    } else if (keyIs(field, "temperature_2m")) {
-      forecast_.current.temp = static_cast<float>(value);
-    } else if (keyIs(field, "apparent_temperature")) {
-      forecast_.current.feels_like = static_cast<float>(value);
-    } else if (keyIs(field, "relative_humidity_2m")) {
-      forecast_.current.humidity = static_cast<int>(value);
-    } else if (keyIs(field, "dew_point_2m")) {
-      forecast_.current.dew_point = static_cast<float>(value);
-    } else if (keyIs(field, "weather_code")) {
-      forecast_.current.weather.condition = OpenMeteoWeatherProvider::mapWeatherCode(static_cast<int>(value));
-    } else if (keyIs(field, "cloud_cover")) {
-      forecast_.current.clouds = static_cast<int>(value);
-    } else if (keyIs(field, "visibility")) {
-      forecast_.current.visibility = static_cast<int>(value);
-    } else if (keyIs(field, "surface_pressure")) {
-      forecast_.current.pressure = static_cast<int>(value);
-    } else if (keyIs(field, "wind_speed_10m")) {
-      forecast_.current.wind_speed = static_cast<float>(value);
-    } else if (keyIs(field, "wind_direction_10m")) {
-      forecast_.current.wind_deg = static_cast<int>(value);
-    } else if (keyIs(field, "wind_gusts_10m")) {
-      forecast_.current.wind_gust = static_cast<float>(value);
-    } else if (keyIs(field, "is_day")) {
-      forecast_.current.is_day = value != 0.0;
+  ForecastWriter writer_;
+  column_scanner::ColumnScanner scanner_;
+  Section columnSection_ = Section::HOURLY;
+  HourlyField hourlyColumn_ = HourlyField::TIME;
+  DailyField dailyColumn_ = DailyField::TIME;
+};
+
+/* Comma separated API keys of `fields`, for the query string. */
+template <typename Field, size_t N, size_t M>
+static String queryList(const key_dispatch::Key<Field> (&keys)[N], const Field (&fields)[M]) {
+  String list;
+  for (Field field : fields) {
+    if (list.length() > 0) {
+      list += ',';
     }
+    list += keyName(keys, field);
   }
+  return list;
+}
 
-  void storeHourly(const char *field, size_t idx, double value) {
-    if (idx >= NUM_HOURLY) {
-      return;
-    }
-    if (keyIs(field, "time")) {
-      forecast_.hourly[idx].dt = static_cast<int64_t>(value);
-      if (idx == 0) {
-        sawHourlyTime_ = true;
-      }
-    } else if (keyIs(field, "temperature_2m")) {
-      forecast_.hourly[idx].temp = static_cast<float>(value);
-    } else if (keyIs(field, "cloud_cover")) {
-      forecast_.hourly[idx].clouds = static_cast<int>(value);
-    } else if (keyIs(field, "wind_speed_10m")) {
-      forecast_.hourly[idx].wind_speed = static_cast<float>(value);
-    } else if (keyIs(field, "wind_gusts_10m")) {
-      forecast_.hourly[idx].wind_gust = static_cast<float>(value);
-    } else if (keyIs(field, "precipitation_probability")) {
-      forecast_.hourly[idx].pop = static_cast<int>(value);
-    } else if (keyIs(field, "rain")) {
-      forecast_.hourly[idx].rain_1h = static_cast<float>(value);
-    } else if (keyIs(field, "snowfall")) {
-      forecast_.hourly[idx].snow_1h = static_cast<float>(value);
-    } else if (keyIs(field, "weather_code")) {
-      forecast_.hourly[idx].weather.condition = OpenMeteoWeatherProvider::mapWeatherCode(static_cast<int>(value));
-    } else if (keyIs(field, "is_day")) {
-      forecast_.hourly[idx].is_day = value != 0.0;
-    } else if (keyIs(field, "soil_temperature_18cm")) {
-      if (idx == 0) {
-        forecast_.current.soil_temperature_18cm = static_cast<float>(value);
-      }
+/* Store the `current` section of a FlatBuffers response: one value per
+ * variable, in CURRENT_QUERY order. */
+static void decodeCurrent(const flatbuffer::Table &table, ForecastWriter &writer) {
+  if (!table.valid()) {
+    return;
+  }
+  const open_meteo_fb::Series series(table);
+  writer.storeCurrent(CurrentField::TIME, static_cast<double>(series.time));
+  const uint32_t count = std::min<uint32_t>(series.variables.size(), sizeof(CURRENT_QUERY) / sizeof(CURRENT_QUERY[0]));
+  for (uint32_t v = 0; v < count; ++v) {
+    const float value = series.variables[v].scalar<float>(open_meteo_fb::variable::VALUE, NAN);
+    if (!std::isnan(value)) {
+      writer.storeCurrent(CURRENT_QUERY[v], value);
     }
   }
+}
 
-  void storeDaily(const char *field, size_t idx, double value) {
-    if (idx >= NUM_DAILY) {
-      return;
-    }
-    if (keyIs(field, "time")) {
-      forecast_.daily[idx].dt = static_cast<int64_t>(value);
-      if (idx == 0) {
-        sawDailyTime_ = true;
-      }
-    } else if (keyIs(field, "temperature_2m_max")) {
-      forecast_.daily[idx].temp.max = static_cast<float>(value);
-    } else if (keyIs(field, "temperature_2m_min")) {
-      forecast_.daily[idx].temp.min = static_cast<float>(value);
-    } else if (keyIs(field, "sunrise")) {
-      if (idx == 0) {
-        forecast_.current.sunrise = static_cast<int64_t>(value);
-      }
-      forecast_.daily[idx].sunrise = static_cast<int64_t>(value);
-    } else if (keyIs(field, "sunset")) {
-      if (idx == 0) {
-        forecast_.current.sunset = static_cast<int64_t>(value);
-      }
-      forecast_.daily[idx].sunset = static_cast<int64_t>(value);
-    } else if (keyIs(field, "uv_index_max")) {
-      if (idx == 0) {
-        forecast_.current.uvi = static_cast<float>(value);
+/* Store the `hourly` or `daily` section of a FlatBuffers response: one array
+ * per variable, in `query` order, step i at series.at(i). Floats are read
+ * from `values`, timestamps (sunrise, sunset) from `values_int64`. */
+template <typename Field, size_t N, typename Store>
+static void decodeSteps(const flatbuffer::Table &table, const Field (&query)[N], uint32_t maxSteps, Store store) {
+  if (!table.valid()) {
+    return;
+  }
+  const open_meteo_fb::Series series(table);
+  const uint32_t steps = std::min(series.steps(), maxSteps);
+  for (uint32_t i = 0; i < steps; ++i) {
+    store(Field::TIME, i, static_cast<double>(series.at(i)));
+  }
+  const uint32_t count = std::min<uint32_t>(series.variables.size(), N);
+  for (uint32_t v = 0; v < count; ++v) {
+    const flatbuffer::Table variable = series.variables[v];
+    const flatbuffer::Vector<float> values = variable.vector<float>(open_meteo_fb::variable::VALUES);
+    const flatbuffer::Vector<int64_t> times = variable.vector<int64_t>(open_meteo_fb::variable::VALUES_INT64);
+    for (uint32_t i = 0; i < std::min(values.size(), maxSteps); ++i) {
+      const float value = values[i];
+      if (!std::isnan(value)) {
+        store(query[v], i, value);
       }
-      forecast_.daily[idx].uvi = static_cast<float>(value);
-    } else if (keyIs(field, "rain_sum")) {
-      forecast_.daily[idx].rain = static_cast<float>(value);
-    } else if (keyIs(field, "snowfall_sum")) {
-      forecast_.daily[idx].snow = static_cast<float>(value);
-    } else if (keyIs(field, "precipitation_probability_max")) {
-      forecast_.daily[idx].pop = static_cast<int>(value);
-    } else if (keyIs(field, "wind_speed_10m_max")) {
-      forecast_.daily[idx].wind_speed = static_cast<float>(value);
-    } else if (keyIs(field, "wind_gusts_10m_max")) {
-      forecast_.daily[idx].wind_gust = static_cast<float>(value);
-    } else if (keyIs(field, "weather_code")) {
-      forecast_.daily[idx].weather.condition = OpenMeteoWeatherProvider::mapWeatherCode(static_cast<int>(value));
-    } else if (keyIs(field, "shortwave_radiation_sum")) {
-      forecast_.daily[idx].shortwave_radiation_sum = static_cast<float>(value);
+    }
+    for (uint32_t i = 0; i < std::min(times.size(), maxSteps); ++i) {
+      store(query[v], i, static_cast<double>(times[i]));
     }
   }
+}
 
-  forecast_t &forecast_;
-  bool sawStart_ = false;
-  bool documentDone_ = false;
-  bool sawCurrentTime_ = false;
-  bool sawHourlyTime_ = false;
-  bool sawDailyTime_ = false;
-};
+/* Clear the model and, when the hourly rows are decoded elsewhere, those
+ * rows: values a response does not carry can never survive. */
+static void resetModel(forecast_t &forecast, hourly_t *hourly, size_t hourlyRows) {
+  forecast.reset();
+  for (size_t i = 0; hourly != nullptr && i < hourlyRows; ++i) {
+    hourly[i] = hourly_t{};
+  }
+}
 
 const char *OpenMeteoWeatherProvider::getApiName() const {
   return "Open Meteo API";
@@ -272,85 +459,162 @@ weather_condition OpenMeteoWeatherProvider::mapWeatherCode(int id) {
   }
 }  // OpenMeteoWeatherProvider::mapWeatherCode
 
-/* Perform an HTTP GET request to Open-Meteo's forecast API and map the
- * response into the generic forecast model.
- */
-ProviderResult OpenMeteoWeatherProvider::fetch(forecast_t &forecast) {
+#if WEATHER_API_FORECAST_REFRESH_EVERY > 1
+// Hourly and daily sections of the last full request, see forecast_refresh.h.
+static RTC_DATA_ATTR forecast_refresh::Store forecastStore = {};
+#endif
+
+/* GET `uri` from Open-Meteo's forecast API and map the response, asked for
+ * `sections`, into the generic forecast model (its hourly rows into
+ * `hourly` when given, see deserializeCall). */
+static ProviderResult requestForecast(const String &uri, OpenMeteoWeatherProvider::Sections sections,
+                                      forecast_t &forecast, hourly_t *hourly, size_t hourlyRows,
+                                      const FetchCancel &cancel) {
 #if defined(WEATHER_API_TRANSPORT_HTTP)
   WiFiClient client;
   const uint16_t port = 80;
 #elif defined(WEATHER_API_TRANSPORT_HTTPS_NO_VERIFY)
-  WiFiClientSecure client;
+  TlsSessionClient client;
   client.setInsecure();
   const uint16_t port = 443;
 #else  // WEATHER_API_TRANSPORT_HTTPS_VERIFY
-  WiFiClientSecure client;
+  TlsSessionClient client;
   client.setCACert(cert_ISRG_Root_X1);
   const uint16_t port = 443;
 #endif
-  String uri =
-      "/v1/forecast?latitude=" + LAT + "&longitude=" + LON + "&" +
-      "current=temperature_2m,relative_humidity_2m,dew_point_2m,apparent_temperature,weather_code,cloud_cover,"
-      "visibility,surface_pressure,wind_speed_10m,wind_direction_10m,wind_gusts_10m,is_day&" +
-      "hourly=temperature_2m,cloud_cover,wind_speed_10m,wind_gusts_10m,precipitation_probability,rain,snowfall,weather_"
-      "code,is_day&" +
-      "daily=weather_code,temperature_2m_max,temperature_2m_min,sunrise,sunset,uv_index_max,rain_sum,snowfall_sum,"
-      "precipitation_probability_max,wind_speed_10m_max,wind_gusts_10m_max&" +
-      "wind_speed_unit=ms&timezone=auto&timeformat=unixtime&forecast_days=5&forecast_hours=" + HOURLY_GRAPH_MAX;
+
+#if defined(WEATHER_API_FORMAT_FLATBUFFERS)
+  // Ask for FlatBuffers first. A response that does not decode (an API
+  // change, a proxy rewriting it) falls back to the JSON request below at
+  // once: it is marked permanent, so it is not downloaded again first.
+  // Connection and HTTP errors do not fall back, JSON would fail alike.
+  const String fbUri = uri + "&format=flatbuffers";
+  bool undecodable = false;
+  ProviderResult result = httpGetWithRetry(
+      client, OM_ENDPOINT, port, fbUri, OM_ENDPOINT + fbUri, true, WEATHER_API_COMPRESSION, HTTP_CLIENT_TCP_TIMEOUT,
+      cancel, [&forecast, &undecodable, sections, hourly, hourlyRows](ResponseBody &body, size_t) {
+        ProviderResult decoded =
+            OpenMeteoWeatherProvider::deserializeFlatBuffers(body, forecast, sections, hourly, hourlyRows);
+        undecodable = !decoded.isOk();
+        if (undecodable) {
+          decoded.setPermanent();
+        }
+        return decoded;
+      });
+  if (result.isOk() || !undecodable) {
+    return result;
+  }
+  LOG_WARNING("Open-Meteo FlatBuffers response not decodable (%s), falling back to JSON", result.detail().c_str());
+#endif
 
   // This string is printed to terminal to help with debugging.
   String sanitizedUri = OM_ENDPOINT + uri;
 
-  return httpGetWithRetry(client, OM_ENDPOINT, port, uri, sanitizedUri, true, HTTP_CLIENT_TCP_TIMEOUT,
-                          [&forecast](Stream &json, size_t) { return deserializeCall(json, forecast); });
+  return httpGetWithRetry(client, OM_ENDPOINT, port, uri, sanitizedUri, true, WEATHER_API_COMPRESSION,
+                          HTTP_CLIENT_TCP_TIMEOUT, cancel,
+                          [&forecast, sections, hourly, hourlyRows](ResponseBody &json, size_t) {
+                            return OpenMeteoWeatherProvider::deserializeCall(json, forecast, sections, hourly,
+                                                                             hourlyRows);
+                          });
+}
+
+/* Perform an HTTP GET request to Open-Meteo's forecast API and map the
+ * response into the generic forecast model. With an incremental refresh
+ * configured, most wakes only ask for the current section and merge the
+ * hourly and daily sections kept from the last full request.
+ */
+ProviderResult OpenMeteoWeatherProvider::fetch(forecast_t &forecast, const FetchCancel &cancel) {
+#if WEATHER_API_FORECAST_REFRESH_EVERY > 1
+  forecast_refresh::ensureValid(forecastStore);
+  const Sections sections =
+      forecast_refresh::fullDue(forecastStore, time(nullptr), WEATHER_API_FORECAST_REFRESH_EVERY, HOURLY_GRAPH_MAX)
+          ? Sections::ALL
+          : Sections::CURRENT;
+  // The graph plus the hours that pass until the next full request; the
+  // rows are decoded into the store, so a failed request leaves none kept.
+  const int hourlyRows = static_cast<int>(forecast_refresh::KEEP_HOURLY);
+  hourly_t *hourly = nullptr;
+  if (sections == Sections::ALL) {
+    forecast_refresh::invalidate(forecastStore);
+    hourly = forecastStore.hourly;
+  }
+#else
+  const Sections sections = Sections::ALL;
+  const int hourlyRows = HOURLY_GRAPH_MAX;
+  hourly_t *hourly = nullptr;
+#endif
+  // Only the variables the configured display draws (open_meteo_query_plan.h)
+  // and only the hours and days it shows.
+  String uri = "/v1/forecast?latitude=" + LAT + "&longitude=" + LON + "&current=" +
+               queryList(CURRENT_LIST, CURRENT_QUERY);
+  if (sections == Sections::ALL) {
+    uri += "&hourly=" + queryList(HOURLY_LIST, HOURLY_QUERY) + "&daily=" + queryList(DAILY_LIST, DAILY_QUERY) +
+           "&forecast_days=" + String(NUM_DAILY) + "&forecast_hours=" + String(hourlyRows);
+  }
+  uri += "&wind_speed_unit=ms&timezone=auto&timeformat=unixtime";
+
+  ProviderResult result = requestForecast(uri, sections, forecast, hourly, hourlyRows, cancel);
+#if WEATHER_API_FORECAST_REFRESH_EVERY > 1
+  if (result.isOk() && sections == Sections::ALL) {
+    forecast_refresh::keep(forecastStore, forecast);
+  } else if (result.isOk()) {
+    forecast_refresh::merge(forecastStore, forecast);
+    LOG_DEBUG("Open-Meteo current conditions merged, %u of %d wakes since the full forecast",
+              static_cast<unsigned>(forecastStore.wakesSinceFull), WEATHER_API_FORECAST_REFRESH_EVERY);
+  }
+#endif
+  return result;
 }  // OpenMeteoWeatherProvider::fetch
 
 /* Map a streamed response of the Open-Meteo forecast API into the generic
- * forecast model directly as the bytes stream in. */
-ProviderResult OpenMeteoWeatherProvider::deserializeCall(Stream &json, forecast_t &forecast) {
+ * forecast model directly as the chunks stream in. */
+ProviderResult OpenMeteoWeatherProvider::deserializeCall(ResponseBody &json, forecast_t &forecast,
+                                                         Sections sections, hourly_t *hourly, size_t hourlyRows) {
   // The model is long-lived in the caller and shared with the previous fetch:
   // clear it first, so values a response does not carry can never survive.
   // Rejections reset it again, leaving the model clean after any non-Ok.
-  forecast.reset();
-  WeatherHandler handler(forecast);
-  ArduinoStreamParser parser;
-  parser.setHandler(&handler);
-  // Feed the parser byte by byte until the root document closes or an error
-  // is flagged. The Open-Meteo API never sends a Content-Length (HTTP/1.0
-  // responses are close-delimited), so there is no declared size to read up
-  // to. Reading one byte at a time never blocks waiting for a full buffer:
-  // readBytes() only waits for the next byte (or the socket timeout), and the
-  // loop exits the moment the document is complete, so there is no trailing
-  // read to stall on either.
-  uint8_t b;
-  while (!parser.hasParseError() && !handler.finishedDocument() && json.readBytes(&b, 1) > 0) {
-    parser.write(&b, 1);
+  resetModel(forecast, hourly, hourlyRows);
+  WeatherHandler handler(forecast, hourly, hourlyRows);
+  // Inside a known column the bytes go to the column scanner instead; its
+  // closing ']' is then written to the parser, which sees an empty array.
+  ProviderResult parsed = json_stream::parse(json, handler, "Open-Meteo");
+  if (parsed.isOk() && !handler.isComplete(sections)) {
+    LOG_WARNING("Open-Meteo response is no forecast: required time keys (current.time, hourly.time, daily.time) missing");
+    parsed = ProviderResult::error(String(TXT_DESERIALIZATION_ERROR_INVALID_INPUT) + " (missing current/hourly/daily time)");
   }
-  if (parser.hasParseError()) {
-    // Genuinely malformed JSON flagged by the parser. Trailing bytes after a
-    // completed document never reach this branch: the read loop above exits as
-    // soon as endDocument() fires, so anything following the JSON is simply not
-    // fed to the parser.
-    LOG_WARNING("Open-Meteo JSON parse error: %s", parser.getErrorMessage());
-    forecast.reset();
-    return ProviderResult::error(TXT_DESERIALIZATION_ERROR_INVALID_INPUT);
+  if (!parsed.isOk()) {
+    resetModel(forecast, hourly, hourlyRows);
   }
-  if (handler.finishedDocument()) {
-    if (!handler.isComplete()) {
-      LOG_WARNING("Open-Meteo response is no forecast: required time keys (current.time, hourly.time, daily.time) missing");
-      forecast.reset();
-      return ProviderResult::error(String(TXT_DESERIALIZATION_ERROR_INVALID_INPUT) + " (missing current/hourly/daily time)");
-    }
-    return ProviderResult::ok();
+  return parsed;
+}  // OpenMeteoWeatherProvider::deserializeCall
+
+/* Map a FlatBuffers response of the Open-Meteo forecast API into the
+ * generic forecast model, through the same writer as the JSON handler. The
+ * message is read whole, then its float arrays are read in place. */
+ProviderResult OpenMeteoWeatherProvider::deserializeFlatBuffers(ResponseBody &body, forecast_t &forecast,
+                                                                Sections sections, hourly_t *hourly,
+                                                                size_t hourlyRows) {
+  resetModel(forecast, hourly, hourlyRows);
+  open_meteo_fb::Message message;
+  const open_meteo_fb::ReadStatus status = message.read(body);
+  if (status != open_meteo_fb::ReadStatus::OK) {
+    LOG_WARNING("Open-Meteo FlatBuffers message unreadable (%u B read)", static_cast<unsigned>(message.size()));
+    return ProviderResult::error(open_meteo_fb::readError(status));
   }
-  forecast.reset();
-  // The body never closed the root document: empty responses and truncated
-  // bodies are both silent for this parser, so distinguish them by whether
-  // any parse event happened at all.
-  if (!handler.sawStart()) {
-    return ProviderResult::error(TXT_DESERIALIZATION_ERROR_EMPTY_INPUT);
+  const flatbuffer::Table root = message.root();
+  ForecastWriter writer(forecast, hourly, hourlyRows);
+  decodeCurrent(root.table(open_meteo_fb::response::CURRENT), writer);
+  decodeSteps(root.table(open_meteo_fb::response::HOURLY), HOURLY_QUERY, writer.hourlyRows(),
+              [&writer](HourlyField field, size_t idx, double value) { writer.storeHourly(field, idx, value); });
+  decodeSteps(root.table(open_meteo_fb::response::DAILY), DAILY_QUERY, NUM_DAILY,
+              [&writer](DailyField field, size_t idx, double value) { writer.storeDaily(field, idx, value); });
+  if (!writer.isComplete(sections)) {
+    LOG_WARNING("Open-Meteo FlatBuffers response is no forecast: current, hourly or daily section missing");
+    resetModel(forecast, hourly, hourlyRows);
+    return ProviderResult::error(String(TXT_DESERIALIZATION_ERROR_INVALID_INPUT) +
+                                 " (missing current/hourly/daily time)");
   }
-  return ProviderResult::error(TXT_DESERIALIZATION_ERROR_INCOMPLETE_INPUT);
-}  // OpenMeteoWeatherProvider::deserializeCall
+  return ProviderResult::ok();
+}  // OpenMeteoWeatherProvider::deserializeFlatBuffers
 
 #endif  // WEATHER_API_PROVIDER_OPEN_METEO
\ No newline at end of file
@@ -4,33 +4,93 @@
 #if defined(AIR_QUALITY_API_PROVIDER_OPEN_WEATHER_MAP)
 
 #include <Arduino.h>
-#include <ArduinoJson.h>
 #include <WiFiClient.h>
+#include <cstring>
 #if !defined(AIR_QUALITY_API_TRANSPORT_HTTP)
-#include <WiFiClientSecure.h>
+#include "tls_session_client.h"
 #endif
 #if defined(AIR_QUALITY_API_TRANSPORT_HTTPS_VERIFY)
 #include "cert.h"
 #endif
 #include <time.h>
 #include "_locale.h"
+#include "air_quality_window.h"
 #include "client_utils.h"
-#include "provider_result_utils.h"
+#include "json_stream.h"
 #include "owm_air_quality_provider.h"
 
+namespace {
+
+struct Component {
+  const char *key;
+  AirQualityWindow::Pollutant pollutant;
+};
+
+const Component COMPONENTS[] = {
+    {"co", AirQualityWindow::Pollutant::CO},     {"no", AirQualityWindow::Pollutant::NO},
+    {"no2", AirQualityWindow::Pollutant::NO2},   {"o3", AirQualityWindow::Pollutant::O3},
+    {"so2", AirQualityWindow::Pollutant::SO2},   {"pm2_5", AirQualityWindow::Pollutant::PM2_5},
+    {"pm10", AirQualityWindow::Pollutant::PM10}, {"nh3", AirQualityWindow::Pollutant::NH3},
+};
+
+/* SAX event handler: hands list[i].components.<key> and list[i].dt to the
+ * rolling window as the bytes stream in, instead of building a JsonDocument
+ * of the whole history first. OWM sends the components of a row before its
+ * dt, which the window allows for. */
+class AirPollutionHandler : public json_stream::DocumentHandler {
+ public:
+  explicit AirPollutionHandler(AirQualityWindow &window) : window_(window) {}
+
+  void value(ElementPath path, ElementValue value) override {
+    const int depth = path.getCount();
+    if (depth < 3 || depth > 4) {
+      return;
+    }
+    const char *section = path.get(0)->getKey();
+    const int row = path.get(1)->getIndex();
+    const char *field = path.getCurrent()->getKey();
+    if (section == nullptr || strcmp(section, "list") != 0 || row < 0 || field == nullptr) {
+      return;
+    }
+    const bool number = value.isInt() || value.isFloat();
+    if (depth == 3) {
+      if (strcmp(field, "dt") == 0 && number) {
+        window_.time(static_cast<size_t>(row), static_cast<int64_t>(value.getDouble()));
+      }
+      return;
+    }
+    const char *group = path.getParent()->getKey();
+    if (group == nullptr || strcmp(group, "components") != 0) {
+      return;
+    }
+    for (const Component &component : COMPONENTS) {
+      if (strcmp(field, component.key) == 0) {
+        const float concentration = number ? static_cast<float>(value.getDouble()) : 0.0f;
+        window_.value(component.pollutant, static_cast<size_t>(row), concentration);
+        return;
+      }
+    }
+  }
+
+ private:
+  AirQualityWindow &window_;
+};
+
+}  // namespace
+
 /* Perform an HTTP GET request to OpenWeatherMap's "Air Pollution" API and map
  * the response into the generic air quality model.
  */
-ProviderResult OWMAirQualityProvider::fetch(air_quality_t &airQuality) {
+ProviderResult OWMAirQualityProvider::fetch(air_quality_t &airQuality, const FetchCancel &cancel) {
 #if defined(AIR_QUALITY_API_TRANSPORT_HTTP)
   WiFiClient client;
   const uint16_t port = 80;
 #elif defined(AIR_QUALITY_API_TRANSPORT_HTTPS_NO_VERIFY)
-  WiFiClientSecure client;
+  TlsSessionClient client;
   client.setInsecure();
   const uint16_t port = 443;
 #else  // AIR_QUALITY_API_TRANSPORT_HTTPS_VERIFY
-  WiFiClientSecure client;
+  TlsSessionClient client;
   client.setCACert(cert_USERTrust_RSA_Certification_Authority);
   const uint16_t port = 443;
 #endif
@@ -46,46 +106,27 @@ ProviderResult OWMAirQualityProvider::fetch(air_quality_t &airQuality) {
   String sanitizedUri = OWM_ENDPOINT + "/data/2.5/air_pollution/history?lat=" + LAT + "&lon=" + LON +
                         "&start=" + startStr + "&end=" + endStr + "&appid={API key}";
 
-  return httpGetWithRetry(client, OWM_ENDPOINT, port, uri, sanitizedUri, false, HTTP_CLIENT_TCP_TIMEOUT,
-                          [&airQuality](Stream &json, size_t) { return deserializeAirQuality(json, airQuality); });
+  return httpGetWithRetry(client, OWM_ENDPOINT, port, uri, sanitizedUri, false, AIR_QUALITY_API_COMPRESSION,
+                          HTTP_CLIENT_TCP_TIMEOUT, cancel,
+                          [&airQuality](ResponseBody &json, size_t) {
+                            return deserializeAirQuality(json, airQuality);
+                          });
 }  // OWMAirQualityProvider::fetch
 
-ProviderResult OWMAirQualityProvider::deserializeAirQuality(Stream &json, air_quality_t &airQuality) {
-  int i = 0;
-
-  JsonDocument doc;
-
-  DeserializationError error = deserializeJson(doc, json);
-  LOG_DEBUG("doc.overflowed() : %s", doc.overflowed() ? "true" : "false");
-  if (LogLevel::TRACE >= g_logLevel) {
-    LOG_TRACE("pretty JSON dump:");
-    serializeJsonPretty(doc, Serial);
-    Serial.println();
-  }
-  if (error) {
-    return mapDeserializationError(error);
+/* Map the response into the NUM_AIR_POLLUTION hourly rows ending at the
+ * last one at or before now. The history request already spans just that
+ * many hours; the window also holds if OWM sends an extra row. The model is
+ * only written once the document closed. */
+ProviderResult OWMAirQualityProvider::deserializeAirQuality(ResponseBody &json, air_quality_t &airQuality) {
+  AirQualityWindow window(time(nullptr));
+  AirPollutionHandler handler(window);
+  const ProviderResult parsed = json_stream::parse(json, handler, "OWM air pollution");
+  if (!parsed.isOk()) {
+    return parsed;
   }
-
-  for (JsonObject list : doc["list"].as<JsonArray>()) {
-    JsonObject list_components = list["components"];
-    airQuality.components.co[i] = list_components["co"].as<float>();
-    airQuality.components.no[i] = list_components["no"].as<float>();
-    airQuality.components.no2[i] = list_components["no2"].as<float>();
-    airQuality.components.o3[i] = list_components["o3"].as<float>();
-    airQuality.components.so2[i] = list_components["so2"].as<float>();
-    airQuality.components.pm2_5[i] = list_components["pm2_5"].as<float>();
-    airQuality.components.pm10[i] = list_components["pm10"].as<float>();
-    airQuality.components.nh3[i] = list_components["nh3"].as<float>();
-
-    airQuality.dt[i] = list["dt"].as<int64_t>();
-
-    if (i == NUM_AIR_POLLUTION - 1) {
-      break;
-    }
-    ++i;
-  }
-
-  return mapDeserializationError(error);
+  const size_t rows = window.resolve(airQuality);
+  LOG_DEBUG("OWM air pollution: %u hourly rows up to now", static_cast<unsigned>(rows));
+  return ProviderResult::ok();
 }  // OWMAirQualityProvider::deserializeAirQuality
 
 #endif  // AIR_QUALITY_API_PROVIDER_OPEN_WEATHER_MAP
@@ -11,18 +11,323 @@
 #include "logger.h"
 
 #include <Arduino.h>
-#include <ArduinoJson.h>
+#include <cstring>
 #include <HTTPClient.h>
 #include <WiFiClient.h>
-#include <WiFiClientSecure.h>
+#include "tls_session_client.h"
 #include "cert.h"
 #include "_locale.h"
 #include "client_utils.h"
+#include "json_stream.h"
 #include "owm_provider.h"
-#include "provider_result_utils.h"
 
 #define OWM_NUM_ALERTS 8
 
+/* SAX event handler: maps the One Call response into the forecast model and
+ * the alerts vector as the bytes stream in, the way WeatherHandler does for
+ * Open-Meteo, instead of building a JsonDocument of the whole response
+ * first (tens of KB with 48 hourly and 8 daily entries).
+ *
+ * Keys are read from the ElementPath handed to each value() callback (the
+ * parser has no Key() event). The One Call layout by depth:
+ *   1  lat, lon, timezone, timezone_offset
+ *   2  current.<field>
+ *   3  current.rain.1h, hourly[i].<field>, daily[i].<field>, alerts[i].<field>
+ *   4  current.weather[0].<field>, hourly[i].rain.1h, daily[i].temp.<field>,
+ *      alerts[i].tags[0]
+ *   5  hourly[i].weather[0].<field>, daily[i].weather[0].<field>
+ * Everything else (minutely, moon phases, feels_like per day part, alert
+ * descriptions...) is consumed and discarded.
+ *
+ * Either output may be null: the alerts-only request carries no forecast,
+ * and alerts are only kept when OWM is the alerts provider. A forecast only
+ * counts once current.dt and the first hourly and daily dt were seen, so a
+ * valid JSON that lacks them is rejected instead of leaving a zeroed model.
+ */
+class OneCallHandler : public json_stream::DocumentHandler {
+ public:
+  OneCallHandler(forecast_t *forecast, std::vector<weather_alert_t> *alerts)
+      : forecast_(forecast), alerts_(alerts), alertsBase_(alerts != nullptr ? alerts->size() : 0) {}
+
+  void value(ElementPath path, ElementValue value) override {
+    const int depth = path.getCount();
+    const char *section = keyAt(path, -depth);
+    if (section == nullptr) {
+      return;
+    }
+    if (keyIs(section, "alerts")) {
+      storeAlert(path, value);
+      return;
+    }
+    if (forecast_ == nullptr) {
+      return;
+    }
+    if (value.isString()) {
+      storeString(path, value.getString());
+      return;
+    }
+    // getDouble() is exact here: the forked parser stores integers as 64-bit
+    // (unix timestamps fit well below 2^53).
+    if (!value.isInt() && !value.isFloat()) {
+      return;
+    }
+    const double d = value.getDouble();
+    if (depth == 1) {
+      storeRoot(section, d);
+    } else if (keyIs(section, "current")) {
+      if (depth == 2) {
+        storeCurrent(keyAt(path, -1), d);
+      } else if (depth == 3 && keyIs(keyAt(path, -1), "1h")) {
+        storeCurrent(keyAt(path, -2), d);  // rain.1h / snow.1h
+      } else if (depth == 4 && keyIs(keyAt(path, -3), "weather") && indexAt(path, -2) == 0 &&
+                 keyIs(keyAt(path, -1), "id")) {
+        forecast_->current.weather.condition = OWMProvider::mapWeatherCode(static_cast<int>(d));
+      }
+    } else if (keyIs(section, "hourly") || keyIs(section, "daily")) {
+      const bool hourly = section[0] == 'h';
+      const int idx = indexAt(path, 1 - depth);
+      if (idx < 0 || static_cast<size_t>(idx) >= (hourly ? NUM_HOURLY : NUM_DAILY)) {
+        return;
+      }
+      const char *field = keyAt(path, -1);
+      if (depth == 3 && hourly) {
+        storeHourly(forecast_->hourly[idx], field, d);
+        sawHourlyTime_ |= idx == 0 && keyIs(field, "dt");
+      } else if (depth == 3) {
+        storeDaily(forecast_->daily[idx], field, d);
+        sawDailyTime_ |= idx == 0 && keyIs(field, "dt");
+      } else if (depth == 4) {
+        const char *group = keyAt(path, -2);
+        if (hourly && keyIs(field, "1h")) {
+          storeHourly(forecast_->hourly[idx], group, d);  // rain.1h / snow.1h
+        } else if (!hourly && keyIs(group, "temp")) {
+          storeDailyTemp(forecast_->daily[idx].temp, field, d);
+        }
+      } else if (depth == 5 && keyIs(keyAt(path, -3), "weather") && indexAt(path, -2) == 0 && keyIs(field, "id")) {
+        weather_t &weather = hourly ? forecast_->hourly[idx].weather : forecast_->daily[idx].weather;
+        weather.condition = OWMProvider::mapWeatherCode(static_cast<int>(d));
+      }
+    }
+  }
+
+  bool isComplete() const { return forecast_ == nullptr || (sawCurrentTime_ && sawHourlyTime_ && sawDailyTime_); }
+
+ private:
+  static bool keyIs(const char *str, const char *key) { return str != nullptr && strcmp(str, key) == 0; }
+
+  // Key of the selector `fromEnd` places from the end of the path (-1 is the
+  // current one), null out of range. ElementPath::get() counts negative
+  // indices from the parent (-1 is the parent), so the position is turned
+  // into one from the root first.
+  static const char *keyAt(ElementPath &path, int fromEnd) {
+    ElementSelector *selector = path.get(path.getCount() + fromEnd);
+    return selector != nullptr ? selector->getKey() : nullptr;
+  }
+
+  static int indexAt(ElementPath &path, int fromEnd) {
+    ElementSelector *selector = path.get(path.getCount() + fromEnd);
+    return selector != nullptr ? selector->getIndex() : -1;
+  }
+
+  void storeString(ElementPath &path, const char *text) {
+    const int depth = path.getCount();
+    const char *section = keyAt(path, -depth);
+    if (depth == 1 && keyIs(section, "timezone")) {
+      forecast_->timezone = text;
+      return;
+    }
+    // weather[0].icon ends in 'd' by day and 'n' by night.
+    if (depth < 4 || !keyIs(keyAt(path, -1), "icon") || !keyIs(keyAt(path, -3), "weather") || indexAt(path, -2) != 0) {
+      return;
+    }
+    const size_t len = strlen(text);
+    const bool isDay = len > 0 && text[len - 1] == 'd';
+    if (depth == 4 && keyIs(section, "current")) {
+      forecast_->current.is_day = isDay;
+    } else if (depth == 5 && keyIs(section, "hourly")) {
+      const int idx = indexAt(path, -4);
+      if (idx >= 0 && idx < NUM_HOURLY) {
+        forecast_->hourly[idx].is_day = isDay;
+      }
+    }
+  }
+
+  void storeRoot(const char *field, double value) {
+    if (keyIs(field, "lat")) {
+      forecast_->lat = static_cast<float>(value);
+    } else if (keyIs(field, "lon")) {
+      forecast_->lon = static_cast<float>(value);
+    } else if (keyIs(field, "timezone_offset")) {
+      forecast_->timezone_offset = static_cast<int>(value);
+    }
+  }
+
+  void storeCurrent(const char *field, double value) {
+    current_t &current = forecast_->current;
+    if (keyIs(field, "dt")) {
+      current.dt = static_cast<int64_t>(value);
+      sawCurrentTime_ = true;
+    } else if (keyIs(field, "sunrise")) {
+      current.sunrise = static_cast<int64_t>(value);
+    } else if (keyIs(field, "sunset")) {
+      current.sunset = static_cast<int64_t>(value);
+    } else if (keyIs(field, "temp")) {
+      current.temp = static_cast<float>(value);
+    } else if (keyIs(field, "feels_like")) {
+      current.feels_like = static_cast<float>(value);
+    } else if (keyIs(field, "pressure")) {
+      current.pressure = static_cast<int>(value);
+    } else if (keyIs(field, "humidity")) {
+      current.humidity = static_cast<int>(value);
+    } else if (keyIs(field, "dew_point")) {
+      current.dew_point = static_cast<float>(value);
+    } else if (keyIs(field, "clouds")) {
+      current.clouds = static_cast<int>(value);
+    } else if (keyIs(field, "uvi")) {
+      current.uvi = static_cast<float>(value);
+    } else if (keyIs(field, "visibility")) {
+      current.visibility = static_cast<int>(value);
+    } else if (keyIs(field, "wind_speed")) {
+      current.wind_speed = static_cast<float>(value);
+    } else if (keyIs(field, "wind_gust")) {
+      current.wind_gust = static_cast<float>(value);
+    } else if (keyIs(field, "wind_deg")) {
+      current.wind_deg = static_cast<int>(value);
+    } else if (keyIs(field, "rain")) {
+      current.rain_1h = static_cast<float>(value);
+    } else if (keyIs(field, "snow")) {
+      current.snow_1h = static_cast<float>(value);
+    }
+  }
+
+  static void storeHourly(hourly_t &hourly, const char *field, double value) {
+    if (keyIs(field, "dt")) {
+      hourly.dt = static_cast<int64_t>(value);
+    } else if (keyIs(field, "temp")) {
+      hourly.temp = static_cast<float>(value);
+    } else if (keyIs(field, "feels_like")) {
+      hourly.feels_like = static_cast<float>(value);
+    } else if (keyIs(field, "pressure")) {
+      hourly.pressure = static_cast<int>(value);
+    } else if (keyIs(field, "humidity")) {
+      hourly.humidity = static_cast<int>(value);
+    } else if (keyIs(field, "dew_point")) {
+      hourly.dew_point = static_cast<float>(value);
+    } else if (keyIs(field, "clouds")) {
+      hourly.clouds = static_cast<int>(value);
+    } else if (keyIs(field, "uvi")) {
+      hourly.uvi = static_cast<float>(value);
+    } else if (keyIs(field, "visibility")) {
+      hourly.visibility = static_cast<int>(value);
+    } else if (keyIs(field, "wind_speed")) {
+      hourly.wind_speed = static_cast<float>(value);
+    } else if (keyIs(field, "wind_gust")) {
+      hourly.wind_gust = static_cast<float>(value);
+    } else if (keyIs(field, "wind_deg")) {
+      hourly.wind_deg = static_cast<int>(value);
+    } else if (keyIs(field, "pop")) {
+      hourly.pop = static_cast<int>(static_cast<float>(value) * 100);
+    } else if (keyIs(field, "rain")) {
+      hourly.rain_1h = static_cast<float>(value);
+    } else if (keyIs(field, "snow")) {
+      hourly.snow_1h = static_cast<float>(value);
+    }
+  }
+
+  static void storeDaily(daily_t &daily, const char *field, double value) {
+    if (keyIs(field, "dt")) {
+      daily.dt = static_cast<int64_t>(value);
+    } else if (keyIs(field, "sunrise")) {
+      daily.sunrise = static_cast<int64_t>(value);
+    } else if (keyIs(field, "sunset")) {
+      daily.sunset = static_cast<int64_t>(value);
+    } else if (keyIs(field, "pressure")) {
+      daily.pressure = static_cast<int>(value);
+    } else if (keyIs(field, "humidity")) {
+      daily.humidity = static_cast<int>(value);
+    } else if (keyIs(field, "dew_point")) {
+      daily.dew_point = static_cast<float>(value);
+    } else if (keyIs(field, "clouds")) {
+      daily.clouds = static_cast<int>(value);
+    } else if (keyIs(field, "uvi")) {
+      daily.uvi = static_cast<float>(value);
+    } else if (keyIs(field, "visibility")) {
+      daily.visibility = static_cast<int>(value);
+    } else if (keyIs(field, "wind_speed")) {
+      daily.wind_speed = static_cast<float>(value);
+    } else if (keyIs(field, "wind_gust")) {
+      daily.wind_gust = static_cast<float>(value);
+    } else if (keyIs(field, "wind_deg")) {
+      daily.wind_deg = static_cast<int>(value);
+    } else if (keyIs(field, "pop")) {
+      daily.pop = static_cast<int>(static_cast<float>(value) * 100);
+    } else if (keyIs(field, "rain")) {
+      daily.rain = static_cast<float>(value);
+    } else if (keyIs(field, "snow")) {
+      daily.snow = static_cast<float>(value);
+    }
+  }
+
+  static void storeDailyTemp(temperature_t &temp, const char *field, double value) {
+    const float t = static_cast<float>(value);
+    if (keyIs(field, "morn")) {
+      temp.morn = t;
+    } else if (keyIs(field, "day")) {
+      temp.day = t;
+    } else if (keyIs(field, "eve")) {
+      temp.eve = t;
+    } else if (keyIs(field, "night")) {
+      temp.night = t;
+    } else if (keyIs(field, "min")) {
+      temp.min = t;
+    } else if (keyIs(field, "max")) {
+      temp.max = t;
+    }
+  }
+
+  // alerts[i].event/start/end and alerts[i].tags[0], first OWM_NUM_ALERTS.
+  void storeAlert(ElementPath &path, ElementValue &value) {
+    const int depth = path.getCount();
+    const int idx = indexAt(path, 1 - depth);
+    if (alerts_ == nullptr || idx < 0 || idx >= OWM_NUM_ALERTS || depth < 3) {
+      return;
+    }
+    const size_t slot = alertsBase_ + static_cast<size_t>(idx);
+    if (alerts_->size() <= slot) {
+      alerts_->resize(slot + 1);
+    }
+    weather_alert_t &alert = (*alerts_)[slot];
+    const char *field = keyAt(path, 2 - depth);
+    if (depth == 3 && value.isString() && keyIs(field, "event")) {
+      alert.event = value.getString();
+    } else if (depth == 3 && (value.isInt() || value.isFloat()) && keyIs(field, "start")) {
+      alert.start = static_cast<int64_t>(value.getDouble());
+    } else if (depth == 3 && (value.isInt() || value.isFloat()) && keyIs(field, "end")) {
+      alert.end = static_cast<int64_t>(value.getDouble());
+    } else if (depth == 4 && value.isString() && keyIs(field, "tags") && indexAt(path, -1) == 0) {
+      alert.tags = value.getString();
+    }
+  }
+
+  forecast_t *forecast_;
+  std::vector<weather_alert_t> *alerts_;
+  size_t alertsBase_;
+  bool sawCurrentTime_ = false;
+  bool sawHourlyTime_ = false;
+  bool sawDailyTime_ = false;
+};
+
+/* Feed `json` to `handler` and reject a closed document that carries no
+ * forecast. */
+static ProviderResult parseOneCall(ResponseBody &json, OneCallHandler &handler) {
+  const ProviderResult parsed = json_stream::parse(json, handler, "One Call");
+  if (parsed.isOk() && !handler.isComplete()) {
+    LOG_WARNING("One Call response is no forecast: current.dt, hourly and daily missing");
+    return ProviderResult::error(String(TXT_DESERIALIZATION_ERROR_INVALID_INPUT) + " (missing current/hourly/daily)");
+  }
+  return parsed;
+}
+
 OWMProvider::OWMProvider() {
   fetchMutex_ = xSemaphoreCreateMutex();
 }
@@ -38,7 +343,8 @@ const char *OWMProvider::getApiName() const {
   return "One Call API";
 }
 
-ProviderResult OWMProvider::fetchInternal(forecast_t *forecast, std::vector<weather_alert_t> *alertsOut) {
+ProviderResult OWMProvider::fetchInternal(forecast_t *forecast, std::vector<weather_alert_t> *alertsOut,
+                                          const FetchCancel &cancel) {
   // Unified fetch: handles both full forecast and alerts-only via single method.
   // Chooses URI and deserializer based on what is requested.
   bool isAlertsOnly = (forecast == nullptr && alertsOut != nullptr);
@@ -53,11 +359,11 @@ ProviderResult OWMProvider::fetchInternal(forecast_t *forecast, std::vector<weat
     WiFiClient client;
     const uint16_t port = 80;
 #elif defined(ALERTS_API_TRANSPORT_HTTPS_NO_VERIFY)
-    WiFiClientSecure client;
+    TlsSessionClient client;
     client.setInsecure();
     const uint16_t port = 443;
 #else
-    WiFiClientSecure client;
+    TlsSessionClient client;
     client.setCACert(cert_USERTrust_RSA_Certification_Authority);
     const uint16_t port = 443;
 #endif
@@ -67,8 +373,8 @@ ProviderResult OWMProvider::fetchInternal(forecast_t *forecast, std::vector<weat
     uri += "&appid=" + OWM_APIKEY;
     std::vector<weather_alert_t> tmp;
     ProviderResult result = httpGetWithRetry(
-        client, OWM_ENDPOINT, port, uri, sanitizedUri, false, HTTP_CLIENT_TCP_TIMEOUT,
-        [&tmp](Stream &json, size_t) { return deserializeAlerts(json, tmp); });
+        client, OWM_ENDPOINT, port, uri, sanitizedUri, false, ALERTS_API_COMPRESSION, HTTP_CLIENT_TCP_TIMEOUT, cancel,
+        [&tmp](ResponseBody &json, size_t) { return deserializeAlerts(json, tmp); });
     if (result.isOk()) {
       *alertsOut = tmp;
       alerts_ = tmp;
@@ -88,11 +394,11 @@ ProviderResult OWMProvider::fetchInternal(forecast_t *forecast, std::vector<weat
   WiFiClient client;
   const uint16_t port = 80;
 #elif defined(WEATHER_API_TRANSPORT_HTTPS_NO_VERIFY)
-  WiFiClientSecure client;
+  TlsSessionClient client;
   client.setInsecure();
   const uint16_t port = 443;
 #else
-  WiFiClientSecure client;
+  TlsSessionClient client;
   client.setCACert(cert_USERTrust_RSA_Certification_Authority);
   const uint16_t port = 443;
 #endif
@@ -139,8 +445,8 @@ ProviderResult OWMProvider::fetchInternal(forecast_t *forecast, std::vector<weat
 #endif
 
   ProviderResult result = httpGetWithRetry(
-      client, OWM_ENDPOINT, port, uri, sanitizedUri, false, HTTP_CLIENT_TCP_TIMEOUT,
-      [fcPtr, alPtr](Stream &json, size_t) { return deserializeOneCall(json, *fcPtr, alPtr); });
+      client, OWM_ENDPOINT, port, uri, sanitizedUri, false, WEATHER_API_COMPRESSION, HTTP_CLIENT_TCP_TIMEOUT, cancel,
+      [fcPtr, alPtr](ResponseBody &json, size_t) { return deserializeOneCall(json, *fcPtr, alPtr); });
 
   if (result.isOk()) {
     if (forecast && fcPtr != forecast) {
@@ -163,7 +469,7 @@ ProviderResult OWMProvider::fetchInternal(forecast_t *forecast, std::vector<weat
   return result;
 }
 
-ProviderResult OWMProvider::fetch(forecast_t &forecast) {
+ProviderResult OWMProvider::fetch(forecast_t &forecast, const FetchCancel &cancel) {
   if (fetchMutex_) xSemaphoreTake(fetchMutex_, portMAX_DELAY);
   if (fetched_) {
     ProviderResult r = fetchStatus_;
@@ -173,12 +479,12 @@ ProviderResult OWMProvider::fetch(forecast_t &forecast) {
     if (fetchMutex_) xSemaphoreGive(fetchMutex_);
     return r;
   }
-  ProviderResult r = fetchInternal(&forecast, nullptr);
+  ProviderResult r = fetchInternal(&forecast, nullptr, cancel);
   if (fetchMutex_) xSemaphoreGive(fetchMutex_);
   return r;
 }
 
-ProviderResult OWMProvider::fetch(std::vector<weather_alert_t> &alerts) {
+ProviderResult OWMProvider::fetch(std::vector<weather_alert_t> &alerts, const FetchCancel &cancel) {
   if (fetchMutex_) xSemaphoreTake(fetchMutex_, portMAX_DELAY);
   if (fetched_) {
     ProviderResult r = fetchStatus_;
@@ -189,10 +495,9 @@ ProviderResult OWMProvider::fetch(std::vector<weather_alert_t> &alerts) {
       alerts.clear();
     }
     if (fetchMutex_) xSemaphoreGive(fetchMutex_);
-    if (r.isOk()) return ProviderResult::ok();
     return r;
   }
-  ProviderResult r = fetchInternal(nullptr, &alerts);
+  ProviderResult r = fetchInternal(nullptr, &alerts, cancel);
   if (!r.isOk()) {
     LOG_ERROR("Alerts API: %s", r.detail().c_str());
     alerts.clear();
@@ -292,167 +597,36 @@ weather_condition OWMProvider::mapWeatherCode(int id) {
   }
 }
 
-ProviderResult OWMProvider::deserializeOneCall(Stream &json, forecast_t &forecast, std::vector<weather_alert_t> *alerts) {
-  int i;
-  JsonDocument filter;
-  filter["current"] = true;
-  filter["minutely"] = false;
-  filter["hourly"] = true;
-  filter["daily"] = true;
+/* Map a streamed One Call response into the forecast model and, when
+ * `alerts` is given, the first OWM_NUM_ALERTS alerts. */
+ProviderResult OWMProvider::deserializeOneCall(ResponseBody &json, forecast_t &forecast,
+                                               std::vector<weather_alert_t> *alerts) {
+  // Fields a response does not carry read as zero, never as the values of a
+  // previous fetch; rejections reset the model again.
+  forecast.reset();
+  const size_t alertCount = alerts != nullptr ? alerts->size() : 0;
 #if !defined(ALERTS_API_PROVIDER_OPEN_WEATHER_MAP)
-  filter["alerts"] = false;
-#else
-  for (int i = 0; i < OWM_NUM_ALERTS; ++i) {
-    filter["alerts"][i]["sender_name"] = false;
-    filter["alerts"][i]["event"] = true;
-    filter["alerts"][i]["start"] = true;
-    filter["alerts"][i]["end"] = true;
-    filter["alerts"][i]["description"] = false;
-    filter["alerts"][i]["tags"] = true;
-  }
+  alerts = nullptr;
 #endif
-  JsonDocument doc;
-  DeserializationError error = deserializeJson(doc, json, DeserializationOption::Filter(filter));
-  LOG_DEBUG("doc.overflowed() : %s", doc.overflowed() ? "true" : "false");
-  if (LogLevel::TRACE >= g_logLevel) {
-    LOG_TRACE("pretty JSON dump:");
-    serializeJsonPretty(doc, Serial);
-    Serial.println();
-  }
-  if (error) {
-    return mapDeserializationError(error);
-  }
-
-  forecast.lat = doc["lat"].as<float>();
-  forecast.lon = doc["lon"].as<float>();
-  forecast.timezone = doc["timezone"].as<const char *>();
-  forecast.timezone_offset = doc["timezone_offset"].as<int>();
-
-  JsonObject current = doc["current"];
-  forecast.current.dt = current["dt"].as<int64_t>();
-  forecast.current.sunrise = current["sunrise"].as<int64_t>();
-  forecast.current.sunset = current["sunset"].as<int64_t>();
-  forecast.current.temp = current["temp"].as<float>();
-  forecast.current.feels_like = current["feels_like"].as<float>();
-  forecast.current.pressure = current["pressure"].as<int>();
-  forecast.current.humidity = current["humidity"].as<int>();
-  forecast.current.dew_point = current["dew_point"].as<float>();
-  forecast.current.clouds = current["clouds"].as<int>();
-  forecast.current.uvi = current["uvi"].as<float>();
-  forecast.current.visibility = current["visibility"].as<int>();
-  forecast.current.wind_speed = current["wind_speed"].as<float>();
-  forecast.current.wind_gust = current["wind_gust"].as<float>();
-  forecast.current.wind_deg = current["wind_deg"].as<int>();
-  forecast.current.rain_1h = current["rain"]["1h"].as<float>();
-  forecast.current.snow_1h = current["snow"]["1h"].as<float>();
-  JsonObject current_weather = current["weather"][0];
-  forecast.current.weather.condition = mapWeatherCode(current_weather["id"].as<int>());
-  forecast.current.is_day = current_weather["icon"].as<String>().endsWith("d");
-
-  i = 0;
-  for (JsonObject hourly : doc["hourly"].as<JsonArray>()) {
-    forecast.hourly[i].dt = hourly["dt"].as<int64_t>();
-    forecast.hourly[i].temp = hourly["temp"].as<float>();
-    forecast.hourly[i].feels_like = hourly["feels_like"].as<float>();
-    forecast.hourly[i].pressure = hourly["pressure"].as<int>();
-    forecast.hourly[i].humidity = hourly["humidity"].as<int>();
-    forecast.hourly[i].dew_point = hourly["dew_point"].as<float>();
-    forecast.hourly[i].clouds = hourly["clouds"].as<int>();
-    forecast.hourly[i].uvi = hourly["uvi"].as<float>();
-    forecast.hourly[i].visibility = hourly["visibility"].as<int>();
-    forecast.hourly[i].wind_speed = hourly["wind_speed"].as<float>();
-    forecast.hourly[i].wind_gust = hourly["wind_gust"].as<float>();
-    forecast.hourly[i].wind_deg = hourly["wind_deg"].as<int>();
-    forecast.hourly[i].pop = hourly["pop"].as<float>() * 100;
-    forecast.hourly[i].rain_1h = hourly["rain"]["1h"].as<float>();
-    forecast.hourly[i].snow_1h = hourly["snow"]["1h"].as<float>();
-    JsonObject hourly_weather = hourly["weather"][0];
-    forecast.hourly[i].weather.condition = mapWeatherCode(hourly_weather["id"].as<int>());
-    forecast.hourly[i].is_day = hourly_weather["icon"].as<String>().endsWith("d");
-    if (i == NUM_HOURLY - 1) break;
-    ++i;
-  }
-
-  i = 0;
-  for (JsonObject daily : doc["daily"].as<JsonArray>()) {
-    forecast.daily[i].dt = daily["dt"].as<int64_t>();
-    forecast.daily[i].sunrise = daily["sunrise"].as<int64_t>();
-    forecast.daily[i].sunset = daily["sunset"].as<int64_t>();
-    JsonObject daily_temp = daily["temp"];
-    forecast.daily[i].temp.morn = daily_temp["morn"].as<float>();
-    forecast.daily[i].temp.day = daily_temp["day"].as<float>();
-    forecast.daily[i].temp.eve = daily_temp["eve"].as<float>();
-    forecast.daily[i].temp.night = daily_temp["night"].as<float>();
-    forecast.daily[i].temp.min = daily_temp["min"].as<float>();
-    forecast.daily[i].temp.max = daily_temp["max"].as<float>();
-    forecast.daily[i].pressure = daily["pressure"].as<int>();
-    forecast.daily[i].humidity = daily["humidity"].as<int>();
-    forecast.daily[i].dew_point = daily["dew_point"].as<float>();
-    forecast.daily[i].clouds = daily["clouds"].as<int>();
-    forecast.daily[i].uvi = daily["uvi"].as<float>();
-    forecast.daily[i].visibility = daily["visibility"].as<int>();
-    forecast.daily[i].wind_speed = daily["wind_speed"].as<float>();
-    forecast.daily[i].wind_gust = daily["wind_gust"].as<float>();
-    forecast.daily[i].wind_deg = daily["wind_deg"].as<int>();
-    forecast.daily[i].pop = daily["pop"].as<float>() * 100;
-    forecast.daily[i].rain = daily["rain"].as<float>();
-    forecast.daily[i].snow = daily["snow"].as<float>();
-    JsonObject daily_weather = daily["weather"][0];
-    forecast.daily[i].weather.condition = mapWeatherCode(daily_weather["id"].as<int>());
-    if (i == NUM_DAILY - 1) break;
-    ++i;
-  }
-
-#if defined(ALERTS_API_PROVIDER_OPEN_WEATHER_MAP)
-  if (alerts != nullptr) {
-    i = 0;
-    for (JsonObject alert : doc["alerts"].as<JsonArray>()) {
-      weather_alert_t new_alert = {};
-      new_alert.event = alert["event"].as<const char *>();
-      new_alert.start = alert["start"].as<int64_t>();
-      new_alert.end = alert["end"].as<int64_t>();
-      new_alert.tags = alert["tags"][0].as<const char *>();
-      alerts->push_back(new_alert);
-      if (i == OWM_NUM_ALERTS - 1) break;
-      ++i;
+  OneCallHandler handler(&forecast, alerts);
+  ProviderResult result = parseOneCall(json, handler);
+  if (!result.isOk()) {
+    forecast.reset();
+    if (alerts != nullptr) {
+      alerts->resize(alertCount);
     }
   }
-#endif
-
-  return mapDeserializationError(error);
+  return result;
 }
 
-ProviderResult OWMProvider::deserializeAlerts(Stream &json, std::vector<weather_alert_t> &alerts) {
-  JsonDocument filter;
-  for (int i = 0; i < OWM_NUM_ALERTS; ++i) {
-    filter["alerts"][i]["sender_name"] = false;
-    filter["alerts"][i]["event"] = true;
-    filter["alerts"][i]["start"] = true;
-    filter["alerts"][i]["end"] = true;
-    filter["alerts"][i]["description"] = false;
-    filter["alerts"][i]["tags"] = true;
-  }
-  JsonDocument doc;
-  DeserializationError error = deserializeJson(doc, json, DeserializationOption::Filter(filter));
-  LOG_DEBUG("doc.overflowed() : %s", doc.overflowed() ? "true" : "false");
-  if (LogLevel::TRACE >= g_logLevel) {
-    LOG_TRACE("pretty JSON dump:");
-    serializeJsonPretty(doc, Serial);
-    Serial.println();
+/* Map a streamed alerts-only One Call response (exclude=current,minutely,
+ * hourly,daily) into the first OWM_NUM_ALERTS alerts. */
+ProviderResult OWMProvider::deserializeAlerts(ResponseBody &json, std::vector<weather_alert_t> &alerts) {
+  const size_t alertCount = alerts.size();
+  OneCallHandler handler(nullptr, &alerts);
+  ProviderResult result = parseOneCall(json, handler);
+  if (!result.isOk()) {
+    alerts.resize(alertCount);
   }
-  if (error) {
-    return mapDeserializationError(error);
-  }
-  int i = 0;
-  for (JsonObject alert : doc["alerts"].as<JsonArray>()) {
-    weather_alert_t new_alert = {};
-    new_alert.event = alert["event"].as<const char *>();
-    new_alert.start = alert["start"].as<int64_t>();
-    new_alert.end = alert["end"].as<int64_t>();
-    new_alert.tags = alert["tags"][0].as<const char *>();
-    alerts.push_back(new_alert);
-    if (i == OWM_NUM_ALERTS - 1) break;
-    ++i;
-  }
-  return mapDeserializationError(error);
+  return result;
 }
@@ -0,0 +1,120 @@
+/* Core split of a fetch: receive on the network core, parse on the other.
+ * Copyright (C) 2026  Lumixen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#include "parse_pipeline.h"
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+
+#include "fetch_executor.h"
+#include "logger.h"
+#include "spsc_ring.h"
+#include "stack_watermark.h"
+
+namespace {
+
+// How long either side sleeps on an empty (parser) or full (receiver) ring.
+constexpr uint32_t RING_POLL_MS = 1;
+
+/* The ring read as a response body by the parse task: each chunk is the
+ * contiguous unread span, released to the receiver on the next refill. */
+class RingBody : public ResponseBody {
+ public:
+  explicit RingBody(SpscRing &ring) : ring_(ring) {}
+
+ protected:
+  bool fill(const char *&data, size_t &len) override {
+    ring_.release(held_);
+    held_ = 0;
+    for (;;) {
+      if (ring_.peek(data, len)) {
+        held_ = len;
+        return true;
+      }
+      if (ring_.drained()) {
+        return false;
+      }
+      vTaskDelay(pdMS_TO_TICKS(RING_POLL_MS));
+    }
+  }
+
+ private:
+  SpscRing &ring_;
+  size_t held_ = 0;
+};
+
+struct ParseContext {
+  SpscRing *ring;
+  const std::function<ProviderResult(ResponseBody &)> *parse;
+  uint32_t stackBytes;
+  ProviderResult result;
+  SemaphoreHandle_t doneSem;
+};
+
+void parseTask(void *pvParameters) {
+  ParseContext *context = static_cast<ParseContext *>(pvParameters);
+  {
+    RingBody body(*context->ring);
+    context->result = (*context->parse)(body);
+  }
+  // Whatever the parser left unread is dropped by the receiver.
+  context->ring->abandon();
+  stackWatermarkRecord(StackSlot::PARSE, context->stackBytes);
+  // The context lives on the receiver's stack: not touched after this.
+  xSemaphoreGive(context->doneSem);
+  vTaskDelete(nullptr);
+}
+
+}  // namespace
+
+ProviderResult pipelinedParse(ResponseBody &source, const std::function<ProviderResult(ResponseBody &)> &parse) {
+  char *buffer = static_cast<char *>(malloc(PARSE_RING_BYTES));
+  SemaphoreHandle_t doneSem = buffer != nullptr ? xSemaphoreCreateBinary() : nullptr;
+  if (doneSem == nullptr) {
+    free(buffer);
+    LOG_WARNING("Parse pipeline: no memory, parsing inline");
+    return parse(source);
+  }
+  SpscRing ring(buffer, PARSE_RING_BYTES);
+  ParseContext context{&ring, &parse, stackSizeFor(StackSlot::PARSE, PARSE_STACK_BYTES), ProviderResult(), doneSem};
+  if (xTaskCreatePinnedToCore(parseTask, "BodyParser", context.stackBytes, &context, FETCH_TASK_PRIORITY, nullptr,
+                              PARSE_CORE) != pdPASS) {
+    vSemaphoreDelete(doneSem);
+    free(buffer);
+    LOG_WARNING("Parse pipeline: parse task creation failed, parsing inline");
+    return parse(source);
+  }
+
+  // Receive: every chunk goes into the ring, waiting for room while the
+  // parser is behind, until the body ends or the parser stopped reading.
+  uint32_t fullMs = 0;
+  const char *data = nullptr;
+  size_t len = 0;
+  while (!ring.abandoned() && source.next(data, len)) {
+    while (len > 0 && !ring.abandoned()) {
+      const size_t written = ring.write(data, len);
+      data += written;
+      len -= written;
+      if (written == 0) {
+        vTaskDelay(pdMS_TO_TICKS(RING_POLL_MS));
+        fullMs += RING_POLL_MS;
+      }
+    }
+  }
+  ring.close();
+  xSemaphoreTake(doneSem, portMAX_DELAY);
+  LOG_DEBUG("Parse pipeline: %u B received, ~%u ms waiting for the parser", static_cast<unsigned>(source.consumed()),
+            static_cast<unsigned>(fullMs));
+
+  vSemaphoreDelete(doneSem);
+  free(buffer);
+  return context.result;
+}
@@ -9,13 +9,24 @@
 
 #include "provider_fetch_operations.h"
 
+#include "config.h"
+#include "logger.h"
+
 std::vector<std::unique_ptr<FetchOperation>> createFetchOperations(
     WeatherProvider *weatherProvider, AirQualityProvider *airQualityProvider, AlertProvider *alertProvider,
     forecast_t &forecast, air_quality_t &airQuality, std::vector<weather_alert_t> &alerts) {
   std::vector<std::unique_ptr<FetchOperation>> ops;
-  // Alerts first so it goes first into the bounded pool (max 2)
+  // Alerts first: the schedule keeps this order between operations expected
+  // to take equally long, e.g. before any history was recorded.
   if (alertProvider) {
-    ops.push_back(std::make_unique<AlertFetchOperation>(alertProvider, alerts));
+#if defined(WEATHER_API_PROVIDER_OPEN_WEATHER_MAP) && defined(ALERTS_API_PROVIDER_OPEN_WEATHER_MAP)
+    // Piggyback: alerts come with the One Call forecast. Started next to it,
+    // the alerts operation would only hold a worker blocked on the provider.
+    const uint32_t dependsOn = fetchKindBit(FetchKind::WEATHER);
+#else
+    const uint32_t dependsOn = 0;
+#endif
+    ops.push_back(std::make_unique<AlertFetchOperation>(alertProvider, alerts, dependsOn));
   }
   if (weatherProvider) {
     ops.push_back(std::make_unique<WeatherFetchOperation>(weatherProvider, forecast));
@@ -25,3 +36,14 @@ std::vector<std::unique_ptr<FetchOperation>> createFetchOperations(
   }
   return ops;
 }
+
+void skipCachedFetchOperations(std::vector<std::unique_ptr<FetchOperation>> &ops) {
+  for (auto it = ops.begin(); it != ops.end();) {
+    if ((*it)->restoreFromCache()) {
+      LOG_INFO("%s: cached result still fresh, not fetched", (*it)->name());
+      it = ops.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
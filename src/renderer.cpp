@@ -15,29 +15,26 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <new>
+
 #include "_locale.h"
-#include "_strftime.h"
 #include "renderer.h"
 #include "config.h"
-#include "conversions.h"
 #include "data_models.h"
+#include "display_list.h"
 #include "display_utils.h"
+#include "line_breaker.h"
 #include "logger.h"
 #include "moon_tools.h"
+#include "wake_profiler.h"
 
 // fonts
 #include FONT_HEADER
+#include "font_metrics.h"
 
 // icon header files
-#include "icons/icons_16x16.h"
 #include "icons/icons_24x24.h"
 #include "icons/icons_32x32.h"
-#include "icons/icons_48x48.h"
-#include "icons/icons_64x64.h"
-#include "icons/icons_96x96.h"
-#include "icons/icons_128x128.h"
-#include "icons/icons_160x160.h"
-#include "icons/icons_196x196.h"
 
 #ifdef EPD_PANEL_GENERIC_BW_V2
 GxEPD2_BW<GxEPD2_750_T7, GxEPD2_750_T7::HEIGHT> display(GxEPD2_750_T7(PIN_EPD_CS, PIN_EPD_DC, PIN_EPD_RST,
@@ -59,11 +56,34 @@ GxEPD2_7C<GxEPD2_730c_GDEY073D46, GxEPD2_730c_GDEY073D46::HEIGHT / 4> display(
 GxEPD2_BW<GxEPD2_750, GxEPD2_750::HEIGHT> display(GxEPD2_750(PIN_EPD_CS, PIN_EPD_DC, PIN_EPD_RST, PIN_EPD_BUSY));
 #endif
 
+// The scene of this wake: the draw functions record into it once and
+// renderScene() replays it onto each page. Sized for the full layout, where a
+// 48 h outlook graph takes about 400 commands and the rest about 150. At about
+// 17 KB it lives on the heap only from beginScene() to the end of renderScene(),
+// so it does not compete with the fetches for memory.
+using SceneList = display_list::DisplayList<GFXfont, 640, 2048>;
+static SceneList *scene = nullptr;
+static uint32_t sceneStart = 0;
+
+// Build-time metrics of the fonts the scene is drawn with (font_metrics.h).
+static constexpr text_metrics::FontMetrics SCENE_FONTS[] = {
+    FONT_5pt8b_METRICS,  FONT_6pt8b_METRICS,  FONT_7pt8b_METRICS,  FONT_8pt8b_METRICS,
+    FONT_11pt8b_METRICS, FONT_12pt8b_METRICS, FONT_14pt8b_METRICS, FONT_16pt8b_METRICS,
+    FONT_26pt8b_METRICS, FONT_48pt8b_temperature_METRICS,
+};
+
+// BUSY wait time recorded so far, so the page passes can leave it out.
+static uint32_t displayBusyMs = 0;
+
 // Callback function for light sleep while epaper driver is busy.
 void beginLightSleep(const void *) {
   LOG_DEBUG("Entering light sleep at %ss", String(millis() / 1000.0, 1).c_str());
   Serial.flush();  // Ensure all serial output is sent before sleeping
+  const uint32_t busyStart = millis();
   esp_light_sleep_start();
+  const uint32_t busyMs = millis() - busyStart;
+  displayBusyMs += busyMs;
+  wakeProfilerRecord(WakePhase::DISPLAY_BUSY, WAKE_TAG_NONE, busyStart, busyMs);
   LOG_DEBUG("Woke up from light sleep at %ss", String(millis() / 1000.0, 1).c_str());
 }
 
@@ -72,7 +92,7 @@ void beginLightSleep(const void *) {
 uint16_t getStringWidth(const String &text) {
   int16_t x1, y1;
   uint16_t w, h;
-  display.getTextBounds(text, 0, 0, &x1, &y1, &w, &h);
+  scene->getTextBounds(text.c_str(), 0, 0, &x1, &y1, &w, &h);
   return w;
 }
 
@@ -81,31 +101,38 @@ uint16_t getStringWidth(const String &text) {
 uint16_t getStringHeight(const String &text) {
   int16_t x1, y1;
   uint16_t w, h;
-  display.getTextBounds(text, 0, 0, &x1, &y1, &w, &h);
+  scene->getTextBounds(text.c_str(), 0, 0, &x1, &y1, &w, &h);
   return h;
 }
 
-/* Draws a string with alignment
+/* Draws a string already measured with the current font with alignment.
+ * Returns the string width in pixels.
  */
-void drawString(int16_t x, int16_t y, const String &text, alignment_t alignment, uint16_t color) {
-  int16_t x1, y1;
-  uint16_t w, h;
-  display.setTextColor(color);
-  display.getTextBounds(text, x, y, &x1, &y1, &w, &h);
+static uint16_t drawMeasured(int16_t x, int16_t y, const char *text, const text_metrics::Extent &extent,
+                             alignment_t alignment, uint16_t color = GxEPD_BLACK) {
+  const uint16_t w = extent.width();
+  scene->setTextColor(color);
   if (alignment == RIGHT) {
     x = x - w;
   }
   if (alignment == CENTER) {
     x = x - w / 2;
   }
-  display.setCursor(x, y);
-  display.print(text);
-  return;
+  scene->setCursor(x, y);
+  scene->printMeasured(text, extent);
+  return w;
+}  // end drawMeasured
+
+/* Draws a string with alignment, measuring it once.
+ * Returns the string width in pixels.
+ */
+uint16_t drawString(int16_t x, int16_t y, const String &text, alignment_t alignment, uint16_t color) {
+  return drawMeasured(x, y, text.c_str(), scene->measureText(text.c_str()), alignment, color);
 }  // end drawString
 
 /* Draws a string that will flow into the next line when max_width is reached.
  * If a string exceeds max_lines an ellipsis (...) will terminate the last word.
- * Lines will break at spaces(' ') and dashes('-').
+ * Lines will break at spaces(' ') and dashes('-'), see line_breaker.h.
  *
  * Note: max_width should be big enough to accommodate the largest word that
  *       will be displayed. If an unbroken string of characters longer than
@@ -114,78 +141,15 @@ void drawString(int16_t x, int16_t y, const String &text, alignment_t alignment,
  */
 void drawMultiLnString(int16_t x, int16_t y, const String &text, alignment_t alignment, uint16_t max_width,
                        uint16_t max_lines, int16_t line_spacing, uint16_t color) {
-  uint16_t current_line = 0;
-  String textRemaining = text;
-  // print until we reach max_lines or no more text remains
-  while (current_line < max_lines && !textRemaining.isEmpty()) {
-    int16_t x1, y1;
-    uint16_t w, h;
-
-    display.getTextBounds(textRemaining, 0, 0, &x1, &y1, &w, &h);
-
-    int endIndex = textRemaining.length();
-    // check if remaining text is to wide, if it is then print what we can
-    String subStr = textRemaining;
-    int splitAt = 0;
-    int keepLastChar = 0;
-    while (w > max_width && splitAt != -1) {
-      if (keepLastChar) {
-        // if we kept the last character during the last iteration of this while
-        // loop, remove it now so we don't get stuck in an infinite loop.
-        subStr.remove(subStr.length() - 1);
-      }
-
-      // find the last place in the string that we can break it.
-      if (current_line < max_lines - 1) {
-        splitAt = std::max(subStr.lastIndexOf(" "), subStr.lastIndexOf("-"));
-      } else {
-        // this is the last line, only break at spaces so we can add ellipsis
-        splitAt = subStr.lastIndexOf(" ");
-      }
-
-      // if splitAt == -1 then there is an unbroken set of characters that is
-      // longer than max_width. Otherwise if splitAt != -1 then we can continue
-      // the loop until the string is <= max_width
-      if (splitAt != -1) {
-        endIndex = splitAt;
-        subStr = subStr.substring(0, endIndex + 1);
-
-        char lastChar = subStr.charAt(endIndex);
-        if (lastChar == ' ') {
-          // remove this char now so it is not counted towards line width
-          keepLastChar = 0;
-          subStr.remove(endIndex);
-          --endIndex;
-        } else if (lastChar == '-') {
-          // this char will be printed on this line and removed next iteration
-          keepLastChar = 1;
-        }
-
-        if (current_line < max_lines - 1) {
-          // this is not the last line
-          display.getTextBounds(subStr, 0, 0, &x1, &y1, &w, &h);
-        } else {
-          // this is the last line, we need to make sure there is space for
-          // ellipsis
-          display.getTextBounds(subStr + "...", 0, 0, &x1, &y1, &w, &h);
-          if (w <= max_width) {
-            // ellipsis fit, add them to subStr
-            subStr = subStr + "...";
-          }
-        }
-
-      }  // end if (splitAt != -1)
-    }  // end inner while
-
-    drawString(x, y + (current_line * line_spacing), subStr, alignment, color);
-
-    // update textRemaining to no longer include what was printed
-    // +1 for exclusive bounds, +1 to get passed space/dash
-    textRemaining = textRemaining.substring(endIndex + 2 - keepLastChar);
-
-    ++current_line;
-  }  // end outer while
-
+  const char *chars = text.c_str();
+  line_breaker::breakLines(
+      chars, max_width, max_lines, [](uint8_t c) { return scene->glyphMetrics(c); },
+      [&](const line_breaker::Line &line, uint16_t current_line) {
+        char lineText[line_breaker::MAX_TEXT + sizeof(line_breaker::ELLIPSIS)];
+        memcpy(lineText, chars + line.start, line.length);
+        strcpy(lineText + line.length, line.ellipsis ? line_breaker::ELLIPSIS : "");
+        drawMeasured(x, y + (current_line * line_spacing), lineText, scene->measureText(lineText), alignment, color);
+      });
   return;
 }  // end drawMultiLnString
 
@@ -243,1258 +207,368 @@ void powerOffDisplay() {
   return;
 }  // end initDisplay
 
-/* These functions are responsible for drawing the current conditions and
- * associated icons on the left panel.
+/* Start recording the scene. The draw functions called until renderScene()
+ * are recorded, not drawn. Returns false, and nothing may be drawn, if the
+ * scene could not be allocated.
  */
-
-// drawCurrentSunrise
-#ifdef POS_SUNRISE
-void drawCurrentSunrise(const current_t &current) {
-  String dataStr, unitStr;
-  int PosX = POS_SUNRISE % 2;
-  int PosY = static_cast<int>(POS_SUNRISE / 2);
-  // icons
-  display.drawInvertedBitmap(162 * PosX, 204 + (48 + 8) * PosY, wi_sunrise_48x48, 48, 48, GxEPD_BLACK);
-
-  // labels
-  display.setFont(&FONT_7pt8b);
-  drawString(48 + (162 * PosX), 204 + 10 + (48 + 8) * PosY, TXT_SUNRISE, LEFT);
-
-  // sunrise
-  display.setFont(&FONT_12pt8b);
-  char timeBuffer[12] = {};  // big enough to accommodate "hh:mm:ss am"
-  time_t ts = current.sunrise;
-  tm *timeInfo = localtime(&ts);
-  _strftime(timeBuffer, sizeof(timeBuffer), TIME_FORMAT, timeInfo);
-  drawString(48 + (162 * PosX), 204 + 17 / 2 + (48 + 8) * PosY + 48 / 2, timeBuffer, LEFT);
-
-  return;
-}
-#endif
-// end drawCurrentSunrise
-
-// drawCurrentWind
-#ifdef POS_WIND
-void drawCurrentWind(const current_t &current) {
-  String dataStr, unitStr;
-  int PosX = (POS_WIND % 2);
-  int PosY = static_cast<int>(POS_WIND / 2);
-
-  // icons
-  display.drawInvertedBitmap(162 * PosX, 204 + (48 + 8) * PosY, wi_strong_wind_48x48, 48, 48, GxEPD_BLACK);
-
-  // labels
-  display.setFont(&FONT_7pt8b);
-  drawString(48 + (162 * PosX), 204 + 10 + (48 + 8) * PosY, TXT_WIND, LEFT);
-
-  // wind
-  display.setFont(&FONT_12pt8b);
-#ifdef WIND_DIRECTION_INDICATOR_ARROW
-  display.drawInvertedBitmap(48 + (162 * PosX), 204 + 24 / 2 + (48 + 8) * PosY, getWindBitmap24(current.wind_deg), 24,
-                             24, GxEPD_BLACK);
-#endif
-#ifdef UNITS_SPEED_METERSPERSECOND
-  dataStr = String(static_cast<int>(std::round(current.wind_speed)));
-  unitStr = String(" ") + TXT_UNITS_SPEED_METERSPERSECOND;
-#endif
-#ifdef UNITS_SPEED_FEETPERSECOND
-  dataStr = String(static_cast<int>(std::round(meterspersecond_to_feetpersecond(current.wind_speed))));
-  unitStr = String(" ") + TXT_UNITS_SPEED_FEETPERSECOND;
-#endif
-#ifdef UNITS_SPEED_KILOMETERSPERHOUR
-  dataStr = String(static_cast<int>(std::round(meterspersecond_to_kilometersperhour(current.wind_speed))));
-  unitStr = String(" ") + TXT_UNITS_SPEED_KILOMETERSPERHOUR;
-#endif
-#ifdef UNITS_SPEED_MILESPERHOUR
-  dataStr = String(static_cast<int>(std::round(meterspersecond_to_milesperhour(current.wind_speed))));
-  unitStr = String(" ") + TXT_UNITS_SPEED_MILESPERHOUR;
-#endif
-#ifdef UNITS_SPEED_KNOTS
-  dataStr = String(static_cast<int>(std::round(meterspersecond_to_knots(current.wind_speed))));
-  unitStr = String(" ") + TXT_UNITS_SPEED_KNOTS;
-#endif
-#ifdef UNITS_SPEED_BEAUFORT
-  dataStr = String(meterspersecond_to_beaufort(current.wind_speed));
-  unitStr = String(" ") + TXT_UNITS_SPEED_BEAUFORT;
-#endif
-
-#ifdef WIND_DIRECTION_INDICATOR_ARROW
-  drawString((48 + 24) + (162 * PosX), 204 + 17 / 2 + (48 + 8) * PosY + 48 / 2, dataStr, LEFT);
-#else
-  drawString(48 + (162 * PosX), 204 + 17 / 2 + (48 + 8) * PosY + 48 / 2, dataStr, LEFT);
-#endif
-  display.setFont(&FONT_8pt8b);
-  drawString(display.getCursorX(), 204 + 17 / 2 + (48 + 8) * PosY + 48 / 2, unitStr, LEFT);
-
-#if defined(WIND_DIRECTION_INDICATOR_NUMBER)
-  dataStr = String(current.wind_deg) + "\260";
-  display.setFont(&FONT_12pt8b);
-  drawString(display.getCursorX() + 6, 204 + 17 / 2 + (48 + 8) * PosY + 48 / 2, dataStr, LEFT);
-#endif
-#if defined(WIND_DIRECTION_INDICATOR_CARDINAL) || defined(WIND_DIRECTION_INDICATOR_INTERCARDINAL) || \
-    defined(WIND_DIRECTION_INDICATOR_SECONDARY_INTERCARDINAL) || \
-    defined(WIND_DIRECTION_INDICATOR_TERTIARY_INTERCARDINAL)
-  dataStr = getCompassPointNotation(current.wind_deg);
-  display.setFont(&FONT_12pt8b);
-  drawString(display.getCursorX() + 6, 204 + 17 / 2 + (48 + 8) * PosY + 48 / 2, dataStr, LEFT);
-#endif
-
-  return;
-}
-#endif
-// end drawCurrentWind
-
-// drawCurrentUVI
-#ifdef POS_UVI
-void drawCurrentUVI(const current_t &current) {
-  String dataStr, unitStr;
-  int PosX = (POS_UVI % 2);
-  int PosY = static_cast<int>(POS_UVI / 2);
-
-  // icons
-  display.drawInvertedBitmap(162 * PosX, 204 + (48 + 8) * PosY, wi_day_sunny_48x48, 48, 48, GxEPD_BLACK);
-
-  // labels
-  display.setFont(&FONT_7pt8b);
-  drawString(48 + (162 * PosX), 204 + 10 + (48 + 8) * PosY, TXT_UV_INDEX, LEFT);
-
-  // spacing between end of index value and start of descriptor text
-  const int sp = 8;
-
-  // uv index
-  display.setFont(&FONT_12pt8b);
-  unsigned int uvi = static_cast<unsigned int>(std::max(std::round(current.uvi), 0.0f));
-  dataStr = String(uvi);
-  drawString(48 + (162 * PosX), 204 + 17 / 2 + (48 + 8) * PosY + 48 / 2, dataStr, LEFT);
-  display.setFont(&FONT_7pt8b);
-  dataStr = String(getUVIdesc(uvi));
-  int max_w = (162 + (PosX * 162) - sp) - (display.getCursorX() + sp);
-  if (getStringWidth(dataStr) <= max_w) {  // Fits on a single line, draw along bottom
-    drawString(display.getCursorX() + sp, 204 + 17 / 2 + (48 + 8) * PosY + 48 / 2, dataStr, LEFT);
-  } else {  // use smaller font
-    display.setFont(&FONT_5pt8b);
-    if (getStringWidth(dataStr) <= max_w) {  // Fits on a single line with smaller font, draw along bottom
-      drawString(display.getCursorX() + sp, 204 + 17 / 2 + (48 + 8) * PosY + 48 / 2, dataStr, LEFT);
-    } else {  // Does not fit on a single line, draw higher to allow room for 2nd line
-      drawMultiLnString(display.getCursorX() + sp, 204 + 17 / 2 + (48 + 8) * PosY + 48 / 2 - 10, dataStr, LEFT, max_w,
-                        2, 10);
-    }
+bool beginScene() {
+  sceneStart = millis();
+  delete scene;
+  scene = new (std::nothrow) SceneList();
+  if (scene == nullptr) {
+    LOG_ERROR("Not enough memory for the display list (%u bytes)", static_cast<unsigned>(sizeof(SceneList)));
+    return false;
+  }
+  scene->setMetrics(SCENE_FONTS, sizeof(SCENE_FONTS) / sizeof(SCENE_FONTS[0]));
+  return true;
+}  // end beginScene
+
+/* Draw the recorded scene onto the display, page by page. Each page replays
+ * only the commands that intersect its band of rows. A scene that overflowed
+ * the display list is not drawn at all, the display keeps its last image and
+ * false is returned. The scene is freed either way.
+ */
+bool renderScene() {
+  const uint32_t recordMs = millis() - sceneStart;
+  wakeProfilerRecord(WakePhase::DISPLAY_RECORD, WAKE_TAG_NONE, sceneStart, recordMs);
+  LOG_DEBUG("Recorded %u draw commands, %u text bytes in %u ms", static_cast<unsigned>(scene->size()),
+            static_cast<unsigned>(scene->textBytes()), static_cast<unsigned>(recordMs));
+  LOG_DEBUG("Measured %u strings, %u characters", static_cast<unsigned>(scene->measureCalls()),
+            static_cast<unsigned>(scene->measuredChars()));
+  if (scene->overflowed()) {
+    LOG_ERROR("Display list full, scene not drawn");
+    delete scene;
+    scene = nullptr;
+    return false;
   }
-  return;
-}
-#endif
-// end drawCurrentUVI
 
-// drawCurrentAirQuality
-#ifdef POS_AIR_QUALITY
-void drawCurrentAirQuality(const air_quality_t &air_quality) {
-  String dataStr, unitStr;
-  int PosX = (POS_AIR_QUALITY % 2);
-  int PosY = static_cast<int>(POS_AIR_QUALITY / 2);
+  const int16_t pageHeight = display.pageHeight();
+  uint8_t page = 0;
+  bool morePages;
+  do {
+    const uint32_t pageStart = millis();
+    const int16_t top = page * pageHeight;
+    const size_t replayed = scene->replay(display, top, top + pageHeight);
+    const uint32_t replayMs = millis() - pageStart;
+    wakeProfilerRecord(WakePhase::DISPLAY_REPLAY, page, pageStart, replayMs);
+    LOG_DEBUG("Page %u: replayed %u of %u draw commands in %u ms", page, static_cast<unsigned>(replayed),
+              static_cast<unsigned>(scene->size()), static_cast<unsigned>(replayMs));
+    // nextPage() transfers the page buffer and, after the last page, also
+    // runs the refresh. Its BUSY waits are recorded as DISPLAY_BUSY and left
+    // out here, so the replay, transfer and BUSY phases do not overlap.
+    const uint32_t transferStart = millis();
+    const uint32_t busyBefore = displayBusyMs;
+    morePages = display.nextPage();
+    const uint32_t transferMs = millis() - transferStart;
+    const uint32_t busyMs = displayBusyMs - busyBefore;
+    wakeProfilerRecord(WakePhase::DISPLAY_PAGE, page++, transferStart, transferMs > busyMs ? transferMs - busyMs : 0);
+  } while (morePages);
+  delete scene;
+  scene = nullptr;
+  return true;
+}  // end renderScene
+
+/* This function is responsible for drawing one cell of the current conditions
+ * on the left panel: the icon, the label and the value line. A descriptor (UV
+ * index, air quality, moon phase) follows the value and is shrunk or wrapped to
+ * fit the cell.
+ */
+void drawConditionCell(const condition_cell_view_t &cell) {
+  const int x = 162 * (cell.pos % 2);
+  const int y = 204 + (48 + 8) * (cell.pos / 2);
+  const int valueY = y + 17 / 2 + 48 / 2;
 
   // icons
-  display.drawInvertedBitmap(162 * PosX, 204 + (48 + 8) * PosY, air_filter_48x48, 48, 48, GxEPD_BLACK);
+  scene->drawInvertedBitmap(x, y, cell.icon, 48, 48, GxEPD_BLACK);
+  if (cell.badge != nullptr) {
+    scene->drawInvertedBitmap(x + 48 - 24, y + 4, cell.badge, 24, 24, GxEPD_BLACK);
+  }
 
   // labels
-  display.setFont(&FONT_7pt8b);
-
-  const char *air_quality_index_label;
-  if (aqi_desc_type(AQI_SCALE) == AIR_QUALITY_DESC) {
-    air_quality_index_label = TXT_AIR_QUALITY;
-  } else  // (aqi_desc_type(AQI_SCALE) == AIR_POLLUTION_DESC)
-  {
-    air_quality_index_label = TXT_AIR_POLLUTION;
+  scene->setFont(&FONT_7pt8b);
+  drawString(x + 48, y + 10, cell.label, LEFT);
+
+  // value, unit and suffix
+  int valueX = x + 48;
+  if (cell.arrow != nullptr) {
+    scene->drawInvertedBitmap(valueX, y + 24 / 2, cell.arrow, 24, 24, GxEPD_BLACK);
+    valueX += 24;
+  }
+  if (cell.value[0] != '\0') {
+    scene->setFont(&FONT_12pt8b);
+    drawString(valueX, valueY, cell.value, LEFT);
+  }
+  if (cell.unit[0] != '\0') {
+    scene->setFont(&FONT_8pt8b);
+    drawString(scene->getCursorX(), valueY, cell.unit, LEFT);
+  }
+  if (cell.suffix[0] != '\0') {
+    scene->setFont(&FONT_12pt8b);
+    drawString(scene->getCursorX() + 6, valueY, cell.suffix, LEFT);
   }
-  drawString(48 + (162 * PosX), 204 + 10 + (48 + 8) * PosY, air_quality_index_label, LEFT);
 
+  if (cell.desc == nullptr) {
+    return;
+  }
   // spacing between end of index value and start of descriptor text
   const int sp = 8;
-
-  // air quality index
-  display.setFont(&FONT_12pt8b);
-  const air_quality_components_t &c = air_quality.components;
-  // OpenWeatherMap does not provide pb (lead) conentrations, so we pass NULL.
-  int aqi = calc_aqi(AQI_SCALE, c.co, c.nh3, c.no, c.no2, c.o3, NULL, c.so2, c.pm10, c.pm2_5);
-  int aqi_max = aqi_scale_max(AQI_SCALE);
-  if (aqi > aqi_max) {
-    dataStr = "> " + String(aqi_max);
-  } else {
-    dataStr = String(aqi);
-  }
-  drawString(48 + (162 * PosX), 204 + 17 / 2 + (48 + 8) * PosY + 48 / 2, dataStr, LEFT);
-  display.setFont(&FONT_7pt8b);
-  dataStr = String(aqi_desc(AQI_SCALE, aqi));
-  int max_w = (162 + (PosX * 162) - sp) - (display.getCursorX() + sp);
-  if (getStringWidth(dataStr) <= max_w) {  // Fits on a single line, draw along bottom
-    drawString(display.getCursorX() + sp, 204 + 17 / 2 + (48 + 8) * PosY + 48 / 2, dataStr, LEFT);
+  const int descX = cell.value[0] != '\0' ? scene->getCursorX() + sp : x + 48;
+  const int max_w = (x + 162 - sp) - descX;
+  scene->setFont(&FONT_7pt8b);
+  text_metrics::Extent extent = scene->measureText(cell.desc);
+  if (extent.width() <= max_w) {  // Fits on a single line, draw along bottom
+    drawMeasured(descX, valueY, cell.desc, extent, LEFT);
   } else {  // use smaller font
-    display.setFont(&FONT_5pt8b);
-    if (getStringWidth(dataStr) <= max_w) {  // Fits on a single line with smaller font, draw along bottom
-      drawString(display.getCursorX() + sp, 204 + 17 / 2 + (48 + 8) * PosY + 48 / 2, dataStr, LEFT);
+    scene->setFont(&FONT_5pt8b);
+    extent = scene->measureText(cell.desc);
+    if (extent.width() <= max_w) {  // Fits on a single line with smaller font, draw along bottom
+      drawMeasured(descX, valueY, cell.desc, extent, LEFT);
     } else {  // Does not fit on a single line, draw higher to allow room for 2nd line
-      drawMultiLnString(display.getCursorX() + sp, 204 + 17 / 2 + (48 + 8) * PosY + 48 / 2 - 10, dataStr, LEFT, max_w,
-                        2, 10);
+      drawMultiLnString(descX, valueY - 10, cell.desc, LEFT, max_w, 2, 10);
     }
   }
-
-  return;
-}
-#endif
-// end drawCurrentAirQuality
-
-// drawCurrentSunset
-#ifdef POS_SUNSET
-void drawCurrentSunset(const current_t &current) {
-  String dataStr, unitStr;
-  int PosX = (POS_SUNSET % 2);
-  int PosY = static_cast<int>(POS_SUNSET / 2);
-  // icons
-  display.drawInvertedBitmap(162 * PosX, 204 + (48 + 8) * PosY, wi_sunset_48x48, 48, 48, GxEPD_BLACK);
-
-  // labels
-  display.setFont(&FONT_7pt8b);
-  drawString(48 + (162 * PosX), 204 + 10 + (48 + 8) * PosY, TXT_SUNSET, LEFT);
-
-  // sunset
-  display.setFont(&FONT_12pt8b);
-  char timeBuffer[12] = {};  // big enough to accommodate "hh:mm:ss am"
-  time_t ts = current.sunset;
-  tm *timeInfo = localtime(&ts);
-  _strftime(timeBuffer, sizeof(timeBuffer), TIME_FORMAT, timeInfo);
-  drawString(48 + (162 * PosX), 204 + 17 / 2 + (48 + 8) * PosY + 48 / 2, timeBuffer, LEFT);
-
   return;
-}
-#endif
-// end drawCurrentSunset
-
-// drawCurrentHumidity
-#ifdef POS_HUMIDITY
-void drawCurrentHumidity(const current_t &current) {
-  String dataStr, unitStr;
-  int PosX = (POS_HUMIDITY % 2);
-  int PosY = static_cast<int>(POS_HUMIDITY / 2);
+}  // end drawConditionCell
 
-  // icons
-  display.drawInvertedBitmap(162 * PosX, 204 + (48 + 8) * PosY, wi_humidity_48x48, 48, 48, GxEPD_BLACK);
-
-  // labels
-  display.setFont(&FONT_7pt8b);
-  drawString(48 + (162 * PosX), 204 + 10 + (48 + 8) * PosY, TXT_HUMIDITY, LEFT);
-
-  // humidity
-  display.setFont(&FONT_12pt8b);
-  dataStr = String(current.humidity);
-  drawString(48 + (162 * PosX), 204 + 17 / 2 + (48 + 8) * PosY + 48 / 2, dataStr, LEFT);
-  display.setFont(&FONT_8pt8b);
-  drawString(display.getCursorX(), 204 + 17 / 2 + (48 + 8) * PosY + 48 / 2, "%", LEFT);
-  return;
-}
-#endif
-// end drawCurrentHumidity
-
-// drawCurrentPressure
-#ifdef POS_PRESSURE
-void drawCurrentPressure(const current_t &current) {
-  String dataStr, unitStr;
-  int PosX = (POS_PRESSURE % 2);
-  int PosY = static_cast<int>(POS_PRESSURE / 2);
-  //  icons
-  display.drawInvertedBitmap(162 * PosX, 204 + (48 + 8) * PosY, wi_barometer_48x48, 48, 48, GxEPD_BLACK);
-
-  //  labels
-  display.setFont(&FONT_7pt8b);
-  drawString(48 + (162 * PosX), 204 + 10 + (48 + 8) * PosY, TXT_PRESSURE, LEFT);
-
-  // pressure
-#ifdef UNITS_PRES_HECTOPASCALS
-  dataStr = String(current.pressure);
-  unitStr = String(" ") + TXT_UNITS_PRES_HECTOPASCALS;
-#endif
-#ifdef UNITS_PRES_PASCALS
-  dataStr = String(static_cast<int>(std::round(hectopascals_to_pascals(current.pressure))));
-  unitStr = String(" ") + TXT_UNITS_PRES_PASCALS;
-#endif
-#ifdef UNITS_PRES_MILLIMETERSOFMERCURY
-  dataStr = String(static_cast<int>(std::round(hectopascals_to_millimetersofmercury(current.pressure))));
-  unitStr = String(" ") + TXT_UNITS_PRES_MILLIMETERSOFMERCURY;
-#endif
-#ifdef UNITS_PRES_INCHESOFMERCURY
-  dataStr = String(std::round(1e1f * hectopascals_to_inchesofmercury(current.pressure)) / 1e1f, 1);
-  unitStr = String(" ") + TXT_UNITS_PRES_INCHESOFMERCURY;
-#endif
-#ifdef UNITS_PRES_MILLIBARS
-  dataStr = String(static_cast<int>(std::round(hectopascals_to_millibars(current.pressure))));
-  unitStr = String(" ") + TXT_UNITS_PRES_MILLIBARS;
-#endif
-#ifdef UNITS_PRES_ATMOSPHERES
-  dataStr = String(std::round(1e3f * hectopascals_to_atmospheres(current.pressure)) / 1e3f, 3);
-  unitStr = String(" ") + TXT_UNITS_PRES_ATMOSPHERES;
-#endif
-#ifdef UNITS_PRES_GRAMSPERSQUARECENTIMETER
-  dataStr = String(static_cast<int>(std::round(hectopascals_to_gramspersquarecentimeter(current.pressure))));
-  unitStr = String(" ") + TXT_UNITS_PRES_GRAMSPERSQUARECENTIMETER;
-#endif
-#ifdef UNITS_PRES_POUNDSPERSQUAREINCH
-  dataStr = String(std::round(1e2f * hectopascals_to_poundspersquareinch(current.pressure)) / 1e2f, 2);
-  unitStr = String(" ") + TXT_UNITS_PRES_POUNDSPERSQUAREINCH;
+/* This function is responsible for drawing the current conditions and
+ * associated icons.
+ */
+void drawCurrentConditions(const current_view_t &view) {
+  // current weather icon
+  scene->drawInvertedBitmap(0, 0, view.icon, 196, 196, GxEPD_BLACK);
+
+  // current temp
+  // FONT_**_temperature fonts only have the character set used for displaying
+  // temperature (0123456789.-\260)
+  scene->setFont(&FONT_48pt8b_temperature);
+#ifndef EPD_PANEL_GENERIC_BW_V1
+  drawString(196 + 164 / 2 - 20, 196 / 2 + 69 / 2, view.temp, CENTER);
+#elif defined(EPD_PANEL_GENERIC_BW_V1)
+  drawString(156 + 164 / 2 - 20, 196 / 2 + 69 / 2, view.temp, CENTER);
 #endif
-  display.setFont(&FONT_12pt8b);
-  drawString(48 + (162 * PosX), 204 + 17 / 2 + (48 + 8) * PosY + 48 / 2, dataStr, LEFT);
-  display.setFont(&FONT_8pt8b);
-  drawString(display.getCursorX(), 204 + 17 / 2 + (48 + 8) * PosY + 48 / 2, unitStr, LEFT);
+  scene->setFont(&FONT_14pt8b);
+  drawString(scene->getCursorX(), 196 / 2 - 69 / 2 + 20, view.tempUnit, LEFT);
 
-  return;
-}
+  // current feels like
+  scene->setFont(&FONT_12pt8b);
+#ifndef EPD_PANEL_GENERIC_BW_V1
+  drawString(196 + 164 / 2, 98 + 69 / 2 + 12 + 17, view.feelsLike, CENTER);
+#elif defined(EPD_PANEL_GENERIC_BW_V1)
+  drawString(156 + 164 / 2, 98 + 69 / 2 + 12 + 17, view.feelsLike, CENTER);
 #endif
-// end drawCurrentPressure
-
-// drawCurrentVisibility
-#ifdef POS_VISIBILITY
-void drawCurrentVisibility(const current_t &current) {
-  String dataStr, unitStr;
-  int PosX = (POS_VISIBILITY % 2);
-  int PosY = static_cast<int>(POS_VISIBILITY / 2);
-
-  // icons
-  display.drawInvertedBitmap(162 * PosX, 204 + (48 + 8) * PosY, visibility_icon_48x48, 48, 48, GxEPD_BLACK);
-
-  // labels
-  display.setFont(&FONT_7pt8b);
-  drawString(48 + (162 * PosX), 204 + 10 + (48 + 8) * PosY, TXT_VISIBILITY, LEFT);
 
-  // visibility
-  display.setFont(&FONT_12pt8b);
-#ifdef UNITS_DISTANCE_KILOMETERS
-  float vis = meters_to_kilometers(current.visibility);
-  unitStr = String(" ") + TXT_UNITS_DIST_KILOMETERS;
-#endif
-#ifdef UNITS_DISTANCE_MILES
-  float vis = meters_to_miles(current.visibility);
-  unitStr = String(" ") + TXT_UNITS_DIST_MILES;
-#endif
-  // if visibility is less than 1.95, round to 1 decimal place
-  // else round to int
-  if (vis < 1.95) {
-    dataStr = String(std::round(10 * vis) / 10.0, 1);
-  } else {
-    dataStr = String(static_cast<int>(std::round(vis)));
+  // draw current data of the left panel
+  for (int i = 0; i < view.cellCount; ++i) {
+    drawConditionCell(view.cells[i]);
   }
-#ifdef UNITS_DISTANCE_KILOMETERS
-  if (vis >= 10) {
-#endif
-#ifdef UNITS_DISTANCE_MILES
-    if (vis >= 6) {
-#endif
-      dataStr = "> " + dataStr;
-    }
-    drawString(48 + (162 * PosX), 204 + 17 / 2 + (48 + 8) * PosY + 48 / 2, dataStr, LEFT);
-    display.setFont(&FONT_8pt8b);
-    drawString(display.getCursorX(), 204 + 17 / 2 + (48 + 8) * PosY + 48 / 2, unitStr, LEFT);
+  return;
+}  // end drawCurrentConditions
 
-    return;
-  }
+/* This function is responsible for drawing the five day forecast.
+ */
+void drawForecast(const forecast_day_view_t *days) {
+  for (int i = 0; i < 5; ++i) {
+    const forecast_day_view_t &day = days[i];
+#ifndef EPD_PANEL_GENERIC_BW_V1
+    int x = 398 + (i * 82);
+#elif defined(EPD_PANEL_GENERIC_BW_V1)
+    int x = 318 + (i * 64);
 #endif
-// end drawCurrentVisibility
-
-// drawCurrentMoonrise
-#ifdef POS_MOONRISE
-  void drawCurrentMoonrise(const moon_state_t &moon) {
-    String dataStr, unitStr;
-    int PosX = POS_MOONRISE % 2;
-    int PosY = static_cast<int>(POS_MOONRISE / 2);
-
     // icons
-    display.drawInvertedBitmap(162 * PosX, 204 + (48 + 8) * PosY, wi_moonrise_48x48, 48, 48, GxEPD_BLACK);
-
-    // labels
-    display.setFont(&FONT_7pt8b);
-    drawString(48 + (162 * PosX), 204 + 10 + (48 + 8) * PosY, TXT_MOONRISE, LEFT);
-
-    // moonrise
-    display.setFont(&FONT_12pt8b);
-    char timeBuffer[12] = {};  // big enough to accommodate "hh:mm:ss am"
-    time_t ts = moon.moonrise;
-    tm *timeInfo = localtime(&ts);
-    _strftime(timeBuffer, sizeof(timeBuffer), TIME_FORMAT, timeInfo);
-    drawString(48 + (162 * PosX), 204 + 17 / 2 + (48 + 8) * PosY + 48 / 2, timeBuffer, LEFT);
-
-    return;
+    scene->drawInvertedBitmap(x, 98 + 69 / 2 - 32 - 6, day.icon, 64, 64, GxEPD_BLACK);
+    // day of week label
+    scene->setFont(&FONT_11pt8b);
+    drawString(x + 31 - 2, 98 + 69 / 2 - 32 - 26 - 6 + 16, day.day, CENTER);
+
+    // high | low
+    scene->setFont(&FONT_8pt8b);
+    drawString(x + 31, 98 + 69 / 2 + 38 - 6 + 12, "|", CENTER);
+    drawString(x + 31 - 4, 98 + 69 / 2 + 38 - 6 + 12, day.hi, RIGHT);
+    drawString(x + 31 + 5, 98 + 69 / 2 + 38 - 6 + 12, day.lo, LEFT);
+
+    // daily forecast precipitation
+    if (day.precip[0] != '\0') {
+      scene->setFont(&FONT_6pt8b);
+      drawString(x + 31, 98 + 69 / 2 + 38 - 6 + 26, day.precip, CENTER, COLORS_FORECAST_PRECIPITATION);
+    }
   }
-#endif
-// end drawCurrentMoonrise
 
-// drawCurrentMoonset
-#ifdef POS_MOONSET
-  void drawCurrentMoonset(const moon_state_t &moon) {
-    String dataStr, unitStr;
-    int PosX = (POS_MOONSET % 2);
-    int PosY = static_cast<int>(POS_MOONSET / 2);
-    // icons
-    display.drawInvertedBitmap(162 * PosX, 204 + (48 + 8) * PosY, wi_moonset_48x48, 48, 48, GxEPD_BLACK);
-
-    // labels
-    display.setFont(&FONT_7pt8b);
-    drawString(48 + (162 * PosX), 204 + 10 + (48 + 8) * PosY, TXT_MOONSET, LEFT);
-
-    // moonset
-    display.setFont(&FONT_12pt8b);
-    char timeBuffer[12] = {};  // big enough to accommodate "hh:mm:ss am"
-    time_t ts = moon.moonset;
-    tm *timeInfo = localtime(&ts);
-    _strftime(timeBuffer, sizeof(timeBuffer), TIME_FORMAT, timeInfo);
-    drawString(48 + (162 * PosX), 204 + 17 / 2 + (48 + 8) * PosY + 48 / 2, timeBuffer, LEFT);
+  return;
+}  // end drawForecast
 
+/* This function is responsible for drawing the current alerts if any.
+ * Up to 2 alerts can be drawn.
+ */
+void drawAlerts(const alert_view_t *alerts, int count, const String &city, const String &date) {
+  if (count == 0) {  // no alerts to draw
     return;
   }
-#endif
-// end drawCurrentMoonset
 
-// drawCurrentMoonphase
-#ifdef POS_MOONPHASE
-  void drawCurrentMoonphase(const moon_state_t &moon) {
-    String dataStr, unitStr;
-    int PosX = (POS_MOONPHASE % 2);
-    int PosY = static_cast<int>(POS_MOONPHASE / 2);
-
-    // icons
-    display.drawInvertedBitmap(162 * PosX, 204 + (48 + 8) * PosY, getMoonPhaseBitmap48(moon), 48, 48, GxEPD_BLACK);
-
-    // labels
-    display.setFont(&FONT_7pt8b);
-    drawString(48 + (162 * PosX), 204 + 10 + (48 + 8) * PosY, TXT_MOONPHASE, LEFT);
-
-    // moonphase
-    const int sp = 8;
-    dataStr = String(getMoonPhaseStr(moon));
-    int max_w = (162 + (PosX * 162) - sp) - (48 + (PosX * 162));
-    if (getStringWidth(dataStr) <= max_w) {  // Fits on a single line, draw along bottom
-      drawString(48 + (162 * PosX), 204 + 17 / 2 + (48 + 8) * PosY + 48 / 2, dataStr, LEFT);
+  // limit alert text width so that is does not run into the location or date
+  // strings
+  scene->setFont(&FONT_16pt8b);
+  int city_w = getStringWidth(city);
+  scene->setFont(&FONT_12pt8b);
+  int date_w = getStringWidth(date);
+  int max_w = DISP_WIDTH - 2 - std::max(city_w, date_w) - (196 + 4) - 8;
+
+  if (count == 1) {  // 1 alert
+    // adjust max width to for 48x48 icons
+    max_w -= 48;
+
+    const alert_view_t &cur_alert = alerts[0];
+    scene->drawInvertedBitmap(196, 8, cur_alert.icon, 48, 48, COLORS_ALERT);
+
+    scene->setFont(&FONT_14pt8b);
+    text_metrics::Extent extent = scene->measureText(cur_alert.event);
+    if (extent.width() <= max_w) {  // Fits on a single line, draw along bottom
+      drawMeasured(196 + 48 + 4, 24 + 8 - 12 + 20 + 1, cur_alert.event, extent, LEFT);
     } else {  // use smaller font
-      display.setFont(&FONT_5pt8b);
-      if (getStringWidth(dataStr) <= max_w) {  // Fits on a single line with smaller font, draw along bottom
-        drawString(48 + (162 * PosX), 204 + 17 / 2 + (48 + 8) * PosY + 48 / 2, dataStr, LEFT);
+      scene->setFont(&FONT_12pt8b);
+      extent = scene->measureText(cur_alert.event);
+      if (extent.width() <= max_w) {  // Fits on a single line with smaller font, draw along bottom
+        drawMeasured(196 + 48 + 4, 24 + 8 - 12 + 17 + 1, cur_alert.event, extent, LEFT);
       } else {  // Does not fit on a single line, draw higher to allow room for 2nd line
-        drawMultiLnString(48 + (162 * PosX), 204 + 17 / 2 + (48 + 8) * PosY + 48 / 2 - 10, dataStr, LEFT, max_w, 2, 10);
+        drawMultiLnString(196 + 48 + 4, 24 + 8 - 12 + 17 - 11, cur_alert.event, LEFT, max_w, 2, 23);
       }
     }
+  }  // end 1 alert
+  else {  // 2 alerts
+    // adjust max width to for 32x32 icons
+    max_w -= 32;
+
+    scene->setFont(&FONT_12pt8b);
+    for (int i = 0; i < 2; ++i) {
+      scene->drawInvertedBitmap(196, (i * 32), alerts[i].icon, 32, 32, COLORS_ALERT);
+      drawMultiLnString(196 + 32 + 3, 5 + 17 + (i * 32), alerts[i].event, LEFT, max_w, 1, 0);
+    }  // end for-loop
+  }  // end 2 alerts
 
-    return;
-  }
-#endif
-// end drawCurrentMoonphase
-
-// drawCurrentDewpoint
-#ifdef POS_DEWPOINT
-  void drawCurrentDewpoint(const current_t &current) {
-    String dataStr, unitStr;
-    int PosX = (POS_DEWPOINT % 2);
-    int PosY = static_cast<int>(POS_DEWPOINT / 2);
+  return;
+}  // end drawAlerts
 
-    // icons
-    display.drawInvertedBitmap(162 * PosX, 204 + (48 + 8) * PosY, wi_thermometer_48x48, 48, 48, GxEPD_BLACK);
-    display.drawInvertedBitmap(162 * PosX + 48 - 24, 204 + (48 + 8) * PosY + 4, wi_raindrops_24x24, 24, 24,
-                               GxEPD_BLACK);
+/* This function is responsible for drawing the city string and date
+ * information in the top right corner.
+ */
+void drawLocationDate(const String &city, const String &date) {
+  // location, date
+  scene->setFont(&FONT_16pt8b);
+  drawString(DISP_WIDTH - 6, 25, city, RIGHT, COLORS_CITY);
+  scene->setFont(&FONT_12pt8b);
+  drawString(DISP_WIDTH - 6, 32 + 4 + 17, date, RIGHT, COLORS_DATE);
+  return;
+}  // end drawLocationDate
 
-    // labels
-    display.setFont(&FONT_7pt8b);
-    drawString(48 + (162 * PosX), 204 + 10 + (48 + 8) * PosY, TXT_DEWPOINT, LEFT);
+/* Draws an x axis tick mark and its label.
+ */
+static void drawOutlookTick(const outlook_tick_view_t &tick, int yPos1) {
+  scene->drawLine(tick.x, yPos1 + 1, tick.x, yPos1 + 4, GxEPD_BLACK);
+  scene->drawLine(tick.x + 1, yPos1 + 1, tick.x + 1, yPos1 + 4, GxEPD_BLACK);
+  drawString(tick.x, yPos1 + 1 + 12 + 4 + 3, tick.label, CENTER);
+}
 
-    // Dew point
-    display.setFont(&FONT_12pt8b);
-    if (!std::isnan(current.dew_point)) {
-#ifdef UNITS_TEMP_KELVIN
-      dataStr = String(std::round(celsius_to_kelvin(current.dew_point) * 10) / 10.0f, 1) + "K";
-#endif
-#ifdef UNITS_TEMP_CELSIUS
-      dataStr = String(std::round(current.dew_point * 10) / 10.0f, 1) + "\260C";
-#endif
-#ifdef UNITS_TEMP_FAHRENHEIT
-      dataStr = String(static_cast<int>(std::round(celsius_to_fahrenheit(current.dew_point)))) + "\260F";
-#endif
-    } else {
-      dataStr = "--";
+/* This function is responsible for drawing the outlook graph for the specified
+ * number of hours(up to 48).
+ */
+void drawOutlookGraph(const outlook_view_t &view) {
+  const int xPos0 = view.x0;
+  const int xPos1 = view.x1;
+  const int yPos1 = view.y1;
+
+  // draw x axis
+  scene->drawLine(xPos0, yPos1, xPos1, yPos1, GxEPD_BLACK);
+  scene->drawLine(xPos0, yPos1 - 1, xPos1, yPos1 - 1, GxEPD_BLACK);
+
+  // draw y axis
+  for (int i = 0; i <= OUTLOOK_Y_TICKS; ++i) {
+    const int yTick = view.yTicks[i];
+    scene->setFont(&FONT_8pt8b);
+    drawString(xPos0 - 8, yTick + 4, view.tempLabels[i], RIGHT, view.tempColors[i]);
+
+    if (view.precipLabels) {
+      drawString(xPos1 + 8, yTick + 4, view.precipLabelValues[i], LEFT);
+      scene->setFont(&FONT_5pt8b);
+      drawString(scene->getCursorX(), yTick + 4, view.precipUnit, LEFT);
     }
-    drawString(48 + (162 * PosX), 204 + 17 / 2 + (48 + 8) * PosY + 48 / 2, dataStr, LEFT);
-  }
-#endif
-// end drawCurrentDewpoint
-
-// drawCurrentInPressure
-#ifdef POS_INPRESSURE
-  void drawCurrentInPressure(std::optional<float> inPressure) {
-    String dataStr, unitStr;
-    int PosX = (POS_INPRESSURE % 2);
-    int PosY = static_cast<int>(POS_INPRESSURE / 2);
 
-    // icons
-    display.drawInvertedBitmap(162 * PosX, 204 + (48 + 8) * PosY, wi_barometer_48x48, 48, 48, GxEPD_BLACK);
-
-    // labels
-    display.setFont(&FONT_7pt8b);
-    drawString(48 + (162 * PosX), 204 + 10 + (48 + 8) * PosY, TXT_INDOOR_PRESSURE, LEFT);
-
-    if (!inPressure.has_value()) {
-      dataStr = "--";
-      unitStr = "";
-    } else {
-// pressure
-#ifdef UNITS_PRES_HECTOPASCALS
-      dataStr = String(inPressure.value());
-      unitStr = String(" ") + TXT_UNITS_PRES_HECTOPASCALS;
-#endif
-#ifdef UNITS_PRES_PASCALS
-      dataStr = String(static_cast<int>(std::round(hectopascals_to_pascals(inPressure.value()))));
-      unitStr = String(" ") + TXT_UNITS_PRES_PASCALS;
-#endif
-#ifdef UNITS_PRES_MILLIMETERSOFMERCURY
-      dataStr = String(static_cast<int>(std::round(hectopascals_to_millimetersofmercury(inPressure.value()))));
-      unitStr = String(" ") + TXT_UNITS_PRES_MILLIMETERSOFMERCURY;
-#endif
-#ifdef UNITS_PRES_INCHESOFMERCURY
-      dataStr = String(std::round(1e1f * hectopascals_to_inchesofmercury(inPressure.value())) / 1e1f, 1);
-      unitStr = String(" ") + TXT_UNITS_PRES_INCHESOFMERCURY;
-#endif
-#ifdef UNITS_PRES_MILLIBARS
-      dataStr = String(static_cast<int>(std::round(hectopascals_to_millibars(inPressure.value()))));
-      unitStr = String(" ") + TXT_UNITS_PRES_MILLIBARS;
-#endif
-#ifdef UNITS_PRES_ATMOSPHERES
-      dataStr = String(std::round(1e3f * hectopascals_to_atmospheres(inPressure.value())) / 1e3f, 3);
-      unitStr = String(" ") + TXT_UNITS_PRES_ATMOSPHERES;
-#endif
-#ifdef UNITS_PRES_GRAMSPERSQUARECENTIMETER
-      dataStr = String(static_cast<int>(std::round(hectopascals_to_gramspersquarecentimeter(inPressure.value()))));
-      unitStr = String(" ") + TXT_UNITS_PRES_GRAMSPERSQUARECENTIMETER;
-#endif
-#ifdef UNITS_PRES_POUNDSPERSQUAREINCH
-      dataStr = String(std::round(1e2f * hectopascals_to_poundspersquareinch(inPressure.value())) / 1e2f, 2);
-      unitStr = String(" ") + TXT_UNITS_PRES_POUNDSPERSQUAREINCH;
-#endif
+    // draw dotted line
+    if (i < OUTLOOK_Y_TICKS) {
+      scene->drawStipple(xPos0, yTick + (yTick % 2), xPos1 + 2 - xPos0, 1, 3, 1, GxEPD_BLACK);
     }
-    display.setFont(&FONT_12pt8b);
-    drawString(48 + (162 * PosX), 204 + 17 / 2 + (48 + 8) * PosY + 48 / 2, dataStr, LEFT);
-    display.setFont(&FONT_8pt8b);
-    drawString(display.getCursorX(), 204 + 17 / 2 + (48 + 8) * PosY + 48 / 2, unitStr, LEFT);
-    return;
   }
-#endif
-  // end drawCurrentInPressure
 
-  // End defining functions for left panel.
+  scene->setFont(&FONT_8pt8b);
+  for (int i = 0; i < HOURLY_GRAPH_MAX; ++i) {
+    const outlook_hour_view_t &hour = view.hours[i];
 
-  /* This function is responsible for drawing the current conditions and
-   * associated icons.
-   */
-  void drawCurrentConditions(const current_t &current, const air_quality_t &air_quality, std::optional<float> inPressure,
-                             const moon_state_t &moon) {
-    String dataStr, unitStr;
-    // current weather icon
-    display.drawInvertedBitmap(0, 0, getCurrentConditionsBitmap196(current, moon), 196, 196, GxEPD_BLACK);
-
-    // current temp
-#ifdef UNITS_TEMP_KELVIN
-    dataStr = String(static_cast<int>(std::round(celsius_to_kelvin(current.temp))));
-    unitStr = TXT_UNITS_TEMP_KELVIN;
-#endif
-#ifdef UNITS_TEMP_CELSIUS
-    dataStr = String(static_cast<int>(std::round(current.temp)));
-    unitStr = TXT_UNITS_TEMP_CELSIUS;
-#endif
-#ifdef UNITS_TEMP_FAHRENHEIT
-    dataStr = String(static_cast<int>(std::round(celsius_to_fahrenheit(current.temp))));
-    unitStr = TXT_UNITS_TEMP_FAHRENHEIT;
-#endif
-    // FONT_**_temperature fonts only have the character set used for displaying
-    // temperature (0123456789.-\260)
-    display.setFont(&FONT_48pt8b_temperature);
-#ifndef EPD_PANEL_GENERIC_BW_V1
-    drawString(196 + 164 / 2 - 20, 196 / 2 + 69 / 2, dataStr, CENTER);
-#elif defined(EPD_PANEL_GENERIC_BW_V1)
-  drawString(156 + 164 / 2 - 20, 196 / 2 + 69 / 2, dataStr, CENTER);
-#endif
-    display.setFont(&FONT_14pt8b);
-    drawString(display.getCursorX(), 196 / 2 - 69 / 2 + 20, unitStr, LEFT);
-
-    // current feels like
-#ifdef UNITS_TEMP_KELVIN
-    dataStr = String(TXT_FEELS_LIKE) + ' ' +
-              String(static_cast<int>(std::round(celsius_to_kelvin(current.feels_like)))) + 'K';
-#endif
-#ifdef UNITS_TEMP_CELSIUS
-    dataStr = String(TXT_FEELS_LIKE) + ' ' + String(static_cast<int>(std::round(current.feels_like))) + "\260C";
-#endif
-#ifdef UNITS_TEMP_FAHRENHEIT
-    dataStr = String(TXT_FEELS_LIKE) + ' ' +
-              String(static_cast<int>(std::round(celsius_to_fahrenheit(current.feels_like)))) + "\260F";
-#endif
-    display.setFont(&FONT_12pt8b);
-#ifndef EPD_PANEL_GENERIC_BW_V1
-    drawString(196 + 164 / 2, 98 + 69 / 2 + 12 + 17, dataStr, CENTER);
-#elif defined(EPD_PANEL_GENERIC_BW_V1)
-  drawString(156 + 164 / 2, 98 + 69 / 2 + 12 + 17, dataStr, CENTER);
-#endif
-    // line dividing top and bottom display areas
-    // display.drawLine(0, 196, DISP_WIDTH - 1, 196, GxEPD_BLACK);
-
-    // draw current data of the left panel
-
-#ifdef POS_SUNRISE
-    drawCurrentSunrise(current);
-#endif
-
-#ifdef POS_SUNSET
-    drawCurrentSunset(current);
-#endif
-
-#ifdef POS_WIND
-    drawCurrentWind(current);
-#endif
-
-#ifdef POS_HUMIDITY
-    drawCurrentHumidity(current);
-#endif
-
-#ifdef POS_UVI
-    drawCurrentUVI(current);
-#endif
-
-#ifdef POS_PRESSURE
-    drawCurrentPressure(current);
-#endif
-
-#ifdef POS_VISIBILITY
-    drawCurrentVisibility(current);
-#endif
-
-#ifdef POS_AIR_QUALITY
-    drawCurrentAirQuality(air_quality);
-#endif
-
-#ifdef POS_MOONRISE
-    drawCurrentMoonrise(moon);
-#endif
-
-#ifdef POS_MOONSET
-    drawCurrentMoonset(moon);
-#endif
-
-#ifdef POS_MOONPHASE
-    drawCurrentMoonphase(moon);
-#endif
-
-#ifdef POS_DEWPOINT
-    drawCurrentDewpoint(current);
-#endif
-
-#ifdef POS_INPRESSURE
-    drawCurrentInPressure(inPressure);
-#endif
-    // end drawing left panel
-  }  // end drawCurrentConditions
-
-  /* This function is responsible for drawing the five day forecast.
-   */
-  void drawForecast(const daily_t *daily, tm timeInfo) {
-    // 5 day, forecast
-    String hiStr, loStr;
-    String dataStr, unitStr;
-    for (int i = 0; i < 5; ++i) {
-#ifndef EPD_PANEL_GENERIC_BW_V1
-      int x = 398 + (i * 82);
-#elif defined(EPD_PANEL_GENERIC_BW_V1)
-    int x = 318 + (i * 64);
-#endif
-      // icons
-      display.drawInvertedBitmap(x, 98 + 69 / 2 - 32 - 6, getDailyForecastBitmap64(daily[i]), 64, 64, GxEPD_BLACK);
-      // day of week label
-      display.setFont(&FONT_11pt8b);
-      char dayBuffer[8] = {};
-      _strftime(dayBuffer, sizeof(dayBuffer), "%a", &timeInfo);  // abbrv'd day
-      drawString(x + 31 - 2, 98 + 69 / 2 - 32 - 26 - 6 + 16, dayBuffer, CENTER);
-      timeInfo.tm_wday = (timeInfo.tm_wday + 1) % 7;  // increment to next day
-
-      // high | low
-      display.setFont(&FONT_8pt8b);
-      drawString(x + 31, 98 + 69 / 2 + 38 - 6 + 12, "|", CENTER);
-#ifdef UNITS_TEMP_KELVIN
-      hiStr = String(static_cast<int>(std::round(celsius_to_kelvin(daily[i].temp.max))));
-      loStr = String(static_cast<int>(std::round(celsius_to_kelvin(daily[i].temp.min))));
-#endif
-#ifdef UNITS_TEMP_CELSIUS
-      hiStr = String(static_cast<int>(std::round(daily[i].temp.max))) + "\260";
-      loStr = String(static_cast<int>(std::round(daily[i].temp.min))) + "\260";
-#endif
-#ifdef UNITS_TEMP_FAHRENHEIT
-      hiStr = String(static_cast<int>(std::round(celsius_to_fahrenheit(daily[i].temp.max)))) + "\260";
-      loStr = String(static_cast<int>(std::round(celsius_to_fahrenheit(daily[i].temp.min)))) + "\260";
-#endif
-      drawString(x + 31 - 4, 98 + 69 / 2 + 38 - 6 + 12, hiStr, RIGHT);
-      drawString(x + 31 + 5, 98 + 69 / 2 + 38 - 6 + 12, loStr, LEFT);
-
-// daily forecast precipitation
-#ifndef DISPLAY_DAILY_PRECIP_DISABLED
-      float dailyPrecip;
-#if defined(UNITS_DAILY_PRECIP_POP)
-      dailyPrecip = daily[i].pop;
-      dataStr = String(static_cast<int>(dailyPrecip));
-      unitStr = "%";
-#else
-    dailyPrecip = daily[i].snow + daily[i].rain;
-#if defined(UNITS_DAILY_PRECIP_MILLIMETERS)
-    // Round up to nearest mm
-    dailyPrecip = std::round(dailyPrecip);
-    dataStr = String(static_cast<int>(dailyPrecip));
-    unitStr = String(" ") + TXT_UNITS_PRECIP_MILLIMETERS;
-#elif defined(UNITS_DAILY_PRECIP_CENTIMETERS)
-    // Round up to nearest 0.1 cm
-    dailyPrecip = millimeters_to_centimeters(dailyPrecip);
-    dailyPrecip = std::round(dailyPrecip * 10) / 10.0f;
-    dataStr = String(dailyPrecip, 1);
-    unitStr = String(" ") + TXT_UNITS_PRECIP_CENTIMETERS;
-#elif defined(UNITS_DAILY_PRECIP_INCHES)
-    // Round up to nearest 0.1 inch
-    dailyPrecip = millimeters_to_inches(dailyPrecip);
-    dailyPrecip = std::round(dailyPrecip * 10) / 10.0f;
-    dataStr = String(dailyPrecip, 1);
-    unitStr = String(" ") + TXT_UNITS_PRECIP_INCHES;
-#endif
-#endif
-#ifdef DISPLAY_DAILY_PRECIP_SMART
-      if (dailyPrecip > 0.0f) {
-#endif
-        display.setFont(&FONT_6pt8b);
-        drawString(x + 31, 98 + 69 / 2 + 38 - 6 + 26, dataStr + unitStr, CENTER, COLORS_FORECAST_PRECIPITATION);
-#ifdef DISPLAY_DAILY_PRECIP_SMART
-      }
-#endif
-#endif  // DISPLAY_DAILY_PRECIP
+    // temperature, 3 px wide
+    for (int s = 0; s < hour.segmentCount; ++s) {
+      const outlook_segment_view_t &seg = hour.segments[s];
+      scene->drawLine(seg.x0, seg.y0, seg.x1, seg.y1, seg.color);
+      scene->drawLine(seg.x0, seg.y0 + 1, seg.x1, seg.y1 + 1, seg.color);
+      scene->drawLine(seg.x0 - 1, seg.y0, seg.x1 - 1, seg.y1, seg.color);
     }
 
-    return;
-  }  // end drawForecast
-
-  /* This function is responsible for drawing the current alerts if any.
-   * Up to 2 alerts can be drawn.
-   */
-  void drawAlerts(std::vector<weather_alert_t> & alerts, const String &city, const String &date) {
-    LOG_DEBUG("Alerts size is %u", alerts.size());
-    if (alerts.size() == 0) {  // no alerts to draw
-      return;
+    // hourly bitmap
+    if (hour.icon != nullptr) {
+      scene->drawInvertedBitmap(hour.iconX, hour.iconY, hour.icon, 32, 32, hour.iconColor);
     }
 
-    int *ignore_list = (int *) calloc(alerts.size(), sizeof(*ignore_list));
-    int *alert_indices = (int *) calloc(alerts.size(), sizeof(*alert_indices));
-    if (!ignore_list || !alert_indices) {
-      LOG_ERROR("Failed to allocate memory while handling alerts.");
-      free(ignore_list);
-      free(alert_indices);
-      return;
+    // graph Precipitation, every other pixel on rows yPos1 - 1, yPos1 - 3, ...
+    // above barTop
+    const int hatchRows = (yPos1 - hour.barTop) / 2;
+    if (hatchRows > 0) {
+      const int hatchX = hour.barX0 + (hour.barX0 % 2);
+      scene->drawStipple(hatchX, yPos1 - 1 - 2 * (hatchRows - 1), hour.barX1 - hatchX, 2 * (hatchRows - 1) + 1, 2, 2,
+                        GxEPD_BLACK);
     }
 
-    // Converts all event text and tags to lowercase, removes extra information,
-    // and filters out redundant alerts of lesser urgency.
-    filterAlerts(alerts, ignore_list);
-
-    // limit alert text width so that is does not run into the location or date
-    // strings
-    display.setFont(&FONT_16pt8b);
-    int city_w = getStringWidth(city);
-    display.setFont(&FONT_12pt8b);
-    int date_w = getStringWidth(date);
-    int max_w = DISP_WIDTH - 2 - std::max(city_w, date_w) - (196 + 4) - 8;
-
-    // find indices of valid alerts
-    int num_valid_alerts = 0;
-    String ignoreList = "[ ";
-    for (int i = 0; i < alerts.size(); ++i) {
-      ignoreList += String(ignore_list[i]) + " ";
-      if (!ignore_list[i]) {
-        alert_indices[num_valid_alerts] = i;
-        ++num_valid_alerts;
-      }
+    if (hour.tick) {
+      drawOutlookTick(hour.tickView, yPos1);
     }
-    LOG_DEBUG("ignore_list      : %s]", ignoreList.c_str());
-    LOG_DEBUG("num_valid_alerts : %d", num_valid_alerts);
-
-    if (num_valid_alerts == 1) {  // 1 alert
-      // adjust max width to for 48x48 icons
-      max_w -= 48;
-
-      weather_alert_t &cur_alert = alerts[alert_indices[0]];
-      display.drawInvertedBitmap(196, 8, getAlertBitmap48(cur_alert), 48, 48, COLORS_ALERT);
-      // must be called after getAlertBitmap
-      toTitleCase(cur_alert.event);
-
-      display.setFont(&FONT_14pt8b);
-      if (getStringWidth(cur_alert.event) <= max_w) {  // Fits on a single line, draw along bottom
-        drawString(196 + 48 + 4, 24 + 8 - 12 + 20 + 1, cur_alert.event, LEFT);
-      } else {  // use smaller font
-        display.setFont(&FONT_12pt8b);
-        if (getStringWidth(cur_alert.event) <= max_w) {  // Fits on a single line with smaller font, draw along bottom
-          drawString(196 + 48 + 4, 24 + 8 - 12 + 17 + 1, cur_alert.event, LEFT);
-        } else {  // Does not fit on a single line, draw higher to allow room for 2nd line
-          drawMultiLnString(196 + 48 + 4, 24 + 8 - 12 + 17 - 11, cur_alert.event, LEFT, max_w, 2, 23);
-        }
-      }
-    }  // end 1 alert
-    else {  // 2 alerts
-      // adjust max width to for 32x32 icons
-      max_w -= 32;
-
-      display.setFont(&FONT_12pt8b);
-      for (int i = 0; i < 2; ++i) {
-        weather_alert_t &cur_alert = alerts[alert_indices[i]];
-
-        display.drawInvertedBitmap(196, (i * 32), getAlertBitmap32(cur_alert), 32, 32, COLORS_ALERT);
-        // must be called after getAlertBitmap
-        toTitleCase(cur_alert.event);
-
-        drawMultiLnString(196 + 32 + 3, 5 + 17 + (i * 32), cur_alert.event, LEFT, max_w, 1, 0);
-      }  // end for-loop
-    }  // end 2 alerts
-
-    free(ignore_list);
-    free(alert_indices);
-
-    return;
-  }  // end drawAlerts
-
-  /* This function is responsible for drawing the city string and date
-   * information in the top right corner.
-   */
-  void drawLocationDate(const String &city, const String &date) {
-    // location, date
-    display.setFont(&FONT_16pt8b);
-    drawString(DISP_WIDTH - 6, 25, city, RIGHT, COLORS_CITY);
-    display.setFont(&FONT_12pt8b);
-    drawString(DISP_WIDTH - 6, 32 + 4 + 17, date, RIGHT, COLORS_DATE);
-    return;
-  }  // end drawLocationDate
-
-  /* The % operator in C++ is not a true modulo operator but it instead a
-   * remainder operator. The remainder operator and modulo operator are equivalent
-   * for positive numbers, but not for negatives. The follow implementation of the
-   * modulo operator works for +/-a and +b.
-   */
-  inline int modulo(int a, int b) {
-    const int result = a % b;
-    return result >= 0 ? result : result + b;
   }
 
-  /* Convert temperature in celsius to the display y coordinate to be plotted.
-   */
-  int celsius_to_plot_y(float temp, int tempBoundMin, float yPxPerUnit, int yBoundMin) {
-#ifdef UNITS_TEMP_KELVIN
-    return static_cast<int>(std::round(yBoundMin - (yPxPerUnit * (celsius_to_kelvin(temp) - tempBoundMin))));
-#endif
-#ifdef UNITS_TEMP_CELSIUS
-    return static_cast<int>(std::round(yBoundMin - (yPxPerUnit * (temp - tempBoundMin))));
-#endif
-#ifdef UNITS_TEMP_FAHRENHEIT
-    return static_cast<int>(std::round(yBoundMin - (yPxPerUnit * (celsius_to_fahrenheit(temp) - tempBoundMin))));
-#endif
-  }
-
-  /* This function is responsible for drawing the outlook graph for the specified
-   * number of hours(up to 48).
-   */
-  void drawOutlookGraph(const hourly_t *hourly, const daily_t *daily, tm timeInfo, const moon_state_t &moon) {
-    const int xPos0 = 350;
-    int xPos1 = DISP_WIDTH;
-    const int yPos0 = 216;
-    const int yPos1 = DISP_HEIGHT - 46;
-
-    // calculate y max/min and intervals
-    int yMajorTicks = 5;
-#ifdef UNITS_TEMP_KELVIN
-    float tempMin = celsius_to_kelvin(hourly[0].temp);
-#endif
-#ifdef UNITS_TEMP_CELSIUS
-    float tempMin = hourly[0].temp;
-#endif
-#ifdef UNITS_TEMP_FAHRENHEIT
-    float tempMin = celsius_to_fahrenheit(hourly[0].temp);
-#endif
-    float tempMax = tempMin;
-#ifdef UNITS_HOURLY_PRECIP_POP
-    float precipMax = hourly[0].pop;
-#else
-  float precipMax = hourly[0].rain_1h + hourly[0].snow_1h;
-#endif
-    int yTempMajorTicks = 5;
-    float newTemp = 0;
-    for (int i = 1; i < HOURLY_GRAPH_MAX; ++i) {
-#ifdef UNITS_TEMP_KELVIN
-      newTemp = celsius_to_kelvin(hourly[i].temp);
-#endif
-#ifdef UNITS_TEMP_CELSIUS
-      newTemp = hourly[i].temp;
-#endif
-#ifdef UNITS_TEMP_FAHRENHEIT
-      newTemp = celsius_to_fahrenheit(hourly[i].temp);
-#endif
-      tempMin = std::min(tempMin, newTemp);
-      tempMax = std::max(tempMax, newTemp);
-#ifdef UNITS_HOURLY_PRECIP_POP
-      precipMax = std::max<float>(precipMax, hourly[i].pop);
-#else
-    precipMax = std::max<float>(precipMax, hourly[i].rain_1h + hourly[i].snow_1h);
-#endif
-    }
-    int tempBoundMin = static_cast<int>(tempMin - 1) - modulo(static_cast<int>(tempMin - 1), yTempMajorTicks);
-    int tempBoundMax =
-        static_cast<int>(tempMax + 1) + (yTempMajorTicks - modulo(static_cast<int>(tempMax + 1), yTempMajorTicks));
-
-    // while we have to many major ticks then increase the step
-    while ((tempBoundMax - tempBoundMin) / yTempMajorTicks > yMajorTicks) {
-      yTempMajorTicks += 5;
-      tempBoundMin = static_cast<int>(tempMin - 1) - modulo(static_cast<int>(tempMin - 1), yTempMajorTicks);
-      tempBoundMax =
-          static_cast<int>(tempMax + 1) + (yTempMajorTicks - modulo(static_cast<int>(tempMax + 1), yTempMajorTicks));
-    }
-    // while we have not enough major ticks, add to either bound
-    while ((tempBoundMax - tempBoundMin) / yTempMajorTicks < yMajorTicks) {
-      // add to whatever bound is closer to the actual min/max
-      if (tempMin - tempBoundMin <= tempBoundMax - tempMax) {
-        tempBoundMin -= yTempMajorTicks;
-      } else {
-        tempBoundMax += yTempMajorTicks;
-      }
-    }
-
-#ifdef UNITS_HOURLY_PRECIP_POP
-    xPos1 = DISP_WIDTH - 23;
-    float precipBoundMax;
-    if (precipMax > 0) {
-      precipBoundMax = 100.0f;
-    } else {
-      precipBoundMax = 0.0f;
-    }
-#else
-#ifdef UNITS_HOURLY_PRECIP_MILLIMETERS
-  xPos1 = DISP_WIDTH - 24;
-  float precipBoundMax = std::ceil(precipMax);  // Round up to nearest mm
-  int yPrecipMajorTickDecimals = (precipBoundMax < 10);
-#endif
-#ifdef UNITS_HOURLY_PRECIP_CENTIMETERS
-  xPos1 = DISP_WIDTH - 25;
-  precipMax = millimeters_to_centimeters(precipMax);
-  // Round up to nearest 0.1 cm
-  float precipBoundMax = std::ceil(precipMax * 10) / 10.0f;
-  int yPrecipMajorTickDecimals;
-  if (precipBoundMax < 1) {
-    yPrecipMajorTickDecimals = 2;
-    if (precipBoundMax > 0) {
-      xPos1 -= 6;  // needs extra room
-    }
-  } else if (precipBoundMax < 10) {
-    yPrecipMajorTickDecimals = 1;
-  } else {
-    yPrecipMajorTickDecimals = 0;
+  // draw the last tick mark
+  if (view.lastTick) {
+    drawOutlookTick(view.lastTickView, yPos1);
   }
-#endif
-#ifdef UNITS_HOURLY_PRECIP_INCHES
-  xPos1 = DISP_WIDTH - 25;
-  precipMax = millimeters_to_inches(precipMax);
-  // Round up to nearest 0.1 inch
-  float precipBoundMax = std::ceil(precipMax * 10) / 10.0f;
-  int yPrecipMajorTickDecimals;
-  if (precipBoundMax < 1) {
-    yPrecipMajorTickDecimals = 2;
-  } else if (precipBoundMax < 10) {
-    yPrecipMajorTickDecimals = 1;
-  } else {
-    yPrecipMajorTickDecimals = 0;
-  }
-#endif
-  float yPrecipMajorTickValue = precipBoundMax / yMajorTicks;
-  float precipRoundingMultiplier = std::pow(10.f, yPrecipMajorTickDecimals);
-#endif
-
-    if (precipBoundMax > 0) {  // fill need extra room for labels
-      xPos1 -= 23;
-    }
-
-    // draw x axis
-    display.drawLine(xPos0, yPos1, xPos1, yPos1, GxEPD_BLACK);
-    display.drawLine(xPos0, yPos1 - 1, xPos1, yPos1 - 1, GxEPD_BLACK);
-
-    // draw y axis
-    float yInterval = (yPos1 - yPos0) / static_cast<float>(yMajorTicks);
-    for (int i = 0; i <= yMajorTicks; ++i) {
-      String dataStr;
-      int yTick = static_cast<int>(yPos0 + (i * yInterval));
-      display.setFont(&FONT_8pt8b);
-      // Temperature
-      int tempVal = tempBoundMax - (i * yTempMajorTicks);
-      dataStr = String(tempVal);
-#if defined(UNITS_TEMP_CELSIUS) || defined(UNITS_TEMP_FAHRENHEIT)
-      dataStr += "\260";
-      uint16_t tempColor = tempVal < COLORS_OUTLOOK_LOW_THRESHOLD_TEMPERATURE   ? COLORS_OUTLOOK_TEMPERATURE_LOW_COLOR
-                         : tempVal > COLORS_OUTLOOK_HIGH_THRESHOLD_TEMPERATURE  ? COLORS_OUTLOOK_TEMPERATURE_HIGH_COLOR
-                                                                                : COLORS_OUTLOOK_TEMPERATURE_NORMAL_COLOR;
-#else
-    uint16_t tempColor = GxEPD_BLACK;
-#endif
-      drawString(xPos0 - 8, yTick + 4, dataStr, RIGHT, tempColor);
-
-      if (precipBoundMax > 0) {  // don't labels if precip is 0
-#ifdef UNITS_HOURLY_PRECIP_POP
-                                 // PoP
-        dataStr = String(100 - (i * 20));
-        String precipUnit = "%";
-#else
-      // Precipitation volume
-      float precipTick = precipBoundMax - (i * yPrecipMajorTickValue);
-      precipTick = std::round(precipTick * precipRoundingMultiplier) / precipRoundingMultiplier;
-      dataStr = String(precipTick, yPrecipMajorTickDecimals);
-#ifdef UNITS_HOURLY_PRECIP_MILLIMETERS
-      String precipUnit = String(" ") + TXT_UNITS_PRECIP_MILLIMETERS;
-#endif
-#ifdef UNITS_HOURLY_PRECIP_CENTIMETERS
-      String precipUnit = String(" ") + TXT_UNITS_PRECIP_CENTIMETERS;
-#endif
-#ifdef UNITS_HOURLY_PRECIP_INCHES
-      String precipUnit = String(" ") + TXT_UNITS_PRECIP_INCHES;
-#endif
-#endif
-
-        drawString(xPos1 + 8, yTick + 4, dataStr, LEFT);
-        display.setFont(&FONT_5pt8b);
-        drawString(display.getCursorX(), yTick + 4, precipUnit, LEFT);
-      }  // end draw labels if precip is >0
-
-      // draw dotted line
-      if (i < yMajorTicks) {
-        for (int x = xPos0; x <= xPos1 + 1; x += 3) {
-          display.drawPixel(x, yTick + (yTick % 2), GxEPD_BLACK);
-        }
-      }
-    }
-
-    int xMaxTicks = 8;
-    int hourInterval = static_cast<int>(ceil(HOURLY_GRAPH_MAX / static_cast<float>(xMaxTicks)));
-    float xInterval = (xPos1 - xPos0 - 1) / static_cast<float>(HOURLY_GRAPH_MAX);
-    display.setFont(&FONT_8pt8b);
-
-    // precalculate all x and y coordinates for temperature values
-    float yPxPerUnit = (yPos1 - yPos0) / static_cast<float>(tempBoundMax - tempBoundMin);
-    std::vector<int> x_t;
-    std::vector<int> y_t;
-    x_t.reserve(HOURLY_GRAPH_MAX);
-    y_t.reserve(HOURLY_GRAPH_MAX);
-    for (int i = 0; i < HOURLY_GRAPH_MAX; ++i) {
-      y_t[i] = celsius_to_plot_y(hourly[i].temp, tempBoundMin, yPxPerUnit, yPos1);
-      x_t[i] = static_cast<int>(std::round(xPos0 + (i * xInterval) + (0.5 * xInterval)));
-    }
-
-#if DISPLAY_HOURLY_ICONS
-    int day_idx = 0;
-#endif
-    display.setFont(&FONT_8pt8b);
-    for (int i = 0; i < HOURLY_GRAPH_MAX; ++i) {
-      int xTick = static_cast<int>(xPos0 + (i * xInterval));
-      int x0_t, x1_t, y0_t, y1_t;
-
-      if (i > 0) {
-        // temperature
-        x0_t = x_t[i - 1];
-        x1_t = x_t[i];
-        y0_t = y_t[i - 1];
-        y1_t = y_t[i];
-
-        // determine colors
-        auto tempToColor = [](float t) -> uint16_t {
-          if (t < COLORS_OUTLOOK_LOW_THRESHOLD_TEMPERATURE)  return COLORS_OUTLOOK_TEMPERATURE_LOW_COLOR;
-          if (t > COLORS_OUTLOOK_HIGH_THRESHOLD_TEMPERATURE) return COLORS_OUTLOOK_TEMPERATURE_HIGH_COLOR;
-          return COLORS_OUTLOOK_TEMPERATURE_NORMAL_COLOR;
-        };
-        uint16_t previousColor = tempToColor(hourly[i - 1].temp);
-        uint16_t currentColor  = tempToColor(hourly[i].temp);
-
-        if (previousColor == currentColor) {
-          // No crossing, draw single line
-          display.drawLine(x0_t, y0_t, x1_t, y1_t, currentColor);
-          display.drawLine(x0_t, y0_t + 1, x1_t, y1_t + 1, currentColor);
-          display.drawLine(x0_t - 1, y0_t, x1_t - 1, y1_t, currentColor);
-        } else {
-          // Threshold crossing detected. Calculate intersection point.
-          // y = mx + b -> We need x where temp is threshold.
-          float t0 = hourly[i - 1].temp;
-          float t1 = hourly[i].temp;
-          // Determine which threshold was crossed.
-          float crossedThreshold = (t0 < COLORS_OUTLOOK_LOW_THRESHOLD_TEMPERATURE || t1 < COLORS_OUTLOOK_LOW_THRESHOLD_TEMPERATURE)
-                                       ? COLORS_OUTLOOK_LOW_THRESHOLD_TEMPERATURE
-                                       : COLORS_OUTLOOK_HIGH_THRESHOLD_TEMPERATURE;
-          float ratio = (crossedThreshold - t0) / (t1 - t0);  // ratio of distance from t0 to threshold
-
-          int x_cross = x0_t + (x1_t - x0_t) * ratio;
-          int y_cross = y0_t + (y1_t - y0_t) * ratio;
-
-          // Draw first segment (from i-1 to crossing)
-          display.drawLine(x0_t, y0_t, x_cross, y_cross, previousColor);
-          display.drawLine(x0_t, y0_t + 1, x_cross, y_cross + 1, previousColor);
-          display.drawLine(x0_t - 1, y0_t, x_cross - 1, y_cross, previousColor);
-
-          // Draw second segment (from crossing to i)
-          display.drawLine(x_cross, y_cross, x1_t, y1_t, currentColor);
-          display.drawLine(x_cross, y_cross + 1, x1_t, y1_t + 1, currentColor);
-          display.drawLine(x_cross - 1, y_cross, x1_t - 1, y1_t, currentColor);
-        }
-
-        // draw hourly bitmap
-#if DISPLAY_HOURLY_ICONS
-        if (daily[day_idx].dt + 86400 <= hourly[i].dt) {
-          ++day_idx;
-        }
-        if ((i % hourInterval) == 0)  // skip first and last tick
-        {
-          int y_b = INT_MAX;
-          // find the highest (lowest in coordinate value) temperature point that
-          // exists within the width of the icon.
-          // find closest point above the temperature line where the icon won't
-          // interect the temperature line.
-          // y = mx + b
-          int span = static_cast<int>(std::round(16 / xInterval));
-          int l_idx = std::max(i - 1 - span, 0);
-          int r_idx = std::min(i + span, HOURLY_GRAPH_MAX - 1);
-          // left intersecting slope
-          float m_l = (y_t[l_idx + 1] - y_t[l_idx]) / xInterval;
-          int x_l = xTick - 16 - x_t[l_idx];
-          int y_l = static_cast<int>(std::round(m_l * x_l + y_t[l_idx]));
-          y_b = std::min(y_l, y_b);
-          // right intersecting slope
-          float m_r = (y_t[r_idx] - y_t[r_idx - 1]) / xInterval;
-          int x_r = xTick + 16 - x_t[r_idx - 1];
-          int y_r = static_cast<int>(std::round(m_r * x_r + y_t[r_idx - 1]));
-          y_b = std::min(y_r, y_b);
-          // any peaks in between
-          for (int idx = l_idx + 1; idx < r_idx; ++idx) {
-            y_b = std::min(y_t[idx], y_b);
-          }
-          const uint8_t *bitmap = getHourlyForecastBitmap32(hourly[i], moon);
-          const uint16_t hourIconAccentColor =
-              getConditionsAccent(hourly[i].weather.condition) == conditions_accent::WORTH_ACCENTING
-                  ? COLORS_OUTLOOK_CONDITIONS_ICON_ACCENT
-                  : GxEPD_BLACK;
-          display.drawInvertedBitmap(xTick - 16, y_b - 32, bitmap, 32, 32, hourIconAccentColor);
-        }
-#endif
-      }
-
-#ifdef UNITS_HOURLY_PRECIP_POP
-      float precipVal = hourly[i].pop;
-#else
-    float precipVal = hourly[i].rain_1h + hourly[i].snow_1h;
-#ifdef UNITS_HOURLY_PRECIP_CENTIMETERS
-    precipVal = millimeters_to_centimeters(precipVal);
-#endif
-#ifdef UNITS_HOURLY_PRECIP_INCHES
-    precipVal = millimeters_to_inches(precipVal);
-#endif
-#endif
-
-      x0_t = static_cast<int>(std::round(xPos0 + 1 + (i * xInterval)));
-      x1_t = static_cast<int>(std::round(xPos0 + 1 + ((i + 1) * xInterval)));
-      yPxPerUnit = (yPos1 - yPos0) / precipBoundMax;
-      y0_t = static_cast<int>(std::round(yPos1 - (yPxPerUnit * (precipVal))));
-      y1_t = yPos1;
-
-      // graph Precipitation
-      for (int y = y1_t - 1; y > y0_t; y -= 2) {
-        for (int x = x0_t + (x0_t % 2); x < x1_t; x += 2) {
-          display.drawPixel(x, y, GxEPD_BLACK);
-        }
-      }
 
-      if ((i % hourInterval) == 0) {
-        // draw x tick marks
-        display.drawLine(xTick, yPos1 + 1, xTick, yPos1 + 4, GxEPD_BLACK);
-        display.drawLine(xTick + 1, yPos1 + 1, xTick + 1, yPos1 + 4, GxEPD_BLACK);
-        // draw x axis labels
-        char timeBuffer[12] = {};  // big enough to accommodate "hh:mm:ss am"
-        time_t ts = hourly[i].dt;
-        tm *timeInfo = localtime(&ts);
-        _strftime(timeBuffer, sizeof(timeBuffer), HOUR_FORMAT, timeInfo);
-        drawString(xTick, yPos1 + 1 + 12 + 4 + 3, timeBuffer, CENTER);
-      }
-    }
-
-    // draw the last tick mark
-    if ((HOURLY_GRAPH_MAX % hourInterval) == 0) {
-      int xTick = static_cast<int>(std::round(xPos0 + (HOURLY_GRAPH_MAX * xInterval)));
-      // draw x tick marks
-      display.drawLine(xTick, yPos1 + 1, xTick, yPos1 + 4, GxEPD_BLACK);
-      display.drawLine(xTick + 1, yPos1 + 1, xTick + 1, yPos1 + 4, GxEPD_BLACK);
-      // draw x axis labels
-      char timeBuffer[12] = {};  // big enough to accommodate "hh:mm:ss am"
-      time_t ts = hourly[HOURLY_GRAPH_MAX - 1].dt + 3600;
-      tm *timeInfo = localtime(&ts);
-      _strftime(timeBuffer, sizeof(timeBuffer), HOUR_FORMAT, timeInfo);
-      drawString(xTick, yPos1 + 1 + 12 + 4 + 3, timeBuffer, CENTER);
-    }
-
-    return;
-  }  // end drawOutlookGraph
+  return;
+}  // end drawOutlookGraph
 
-  /* This function is responsible for drawing the status bar along the bottom of
-   * the display.
-   */
-  void drawStatusBar(const String &statusStr, const String &refreshTimeStr, int rssi, uint32_t batVoltage) {
-    String dataStr;
-    uint16_t dataColor = GxEPD_BLACK;
-    display.setFont(&FONT_6pt8b);
-    int pos = DISP_WIDTH - 6;
-    const int sp = 2;
+/* This function is responsible for drawing the status bar along the bottom of
+ * the scene.
+ */
+void drawStatusBar(const status_bar_view_t &view) {
+  scene->setFont(&FONT_6pt8b);
+  int pos = DISP_WIDTH - 6;
+  const int sp = 2;
 
 #if BATTERY_MONITORING
-    // battery - (expecting 3.7v LiPo)
-    uint8_t batPercent = calcBatPercent(batVoltage, MIN_BATTERY_VOLTAGE, MAX_BATTERY_VOLTAGE);
-#if defined(EPD_PANEL_GENERIC_3C_B) || defined(EPD_PANEL_DKE_3C_86BF) || defined(EPD_PANEL_GENERIC_7C_F)
-    if (batVoltage < WARN_BATTERY_VOLTAGE) {
-      dataColor = COLORS_STATUS_BAR_BATTERY_WARNING;
-    }
-#endif
-    dataStr = String(batPercent) + "%";
-#if STATUS_BAR_EXTRAS_BAT_VOLTAGE
-    dataStr += " (" + String(std::round(batVoltage / 10.f) / 100.f, 2) + "v)";
-#endif
-    drawString(pos, DISP_HEIGHT - 1 - 4, dataStr, RIGHT, dataColor);
-    pos -= getStringWidth(dataStr) + 25;
-    display.drawInvertedBitmap(pos, DISP_HEIGHT - 1 - 19, getBatBitmap24(batPercent), 24, 24, dataColor);
-    pos -= sp + 9;
-#endif
-
-    // WiFi
-    dataStr = String(getWiFidesc(rssi));
-    dataColor = rssi >= -70 ? GxEPD_BLACK : COLORS_STATUS_BAR_WEAK_WIFI;
-#if STATUS_BAR_EXTRAS_WIFI_RSSI
-    if (rssi != 0) {
-      dataStr += " (" + String(rssi) + "dBm)";
-    }
-#endif
-    drawString(pos, DISP_HEIGHT - 1 - 4, dataStr, RIGHT, dataColor);
-    pos -= getStringWidth(dataStr) + 19;
-    display.drawInvertedBitmap(pos, DISP_HEIGHT - 1 - 15, getWiFiBitmap16(rssi), 16, 16, dataColor);
-    pos -= sp + 8;
-
-    // last refresh
-    dataColor = GxEPD_BLACK;
-    drawString(pos, DISP_HEIGHT - 1 - 4, refreshTimeStr, RIGHT, dataColor);
-    pos -= getStringWidth(refreshTimeStr) + 25;
-    display.drawInvertedBitmap(pos, DISP_HEIGHT - 1 - 23, wi_refresh_32x32, 32, 32, dataColor);
-    pos -= sp;
-
-    // status
-    if (!statusStr.isEmpty()) {
-      drawString(pos, DISP_HEIGHT - 1 - 4, statusStr, RIGHT, COLORS_STATUS_BAR_MESSAGE);
-      pos -= getStringWidth(statusStr) + 24;
-      display.drawInvertedBitmap(pos, DISP_HEIGHT - 1 - 20, error_icon_24x24, 24, 24, COLORS_STATUS_BAR_MESSAGE);
-    }
+  // battery
+  pos -= drawString(pos, DISP_HEIGHT - 1 - 4, view.batteryText, RIGHT, view.batteryColor) + 25;
+  scene->drawInvertedBitmap(pos, DISP_HEIGHT - 1 - 19, view.batteryIcon, 24, 24, view.batteryColor);
+  pos -= sp + 9;
+#endif
+
+  // WiFi
+  pos -= drawString(pos, DISP_HEIGHT - 1 - 4, view.wifiText, RIGHT, view.wifiColor) + 19;
+  scene->drawInvertedBitmap(pos, DISP_HEIGHT - 1 - 15, view.wifiIcon, 16, 16, view.wifiColor);
+  pos -= sp + 8;
+
+  // last refresh
+  pos -= drawString(pos, DISP_HEIGHT - 1 - 4, view.refreshTime, RIGHT, GxEPD_BLACK) + 25;
+  scene->drawInvertedBitmap(pos, DISP_HEIGHT - 1 - 23, wi_refresh_32x32, 32, 32, GxEPD_BLACK);
+  pos -= sp;
+
+  // status
+  if (view.status[0] != '\0') {
+    pos -= drawString(pos, DISP_HEIGHT - 1 - 4, view.status, RIGHT, COLORS_STATUS_BAR_MESSAGE) + 24;
+    scene->drawInvertedBitmap(pos, DISP_HEIGHT - 1 - 20, error_icon_24x24, 24, 24, COLORS_STATUS_BAR_MESSAGE);
+  }
 
-    return;
-  }  // end drawStatusBar
+  return;
+}  // end drawStatusBar
 
   /* This function is responsible for drawing prominent error messages to the
    * screen.
@@ -1503,14 +577,14 @@ void drawCurrentVisibility(const current_t &current) {
    * wrapped.
    */
   void drawError(const uint8_t *bitmap_196x196, const String &errMsgLn1, const String &errMsgLn2) {
-    display.setFont(&FONT_26pt8b);
+    scene->setFont(&FONT_26pt8b);
     if (!errMsgLn2.isEmpty()) {
       drawString(DISP_WIDTH / 2, DISP_HEIGHT / 2 + 196 / 2 + 21, errMsgLn1, CENTER);
       drawString(DISP_WIDTH / 2, DISP_HEIGHT / 2 + 196 / 2 + 21 + 55, errMsgLn2, CENTER);
     } else {
       drawMultiLnString(DISP_WIDTH / 2, DISP_HEIGHT / 2 + 196 / 2 + 21, errMsgLn1, CENTER, DISP_WIDTH - 200, 2, 55);
     }
-    display.drawInvertedBitmap(DISP_WIDTH / 2 - 196 / 2, DISP_HEIGHT / 2 - 196 / 2 - 21, bitmap_196x196, 196, 196,
+    scene->drawInvertedBitmap(DISP_WIDTH / 2 - 196 / 2, DISP_HEIGHT / 2 - 196 / 2 - 21, bitmap_196x196, 196, 196,
                                COLORS_ERROR_ICON);
     return;
   }  // end drawError
@@ -0,0 +1,440 @@
+/* Response cache — parsed provider results reused across deep sleep.
+ * Copyright (C) 2026  Lumixen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#include "response_cache.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <strings.h>
+#include <esp_partition.h>
+#include <esp_rom_crc.h>
+#include <time.h>
+
+#include "logger.h"
+
+namespace response_cache {
+
+void encode(Writer &out, const forecast_t &forecast) {
+  out.value(forecast.lat);
+  out.value(forecast.lon);
+  out.string(forecast.timezone);
+  out.value(forecast.timezone_offset);
+  // The remaining members are plain data; the layout id guards their size.
+  out.value(forecast.current);
+  out.value(forecast.hourly);
+  out.value(forecast.daily);
+}
+
+void encode(Writer &out, const air_quality_t &airQuality) { out.value(airQuality); }
+
+void encode(Writer &out, const std::vector<weather_alert_t> &alerts) {
+  out.value(static_cast<uint32_t>(alerts.size()));
+  for (const weather_alert_t &alert : alerts) {
+    out.string(alert.sender_name);
+    out.string(alert.event);
+    out.value(alert.start);
+    out.value(alert.end);
+    out.string(alert.description);
+    out.string(alert.tags);
+  }
+}
+
+bool decode(Reader &in, forecast_t &forecast) {
+  // Decoded aside (on the heap, it is a few KB) so a bad record never
+  // leaves the model half overwritten.
+  std::unique_ptr<forecast_t> decoded(new forecast_t());
+  in.value(decoded->lat);
+  in.value(decoded->lon);
+  in.string(decoded->timezone);
+  in.value(decoded->timezone_offset);
+  in.value(decoded->current);
+  in.value(decoded->hourly);
+  in.value(decoded->daily);
+  if (!in.atEnd()) {
+    return false;
+  }
+  forecast = *decoded;
+  return true;
+}
+
+bool decode(Reader &in, air_quality_t &airQuality) {
+  air_quality_t decoded;
+  in.value(decoded);
+  if (!in.atEnd()) {
+    return false;
+  }
+  airQuality = decoded;
+  return true;
+}
+
+bool decode(Reader &in, std::vector<weather_alert_t> &alerts) {
+  uint32_t count = 0;
+  // Each alert takes at least its four string lengths and two timestamps,
+  // which bounds the count before anything is allocated.
+  constexpr uint32_t MIN_ALERT_BYTES = 4 * sizeof(uint32_t) + 2 * sizeof(int64_t);
+  if (!in.value(count) || count > MAX_PAYLOAD / MIN_ALERT_BYTES) {
+    return false;
+  }
+  std::vector<weather_alert_t> decoded(count);
+  for (weather_alert_t &alert : decoded) {
+    in.string(alert.sender_name);
+    in.string(alert.event);
+    in.value(alert.start);
+    in.value(alert.end);
+    in.string(alert.description);
+    in.string(alert.tags);
+  }
+  if (!in.atEnd()) {
+    return false;
+  }
+  alerts = std::move(decoded);
+  return true;
+}
+
+void dropExpiredAlerts(std::vector<weather_alert_t> &alerts, int64_t now) {
+  alerts.erase(std::remove_if(alerts.begin(), alerts.end(),
+                              [now](const weather_alert_t &alert) { return alert.end > 0 && alert.end < now; }),
+               alerts.end());
+}
+
+namespace {
+
+/* Days from civil epoch (1970-01-01), from Howard Hinnant's date algorithms. */
+int64_t daysFromCivil(int y, unsigned m, unsigned d) {
+  y -= (m <= 2);
+  const int era = (y >= 0 ? y : y - 399) / 400;
+  const unsigned yoe = static_cast<unsigned>(y - era * 400);
+  const unsigned doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+  const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+  return static_cast<int64_t>(era) * 146097 + static_cast<int64_t>(doe) - 719468;
+}
+
+// Case-insensitive match of `directive` at `p`, ending at a delimiter.
+bool directiveIs(const char *p, size_t len, const char *directive) {
+  const size_t n = strlen(directive);
+  return len == n && strncasecmp(p, directive, n) == 0;
+}
+
+}  // namespace
+
+int64_t parseHttpDate(const char *text) {
+  static const char MONTHS[] = "JanFebMarAprMayJunJulAugSepOctNovDec";
+  if (text == nullptr) {
+    return -1;
+  }
+  char weekday[4] = {};
+  char month[4] = {};
+  char zone[4] = {};
+  int day = 0;
+  int year = 0;
+  int hour = 0;
+  int minute = 0;
+  int second = 0;
+  if (sscanf(text, "%3s, %d %3s %d %d:%d:%d %3s", weekday, &day, month, &year, &hour, &minute, &second, zone) != 8 ||
+      strcmp(zone, "GMT") != 0) {
+    return -1;
+  }
+  const char *found = strstr(MONTHS, month);
+  if (found == nullptr || strlen(month) != 3 || (found - MONTHS) % 3 != 0) {
+    return -1;
+  }
+  const unsigned mon = static_cast<unsigned>((found - MONTHS) / 3 + 1);
+  if (day < 1 || day > 31 || hour > 23 || minute > 59 || second > 60 || year < 1970) {
+    return -1;
+  }
+  return daysFromCivil(year, mon, static_cast<unsigned>(day)) * 86400 + hour * 3600 + minute * 60 + second;
+}
+
+int32_t maxAgeFromHeaders(const char *cacheControl, const char *expires, const char *date, int64_t now) {
+  if (cacheControl != nullptr) {
+    int32_t maxAge = -1;
+    const char *p = cacheControl;
+    while (*p != '\0') {
+      while (*p == ' ' || *p == '\t' || *p == ',') {
+        ++p;
+      }
+      const char *start = p;
+      while (*p != '\0' && *p != ',' && *p != '=') {
+        ++p;
+      }
+      size_t len = static_cast<size_t>(p - start);
+      while (len > 0 && (start[len - 1] == ' ' || start[len - 1] == '\t')) {
+        --len;
+      }
+      const char *value = nullptr;
+      if (*p == '=') {
+        value = ++p;
+        while (*p != '\0' && *p != ',') {
+          ++p;
+        }
+      }
+      if (directiveIs(start, len, "no-store") || directiveIs(start, len, "no-cache")) {
+        return 0;
+      }
+      if (value != nullptr && directiveIs(start, len, "max-age")) {
+        if (*value == '"') {
+          ++value;
+        }
+        if (isdigit(static_cast<unsigned char>(*value))) {
+          const long seconds = strtol(value, nullptr, 10);
+          maxAge = seconds > INT32_MAX ? INT32_MAX : static_cast<int32_t>(seconds);
+        }
+      }
+    }
+    if (maxAge >= 0) {
+      return maxAge;
+    }
+  }
+  if (expires != nullptr) {
+    const int64_t expiresAt = parseHttpDate(expires);
+    if (expiresAt < 0) {
+      return 0;  // invalid Expires (e.g. "0") means already expired
+    }
+    const int64_t dateAt = parseHttpDate(date);
+    const int64_t delta = expiresAt - (dateAt >= 0 ? dateAt : now);
+    if (delta <= 0) {
+      return 0;
+    }
+    return delta > INT32_MAX ? INT32_MAX : static_cast<int32_t>(delta);
+  }
+  return -1;
+}
+
+}  // namespace response_cache
+
+using namespace response_cache;
+
+namespace {
+
+constexpr size_t SECTOR_SIZE = 4096;
+constexpr size_t KIND_COUNT = static_cast<size_t>(FetchKind::COUNT);
+
+// Any change of the firmware build or of the model layout gives a different
+// id, so records written by another build are never decoded.
+uint32_t layoutId() {
+  const uint32_t sizes[] = {
+      static_cast<uint32_t>(SLOT_MAGIC),       static_cast<uint32_t>(sizeof(current_t)),
+      static_cast<uint32_t>(sizeof(hourly_t)), static_cast<uint32_t>(sizeof(daily_t)),
+      static_cast<uint32_t>(NUM_HOURLY),       static_cast<uint32_t>(NUM_DAILY),
+      static_cast<uint32_t>(sizeof(air_quality_t)),
+  };
+  const uint32_t crc = esp_rom_crc32_le(0, reinterpret_cast<const uint8_t *>(sizes), sizeof(sizes));
+  return esp_rom_crc32_le(crc, reinterpret_cast<const uint8_t *>(BUILD_VERSION), strlen(BUILD_VERSION));
+}
+
+const esp_partition_t *cachePartition() {
+  static const esp_partition_t *partition =
+      esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_DATA_SPIFFS, "spiffs");
+  return partition;
+}
+
+/* The partition is split into one region per FetchKind, each a ring of
+ * SLOT_SIZE slots: every write goes to the slot after the newest record, so
+ * erases are spread over the whole region. */
+size_t slotsPerKind(const esp_partition_t *partition) {
+  return (partition->size / SECTOR_SIZE / KIND_COUNT) * SECTOR_SIZE / SLOT_SIZE;
+}
+
+size_t slotOffset(const esp_partition_t *partition, FetchKind kind, size_t slot) {
+  return (static_cast<size_t>(kind) * slotsPerKind(partition) + slot) * SLOT_SIZE;
+}
+
+// Newest valid header of `kind`; returns false when the region holds none.
+bool findNewest(const esp_partition_t *partition, FetchKind kind, SlotHeader &newest, size_t &newestSlot) {
+  const uint32_t layout = layoutId();
+  bool found = false;
+  for (size_t slot = 0; slot < slotsPerKind(partition); ++slot) {
+    SlotHeader header;
+    if (esp_partition_read(partition, slotOffset(partition, kind, slot), &header, sizeof(header)) != ESP_OK) {
+      continue;
+    }
+    if (header.magic != SLOT_MAGIC || header.layout != layout || header.kind != static_cast<uint8_t>(kind) ||
+        header.length > MAX_PAYLOAD) {
+      continue;
+    }
+    if (!found || static_cast<int32_t>(header.sequence - newest.sequence) > 0) {
+      newest = header;
+      newestSlot = slot;
+      found = true;
+    }
+  }
+  return found;
+}
+
+template <typename Model>
+bool restore(FetchKind kind, Model &model) {
+  if (!responseCacheEnabled() || responseCacheTtlMinutes(kind) == 0) {
+    return false;
+  }
+  const esp_partition_t *partition = cachePartition();
+  if (partition == nullptr) {
+    return false;
+  }
+  SlotHeader header;
+  size_t slot = 0;
+  if (!findNewest(partition, kind, header, slot)) {
+    LOG_DEBUG("Response cache %s: no record", fetchKindName(kind));
+    return false;
+  }
+  const int64_t now = time(nullptr);
+  if (!isFresh(header, now)) {
+    LOG_DEBUG("Response cache %s: stale (fetched %lld s ago, lifetime %lld s)", fetchKindName(kind),
+              static_cast<long long>(now - header.fetchedAt),
+              static_cast<long long>(header.expiresAt - header.fetchedAt));
+    return false;
+  }
+  std::vector<uint8_t> payload(header.length);
+  if (esp_partition_read(partition, slotOffset(partition, kind, slot) + sizeof(SlotHeader), payload.data(),
+                         payload.size()) != ESP_OK ||
+      esp_rom_crc32_le(0, payload.data(), payload.size()) != header.crc) {
+    LOG_WARNING("Response cache %s: corrupt record in slot %u", fetchKindName(kind), static_cast<unsigned>(slot));
+    return false;
+  }
+  Reader in(payload.data(), payload.size());
+  if (!decode(in, model)) {
+    LOG_WARNING("Response cache %s: undecodable record in slot %u", fetchKindName(kind), static_cast<unsigned>(slot));
+    return false;
+  }
+  LOG_INFO("Response cache %s: hit, fetched %lld s ago, expires in %lld s", fetchKindName(kind),
+           static_cast<long long>(now - header.fetchedAt), static_cast<long long>(header.expiresAt - now));
+  return true;
+}
+
+struct Staged {
+  bool pending;
+  int64_t fetchedAt;
+  int32_t lifetime;
+  std::vector<uint8_t> payload;
+};
+
+Staged staged[KIND_COUNT];
+
+template <typename Model>
+void stage(FetchKind kind, const Model &model, int32_t maxAge) {
+  if (!responseCacheEnabled()) {
+    return;
+  }
+  const int32_t lifetime = lifetimeSeconds(responseCacheTtlMinutes(kind), maxAge);
+  Staged &entry = staged[static_cast<size_t>(kind)];
+  entry.pending = false;
+  entry.payload.clear();
+  if (lifetime <= 0) {
+    return;
+  }
+  Writer out(entry.payload);
+  encode(out, model);
+  if (entry.payload.size() > MAX_PAYLOAD) {
+    LOG_DEBUG("Response cache %s: %u B record exceeds the slot, not kept", fetchKindName(kind),
+              static_cast<unsigned>(entry.payload.size()));
+    entry.payload.clear();
+    entry.payload.shrink_to_fit();
+    return;
+  }
+  entry.fetchedAt = time(nullptr);
+  entry.lifetime = lifetime;
+  entry.pending = true;
+}
+
+void write(const esp_partition_t *partition, FetchKind kind, Staged &entry) {
+  SlotHeader newest;
+  size_t slot = 0;
+  uint32_t sequence = 0;
+  if (findNewest(partition, kind, newest, slot)) {
+    slot = (slot + 1) % slotsPerKind(partition);
+    sequence = newest.sequence + 1;
+  }
+  const size_t offset = slotOffset(partition, kind, slot);
+
+  SlotHeader header = {};
+  header.magic = SLOT_MAGIC;
+  header.layout = layoutId();
+  header.sequence = sequence;
+  header.length = static_cast<uint32_t>(entry.payload.size());
+  header.crc = esp_rom_crc32_le(0, entry.payload.data(), entry.payload.size());
+  header.kind = static_cast<uint8_t>(kind);
+  header.fetchedAt = entry.fetchedAt;
+  header.expiresAt = entry.fetchedAt + entry.lifetime;
+
+  // Payload first, header last: the header is what makes a record valid.
+  esp_err_t err = esp_partition_erase_range(partition, offset, SLOT_SIZE);
+  if (err == ESP_OK) {
+    err = esp_partition_write(partition, offset + sizeof(SlotHeader), entry.payload.data(), entry.payload.size());
+  }
+  if (err == ESP_OK) {
+    err = esp_partition_write(partition, offset, &header, sizeof(header));
+  }
+  if (err != ESP_OK) {
+    LOG_WARNING("Response cache %s: write failed: %s", fetchKindName(kind), esp_err_to_name(err));
+    return;
+  }
+  LOG_DEBUG("Response cache %s: %u B kept in slot %u for %d s", fetchKindName(kind),
+            static_cast<unsigned>(header.length), static_cast<unsigned>(slot), static_cast<int>(entry.lifetime));
+}
+
+}  // namespace
+
+int32_t responseCacheTtlMinutes(FetchKind kind) {
+  switch (kind) {
+    case FetchKind::WEATHER:
+      return RESPONSE_CACHE_WEATHER_TTL;
+    case FetchKind::AIR_QUALITY:
+      return RESPONSE_CACHE_AIR_QUALITY_TTL;
+    case FetchKind::ALERTS:
+      return RESPONSE_CACHE_ALERTS_TTL;
+    default:
+      return 0;
+  }
+}
+
+bool responseCacheRestore(forecast_t &forecast) { return restore(FetchKind::WEATHER, forecast); }
+
+bool responseCacheRestore(air_quality_t &airQuality) { return restore(FetchKind::AIR_QUALITY, airQuality); }
+
+bool responseCacheRestore(std::vector<weather_alert_t> &alerts) {
+  if (!restore(FetchKind::ALERTS, alerts)) {
+    return false;
+  }
+  dropExpiredAlerts(alerts, time(nullptr));
+  return true;
+}
+
+void responseCacheStage(const forecast_t &forecast, int32_t maxAge) { stage(FetchKind::WEATHER, forecast, maxAge); }
+
+void responseCacheStage(const air_quality_t &airQuality, int32_t maxAge) {
+  stage(FetchKind::AIR_QUALITY, airQuality, maxAge);
+}
+
+void responseCacheStage(const std::vector<weather_alert_t> &alerts, int32_t maxAge) {
+  stage(FetchKind::ALERTS, alerts, maxAge);
+}
+
+void responseCacheFlush() {
+  if (!responseCacheEnabled()) {
+    return;
+  }
+  const esp_partition_t *partition = cachePartition();
+  if (partition == nullptr) {
+    LOG_WARNING("Response cache: no \"spiffs\" partition, results not kept");
+  }
+  for (size_t i = 0; i < KIND_COUNT; ++i) {
+    Staged &entry = staged[i];
+    if (!entry.pending) {
+      continue;
+    }
+    if (partition != nullptr) {
+      write(partition, static_cast<FetchKind>(i), entry);
+    }
+    entry.pending = false;
+    entry.payload.clear();
+    entry.payload.shrink_to_fit();
+  }
+}
@@ -0,0 +1,84 @@
+/* Task stack high-water marks, kept in RTC memory, and stack auto-sizing.
+ * Copyright (C) 2026  Lumixen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#include "stack_watermark.h"
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#include "logger.h"
+#include "wake_profiler.h"
+
+namespace stack_watermark {
+
+const char *slotName(StackSlot slot) {
+  switch (slot) {
+    case StackSlot::FETCH_WEATHER:
+      return "fetch_weather";
+    case StackSlot::FETCH_AIR_QUALITY:
+      return "fetch_air_quality";
+    case StackSlot::FETCH_ALERTS:
+      return "fetch_alerts";
+    case StackSlot::ENV_SENSOR:
+      return "env_sensor";
+    case StackSlot::MQTT:
+      return "mqtt";
+    case StackSlot::MAIN:
+      return "main";
+    case StackSlot::PARSE:
+      return "parse";
+    default:
+      return "unknown";
+  }
+}
+
+}  // namespace stack_watermark
+
+// Deepest stack use per task since power-on (RTC memory, survives deep
+// sleep; cleared by a power-on reset).
+static RTC_DATA_ATTR stack_watermark::Store stackWatermarkStore = {};
+
+// Fetch workers end concurrently: the store is guarded by a spinlock (short,
+// non-blocking critical sections only).
+static portMUX_TYPE stackWatermarkMux = portMUX_INITIALIZER_UNLOCKED;
+
+void stackWatermarkRecordTask(StackSlot slot, void *task, uint32_t stackBytes) {
+  if (task == nullptr) {
+    return;
+  }
+  // Bytes on the ESP32 (StackType_t is a byte).
+  const uint32_t highWater = uxTaskGetStackHighWaterMark(static_cast<TaskHandle_t>(task));
+  const uint32_t used = stack_watermark::usedBytes(stackBytes, highWater);
+  portENTER_CRITICAL(&stackWatermarkMux);
+  stack_watermark::ensureValid(stackWatermarkStore);
+  stack_watermark::record(stackWatermarkStore, slot, stackBytes, highWater);
+  portEXIT_CRITICAL(&stackWatermarkMux);
+  wakeProfilerRecordStack(slot, used);
+  LOG_DEBUG("Stack %s: %u of %u B used", stack_watermark::slotName(slot), static_cast<unsigned>(used),
+            static_cast<unsigned>(stackBytes));
+  if (highWater < stack_watermark::MARGIN_BYTES) {
+    LOG_WARNING("Stack %s: only %u B were left free", stack_watermark::slotName(slot),
+                static_cast<unsigned>(highWater));
+  }
+}
+
+void stackWatermarkRecord(StackSlot slot, uint32_t stackBytes) {
+  stackWatermarkRecordTask(slot, xTaskGetCurrentTaskHandle(), stackBytes);
+}
+
+uint32_t stackSizeFor(StackSlot slot, uint32_t defaultBytes) {
+  if (!stackAutoSizeEnabled()) {
+    return defaultBytes;
+  }
+  portENTER_CRITICAL(&stackWatermarkMux);
+  const uint32_t bytes = stack_watermark::sizeFor(stackWatermarkStore, slot, defaultBytes);
+  portEXIT_CRITICAL(&stackWatermarkMux);
+  return bytes;
+}
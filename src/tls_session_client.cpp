@@ -0,0 +1,420 @@
+/* TLS client with session resumption, for HTTPClient.
+ * Copyright (C) 2026  Lumixen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#include "tls_session_client.h"
+
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <vector>
+#include <fcntl.h>
+#include <lwip/sockets.h>
+#include <mbedtls/ctr_drbg.h>
+#include <mbedtls/entropy.h>
+#include <mbedtls/net_sockets.h>
+#include <mbedtls/platform_util.h>
+#include <mbedtls/ssl.h>
+#include <mbedtls/x509_crt.h>
+
+#include "logger.h"
+#include "tls_session_cache.h"
+#include "wake_profiler.h"
+
+// Sessions and handshake statistics per host (RTC memory, survives deep
+// sleep; cleared by a power-on reset).
+static RTC_DATA_ATTR tls_session::Store tlsSessionStore = {};
+
+// Fetch workers connect concurrently: the store is guarded by a spinlock
+// (short, non-blocking critical sections only).
+static portMUX_TYPE tlsSessionMux = portMUX_INITIALIZER_UNLOCKED;
+
+namespace {
+
+constexpr size_t MASTER_LEN = 48;
+
+int socketSend(void *ctx, const unsigned char *buf, size_t len) {
+  const int fd = *static_cast<int *>(ctx);
+  const int n = send(fd, buf, len, 0);
+  if (n >= 0) {
+    return n;
+  }
+  return (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) ? MBEDTLS_ERR_SSL_WANT_WRITE
+                                                                     : MBEDTLS_ERR_NET_SEND_FAILED;
+}
+
+int socketRecv(void *ctx, unsigned char *buf, size_t len) {
+  const int fd = *static_cast<int *>(ctx);
+  const int n = recv(fd, buf, len, 0);
+  if (n >= 0) {
+    return n;  // 0 = EOF
+  }
+  return (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) ? MBEDTLS_ERR_SSL_WANT_READ
+                                                                     : MBEDTLS_ERR_NET_RECV_FAILED;
+}
+
+// Copy of the session cached for `hash` (empty when none).
+std::vector<uint8_t> cachedSession(uint32_t hash) {
+  std::vector<uint8_t> session;
+  if (!tlsSessionResumptionEnabled()) {
+    return session;
+  }
+  session.resize(tls_session::SESSION_BYTES);
+  portENTER_CRITICAL(&tlsSessionMux);
+  tls_session::ensureValid(tlsSessionStore);
+  const tls_session::Slot *slot = tls_session::find(tlsSessionStore, hash);
+  const size_t len = slot != nullptr ? slot->length : 0;
+  if (len > 0) {
+    memcpy(session.data(), slot->data, len);
+  }
+  portEXIT_CRITICAL(&tlsSessionMux);
+  session.resize(len);
+  return session;
+}
+
+}  // namespace
+
+/* The mbedTLS state of one connection, a few KB: allocated by handshake()
+ * and freed by release(), so it never sits on the stack of the fetch worker
+ * that holds the client, nor on the heap while the client is idle. */
+struct TlsSessionClient::Contexts {
+  mbedtls_ssl_context ssl;
+  mbedtls_ssl_config conf;
+  mbedtls_ctr_drbg_context drbg;
+  mbedtls_entropy_context entropy;
+  mbedtls_x509_crt ca;
+
+  Contexts() {
+    mbedtls_ssl_init(&ssl);
+    mbedtls_ssl_config_init(&conf);
+    mbedtls_ctr_drbg_init(&drbg);
+    mbedtls_entropy_init(&entropy);
+    mbedtls_x509_crt_init(&ca);
+  }
+  ~Contexts() {
+    mbedtls_ssl_free(&ssl);
+    mbedtls_ssl_config_free(&conf);
+    mbedtls_ctr_drbg_free(&drbg);
+    mbedtls_entropy_free(&entropy);
+    mbedtls_x509_crt_free(&ca);
+  }
+};
+
+TlsSessionClient::TlsSessionClient() = default;
+
+TlsSessionClient::~TlsSessionClient() { stop(); }
+
+int TlsSessionClient::connect(IPAddress ip, uint16_t port) { return connect(ip, port, timeoutMs_); }
+
+int TlsSessionClient::connect(IPAddress ip, uint16_t port, int32_t timeout) {
+  return connect(ip.toString().c_str(), port, timeout);
+}
+
+int TlsSessionClient::connect(const char *host, uint16_t port) { return connect(host, port, timeoutMs_); }
+
+int TlsSessionClient::connect(const char *host, uint16_t port, int32_t timeout) {
+  stop();
+  timeoutMs_ = timeout > 0 ? timeout : timeoutMs_;
+  if (!WiFiClient::connect(host, port, timeoutMs_)) {
+    return 0;
+  }
+  socket_ = fd();
+  fcntl(socket_, F_SETFL, fcntl(socket_, F_GETFL, 0) | O_NONBLOCK);
+  if (!handshake(host, timeoutMs_)) {
+    stop();
+    return 0;
+  }
+  return 1;
+}
+
+/* Set up mbedTLS on the connected socket, offer the session cached for
+ * `host` and run the handshake. The session it ended with (resumed or new)
+ * replaces the cached one. */
+bool TlsSessionClient::handshake(const char *host, int32_t timeout) {
+  peerClosed_ = false;
+  peeked_ = -1;
+  resumed_ = false;
+  tls_ = new (std::nothrow) Contexts();
+  if (tls_ == nullptr) {
+    LOG_ERROR("TLS setup failed: no heap for the contexts (%u B)", static_cast<unsigned>(sizeof(Contexts)));
+    return false;
+  }
+  mbedtls_ssl_context &ssl = tls_->ssl;
+  mbedtls_ssl_config &conf = tls_->conf;
+  mbedtls_ctr_drbg_context &drbg = tls_->drbg;
+  mbedtls_entropy_context &entropy = tls_->entropy;
+  mbedtls_x509_crt &ca = tls_->ca;
+
+  int ret = mbedtls_ctr_drbg_seed(&drbg, mbedtls_entropy_func, &entropy, nullptr, 0);
+  if (ret == 0) {
+    ret = mbedtls_ssl_config_defaults(&conf, MBEDTLS_SSL_IS_CLIENT, MBEDTLS_SSL_TRANSPORT_STREAM,
+                                      MBEDTLS_SSL_PRESET_DEFAULT);
+  }
+  if (ret == 0 && rootCA_ != nullptr) {
+    ret = mbedtls_x509_crt_parse(&ca, reinterpret_cast<const unsigned char *>(rootCA_), strlen(rootCA_) + 1);
+  }
+  if (ret != 0) {
+    LOG_ERROR("TLS setup failed: -0x%04X", static_cast<unsigned>(-ret));
+    return false;
+  }
+  if (rootCA_ != nullptr) {
+    mbedtls_ssl_conf_ca_chain(&conf, &ca, nullptr);
+    mbedtls_ssl_conf_authmode(&conf, MBEDTLS_SSL_VERIFY_REQUIRED);
+  } else {
+    mbedtls_ssl_conf_authmode(&conf, MBEDTLS_SSL_VERIFY_NONE);
+  }
+  mbedtls_ssl_conf_rng(&conf, mbedtls_ctr_drbg_random, &drbg);
+  mbedtls_ssl_conf_session_tickets(&conf, MBEDTLS_SSL_SESSION_TICKETS_ENABLED);
+  ret = mbedtls_ssl_setup(&ssl, &conf);
+  if (ret == 0) {
+    ret = mbedtls_ssl_set_hostname(&ssl, host);
+  }
+  if (ret != 0) {
+    LOG_ERROR("TLS setup failed: -0x%04X", static_cast<unsigned>(-ret));
+    return false;
+  }
+  mbedtls_ssl_set_bio(&ssl, &socket_, socketSend, socketRecv, nullptr);
+
+  // Offer the cached session. Its master secret tells afterwards whether the
+  // server resumed it: the session ID cannot, a ticket comes with a fresh one.
+  const uint32_t hostHash = tls_session::hashHost(host);
+  unsigned char offeredMaster[MASTER_LEN];
+  bool offered = false;
+  std::vector<uint8_t> cached = cachedSession(hostHash);
+  if (!cached.empty()) {
+    mbedtls_ssl_session session;
+    mbedtls_ssl_session_init(&session);
+    if (mbedtls_ssl_session_load(&session, cached.data(), cached.size()) == 0 &&
+        mbedtls_ssl_set_session(&ssl, &session) == 0) {
+      memcpy(offeredMaster, session.MBEDTLS_PRIVATE(master), MASTER_LEN);
+      offered = true;
+    }
+    mbedtls_ssl_session_free(&session);
+    mbedtls_platform_zeroize(cached.data(), cached.size());
+  }
+
+  const uint32_t start = millis();
+  while ((ret = mbedtls_ssl_handshake(&ssl)) != 0) {
+    const uint32_t elapsed = millis() - start;
+    if ((ret != MBEDTLS_ERR_SSL_WANT_READ && ret != MBEDTLS_ERR_SSL_WANT_WRITE) ||
+        elapsed >= static_cast<uint32_t>(timeout)) {
+      break;
+    }
+    waitSocket(ret == MBEDTLS_ERR_SSL_WANT_WRITE, timeout - elapsed);
+  }
+  handshakeMs_ = millis() - start;
+  if (ret != 0) {
+    LOG_ERROR("TLS handshake with %s failed: -0x%04X", host, static_cast<unsigned>(-ret));
+    if (offered) {
+      // Never offer a session a failed handshake started from again.
+      portENTER_CRITICAL(&tlsSessionMux);
+      if (tls_session::Slot *slot = tls_session::find(tlsSessionStore, hostHash)) {
+        tls_session::forget(*slot);
+      }
+      portEXIT_CRITICAL(&tlsSessionMux);
+      mbedtls_platform_zeroize(offeredMaster, MASTER_LEN);
+    }
+    return false;
+  }
+
+  const mbedtls_ssl_session *current = mbedtls_ssl_get_session_pointer(&ssl);
+  resumed_ = offered && memcmp(current->MBEDTLS_PRIVATE(master), offeredMaster, MASTER_LEN) == 0;
+  mbedtls_platform_zeroize(offeredMaster, MASTER_LEN);
+  wakeProfilerRecord(resumed_ ? WakePhase::TLS_RESUMED : WakePhase::TLS_FULL, wakeProfilerTaskTag(), start,
+                     handshakeMs_);
+  LOG_DEBUG("TLS %s handshake with %s: %u ms", resumed_ ? "resumed" : "full", host,
+            static_cast<unsigned>(handshakeMs_));
+
+  // Serialize the session outside the lock, then keep it with the stats. A
+  // resumed handshake may have renewed the ticket, so it is saved as well.
+  std::vector<uint8_t> saved;
+  if (tlsSessionResumptionEnabled()) {
+    mbedtls_ssl_session session;
+    mbedtls_ssl_session_init(&session);
+    size_t len = 0;
+    saved.resize(tls_session::SESSION_BYTES);
+    if (mbedtls_ssl_get_session(&ssl, &session) != 0 ||
+        mbedtls_ssl_session_save(&session, saved.data(), saved.size(), &len) != 0) {
+      len = 0;  // too large (peer certificate kept?) or no session to keep
+    }
+    mbedtls_ssl_session_free(&session);
+    saved.resize(len);
+  }
+  bool kept = false;
+  portENTER_CRITICAL(&tlsSessionMux);
+  tls_session::ensureValid(tlsSessionStore);
+  tls_session::Slot &slot = tls_session::acquire(tlsSessionStore, hostHash);
+  tls_session::recordHandshake(slot, resumed_, handshakeMs_);
+  if (tlsSessionResumptionEnabled()) {
+    kept = tls_session::save(tlsSessionStore, slot, saved.data(), saved.size());
+  }
+  portEXIT_CRITICAL(&tlsSessionMux);
+  if (!saved.empty()) {
+    mbedtls_platform_zeroize(saved.data(), saved.size());
+  }
+  if (tlsSessionResumptionEnabled() && !kept) {
+    LOG_WARNING("TLS session of %s not cached (does not fit %u B)", host,
+                static_cast<unsigned>(tls_session::SESSION_BYTES));
+  }
+  return true;
+}  // TlsSessionClient::handshake
+
+// Wait until the socket is readable (writable) or `timeoutMs` passed.
+bool TlsSessionClient::waitSocket(bool forWrite, uint32_t timeoutMs) {
+  fd_set set;
+  FD_ZERO(&set);
+  FD_SET(socket_, &set);
+  timeval tv = {static_cast<time_t>(timeoutMs / 1000), static_cast<suseconds_t>((timeoutMs % 1000) * 1000)};
+  return select(socket_ + 1, forWrite ? nullptr : &set, forWrite ? &set : nullptr, nullptr, &tv) > 0;
+}
+
+size_t TlsSessionClient::write(uint8_t data) { return write(&data, 1); }
+
+size_t TlsSessionClient::write(const uint8_t *buf, size_t size) {
+  if (tls_ == nullptr) {
+    return 0;
+  }
+  size_t written = 0;
+  const uint32_t start = millis();
+  while (written < size) {
+    const int ret = mbedtls_ssl_write(&tls_->ssl, buf + written, size - written);
+    if (ret > 0) {
+      written += static_cast<size_t>(ret);
+      continue;
+    }
+    const uint32_t elapsed = millis() - start;
+    if ((ret != MBEDTLS_ERR_SSL_WANT_READ && ret != MBEDTLS_ERR_SSL_WANT_WRITE) ||
+        elapsed >= static_cast<uint32_t>(timeoutMs_)) {
+      break;
+    }
+    waitSocket(ret == MBEDTLS_ERR_SSL_WANT_WRITE, timeoutMs_ - elapsed);
+  }
+  return written;
+}
+
+int TlsSessionClient::available() {
+  if (tls_ == nullptr) {
+    return 0;
+  }
+  const int pending = peeked_ >= 0 ? 1 : 0;
+  if (!peerClosed_ && mbedtls_ssl_get_bytes_avail(&tls_->ssl) == 0) {
+    // Process whatever records arrived, without blocking.
+    const int ret = mbedtls_ssl_read(&tls_->ssl, nullptr, 0);
+    if (ret < 0 && ret != MBEDTLS_ERR_SSL_WANT_READ && ret != MBEDTLS_ERR_SSL_WANT_WRITE) {
+      peerClosed_ = true;
+    }
+  }
+  return pending + static_cast<int>(mbedtls_ssl_get_bytes_avail(&tls_->ssl));
+}
+
+int TlsSessionClient::read() {
+  uint8_t c = 0;
+  return read(&c, 1) == 1 ? c : -1;
+}
+
+int TlsSessionClient::read(uint8_t *buf, size_t size) {
+  if (buf == nullptr || size == 0 || available() <= 0) {
+    return -1;
+  }
+  size_t n = 0;
+  if (peeked_ >= 0) {
+    buf[n++] = static_cast<uint8_t>(peeked_);
+    peeked_ = -1;
+    if (n == size || mbedtls_ssl_get_bytes_avail(&tls_->ssl) == 0) {
+      return static_cast<int>(n);
+    }
+  }
+  const int ret = mbedtls_ssl_read(&tls_->ssl, buf + n, size - n);
+  if (ret > 0) {
+    return static_cast<int>(n) + ret;
+  }
+  if (ret != MBEDTLS_ERR_SSL_WANT_READ && ret != MBEDTLS_ERR_SSL_WANT_WRITE) {
+    peerClosed_ = true;
+  }
+  return n > 0 ? static_cast<int>(n) : -1;
+}
+
+size_t TlsSessionClient::readBytes(char *buffer, size_t length) {
+  size_t total = 0;
+  uint32_t start = millis();
+  while (total < length) {
+    const int n = read(reinterpret_cast<uint8_t *>(buffer) + total, length - total);
+    if (n > 0) {
+      total += static_cast<size_t>(n);
+      start = millis();
+      continue;
+    }
+    const uint32_t elapsed = millis() - start;
+    if (!connected() || elapsed >= getTimeout()) {
+      break;
+    }
+    waitSocket(false, getTimeout() - elapsed);
+  }
+  return total;
+}
+
+int TlsSessionClient::peek() {
+  if (peeked_ < 0) {
+    uint8_t c = 0;
+    if (read(&c, 1) != 1) {
+      return -1;
+    }
+    peeked_ = c;
+  }
+  return peeked_;
+}
+
+void TlsSessionClient::flush() {}
+
+uint8_t TlsSessionClient::connected() {
+  if (tls_ == nullptr) {
+    return 0;
+  }
+  if (available() > 0) {
+    return 1;
+  }
+  return !peerClosed_ && WiFiClient::connected();
+}
+
+void TlsSessionClient::stop() {
+  if (tls_ != nullptr && !peerClosed_) {
+    mbedtls_ssl_close_notify(&tls_->ssl);  // best effort, the socket is non-blocking
+  }
+  release();
+  WiFiClient::stop();
+  socket_ = -1;
+}
+
+// Free the TLS contexts; the next connect() allocates new ones.
+void TlsSessionClient::release() {
+  delete tls_;
+  tls_ = nullptr;
+  peerClosed_ = false;
+  peeked_ = -1;
+}
+
+void logTlsSessionStats() {
+  for (size_t i = 0; i < tls_session::SLOTS; ++i) {
+    portENTER_CRITICAL(&tlsSessionMux);
+    tls_session::ensureValid(tlsSessionStore);
+    const tls_session::Slot &slot = tlsSessionStore.slots[i];
+    const bool used = slot.used != 0;
+    const uint32_t hostHash = slot.hostHash;
+    const uint32_t length = slot.length;
+    const tls_session::HandshakeStats full = slot.full;
+    const tls_session::HandshakeStats resumed = slot.resumed;
+    portEXIT_CRITICAL(&tlsSessionMux);
+    if (!used) {
+      continue;
+    }
+    LOG_INFO("TLS host %08x: %u full (avg %u ms), %u resumed (avg %u ms), session %u B",
+             static_cast<unsigned>(hostHash), static_cast<unsigned>(full.count), static_cast<unsigned>(full.avgMs),
+             static_cast<unsigned>(resumed.count), static_cast<unsigned>(resumed.avgMs),
+             static_cast<unsigned>(length));
+  }
+}
@@ -0,0 +1,784 @@
+/* Render-ready view of one wake for esp32-weather-epd.
+ * Copyright (C) 2026  Lumixen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#include "view_model.h"
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <aqi.h>
+
+#include "_locale.h"
+#include "_strftime.h"
+#include "conversions.h"
+#include "display_utils.h"
+#include "logger.h"
+#include "renderer.h"
+
+// icon header files
+#include "icons/icons_24x24.h"
+#include "icons/icons_32x32.h"
+#include "icons/icons_48x48.h"
+
+namespace {
+
+template <size_t N>
+void copyText(char (&dst)[N], const char *src) {
+  snprintf(dst, N, "%s", src);
+}
+
+/* The % operator in C++ is not a true modulo operator but it instead a
+ * remainder operator. The remainder operator and modulo operator are equivalent
+ * for positive numbers, but not for negatives. The follow implementation of the
+ * modulo operator works for +/-a and +b.
+ */
+inline int modulo(int a, int b) {
+  const int result = a % b;
+  return result >= 0 ? result : result + b;
+}
+
+/* Convert temperature in celsius to the display y coordinate to be plotted.
+ */
+int celsius_to_plot_y(float temp, int tempBoundMin, float yPxPerUnit, int yBoundMin) {
+#ifdef UNITS_TEMP_KELVIN
+  return static_cast<int>(std::round(yBoundMin - (yPxPerUnit * (celsius_to_kelvin(temp) - tempBoundMin))));
+#endif
+#ifdef UNITS_TEMP_CELSIUS
+  return static_cast<int>(std::round(yBoundMin - (yPxPerUnit * (temp - tempBoundMin))));
+#endif
+#ifdef UNITS_TEMP_FAHRENHEIT
+  return static_cast<int>(std::round(yBoundMin - (yPxPerUnit * (celsius_to_fahrenheit(temp) - tempBoundMin))));
+#endif
+}
+
+uint16_t tempToColor(float t) {
+  if (t < COLORS_OUTLOOK_LOW_THRESHOLD_TEMPERATURE) return COLORS_OUTLOOK_TEMPERATURE_LOW_COLOR;
+  if (t > COLORS_OUTLOOK_HIGH_THRESHOLD_TEMPERATURE) return COLORS_OUTLOOK_TEMPERATURE_HIGH_COLOR;
+  return COLORS_OUTLOOK_TEMPERATURE_NORMAL_COLOR;
+}
+
+void formatTime(char (&dst)[12], const char *format, int64_t dt) {
+  time_t ts = dt;
+  tm *timeInfo = localtime(&ts);
+  _strftime(dst, sizeof(dst), format, timeInfo);
+}
+
+// Pressure in the configured unit; hectopascals are shown with `hpaDecimals`
+// (the providers report whole hPa, the indoor sensor does not).
+[[maybe_unused]] void formatPressure(condition_cell_view_t &cell, float pressure, int hpaDecimals) {
+#ifdef UNITS_PRES_HECTOPASCALS
+  snprintf(cell.value, sizeof(cell.value), "%.*f", hpaDecimals, pressure);
+  snprintf(cell.unit, sizeof(cell.unit), " %s", TXT_UNITS_PRES_HECTOPASCALS);
+#endif
+#ifdef UNITS_PRES_PASCALS
+  snprintf(cell.value, sizeof(cell.value), "%d", static_cast<int>(std::round(hectopascals_to_pascals(pressure))));
+  snprintf(cell.unit, sizeof(cell.unit), " %s", TXT_UNITS_PRES_PASCALS);
+#endif
+#ifdef UNITS_PRES_MILLIMETERSOFMERCURY
+  snprintf(cell.value, sizeof(cell.value), "%d",
+           static_cast<int>(std::round(hectopascals_to_millimetersofmercury(pressure))));
+  snprintf(cell.unit, sizeof(cell.unit), " %s", TXT_UNITS_PRES_MILLIMETERSOFMERCURY);
+#endif
+#ifdef UNITS_PRES_INCHESOFMERCURY
+  snprintf(cell.value, sizeof(cell.value), "%.1f", std::round(1e1f * hectopascals_to_inchesofmercury(pressure)) / 1e1f);
+  snprintf(cell.unit, sizeof(cell.unit), " %s", TXT_UNITS_PRES_INCHESOFMERCURY);
+#endif
+#ifdef UNITS_PRES_MILLIBARS
+  snprintf(cell.value, sizeof(cell.value), "%d", static_cast<int>(std::round(hectopascals_to_millibars(pressure))));
+  snprintf(cell.unit, sizeof(cell.unit), " %s", TXT_UNITS_PRES_MILLIBARS);
+#endif
+#ifdef UNITS_PRES_ATMOSPHERES
+  snprintf(cell.value, sizeof(cell.value), "%.3f", std::round(1e3f * hectopascals_to_atmospheres(pressure)) / 1e3f);
+  snprintf(cell.unit, sizeof(cell.unit), " %s", TXT_UNITS_PRES_ATMOSPHERES);
+#endif
+#ifdef UNITS_PRES_GRAMSPERSQUARECENTIMETER
+  snprintf(cell.value, sizeof(cell.value), "%d",
+           static_cast<int>(std::round(hectopascals_to_gramspersquarecentimeter(pressure))));
+  snprintf(cell.unit, sizeof(cell.unit), " %s", TXT_UNITS_PRES_GRAMSPERSQUARECENTIMETER);
+#endif
+#ifdef UNITS_PRES_POUNDSPERSQUAREINCH
+  snprintf(cell.value, sizeof(cell.value), "%.2f",
+           std::round(1e2f * hectopascals_to_poundspersquareinch(pressure)) / 1e2f);
+  snprintf(cell.unit, sizeof(cell.unit), " %s", TXT_UNITS_PRES_POUNDSPERSQUAREINCH);
+#endif
+}
+
+condition_cell_view_t &addCell(current_view_t &view, int pos, const uint8_t *icon, const char *label) {
+  condition_cell_view_t &cell = view.cells[view.cellCount++];
+  cell = condition_cell_view_t{};
+  cell.pos = pos;
+  cell.icon = icon;
+  cell.label = label;
+  return cell;
+}
+
+void buildCurrent(current_view_t &view, const current_t &current, const air_quality_t &air_quality,
+                  std::optional<float> inPressure, const moon_state_t &moon) {
+  view.icon = getCurrentConditionsBitmap196(current, moon);
+
+  // current temp and feels like
+#ifdef UNITS_TEMP_KELVIN
+  snprintf(view.temp, sizeof(view.temp), "%d", static_cast<int>(std::round(celsius_to_kelvin(current.temp))));
+  view.tempUnit = TXT_UNITS_TEMP_KELVIN;
+  snprintf(view.feelsLike, sizeof(view.feelsLike), "%s %dK", TXT_FEELS_LIKE,
+           static_cast<int>(std::round(celsius_to_kelvin(current.feels_like))));
+#endif
+#ifdef UNITS_TEMP_CELSIUS
+  snprintf(view.temp, sizeof(view.temp), "%d", static_cast<int>(std::round(current.temp)));
+  view.tempUnit = TXT_UNITS_TEMP_CELSIUS;
+  snprintf(view.feelsLike, sizeof(view.feelsLike), "%s %d\260C", TXT_FEELS_LIKE,
+           static_cast<int>(std::round(current.feels_like)));
+#endif
+#ifdef UNITS_TEMP_FAHRENHEIT
+  snprintf(view.temp, sizeof(view.temp), "%d", static_cast<int>(std::round(celsius_to_fahrenheit(current.temp))));
+  view.tempUnit = TXT_UNITS_TEMP_FAHRENHEIT;
+  snprintf(view.feelsLike, sizeof(view.feelsLike), "%s %d\260F", TXT_FEELS_LIKE,
+           static_cast<int>(std::round(celsius_to_fahrenheit(current.feels_like))));
+#endif
+
+  // left panel, in the order it was always drawn
+  view.cellCount = 0;
+#ifdef POS_SUNRISE
+  {
+    condition_cell_view_t &cell = addCell(view, POS_SUNRISE, wi_sunrise_48x48, TXT_SUNRISE);
+    char timeBuffer[12] = {};  // big enough to accommodate "hh:mm:ss am"
+    formatTime(timeBuffer, TIME_FORMAT, current.sunrise);
+    copyText(cell.value, timeBuffer);
+  }
+#endif
+
+#ifdef POS_SUNSET
+  {
+    condition_cell_view_t &cell = addCell(view, POS_SUNSET, wi_sunset_48x48, TXT_SUNSET);
+    char timeBuffer[12] = {};
+    formatTime(timeBuffer, TIME_FORMAT, current.sunset);
+    copyText(cell.value, timeBuffer);
+  }
+#endif
+
+#ifdef POS_WIND
+  {
+    condition_cell_view_t &cell = addCell(view, POS_WIND, wi_strong_wind_48x48, TXT_WIND);
+#ifdef WIND_DIRECTION_INDICATOR_ARROW
+    cell.arrow = getWindBitmap24(current.wind_deg);
+#endif
+#ifdef UNITS_SPEED_METERSPERSECOND
+    snprintf(cell.value, sizeof(cell.value), "%d", static_cast<int>(std::round(current.wind_speed)));
+    snprintf(cell.unit, sizeof(cell.unit), " %s", TXT_UNITS_SPEED_METERSPERSECOND);
+#endif
+#ifdef UNITS_SPEED_FEETPERSECOND
+    snprintf(cell.value, sizeof(cell.value), "%d",
+             static_cast<int>(std::round(meterspersecond_to_feetpersecond(current.wind_speed))));
+    snprintf(cell.unit, sizeof(cell.unit), " %s", TXT_UNITS_SPEED_FEETPERSECOND);
+#endif
+#ifdef UNITS_SPEED_KILOMETERSPERHOUR
+    snprintf(cell.value, sizeof(cell.value), "%d",
+             static_cast<int>(std::round(meterspersecond_to_kilometersperhour(current.wind_speed))));
+    snprintf(cell.unit, sizeof(cell.unit), " %s", TXT_UNITS_SPEED_KILOMETERSPERHOUR);
+#endif
+#ifdef UNITS_SPEED_MILESPERHOUR
+    snprintf(cell.value, sizeof(cell.value), "%d",
+             static_cast<int>(std::round(meterspersecond_to_milesperhour(current.wind_speed))));
+    snprintf(cell.unit, sizeof(cell.unit), " %s", TXT_UNITS_SPEED_MILESPERHOUR);
+#endif
+#ifdef UNITS_SPEED_KNOTS
+    snprintf(cell.value, sizeof(cell.value), "%d",
+             static_cast<int>(std::round(meterspersecond_to_knots(current.wind_speed))));
+    snprintf(cell.unit, sizeof(cell.unit), " %s", TXT_UNITS_SPEED_KNOTS);
+#endif
+#ifdef UNITS_SPEED_BEAUFORT
+    snprintf(cell.value, sizeof(cell.value), "%d", meterspersecond_to_beaufort(current.wind_speed));
+    snprintf(cell.unit, sizeof(cell.unit), " %s", TXT_UNITS_SPEED_BEAUFORT);
+#endif
+#if defined(WIND_DIRECTION_INDICATOR_NUMBER)
+    snprintf(cell.suffix, sizeof(cell.suffix), "%d\260", current.wind_deg);
+#endif
+#if defined(WIND_DIRECTION_INDICATOR_CARDINAL) || defined(WIND_DIRECTION_INDICATOR_INTERCARDINAL) || \
+    defined(WIND_DIRECTION_INDICATOR_SECONDARY_INTERCARDINAL) || \
+    defined(WIND_DIRECTION_INDICATOR_TERTIARY_INTERCARDINAL)
+    copyText(cell.suffix, getCompassPointNotation(current.wind_deg));
+#endif
+  }
+#endif
+
+#ifdef POS_HUMIDITY
+  {
+    condition_cell_view_t &cell = addCell(view, POS_HUMIDITY, wi_humidity_48x48, TXT_HUMIDITY);
+    snprintf(cell.value, sizeof(cell.value), "%d", current.humidity);
+    copyText(cell.unit, "%");
+  }
+#endif
+
+#ifdef POS_UVI
+  {
+    condition_cell_view_t &cell = addCell(view, POS_UVI, wi_day_sunny_48x48, TXT_UV_INDEX);
+    unsigned int uvi = static_cast<unsigned int>(std::max(std::round(current.uvi), 0.0f));
+    snprintf(cell.value, sizeof(cell.value), "%u", uvi);
+    cell.desc = getUVIdesc(uvi);
+  }
+#endif
+
+#ifdef POS_PRESSURE
+  {
+    condition_cell_view_t &cell = addCell(view, POS_PRESSURE, wi_barometer_48x48, TXT_PRESSURE);
+    formatPressure(cell, current.pressure, 0);
+  }
+#endif
+
+#ifdef POS_VISIBILITY
+  {
+    condition_cell_view_t &cell = addCell(view, POS_VISIBILITY, visibility_icon_48x48, TXT_VISIBILITY);
+#ifdef UNITS_DISTANCE_KILOMETERS
+    float vis = meters_to_kilometers(current.visibility);
+    snprintf(cell.unit, sizeof(cell.unit), " %s", TXT_UNITS_DIST_KILOMETERS);
+    const bool beyond = vis >= 10;
+#endif
+#ifdef UNITS_DISTANCE_MILES
+    float vis = meters_to_miles(current.visibility);
+    snprintf(cell.unit, sizeof(cell.unit), " %s", TXT_UNITS_DIST_MILES);
+    const bool beyond = vis >= 6;
+#endif
+    // if visibility is less than 1.95, round to 1 decimal place
+    // else round to int
+    if (vis < 1.95) {
+      snprintf(cell.value, sizeof(cell.value), "%s%.1f", beyond ? "> " : "", std::round(10 * vis) / 10.0);
+    } else {
+      snprintf(cell.value, sizeof(cell.value), "%s%d", beyond ? "> " : "", static_cast<int>(std::round(vis)));
+    }
+  }
+#endif
+
+#ifdef POS_AIR_QUALITY
+  {
+    const char *air_quality_index_label;
+    if (aqi_desc_type(AQI_SCALE) == AIR_QUALITY_DESC) {
+      air_quality_index_label = TXT_AIR_QUALITY;
+    } else  // (aqi_desc_type(AQI_SCALE) == AIR_POLLUTION_DESC)
+    {
+      air_quality_index_label = TXT_AIR_POLLUTION;
+    }
+    condition_cell_view_t &cell = addCell(view, POS_AIR_QUALITY, air_filter_48x48, air_quality_index_label);
+    const air_quality_components_t &c = air_quality.components;
+    // OpenWeatherMap does not provide pb (lead) conentrations, so we pass NULL.
+    int aqi = calc_aqi(AQI_SCALE, c.co, c.nh3, c.no, c.no2, c.o3, NULL, c.so2, c.pm10, c.pm2_5);
+    int aqi_max = aqi_scale_max(AQI_SCALE);
+    if (aqi > aqi_max) {
+      snprintf(cell.value, sizeof(cell.value), "> %d", aqi_max);
+    } else {
+      snprintf(cell.value, sizeof(cell.value), "%d", aqi);
+    }
+    cell.desc = aqi_desc(AQI_SCALE, aqi);
+  }
+#endif
+
+#ifdef POS_MOONRISE
+  {
+    condition_cell_view_t &cell = addCell(view, POS_MOONRISE, wi_moonrise_48x48, TXT_MOONRISE);
+    char timeBuffer[12] = {};
+    formatTime(timeBuffer, TIME_FORMAT, moon.moonrise);
+    copyText(cell.value, timeBuffer);
+  }
+#endif
+
+#ifdef POS_MOONSET
+  {
+    condition_cell_view_t &cell = addCell(view, POS_MOONSET, wi_moonset_48x48, TXT_MOONSET);
+    char timeBuffer[12] = {};
+    formatTime(timeBuffer, TIME_FORMAT, moon.moonset);
+    copyText(cell.value, timeBuffer);
+  }
+#endif
+
+#ifdef POS_MOONPHASE
+  {
+    condition_cell_view_t &cell = addCell(view, POS_MOONPHASE, getMoonPhaseBitmap48(moon), TXT_MOONPHASE);
+    cell.desc = getMoonPhaseStr(moon);  // in place of a value
+  }
+#endif
+
+#ifdef POS_DEWPOINT
+  {
+    condition_cell_view_t &cell = addCell(view, POS_DEWPOINT, wi_thermometer_48x48, TXT_DEWPOINT);
+    cell.badge = wi_raindrops_24x24;
+    if (!std::isnan(current.dew_point)) {
+#ifdef UNITS_TEMP_KELVIN
+      snprintf(cell.value, sizeof(cell.value), "%.1fK", std::round(celsius_to_kelvin(current.dew_point) * 10) / 10.0f);
+#endif
+#ifdef UNITS_TEMP_CELSIUS
+      snprintf(cell.value, sizeof(cell.value), "%.1f\260C", std::round(current.dew_point * 10) / 10.0f);
+#endif
+#ifdef UNITS_TEMP_FAHRENHEIT
+      snprintf(cell.value, sizeof(cell.value), "%d\260F",
+               static_cast<int>(std::round(celsius_to_fahrenheit(current.dew_point))));
+#endif
+    } else {
+      copyText(cell.value, "--");
+    }
+  }
+#endif
+
+#ifdef POS_INPRESSURE
+  {
+    condition_cell_view_t &cell = addCell(view, POS_INPRESSURE, wi_barometer_48x48, TXT_INDOOR_PRESSURE);
+    if (!inPressure.has_value()) {
+      copyText(cell.value, "--");
+    } else {
+      formatPressure(cell, inPressure.value(), 2);
+    }
+  }
+#endif
+}  // end buildCurrent
+
+void buildForecast(forecast_day_view_t (&days)[5], const daily_t *daily, tm timeInfo) {
+  for (int i = 0; i < 5; ++i) {
+    forecast_day_view_t &day = days[i];
+    day.icon = getDailyForecastBitmap64(daily[i]);
+    _strftime(day.day, sizeof(day.day), "%a", &timeInfo);  // abbrv'd day
+    timeInfo.tm_wday = (timeInfo.tm_wday + 1) % 7;         // increment to next day
+
+#ifdef UNITS_TEMP_KELVIN
+    snprintf(day.hi, sizeof(day.hi), "%d", static_cast<int>(std::round(celsius_to_kelvin(daily[i].temp.max))));
+    snprintf(day.lo, sizeof(day.lo), "%d", static_cast<int>(std::round(celsius_to_kelvin(daily[i].temp.min))));
+#endif
+#ifdef UNITS_TEMP_CELSIUS
+    snprintf(day.hi, sizeof(day.hi), "%d\260", static_cast<int>(std::round(daily[i].temp.max)));
+    snprintf(day.lo, sizeof(day.lo), "%d\260", static_cast<int>(std::round(daily[i].temp.min)));
+#endif
+#ifdef UNITS_TEMP_FAHRENHEIT
+    snprintf(day.hi, sizeof(day.hi), "%d\260", static_cast<int>(std::round(celsius_to_fahrenheit(daily[i].temp.max))));
+    snprintf(day.lo, sizeof(day.lo), "%d\260", static_cast<int>(std::round(celsius_to_fahrenheit(daily[i].temp.min))));
+#endif
+
+    day.precip[0] = '\0';
+// daily forecast precipitation
+#ifndef DISPLAY_DAILY_PRECIP_DISABLED
+    float dailyPrecip;
+#if defined(UNITS_DAILY_PRECIP_POP)
+    dailyPrecip = daily[i].pop;
+    snprintf(day.precip, sizeof(day.precip), "%d%%", static_cast<int>(dailyPrecip));
+#else
+    dailyPrecip = daily[i].snow + daily[i].rain;
+#if defined(UNITS_DAILY_PRECIP_MILLIMETERS)
+    // Round up to nearest mm
+    dailyPrecip = std::round(dailyPrecip);
+    snprintf(day.precip, sizeof(day.precip), "%d %s", static_cast<int>(dailyPrecip), TXT_UNITS_PRECIP_MILLIMETERS);
+#elif defined(UNITS_DAILY_PRECIP_CENTIMETERS)
+    // Round up to nearest 0.1 cm
+    dailyPrecip = millimeters_to_centimeters(dailyPrecip);
+    dailyPrecip = std::round(dailyPrecip * 10) / 10.0f;
+    snprintf(day.precip, sizeof(day.precip), "%.1f %s", dailyPrecip, TXT_UNITS_PRECIP_CENTIMETERS);
+#elif defined(UNITS_DAILY_PRECIP_INCHES)
+    // Round up to nearest 0.1 inch
+    dailyPrecip = millimeters_to_inches(dailyPrecip);
+    dailyPrecip = std::round(dailyPrecip * 10) / 10.0f;
+    snprintf(day.precip, sizeof(day.precip), "%.1f %s", dailyPrecip, TXT_UNITS_PRECIP_INCHES);
+#endif
+#endif
+#ifdef DISPLAY_DAILY_PRECIP_SMART
+    if (!(dailyPrecip > 0.0f)) {
+      day.precip[0] = '\0';
+    }
+#endif
+#endif  // DISPLAY_DAILY_PRECIP
+  }
+}  // end buildForecast
+
+void buildOutlook(outlook_view_t &view, const hourly_t *hourly, const moon_state_t &moon) {
+  const int xPos0 = 350;
+  int xPos1 = DISP_WIDTH;
+  const int yPos0 = 216;
+  const int yPos1 = DISP_HEIGHT - 46;
+
+  // calculate y max/min and intervals
+  int yMajorTicks = OUTLOOK_Y_TICKS;
+#ifdef UNITS_TEMP_KELVIN
+  float tempMin = celsius_to_kelvin(hourly[0].temp);
+#endif
+#ifdef UNITS_TEMP_CELSIUS
+  float tempMin = hourly[0].temp;
+#endif
+#ifdef UNITS_TEMP_FAHRENHEIT
+  float tempMin = celsius_to_fahrenheit(hourly[0].temp);
+#endif
+  float tempMax = tempMin;
+#ifdef UNITS_HOURLY_PRECIP_POP
+  float precipMax = hourly[0].pop;
+#else
+  float precipMax = hourly[0].rain_1h + hourly[0].snow_1h;
+#endif
+  int yTempMajorTicks = 5;
+  float newTemp = 0;
+  for (int i = 1; i < HOURLY_GRAPH_MAX; ++i) {
+#ifdef UNITS_TEMP_KELVIN
+    newTemp = celsius_to_kelvin(hourly[i].temp);
+#endif
+#ifdef UNITS_TEMP_CELSIUS
+    newTemp = hourly[i].temp;
+#endif
+#ifdef UNITS_TEMP_FAHRENHEIT
+    newTemp = celsius_to_fahrenheit(hourly[i].temp);
+#endif
+    tempMin = std::min(tempMin, newTemp);
+    tempMax = std::max(tempMax, newTemp);
+#ifdef UNITS_HOURLY_PRECIP_POP
+    precipMax = std::max<float>(precipMax, hourly[i].pop);
+#else
+    precipMax = std::max<float>(precipMax, hourly[i].rain_1h + hourly[i].snow_1h);
+#endif
+  }
+  int tempBoundMin = static_cast<int>(tempMin - 1) - modulo(static_cast<int>(tempMin - 1), yTempMajorTicks);
+  int tempBoundMax =
+      static_cast<int>(tempMax + 1) + (yTempMajorTicks - modulo(static_cast<int>(tempMax + 1), yTempMajorTicks));
+
+  // while we have to many major ticks then increase the step
+  while ((tempBoundMax - tempBoundMin) / yTempMajorTicks > yMajorTicks) {
+    yTempMajorTicks += 5;
+    tempBoundMin = static_cast<int>(tempMin - 1) - modulo(static_cast<int>(tempMin - 1), yTempMajorTicks);
+    tempBoundMax =
+        static_cast<int>(tempMax + 1) + (yTempMajorTicks - modulo(static_cast<int>(tempMax + 1), yTempMajorTicks));
+  }
+  // while we have not enough major ticks, add to either bound
+  while ((tempBoundMax - tempBoundMin) / yTempMajorTicks < yMajorTicks) {
+    // add to whatever bound is closer to the actual min/max
+    if (tempMin - tempBoundMin <= tempBoundMax - tempMax) {
+      tempBoundMin -= yTempMajorTicks;
+    } else {
+      tempBoundMax += yTempMajorTicks;
+    }
+  }
+
+#ifdef UNITS_HOURLY_PRECIP_POP
+  xPos1 = DISP_WIDTH - 23;
+  float precipBoundMax;
+  if (precipMax > 0) {
+    precipBoundMax = 100.0f;
+  } else {
+    precipBoundMax = 0.0f;
+  }
+#else
+#ifdef UNITS_HOURLY_PRECIP_MILLIMETERS
+  xPos1 = DISP_WIDTH - 24;
+  float precipBoundMax = std::ceil(precipMax);  // Round up to nearest mm
+  int yPrecipMajorTickDecimals = (precipBoundMax < 10);
+#endif
+#ifdef UNITS_HOURLY_PRECIP_CENTIMETERS
+  xPos1 = DISP_WIDTH - 25;
+  precipMax = millimeters_to_centimeters(precipMax);
+  // Round up to nearest 0.1 cm
+  float precipBoundMax = std::ceil(precipMax * 10) / 10.0f;
+  int yPrecipMajorTickDecimals;
+  if (precipBoundMax < 1) {
+    yPrecipMajorTickDecimals = 2;
+    if (precipBoundMax > 0) {
+      xPos1 -= 6;  // needs extra room
+    }
+  } else if (precipBoundMax < 10) {
+    yPrecipMajorTickDecimals = 1;
+  } else {
+    yPrecipMajorTickDecimals = 0;
+  }
+#endif
+#ifdef UNITS_HOURLY_PRECIP_INCHES
+  xPos1 = DISP_WIDTH - 25;
+  precipMax = millimeters_to_inches(precipMax);
+  // Round up to nearest 0.1 inch
+  float precipBoundMax = std::ceil(precipMax * 10) / 10.0f;
+  int yPrecipMajorTickDecimals;
+  if (precipBoundMax < 1) {
+    yPrecipMajorTickDecimals = 2;
+  } else if (precipBoundMax < 10) {
+    yPrecipMajorTickDecimals = 1;
+  } else {
+    yPrecipMajorTickDecimals = 0;
+  }
+#endif
+  float yPrecipMajorTickValue = precipBoundMax / yMajorTicks;
+  float precipRoundingMultiplier = std::pow(10.f, yPrecipMajorTickDecimals);
+#endif
+
+  if (precipBoundMax > 0) {  // fill need extra room for labels
+    xPos1 -= 23;
+  }
+  view.x0 = xPos0;
+  view.x1 = xPos1;
+  view.y0 = yPos0;
+  view.y1 = yPos1;
+
+  // y axis labels
+  view.precipLabels = precipBoundMax > 0;  // don't labels if precip is 0
+#ifdef UNITS_HOURLY_PRECIP_POP
+  copyText(view.precipUnit, "%");
+#endif
+#ifdef UNITS_HOURLY_PRECIP_MILLIMETERS
+  snprintf(view.precipUnit, sizeof(view.precipUnit), " %s", TXT_UNITS_PRECIP_MILLIMETERS);
+#endif
+#ifdef UNITS_HOURLY_PRECIP_CENTIMETERS
+  snprintf(view.precipUnit, sizeof(view.precipUnit), " %s", TXT_UNITS_PRECIP_CENTIMETERS);
+#endif
+#ifdef UNITS_HOURLY_PRECIP_INCHES
+  snprintf(view.precipUnit, sizeof(view.precipUnit), " %s", TXT_UNITS_PRECIP_INCHES);
+#endif
+  float yInterval = (yPos1 - yPos0) / static_cast<float>(yMajorTicks);
+  for (int i = 0; i <= yMajorTicks; ++i) {
+    view.yTicks[i] = static_cast<int>(yPos0 + (i * yInterval));
+    // Temperature
+    int tempVal = tempBoundMax - (i * yTempMajorTicks);
+#if defined(UNITS_TEMP_CELSIUS) || defined(UNITS_TEMP_FAHRENHEIT)
+    snprintf(view.tempLabels[i], sizeof(view.tempLabels[i]), "%d\260", tempVal);
+    view.tempColors[i] = tempVal < COLORS_OUTLOOK_LOW_THRESHOLD_TEMPERATURE    ? COLORS_OUTLOOK_TEMPERATURE_LOW_COLOR
+                         : tempVal > COLORS_OUTLOOK_HIGH_THRESHOLD_TEMPERATURE ? COLORS_OUTLOOK_TEMPERATURE_HIGH_COLOR
+                                                                               : COLORS_OUTLOOK_TEMPERATURE_NORMAL_COLOR;
+#else
+    snprintf(view.tempLabels[i], sizeof(view.tempLabels[i]), "%d", tempVal);
+    view.tempColors[i] = GxEPD_BLACK;
+#endif
+
+#ifdef UNITS_HOURLY_PRECIP_POP
+    // PoP
+    snprintf(view.precipLabelValues[i], sizeof(view.precipLabelValues[i]), "%d", 100 - (i * 20));
+#else
+    // Precipitation volume
+    float precipTick = precipBoundMax - (i * yPrecipMajorTickValue);
+    precipTick = std::round(precipTick * precipRoundingMultiplier) / precipRoundingMultiplier;
+    // padded to decimals + 2 like String(float, decimals)
+    snprintf(view.precipLabelValues[i], sizeof(view.precipLabelValues[i]), "%*.*f", yPrecipMajorTickDecimals + 2,
+             yPrecipMajorTickDecimals, precipTick);
+#endif
+  }
+
+  int xMaxTicks = 8;
+  int hourInterval = static_cast<int>(ceil(HOURLY_GRAPH_MAX / static_cast<float>(xMaxTicks)));
+  float xInterval = (xPos1 - xPos0 - 1) / static_cast<float>(HOURLY_GRAPH_MAX);
+
+  // precalculate all x and y coordinates for temperature values
+  float yPxPerUnit = (yPos1 - yPos0) / static_cast<float>(tempBoundMax - tempBoundMin);
+  int x_t[HOURLY_GRAPH_MAX];
+  int y_t[HOURLY_GRAPH_MAX];
+  for (int i = 0; i < HOURLY_GRAPH_MAX; ++i) {
+    y_t[i] = celsius_to_plot_y(hourly[i].temp, tempBoundMin, yPxPerUnit, yPos1);
+    x_t[i] = static_cast<int>(std::round(xPos0 + (i * xInterval) + (0.5 * xInterval)));
+  }
+
+  for (int i = 0; i < HOURLY_GRAPH_MAX; ++i) {
+    outlook_hour_view_t &hour = view.hours[i];
+    hour = outlook_hour_view_t{};
+    int xTick = static_cast<int>(xPos0 + (i * xInterval));
+    int x0_t, x1_t, y0_t, y1_t;
+
+    if (i > 0) {
+      // temperature
+      x0_t = x_t[i - 1];
+      x1_t = x_t[i];
+      y0_t = y_t[i - 1];
+      y1_t = y_t[i];
+
+      // determine colors
+      uint16_t previousColor = tempToColor(hourly[i - 1].temp);
+      uint16_t currentColor = tempToColor(hourly[i].temp);
+
+      if (previousColor == currentColor) {
+        // No crossing, single line
+        hour.segments[0] = {static_cast<int16_t>(x0_t), static_cast<int16_t>(y0_t), static_cast<int16_t>(x1_t),
+                            static_cast<int16_t>(y1_t), currentColor};
+        hour.segmentCount = 1;
+      } else {
+        // Threshold crossing detected. Calculate intersection point.
+        // y = mx + b -> We need x where temp is threshold.
+        float t0 = hourly[i - 1].temp;
+        float t1 = hourly[i].temp;
+        // Determine which threshold was crossed.
+        float crossedThreshold =
+            (t0 < COLORS_OUTLOOK_LOW_THRESHOLD_TEMPERATURE || t1 < COLORS_OUTLOOK_LOW_THRESHOLD_TEMPERATURE)
+                ? COLORS_OUTLOOK_LOW_THRESHOLD_TEMPERATURE
+                : COLORS_OUTLOOK_HIGH_THRESHOLD_TEMPERATURE;
+        float ratio = (crossedThreshold - t0) / (t1 - t0);  // ratio of distance from t0 to threshold
+
+        int x_cross = x0_t + (x1_t - x0_t) * ratio;
+        int y_cross = y0_t + (y1_t - y0_t) * ratio;
+
+        // first segment from i-1 to the crossing, second from the crossing to i
+        hour.segments[0] = {static_cast<int16_t>(x0_t), static_cast<int16_t>(y0_t), static_cast<int16_t>(x_cross),
+                            static_cast<int16_t>(y_cross), previousColor};
+        hour.segments[1] = {static_cast<int16_t>(x_cross), static_cast<int16_t>(y_cross), static_cast<int16_t>(x1_t),
+                            static_cast<int16_t>(y1_t), currentColor};
+        hour.segmentCount = 2;
+      }
+
+      // hourly bitmap
+#if DISPLAY_HOURLY_ICONS
+      if ((i % hourInterval) == 0)  // skip first and last tick
+      {
+        int y_b = INT_MAX;
+        // find the highest (lowest in coordinate value) temperature point that
+        // exists within the width of the icon.
+        // find closest point above the temperature line where the icon won't
+        // interect the temperature line.
+        // y = mx + b
+        int span = static_cast<int>(std::round(16 / xInterval));
+        int l_idx = std::max(i - 1 - span, 0);
+        int r_idx = std::min(i + span, HOURLY_GRAPH_MAX - 1);
+        // left intersecting slope
+        float m_l = (y_t[l_idx + 1] - y_t[l_idx]) / xInterval;
+        int x_l = xTick - 16 - x_t[l_idx];
+        int y_l = static_cast<int>(std::round(m_l * x_l + y_t[l_idx]));
+        y_b = std::min(y_l, y_b);
+        // right intersecting slope
+        float m_r = (y_t[r_idx] - y_t[r_idx - 1]) / xInterval;
+        int x_r = xTick + 16 - x_t[r_idx - 1];
+        int y_r = static_cast<int>(std::round(m_r * x_r + y_t[r_idx - 1]));
+        y_b = std::min(y_r, y_b);
+        // any peaks in between
+        for (int idx = l_idx + 1; idx < r_idx; ++idx) {
+          y_b = std::min(y_t[idx], y_b);
+        }
+        hour.icon = getHourlyForecastBitmap32(hourly[i], moon);
+        hour.iconX = xTick - 16;
+        hour.iconY = y_b - 32;
+        hour.iconColor = getConditionsAccent(hourly[i].weather.condition) == conditions_accent::WORTH_ACCENTING
+                             ? COLORS_OUTLOOK_CONDITIONS_ICON_ACCENT
+                             : GxEPD_BLACK;
+      }
+#endif
+    }
+
+#ifdef UNITS_HOURLY_PRECIP_POP
+    float precipVal = hourly[i].pop;
+#else
+    float precipVal = hourly[i].rain_1h + hourly[i].snow_1h;
+#ifdef UNITS_HOURLY_PRECIP_CENTIMETERS
+    precipVal = millimeters_to_centimeters(precipVal);
+#endif
+#ifdef UNITS_HOURLY_PRECIP_INCHES
+    precipVal = millimeters_to_inches(precipVal);
+#endif
+#endif
+
+    yPxPerUnit = (yPos1 - yPos0) / precipBoundMax;
+    hour.barX0 = static_cast<int>(std::round(xPos0 + 1 + (i * xInterval)));
+    hour.barX1 = static_cast<int>(std::round(xPos0 + 1 + ((i + 1) * xInterval)));
+    hour.barTop = static_cast<int>(std::round(yPos1 - (yPxPerUnit * (precipVal))));
+
+    if ((i % hourInterval) == 0) {
+      hour.tick = true;
+      hour.tickView.x = xTick;
+      char timeBuffer[12] = {};  // big enough to accommodate "hh:mm:ss am"
+      formatTime(timeBuffer, HOUR_FORMAT, hourly[i].dt);
+      copyText(hour.tickView.label, timeBuffer);
+    }
+  }
+
+  // the last tick mark
+  view.lastTick = (HOURLY_GRAPH_MAX % hourInterval) == 0;
+  if (view.lastTick) {
+    view.lastTickView.x = static_cast<int>(std::round(xPos0 + (HOURLY_GRAPH_MAX * xInterval)));
+    char timeBuffer[12] = {};
+    formatTime(timeBuffer, HOUR_FORMAT, hourly[HOURLY_GRAPH_MAX - 1].dt + 3600);
+    copyText(view.lastTickView.label, timeBuffer);
+  }
+}  // end buildOutlook
+
+/* Converts all event text and tags to lowercase, removes extra information,
+ * and filters out redundant alerts of lesser urgency. Up to 2 alerts are
+ * shown.
+ */
+void buildAlerts(weather_view_t &view, std::vector<weather_alert_t> &alerts) {
+  view.alertCount = 0;
+  LOG_DEBUG("Alerts size is %u", alerts.size());
+  if (alerts.size() == 0) {  // no alerts to draw
+    return;
+  }
+
+  int *ignore_list = (int *) calloc(alerts.size(), sizeof(*ignore_list));
+  int *alert_indices = (int *) calloc(alerts.size(), sizeof(*alert_indices));
+  if (!ignore_list || !alert_indices) {
+    LOG_ERROR("Failed to allocate memory while handling alerts.");
+    free(ignore_list);
+    free(alert_indices);
+    return;
+  }
+
+  filterAlerts(alerts, ignore_list);
+
+  // find indices of valid alerts
+  int num_valid_alerts = 0;
+  String ignoreList = "[ ";
+  for (int i = 0; i < alerts.size(); ++i) {
+    ignoreList += String(ignore_list[i]) + " ";
+    if (!ignore_list[i]) {
+      alert_indices[num_valid_alerts] = i;
+      ++num_valid_alerts;
+    }
+  }
+  LOG_DEBUG("ignore_list      : %s]", ignoreList.c_str());
+  LOG_DEBUG("num_valid_alerts : %d", num_valid_alerts);
+
+  view.alertCount = num_valid_alerts == 1 ? 1 : 2;
+  for (int i = 0; i < view.alertCount; ++i) {
+    // alert_indices past the valid alerts are 0, as they always were drawn
+    const int index = i < static_cast<int>(alerts.size()) ? alert_indices[i] : 0;
+    weather_alert_t &cur_alert = alerts[index];
+    view.alerts[i].icon = view.alertCount == 1 ? getAlertBitmap48(cur_alert) : getAlertBitmap32(cur_alert);
+    // must be called after getAlertBitmap
+    toTitleCase(cur_alert.event);
+    copyText(view.alerts[i].event, cur_alert.event.c_str());
+  }
+
+  free(ignore_list);
+  free(alert_indices);
+}  // end buildAlerts
+
+void buildStatusBar(status_bar_view_t &view, const String &statusStr, const String &refreshTimeStr, int rssi,
+                    uint32_t batVoltage) {
+#if BATTERY_MONITORING
+  // battery - (expecting 3.7v LiPo)
+  uint8_t batPercent = calcBatPercent(batVoltage, MIN_BATTERY_VOLTAGE, MAX_BATTERY_VOLTAGE);
+  view.batteryColor = GxEPD_BLACK;
+#if defined(EPD_PANEL_GENERIC_3C_B) || defined(EPD_PANEL_DKE_3C_86BF) || defined(EPD_PANEL_GENERIC_7C_F)
+  if (batVoltage < WARN_BATTERY_VOLTAGE) {
+    view.batteryColor = COLORS_STATUS_BAR_BATTERY_WARNING;
+  }
+#endif
+#if STATUS_BAR_EXTRAS_BAT_VOLTAGE
+  snprintf(view.batteryText, sizeof(view.batteryText), "%u%% (%.2fv)", batPercent,
+           std::round(batVoltage / 10.f) / 100.f);
+#else
+  snprintf(view.batteryText, sizeof(view.batteryText), "%u%%", batPercent);
+#endif
+  view.batteryIcon = getBatBitmap24(batPercent);
+#endif
+
+  // WiFi
+  copyText(view.wifiText, getWiFidesc(rssi));
+  view.wifiColor = rssi >= -70 ? GxEPD_BLACK : COLORS_STATUS_BAR_WEAK_WIFI;
+#if STATUS_BAR_EXTRAS_WIFI_RSSI
+  if (rssi != 0) {
+    snprintf(view.wifiText, sizeof(view.wifiText), "%s (%ddBm)", getWiFidesc(rssi), rssi);
+  }
+#endif
+  view.wifiIcon = getWiFiBitmap16(rssi);
+
+  copyText(view.refreshTime, refreshTimeStr.c_str());
+  copyText(view.status, statusStr.c_str());
+}  // end buildStatusBar
+
+}  // namespace
+
+void buildWeatherView(weather_view_t &view, const forecast_t &forecast, const air_quality_t &airQuality,
+                      std::optional<float> inPressure, const moon_state_t &moon, std::vector<weather_alert_t> &alerts,
+                      tm timeInfo, const String &date, const String &statusStr, const String &refreshTimeStr, int rssi,
+                      uint32_t batVoltage) {
+  buildCurrent(view.current, forecast.current, airQuality, inPressure, moon);
+  buildForecast(view.days, forecast.daily, timeInfo);
+  buildOutlook(view.outlook, forecast.hourly, moon);
+  buildAlerts(view, alerts);
+  copyText(view.date, date.c_str());
+  buildStatusBar(view.statusBar, statusStr, refreshTimeStr, rssi, batVoltage);
+}  // end buildWeatherView
@@ -0,0 +1,290 @@
+/* Wake-cycle profiler — per-phase timing of every wake, kept in RTC memory.
+ * Copyright (C) 2026  Lumixen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#include "wake_profiler.h"
+
+#include <cstdio>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#include "fetch_operation.h"
+#include "logger.h"
+
+namespace wake_profile {
+
+const char *phaseName(WakePhase phase) {
+  switch (phase) {
+    case WakePhase::BATTERY_ADC:
+      return "battery_adc";
+    case WakePhase::WIFI_CONNECT:
+      return "wifi_connect";
+    case WakePhase::TIME_SYNC:
+      return "time_sync";
+    case WakePhase::FETCH:
+      return "fetch";
+    case WakePhase::HTTP_CONNECT:
+      return "http_connect";
+    case WakePhase::HTTP_TTFB:
+      return "http_ttfb";
+    case WakePhase::HTTP_BODY:
+      return "http_body";
+    case WakePhase::HTTP_PARSE:
+      return "http_parse";
+    case WakePhase::MQTT_PUBLISH:
+      return "mqtt_publish";
+    case WakePhase::DISPLAY_INIT:
+      return "display_init";
+    case WakePhase::DISPLAY_PAGE:
+      return "display_page";
+    case WakePhase::DISPLAY_BUSY:
+      return "display_busy";
+    case WakePhase::DEEP_SLEEP:
+      return "deep_sleep";
+    case WakePhase::TLS_FULL:
+      return "tls_full";
+    case WakePhase::TLS_RESUMED:
+      return "tls_resumed";
+    case WakePhase::DISPLAY_RECORD:
+      return "display_record";
+    case WakePhase::DISPLAY_REPLAY:
+      return "display_replay";
+    case WakePhase::VIEW_BUILD:
+      return "view_build";
+    default:
+      return "unknown";
+  }
+}
+
+namespace {
+
+bool isFetchPhase(uint8_t phase) {
+  return (phase >= static_cast<uint8_t>(WakePhase::FETCH) && phase <= static_cast<uint8_t>(WakePhase::HTTP_PARSE)) ||
+         phase == static_cast<uint8_t>(WakePhase::TLS_FULL) || phase == static_cast<uint8_t>(WakePhase::TLS_RESUMED);
+}
+
+// Tag that takes part in the JSON key: fetch phases are split per provider
+// kind and paging passes per page, every other phase is summed across tags.
+uint8_t keyTag(const Sample &sample) {
+  if (isFetchPhase(sample.phase) || sample.phase == static_cast<uint8_t>(WakePhase::DISPLAY_PAGE) ||
+      sample.phase == static_cast<uint8_t>(WakePhase::DISPLAY_REPLAY)) {
+    return sample.tag;
+  }
+  return WAKE_TAG_NONE;
+}
+
+}  // namespace
+
+size_t formatJson(const Record &record, char *buf, size_t len) {
+  size_t pos = 0;
+  int n = snprintf(buf, len, "{\"wake\":%u,\"total_ms\":%u,\"dropped\":%u", static_cast<unsigned>(record.wakeIndex),
+                   static_cast<unsigned>(record.totalMs), static_cast<unsigned>(record.dropped));
+  if (n < 0 || static_cast<size_t>(n) >= len) {
+    return 0;
+  }
+  pos = static_cast<size_t>(n);
+
+  for (size_t i = 0; i < record.sampleCount; ++i) {
+    const Sample &sample = record.samples[i];
+    const uint8_t tag = keyTag(sample);
+    // Emit each (phase, tag) key once, at its first occurrence.
+    bool seen = false;
+    for (size_t j = 0; j < i && !seen; ++j) {
+      seen = record.samples[j].phase == sample.phase && keyTag(record.samples[j]) == tag;
+    }
+    if (seen) {
+      continue;
+    }
+    uint32_t total = 0;
+    for (size_t j = i; j < record.sampleCount; ++j) {
+      if (record.samples[j].phase == sample.phase && keyTag(record.samples[j]) == tag) {
+        total += record.samples[j].durationMs;
+      }
+    }
+
+    const char *name = phaseName(static_cast<WakePhase>(sample.phase));
+    if (tag == WAKE_TAG_NONE) {
+      n = snprintf(buf + pos, len - pos, ",\"%s\":%u", name, static_cast<unsigned>(total));
+    } else if (isFetchPhase(sample.phase)) {
+      n = snprintf(buf + pos, len - pos, ",\"%s_%s\":%u", name, fetchKindName(static_cast<FetchKind>(tag)),
+                   static_cast<unsigned>(total));
+    } else {
+      n = snprintf(buf + pos, len - pos, ",\"%s_%u\":%u", name, static_cast<unsigned>(tag),
+                   static_cast<unsigned>(total));
+    }
+    if (n < 0 || static_cast<size_t>(n) >= len - pos) {
+      return 0;
+    }
+    pos += static_cast<size_t>(n);
+  }
+
+  for (size_t i = 0; i < stack_watermark::SLOTS; ++i) {
+    if (record.stackUsedBytes[i] == 0) {
+      continue;
+    }
+    n = snprintf(buf + pos, len - pos, ",\"stack_%s\":%u", stack_watermark::slotName(static_cast<StackSlot>(i)),
+                 static_cast<unsigned>(record.stackUsedBytes[i]));
+    if (n < 0 || static_cast<size_t>(n) >= len - pos) {
+      return 0;
+    }
+    pos += static_cast<size_t>(n);
+  }
+
+  if (pos + 2 > len) {
+    return 0;
+  }
+  buf[pos++] = '}';
+  buf[pos] = '\0';
+  return pos;
+}
+
+}  // namespace wake_profile
+
+// Ring of the last wakes (RTC memory, survives deep sleep; cleared by a
+// power-on reset). The record of the running wake lives in regular RAM and
+// only reaches the ring once it is complete.
+static RTC_DATA_ATTR wake_profile::Ring wakeProfileRing = {};
+static wake_profile::Record currentWake;
+static bool currentWakeStarted = false;
+
+// Fetch workers record concurrently: samples and task tags are guarded by a
+// spinlock (short, non-blocking critical sections only).
+static portMUX_TYPE wakeProfileMux = portMUX_INITIALIZER_UNLOCKED;
+
+static constexpr size_t TASK_TAG_SLOTS = 4;
+static struct {
+  TaskHandle_t task;
+  uint8_t tag;
+} taskTags[TASK_TAG_SLOTS] = {};
+
+// One line per wake: the main phases and the display phases, which are
+// disjoint (DISPLAY_PAGE leaves the BUSY waits out).
+static void logSummary(const wake_profile::Record &record) {
+  LOG_INFO("Wake profile #%u: total %u ms, wifi %u ms, time %u ms, fetch %u ms, display record %u ms, "
+           "replay %u ms, transfer %u ms, busy %u ms",
+           static_cast<unsigned>(record.wakeIndex), static_cast<unsigned>(record.totalMs),
+           static_cast<unsigned>(wake_profile::phaseTotalMs(record, WakePhase::WIFI_CONNECT)),
+           static_cast<unsigned>(wake_profile::phaseTotalMs(record, WakePhase::TIME_SYNC)),
+           static_cast<unsigned>(wake_profile::phaseTotalMs(record, WakePhase::FETCH)),
+           static_cast<unsigned>(wake_profile::phaseTotalMs(record, WakePhase::DISPLAY_RECORD)),
+           static_cast<unsigned>(wake_profile::phaseTotalMs(record, WakePhase::DISPLAY_REPLAY)),
+           static_cast<unsigned>(wake_profile::phaseTotalMs(record, WakePhase::DISPLAY_PAGE)),
+           static_cast<unsigned>(wake_profile::phaseTotalMs(record, WakePhase::DISPLAY_BUSY)));
+}
+
+void wakeProfilerBegin() {
+  if (!wakeProfilerEnabled()) {
+    return;
+  }
+  if (!wake_profile::valid(wakeProfileRing)) {
+    wake_profile::reset(wakeProfileRing);
+  }
+  wake_profile::begin(currentWake, wakeProfileRing.wakeCount);
+  currentWakeStarted = true;
+}
+
+void wakeProfilerRecord(WakePhase phase, uint8_t tag, uint32_t startMs, uint32_t durationMs) {
+  if (!wakeProfilerEnabled() || !currentWakeStarted) {
+    return;
+  }
+  portENTER_CRITICAL(&wakeProfileMux);
+  wake_profile::add(currentWake, phase, tag, startMs, durationMs);
+  portEXIT_CRITICAL(&wakeProfileMux);
+}
+
+void wakeProfilerRecordStack(StackSlot slot, uint32_t usedBytes) {
+  if (!wakeProfilerEnabled() || !currentWakeStarted) {
+    return;
+  }
+  portENTER_CRITICAL(&wakeProfileMux);
+  wake_profile::addStack(currentWake, slot, usedBytes);
+  portEXIT_CRITICAL(&wakeProfileMux);
+}
+
+void wakeProfilerBindTask(uint8_t tag) {
+  if (!wakeProfilerEnabled()) {
+    return;
+  }
+  TaskHandle_t self = xTaskGetCurrentTaskHandle();
+  portENTER_CRITICAL(&wakeProfileMux);
+  size_t freeSlot = TASK_TAG_SLOTS;
+  for (size_t i = 0; i < TASK_TAG_SLOTS; ++i) {
+    if (taskTags[i].task == self) {
+      freeSlot = i;
+      break;
+    }
+    if (taskTags[i].task == nullptr && freeSlot == TASK_TAG_SLOTS) {
+      freeSlot = i;
+    }
+  }
+  if (freeSlot < TASK_TAG_SLOTS) {
+    taskTags[freeSlot].task = tag == WAKE_TAG_NONE ? nullptr : self;
+    taskTags[freeSlot].tag = tag;
+  }
+  portEXIT_CRITICAL(&wakeProfileMux);
+}
+
+uint8_t wakeProfilerTaskTag() {
+  if (!wakeProfilerEnabled()) {
+    return WAKE_TAG_NONE;
+  }
+  TaskHandle_t self = xTaskGetCurrentTaskHandle();
+  uint8_t tag = WAKE_TAG_NONE;
+  portENTER_CRITICAL(&wakeProfileMux);
+  for (size_t i = 0; i < TASK_TAG_SLOTS; ++i) {
+    if (taskTags[i].task == self) {
+      tag = taskTags[i].tag;
+      break;
+    }
+  }
+  portEXIT_CRITICAL(&wakeProfileMux);
+  return tag;
+}
+
+void wakeProfilerCommit() {
+  if (!wakeProfilerEnabled() || !currentWakeStarted) {
+    return;
+  }
+  portENTER_CRITICAL(&wakeProfileMux);
+  currentWake.totalMs = millis();
+  wake_profile::commit(wakeProfileRing, currentWake);
+  currentWakeStarted = false;
+  portEXIT_CRITICAL(&wakeProfileMux);
+
+  // The wakes kept in the ring, oldest first, then the samples of this one.
+  for (size_t age = wake_profile::HISTORY; age-- > 0;) {
+    const wake_profile::Record *kept = wake_profile::latest(wakeProfileRing, age);
+    if (kept != nullptr) {
+      logSummary(*kept);
+    }
+  }
+  const wake_profile::Record &record = currentWake;
+  for (size_t i = 0; i < record.sampleCount; ++i) {
+    const wake_profile::Sample &sample = record.samples[i];
+    LOG_DEBUG("  %-13s tag %3u  start %6u ms  took %5u ms", wake_profile::phaseName(static_cast<WakePhase>(sample.phase)),
+              static_cast<unsigned>(sample.tag), static_cast<unsigned>(sample.startMs),
+              static_cast<unsigned>(sample.durationMs));
+  }
+  for (size_t i = 0; i < stack_watermark::SLOTS; ++i) {
+    if (record.stackUsedBytes[i] > 0) {
+      LOG_DEBUG("  stack %-17s used %5u B", stack_watermark::slotName(static_cast<StackSlot>(i)),
+                static_cast<unsigned>(record.stackUsedBytes[i]));
+    }
+  }
+  if (record.dropped > 0) {
+    LOG_WARNING("Wake profile: %u samples dropped (record full)", static_cast<unsigned>(record.dropped));
+  }
+}
+
+bool wakeProfilerLastJson(char *buf, size_t len) {
+  if (!wakeProfilerEnabled()) {
+    return false;
+  }
+  const wake_profile::Record *record = wake_profile::latest(wakeProfileRing);
+  return record != nullptr && wake_profile::formatJson(*record, buf, len) > 0;
+}
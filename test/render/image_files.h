@@ -0,0 +1,150 @@
+/* Image files and hashes of host-rendered frames.
+ * Copyright (C) 2026  Lumixen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/*
+ * A frame is one ink index per pixel (gxepd2_host::Ink), rows top to bottom.
+ * PBM keeps white as white and any ink as black; PNG keeps every ink, as a
+ * 4-bit palette image in stored (uncompressed) deflate blocks, so no zlib is
+ * needed. The hash identifies a frame in golden.txt.
+ */
+namespace image_files {
+
+// FNV-1a over the inks and the size.
+inline uint64_t hash(const uint8_t *inks, int width, int height) {
+  uint64_t h = 0xcbf29ce484222325ULL;
+  auto mix = [&h](uint8_t byte) {
+    h ^= byte;
+    h *= 0x100000001b3ULL;
+  };
+  for (int shift = 0; shift < 32; shift += 8) {
+    mix(static_cast<uint8_t>(width >> shift));
+    mix(static_cast<uint8_t>(height >> shift));
+  }
+  for (size_t i = 0; i < static_cast<size_t>(width) * height; ++i) {
+    mix(inks[i]);
+  }
+  return h;
+}
+
+inline bool writeFile(const std::string &path, const std::vector<uint8_t> &bytes) {
+  FILE *f = fopen(path.c_str(), "wb");
+  if (f == nullptr) {
+    return false;
+  }
+  const bool ok = fwrite(bytes.data(), 1, bytes.size(), f) == bytes.size();
+  return fclose(f) == 0 && ok;
+}
+
+// Binary PBM (P4): 1 bit per pixel, 1 = black, rows padded to whole bytes.
+inline bool writePbm(const std::string &path, const uint8_t *inks, int width, int height, uint8_t white) {
+  const std::string header = "P4\n" + std::to_string(width) + " " + std::to_string(height) + "\n";
+  std::vector<uint8_t> bytes(header.begin(), header.end());
+  const size_t rowBytes = (width + 7) / 8;
+  for (int y = 0; y < height; ++y) {
+    const size_t row = bytes.size();
+    bytes.resize(row + rowBytes, 0);
+    for (int x = 0; x < width; ++x) {
+      if (inks[y * width + x] != white) {
+        bytes[row + x / 8] |= 0x80 >> (x % 8);
+      }
+    }
+  }
+  return writeFile(path, bytes);
+}
+
+namespace detail {
+
+inline uint32_t crc32(const uint8_t *data, size_t len, uint32_t crc = 0) {
+  crc = ~crc;
+  for (size_t i = 0; i < len; ++i) {
+    crc ^= data[i];
+    for (int k = 0; k < 8; ++k) {
+      crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+    }
+  }
+  return ~crc;
+}
+
+inline void put32(std::vector<uint8_t> &out, uint32_t v) {
+  for (int shift = 24; shift >= 0; shift -= 8) {
+    out.push_back(static_cast<uint8_t>(v >> shift));
+  }
+}
+
+inline void chunk(std::vector<uint8_t> &png, const char type[4], const std::vector<uint8_t> &data) {
+  put32(png, static_cast<uint32_t>(data.size()));
+  const size_t start = png.size();
+  png.insert(png.end(), type, type + 4);
+  png.insert(png.end(), data.begin(), data.end());
+  put32(png, crc32(png.data() + start, png.size() - start));
+}
+
+}  // namespace detail
+
+// PNG, palette color type with `palette` (RGB triplets, at most 16).
+inline bool writePng(const std::string &path, const uint8_t *inks, int width, int height, const uint8_t (*palette)[3],
+                     size_t paletteSize) {
+  using namespace detail;
+  std::vector<uint8_t> png = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+
+  std::vector<uint8_t> ihdr;
+  put32(ihdr, width);
+  put32(ihdr, height);
+  ihdr.insert(ihdr.end(), {4, 3, 0, 0, 0});  // 4-bit, palette, deflate, no filter, no interlace
+  chunk(png, "IHDR", ihdr);
+
+  std::vector<uint8_t> plte;
+  for (size_t i = 0; i < paletteSize; ++i) {
+    plte.insert(plte.end(), palette[i], palette[i] + 3);
+  }
+  chunk(png, "PLTE", plte);
+
+  // Scanlines: filter type 0, then two pixels per byte.
+  std::vector<uint8_t> raw;
+  const size_t rowBytes = (width + 1) / 2;
+  raw.reserve(height * (rowBytes + 1));
+  for (int y = 0; y < height; ++y) {
+    raw.push_back(0);
+    for (int x = 0; x < width; x += 2) {
+      const uint8_t hi = inks[y * width + x];
+      const uint8_t lo = x + 1 < width ? inks[y * width + x + 1] : 0;
+      raw.push_back(static_cast<uint8_t>(hi << 4 | lo));
+    }
+  }
+
+  // zlib stream of stored blocks.
+  std::vector<uint8_t> idat = {0x78, 0x01};
+  size_t at = 0;
+  do {
+    const size_t len = raw.size() - at < 65535 ? raw.size() - at : 65535;
+    idat.push_back(at + len == raw.size() ? 1 : 0);  // BFINAL, BTYPE 00
+    idat.insert(idat.end(), {static_cast<uint8_t>(len), static_cast<uint8_t>(len >> 8),
+                             static_cast<uint8_t>(~len), static_cast<uint8_t>(~len >> 8)});
+    idat.insert(idat.end(), raw.begin() + at, raw.begin() + at + len);
+    at += len;
+  } while (at < raw.size());
+  uint32_t a = 1, b = 0;
+  for (uint8_t byte : raw) {
+    a = (a + byte) % 65521;
+    b = (b + a) % 65521;
+  }
+  put32(idat, b << 16 | a);
+  chunk(png, "IDAT", idat);
+  chunk(png, "IEND", {});
+  return writeFile(path, png);
+}
+
+}  // namespace image_files
@@ -0,0 +1,302 @@
+/* Host render driver for esp32-weather-epd.
+ * Copyright (C) 2026  Lumixen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+/*
+ * Renders the weather screen of a fixed forecast with the firmware's own
+ * draw code (renderer.cpp, display_utils.cpp, view_model.cpp) onto the
+ * in-memory display of test/render/shim, for the panel of the config.h it
+ * is built with (see run_render.sh):
+ *
+ *   - each widget is drawn alone through initDisplay() .. renderScene()
+ *     and reported with its draw calls and pixels;
+ *   - every render is hashed into <out>/<panel>.hashes, for golden.txt;
+ *   - the full frame and the error screen are written as PNG and PBM;
+ *   - with RUNS > 0, full frames are timed (record and replay).
+ *
+ * usage: render_frame [-v] <out dir> [RUNS]
+ */
+
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <string>
+#include <vector>
+
+#include "_locale.h"
+#include "config.h"
+#include "display_utils.h"
+#include "icons/icons_196x196.h"
+#include "image_files.h"
+#include "renderer.h"
+#include "view_model.h"
+#include "wake_profiler.h"
+
+#if defined(EPD_PANEL_GENERIC_BW_V2)
+static const char PANEL[] = "GENERIC_BW_V2";
+#elif defined(EPD_PANEL_GENERIC_3C_B)
+static const char PANEL[] = "GENERIC_3C_B";
+#elif defined(EPD_PANEL_DKE_3C_86BF)
+static const char PANEL[] = "DKE_3C_86BF";
+#elif defined(EPD_PANEL_GENERIC_7C_F)
+static const char PANEL[] = "GENERIC_7C_F";
+#elif defined(EPD_PANEL_GENERIC_BW_V1)
+static const char PANEL[] = "GENERIC_BW_V1";
+#endif
+
+// wake_profiler.cpp keeps its record in RTC memory under FreeRTOS; the host
+// times the frame itself.
+void wakeProfilerRecord(WakePhase, uint8_t, uint32_t, uint32_t) {}
+
+// ------------------------------------------------------------------ fixture
+
+static const time_t NOW = 1784019600;  // 2026-07-14 09:00 UTC
+
+// A summer day with a thunderstorm in the afternoon, as providers map it.
+static void makeForecast(forecast_t &forecast, air_quality_t &airQuality) {
+  static const int8_t HOURLY_TEMP[] = {21, 23, 24, 26, 27, 28, 27, 24, 20, 19, 19, 18,
+                                       17, 16, 15, 15, 14, 14, 13, 13, 14, 16, 18, 20};
+  static const uint8_t HOURLY_POP[] = {0,  0,  5,  10, 25, 55, 80, 90, 70, 40, 20, 10,
+                                       5,  0,  0,  0,  0,  0,  5,  5,  10, 10, 5,  0};
+  static const weather_condition HOURLY_WEATHER[] = {
+      weather_condition::PARTLY_CLOUDY, weather_condition::PARTLY_CLOUDY, weather_condition::CLOUDY,
+      weather_condition::CLOUDY,        weather_condition::OVERCAST,      weather_condition::RAIN_SHOWERS,
+      weather_condition::THUNDERSTORM,  weather_condition::THUNDERSTORM,  weather_condition::RAIN,
+      weather_condition::DRIZZLE,       weather_condition::OVERCAST,      weather_condition::CLOUDY,
+      weather_condition::PARTLY_CLOUDY, weather_condition::CLEAR,         weather_condition::CLEAR,
+      weather_condition::CLEAR,         weather_condition::CLEAR,         weather_condition::CLEAR,
+      weather_condition::FOG,           weather_condition::FOG,           weather_condition::PARTLY_CLOUDY,
+      weather_condition::CLEAR,         weather_condition::CLEAR,         weather_condition::PARTLY_CLOUDY,
+  };
+  static const weather_condition DAILY_WEATHER[] = {
+      weather_condition::THUNDERSTORM, weather_condition::RAIN, weather_condition::PARTLY_CLOUDY,
+      weather_condition::CLEAR,        weather_condition::SNOW,
+  };
+
+  forecast.reset();
+  forecast.lat = 51.5072f;
+  forecast.lon = -0.1276f;
+  current_t &current = forecast.current;
+  current.dt = NOW;
+  current.sunrise = NOW - 4 * 3600 - 5 * 60;
+  current.sunset = NOW + 11 * 3600 + 18 * 60;
+  current.temp = 21.4f;
+  current.feels_like = 22.3f;
+  current.pressure = 1016;
+  current.humidity = 64;
+  current.dew_point = 14.2f;
+  current.clouds = 40;
+  current.uvi = 5.6f;
+  current.visibility = 10000;
+  current.wind_speed = 4.2f;
+  current.wind_gust = 8.1f;
+  current.wind_deg = 245;
+  current.is_day = true;
+  current.weather.condition = weather_condition::PARTLY_CLOUDY;
+
+  for (int i = 0; i < NUM_HOURLY; ++i) {
+    hourly_t &hour = forecast.hourly[i];
+    hour.dt = NOW + i * 3600;
+    hour.temp = HOURLY_TEMP[i % 24] + 0.3f;
+    hour.feels_like = hour.temp;
+    hour.pop = HOURLY_POP[i % 24];
+    hour.rain_1h = hour.pop / 20.0f;
+    hour.is_day = i % 24 < 12;
+    hour.weather.condition = HOURLY_WEATHER[i % 24];
+  }
+  for (int d = 0; d < NUM_DAILY; ++d) {
+    daily_t &day = forecast.daily[d];
+    day.dt = NOW + d * 86400;
+    day.sunrise = current.sunrise + d * 86400;
+    day.sunset = current.sunset + d * 86400;
+    day.temp.max = 28.4f - 3 * d;
+    day.temp.min = 13.2f - 4 * d;
+    day.pop = 90 - 20 * d;
+    day.rain = d < 2 ? 12.4f - 6 * d : 0;
+    day.snow = d == 4 ? 3.0f : 0;
+    day.weather.condition = DAILY_WEATHER[d];
+  }
+
+  airQuality = air_quality_t{};
+  for (int i = 0; i < NUM_AIR_POLLUTION; ++i) {
+    airQuality.dt[i] = NOW - (NUM_AIR_POLLUTION - 1 - i) * 3600;
+    airQuality.components.co[i] = 210;
+    airQuality.components.no2[i] = 18;
+    airQuality.components.o3[i] = 64 + i;
+    airQuality.components.so2[i] = 2;
+    airQuality.components.pm2_5[i] = 9;
+    airQuality.components.pm10[i] = 17;
+  }
+}
+
+static weather_alert_t makeAlert(const char *event, const char *tags) {
+  weather_alert_t alert;
+  alert.sender_name = "Met Office";
+  alert.event = event;
+  alert.start = NOW;
+  alert.end = NOW + 10 * 3600;
+  alert.tags = tags;
+  return alert;
+}
+
+// ------------------------------------------------------------------ renders
+
+static weather_view_t view;      // one alert: the large alert layout
+static weather_view_t twoAlerts;  // the compact layout
+
+static void drawFrame() {
+  drawCurrentConditions(view.current);
+  drawOutlookGraph(view.outlook);
+  drawForecast(view.days);
+  drawLocationDate(CITY_STRING, view.date);
+  drawAlerts(view.alerts, view.alertCount, CITY_STRING, view.date);
+  drawStatusBar(view.statusBar);
+}
+
+struct Widget {
+  const char *name;
+  void (*draw)();
+  bool image;  // also written as PNG and PBM
+};
+
+static const Widget WIDGETS[] = {
+    {"current", [] { drawCurrentConditions(view.current); }, false},
+    {"outlook", [] { drawOutlookGraph(view.outlook); }, false},
+    {"forecast", [] { drawForecast(view.days); }, false},
+    {"location", [] { drawLocationDate(CITY_STRING, view.date); }, false},
+    {"alert", [] { drawAlerts(view.alerts, view.alertCount, CITY_STRING, view.date); }, false},
+    {"alerts", [] { drawAlerts(twoAlerts.alerts, twoAlerts.alertCount, CITY_STRING, twoAlerts.date); }, false},
+    {"status", [] { drawStatusBar(view.statusBar); }, false},
+    {"error", [] { drawError(wifi_x_196x196, TXT_WIFI_CONNECTION_FAILED); }, true},
+    {"frame", drawFrame, true},
+};
+
+using Clock = std::chrono::steady_clock;
+
+static double elapsedUs(Clock::time_point start, Clock::time_point end) {
+  return std::chrono::duration<double, std::micro>(end - start).count();
+}
+
+// One wake's display sequence (main.cpp) around `draw`.
+static void render(void (*draw)(), double *recordUs = nullptr, double *replayUs = nullptr) {
+  initDisplay();
+  const Clock::time_point start = Clock::now();
+  if (!beginScene()) {
+    fprintf(stderr, "cannot allocate the scene\n");
+    exit(1);
+  }
+  draw();
+  const Clock::time_point recorded = Clock::now();
+  // A scene that overflows the display list is not drawn on the panel either.
+  if (!renderScene()) {
+    fprintf(stderr, "the scene overflowed the display list\n");
+    exit(1);
+  }
+  const Clock::time_point replayed = Clock::now();
+  powerOffDisplay();
+  if (recordUs != nullptr) {
+    *recordUs = elapsedUs(start, recorded);
+    *replayUs = elapsedUs(recorded, replayed);
+  }
+}
+
+static uint32_t inked() {
+  uint32_t count = 0;
+  for (size_t i = 0; i < static_cast<size_t>(DISP_WIDTH) * DISP_HEIGHT; ++i) {
+    count += display.inks()[i] != gxepd2_host::WHITE;
+  }
+  return count;
+}
+
+int main(int argc, char **argv) {
+  int opt;
+  while ((opt = getopt(argc, argv, "v")) != -1) {
+    if (opt == 'v') {
+      Serial.enabled = true;
+    } else {
+      return 2;
+    }
+  }
+  if (optind >= argc) {
+    fprintf(stderr, "usage: %s [-v] <out dir> [RUNS]\n", argv[0]);
+    return 2;
+  }
+  const std::string out = argv[optind];
+  const int runs = optind + 1 < argc ? atoi(argv[optind + 1]) : 0;
+
+  setenv("TZ", TIMEZONE, 1);
+  tzset();
+  tm timeInfo = {};
+  localtime_r(&NOW, &timeInfo);
+
+  static forecast_t forecast;
+  static air_quality_t airQuality;
+  makeForecast(forecast, airQuality);
+  const moon_state_t moon = {NOW - 3 * 3600, NOW + 9 * 3600, 0.62f};
+  String dateStr, refreshTimeStr;
+  getDateStr(dateStr, &timeInfo);
+  getRefreshTimeStr(refreshTimeStr, true, &timeInfo);
+
+  std::vector<weather_alert_t> alerts = {makeAlert("Yellow Thunderstorm Warning", "thunderstorm")};
+  const Clock::time_point viewStart = Clock::now();
+  buildWeatherView(view, forecast, airQuality, std::nullopt, moon, alerts, timeInfo, dateStr, "", refreshTimeStr,
+                   -75, 3500);
+  const double viewUs = elapsedUs(viewStart, Clock::now());
+  alerts = {makeAlert("Yellow Thunderstorm Warning", "thunderstorm"),
+            makeAlert("Amber Extreme Heat Warning, (Until 8 PM)", "extreme high temperature")};
+  buildWeatherView(twoAlerts, forecast, airQuality, std::nullopt, moon, alerts, timeInfo, dateStr, "",
+                   refreshTimeStr, -75, 3500);
+
+  const std::string hashesPath = out + "/" + PANEL + ".hashes";
+  FILE *hashes = fopen(hashesPath.c_str(), "w");
+  if (hashes == nullptr) {
+    fprintf(stderr, "cannot write %s\n", hashesPath.c_str());
+    return 1;
+  }
+  printf("%s %dx%d, %d page(s) of %u rows\n", PANEL, DISP_WIDTH, DISP_HEIGHT,
+         (DISP_HEIGHT + display.pageHeight() - 1) / display.pageHeight(), display.pageHeight());
+  printf("%-9s %10s %7s %7s %7s %6s %9s %8s %7s\n", "widget", "draw calls", "prints", "glyphs", "bitmaps", "lines",
+         "pixels", "clipped", "inked");
+  bool ok = true;
+  for (const Widget &widget : WIDGETS) {
+    render(widget.draw);
+    const gxepd2_host::Stats &stats = display.stats();
+    printf("%-9s %10u %7u %7u %7u %6u %9u %8u %7u\n", widget.name, stats.drawCalls(), stats.prints, stats.glyphs,
+           stats.bitmaps, stats.lines, stats.written, stats.clipped, inked());
+    fprintf(hashes, "%s %s %016llx\n", PANEL, widget.name,
+            static_cast<unsigned long long>(image_files::hash(display.inks(), DISP_WIDTH, DISP_HEIGHT)));
+    if (widget.image) {
+      const std::string base = out + "/" + PANEL + "_" + widget.name;
+      ok &= image_files::writePng(base + ".png", display.inks(), DISP_WIDTH, DISP_HEIGHT, gxepd2_host::INK_RGB,
+                                  gxepd2_host::INK_COUNT);
+      ok &= image_files::writePbm(base + ".pbm", display.inks(), DISP_WIDTH, DISP_HEIGHT, gxepd2_host::WHITE);
+    }
+  }
+  fclose(hashes);
+  if (!ok) {
+    fprintf(stderr, "cannot write the images to %s\n", out.c_str());
+    return 1;
+  }
+
+  if (runs > 0) {
+    double recordTotal = 0, replayTotal = 0, best = 1e30;
+    for (int i = 0; i < runs; ++i) {
+      double recordUs, replayUs;
+      render(drawFrame, &recordUs, &replayUs);
+      recordTotal += recordUs;
+      replayTotal += replayUs;
+      best = std::min(best, recordUs + replayUs);
+    }
+    printf("benchmark: %d frames, view %.0f us, record %.0f us, replay %.0f us, frame %.0f us (best %.0f us)\n", runs,
+           viewUs, recordTotal / runs, replayTotal / runs, (recordTotal + replayTotal) / runs, best);
+  }
+  return 0;
+}
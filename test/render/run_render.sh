@@ -0,0 +1,111 @@
+#!/usr/bin/env bash
+#
+# Renders the weather screen on the host for every supported panel and checks
+# it against the golden hashes in test/render/golden.txt. No panel, ESP32 or
+# QEMU is needed: renderer.cpp, display_utils.cpp and view_model.cpp are built
+# natively against the in-memory GxEPD2 display in test/render/shim, with the
+# config.h and font_metrics.h scripts/config.py generates for each panel.
+#
+# Each panel uses test/configs/openmeteo.yml with its epdPanel; on the color
+# panels the alert, warning and high-temperature colors are set to red. For
+# every panel render_frame.cpp prints the draw calls and pixels of each widget
+# and writes, under $RENDER_OUT:
+#
+#   <panel>_frame.png/.pbm    the full screen
+#   <panel>_error.png/.pbm    the error screen
+#   <panel>.hashes            hash of every widget's render
+#
+# A hash that differs from golden.txt fails the run; look at the images, and
+# if the change is intended, record the new hashes with --update.
+#
+# Usage:
+#   test/render/run_render.sh [--update] [--bench RUNS] [PANEL...]
+#
+# Environment:
+#   CC, CXX      host compilers (default: cc, c++)
+#   PYTHON       Python with pydantic and pyyaml (default: python3)
+#   RENDER_OUT   output directory (default: .render in the project)
+set -euo pipefail
+
+ROOT="$(cd "$(dirname "$0")/../.." && pwd)"
+CC="${CC:-cc}"
+CXX="${CXX:-c++}"
+PYTHON="${PYTHON:-python3}"
+OUT="${RENDER_OUT:-$ROOT/.render}"
+GOLDEN="$ROOT/test/render/golden.txt"
+
+update=0
+runs=0
+panels=()
+while [ $# -gt 0 ]; do
+    case "$1" in
+        --update) update=1 ;;
+        --bench) runs="$2"; shift ;;
+        *) panels+=("$1") ;;
+    esac
+    shift
+done
+if [ ${#panels[@]} -eq 0 ]; then
+    panels=(GENERIC_BW_V2 GENERIC_3C_B DKE_3C_86BF GENERIC_7C_F GENERIC_BW_V1)
+fi
+
+cd "$ROOT"
+mkdir -p "$OUT"
+
+status=0
+for panel in "${panels[@]}"; do
+    echo "=================================================="
+    echo "  render: $panel"
+    echo "=================================================="
+    build="$OUT/build/$panel"
+    mkdir -p "$build"
+
+    colors=()
+    case "$panel" in
+        GENERIC_BW_V2 | GENERIC_BW_V1) ;;
+        *) colors=(-e 's/^  \(outlookTemperatureHighColor\|alert\|statusBarBatteryWarning\|statusBarWeakWifi\): black$/  \1: red/') ;;
+    esac
+    sed -e "s/^epdPanel: .*/epdPanel: $panel/" "${colors[@]}" test/configs/openmeteo.yml >"$build/config.yml"
+    "$PYTHON" scripts/config.py --header "$build/config.h" "$build/config.yml" >"$build/config.log"
+
+    "$CC" -O2 -c lib/pollutant-concentration-to-aqi/aqi.c -o "$build/aqi.o"
+    "$CXX" -std=gnu++17 -O2 \
+        -I test/render/shim -I "$build" -I include \
+        -I lib/esp32-weather-epd-assets -I lib/pollutant-concentration-to-aqi \
+        src/renderer.cpp src/display_utils.cpp src/view_model.cpp src/locale.cpp src/_strftime.cpp \
+        src/conversions.cpp test/render/render_frame.cpp "$build/aqi.o" -o "$build/render_frame"
+
+    if [ "$runs" -gt 0 ]; then
+        "$build/render_frame" "$OUT" "$runs"
+    else
+        "$build/render_frame" "$OUT"
+    fi
+
+    if [ "$update" -eq 0 ]; then
+        if diff <(grep "^$panel " "$GOLDEN" || true) "$OUT/$panel.hashes" >"$build/golden.diff"; then
+            echo "golden: $panel matches"
+        else
+            echo "golden: $panel differs (images in $OUT):"
+            cat "$build/golden.diff"
+            status=1
+        fi
+    fi
+done
+
+if [ "$update" -eq 1 ]; then
+    {
+        echo "# Hashes of the host renders (test/render/run_render.sh --update)."
+        echo "# <panel> <widget> <FNV-1a of the frame buffer>"
+        for panel in GENERIC_BW_V2 GENERIC_3C_B DKE_3C_86BF GENERIC_7C_F GENERIC_BW_V1; do
+            if [[ " ${panels[*]} " == *" $panel "* ]]; then
+                cat "$OUT/$panel.hashes"
+            else
+                grep "^$panel " "$GOLDEN" || true
+            fi
+        done
+    } >"$GOLDEN.tmp"
+    mv "$GOLDEN.tmp" "$GOLDEN"
+    echo "golden: updated $GOLDEN"
+fi
+
+exit "$status"
@@ -0,0 +1,212 @@
+/* Host stand-in for the parts of the Arduino-ESP32 core the renderer uses.
+ * Copyright (C) 2026  Lumixen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#define PROGMEM
+#define RTC_DATA_ATTR
+#define IRAM_ATTR
+#define pgm_read_byte(addr) (*reinterpret_cast<const uint8_t *>(addr))
+
+#define HIGH 0x1
+#define LOW 0x0
+#define INPUT 0x01
+#define OUTPUT 0x03
+
+using std::max;
+using std::min;
+
+inline uint32_t micros() {
+  static const auto start = std::chrono::steady_clock::now();
+  return static_cast<uint32_t>(
+      std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+}
+inline uint32_t millis() { return micros() / 1000; }
+inline void delay(uint32_t) {}
+inline void yield() {}
+inline void pinMode(uint8_t, uint8_t) {}
+inline void digitalWrite(uint8_t, uint8_t) {}
+inline int toUpperCase(int c) { return toupper(c); }
+inline int toLowerCase(int c) { return tolower(c); }
+
+/* WString.h: the members the linked sources call, with Arduino's semantics
+ * (out of range indices are ignored, replace() replaces every match). */
+class String {
+ public:
+  String() {}
+  String(const char *c) : s_(c ? c : "") {}
+  String(const std::string &c) : s_(c) {}
+  explicit String(char c) : s_(1, c) {}
+  explicit String(int v) : s_(std::to_string(v)) {}
+  explicit String(unsigned v) : s_(std::to_string(v)) {}
+  explicit String(long v) : s_(std::to_string(v)) {}
+  explicit String(unsigned long v) : s_(std::to_string(v)) {}
+  explicit String(double v, unsigned int decimals = 2) { format(v, decimals); }
+  explicit String(float v, unsigned int decimals = 2) { format(v, decimals); }
+
+  const char *c_str() const { return s_.c_str(); }
+  unsigned int length() const { return static_cast<unsigned int>(s_.size()); }
+  bool isEmpty() const { return s_.empty(); }
+  bool reserve(unsigned int n) {
+    s_.reserve(n);
+    return true;
+  }
+
+  String &operator+=(const String &o) {
+    s_ += o.s_;
+    return *this;
+  }
+  String &operator+=(const char *o) {
+    s_ += o;
+    return *this;
+  }
+  String &operator+=(char c) {
+    s_ += c;
+    return *this;
+  }
+  bool concat(const char *p, unsigned int n) {
+    s_.append(p, n);
+    return true;
+  }
+  friend String operator+(const String &a, const String &b) { return String(a.s_ + b.s_); }
+  friend String operator+(const String &a, const char *b) { return String(a.s_ + b); }
+  friend String operator+(const char *a, const String &b) { return String(a + b.s_); }
+  bool operator==(const String &o) const { return s_ == o.s_; }
+  bool operator==(const char *o) const { return s_ == o; }
+  bool operator!=(const String &o) const { return s_ != o.s_; }
+  bool operator!=(const char *o) const { return s_ != o; }
+
+  char charAt(unsigned int i) const { return i < s_.size() ? s_[i] : '\0'; }
+  void setCharAt(unsigned int i, char c) {
+    if (i < s_.size()) {
+      s_[i] = c;
+    }
+  }
+  char operator[](unsigned int i) const { return charAt(i); }
+  int indexOf(char c, unsigned int from = 0) const { return found(s_.find(c, from)); }
+  int indexOf(const String &t, unsigned int from = 0) const { return found(s_.find(t.s_, from)); }
+  int lastIndexOf(char c) const { return found(s_.rfind(c)); }
+  String substring(unsigned int left) const { return left >= s_.size() ? String() : String(s_.substr(left)); }
+  String substring(unsigned int left, unsigned int right) const {
+    if (left > right) {
+      std::swap(left, right);
+    }
+    if (left >= s_.size()) {
+      return String();
+    }
+    return String(s_.substr(left, std::min<size_t>(right, s_.size()) - left));
+  }
+  bool startsWith(const String &p) const { return s_.compare(0, p.s_.size(), p.s_) == 0; }
+  bool endsWith(const String &p) const {
+    return s_.size() >= p.s_.size() && s_.compare(s_.size() - p.s_.size(), p.s_.size(), p.s_) == 0;
+  }
+  void replace(const String &find, const String &with) {
+    if (find.s_.empty()) {
+      return;
+    }
+    for (size_t at = s_.find(find.s_); at != std::string::npos; at = s_.find(find.s_, at + with.s_.size())) {
+      s_.replace(at, find.s_.size(), with.s_);
+    }
+  }
+  void remove(unsigned int index) { remove(index, static_cast<unsigned int>(-1)); }
+  void remove(unsigned int index, unsigned int count) {
+    if (index < s_.size()) {
+      s_.erase(index, count);
+    }
+  }
+  void trim() {
+    const size_t first = s_.find_first_not_of(" \t\r\n\v\f");
+    if (first == std::string::npos) {
+      s_.clear();
+      return;
+    }
+    s_ = s_.substr(first, s_.find_last_not_of(" \t\r\n\v\f") - first + 1);
+  }
+  void toLowerCase() {
+    for (char &c : s_) {
+      c = static_cast<char>(tolower(static_cast<unsigned char>(c)));
+    }
+  }
+  void toUpperCase() {
+    for (char &c : s_) {
+      c = static_cast<char>(toupper(static_cast<unsigned char>(c)));
+    }
+  }
+  long toInt() const { return atol(s_.c_str()); }
+  float toFloat() const { return static_cast<float>(atof(s_.c_str())); }
+  double toDouble() const { return atof(s_.c_str()); }
+
+ private:
+  static int found(size_t at) { return at == std::string::npos ? -1 : static_cast<int>(at); }
+  void format(double v, unsigned int decimals) {
+    char buf[64];
+    snprintf(buf, sizeof(buf), "%.*f", static_cast<int>(decimals), v);
+    s_ = buf;
+  }
+
+  std::string s_;
+};
+
+/* Print.h: byte sink with print/println/printf on top of write(). */
+class Print {
+ public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t c) = 0;
+  virtual size_t write(const uint8_t *buf, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+      write(buf[i]);
+    }
+    return n;
+  }
+  size_t print(const char *s) { return write(reinterpret_cast<const uint8_t *>(s), strlen(s)); }
+  size_t print(const String &s) { return print(s.c_str()); }
+  size_t println(const char *s = "") { return print(s) + print("\n"); }
+  size_t println(const String &s) { return println(s.c_str()); }
+  size_t printf(const char *fmt, ...) __attribute__((format(printf, 2, 3))) {
+    char buf[512];
+    va_list args;
+    va_start(args, fmt);
+    const int n = vsnprintf(buf, sizeof(buf), fmt, args);
+    va_end(args);
+    return n < 0 ? 0 : print(buf);
+  }
+  virtual void flush() {}
+};
+
+/* Serial goes to stderr, so the images and reports on stdout stay clean.
+ * Quiet by default; the render driver turns it on with -v. */
+class HardwareSerial : public Print {
+ public:
+  void begin(unsigned long) {}
+  size_t write(uint8_t c) override { return enabled ? fputc(c, stderr) != EOF : 1; }
+  void flush() override { fflush(stderr); }
+  bool enabled = false;
+};
+inline HardwareSerial Serial;
+
+// esp_err.h, driver/gpio.h and esp_sleep.h
+typedef int esp_err_t;
+#define ESP_OK 0
+#define ESP_FAIL -1
+typedef int gpio_num_t;
+typedef enum { ESP_SLEEP_WAKEUP_UNDEFINED, ESP_SLEEP_WAKEUP_ALL, ESP_SLEEP_WAKEUP_EXT0 } esp_sleep_source_t;
+inline esp_err_t esp_sleep_enable_ext0_wakeup(gpio_num_t, int) { return ESP_OK; }
+inline esp_err_t esp_sleep_disable_wakeup_source(esp_sleep_source_t) { return ESP_OK; }
+inline esp_err_t esp_light_sleep_start() { return ESP_OK; }
@@ -0,0 +1,9 @@
+/* Host stand-in for GxEPD2_3C.h and its 3-color panels, see GxEPD2_host.h. */
+#pragma once
+
+#include "GxEPD2_host.h"
+
+GXEPD2_HOST_PANEL(GxEPD2_750c_Z08, 800, 480);
+
+template <typename GxEPD2_Type, uint16_t page_height>
+using GxEPD2_3C = gxepd2_host::Display<GxEPD2_Type, page_height, gxepd2_host::ink3C>;
@@ -0,0 +1,6 @@
+/* Host stand-in for lib/gxepd2-86bf, see GxEPD2_host.h. */
+#pragma once
+
+#include "GxEPD2_host.h"
+
+GXEPD2_HOST_PANEL(GxEPD2_750c_86BF, 800, 480);
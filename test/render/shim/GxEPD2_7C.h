@@ -0,0 +1,9 @@
+/* Host stand-in for GxEPD2_7C.h and its 7-color panels, see GxEPD2_host.h. */
+#pragma once
+
+#include "GxEPD2_host.h"
+
+GXEPD2_HOST_PANEL(GxEPD2_730c_GDEY073D46, 800, 480);
+
+template <typename GxEPD2_Type, uint16_t page_height>
+using GxEPD2_7C = gxepd2_host::Display<GxEPD2_Type, page_height, gxepd2_host::ink7C>;
@@ -0,0 +1,10 @@
+/* Host stand-in for GxEPD2_BW.h and its black/white panels, see GxEPD2_host.h. */
+#pragma once
+
+#include "GxEPD2_host.h"
+
+GXEPD2_HOST_PANEL(GxEPD2_750_T7, 800, 480);
+GXEPD2_HOST_PANEL(GxEPD2_750, 640, 384);
+
+template <typename GxEPD2_Type, uint16_t page_height>
+using GxEPD2_BW = gxepd2_host::Display<GxEPD2_Type, page_height, gxepd2_host::inkBW>;
@@ -0,0 +1,321 @@
+/* In-memory GxEPD2 display for rendering on the host.
+ * Copyright (C) 2026  Lumixen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#pragma once
+
+#include <Adafruit_GFX.h>
+#include <Arduino.h>
+#include <SPI.h>  // GxEPD2_EPD.h brings the SPI bus in
+#include <vector>
+
+// GxEPD2.h
+#define GxEPD_BLACK 0x0000
+#define GxEPD_DARKGREY 0x7BEF
+#define GxEPD_LIGHTGREY 0xC618
+#define GxEPD_WHITE 0xFFFF
+#define GxEPD_RED 0xF800
+#define GxEPD_YELLOW 0xFFE0
+#define GxEPD_COLORED GxEPD_RED
+#define GxEPD_GREEN 0x07E0
+#define GxEPD_BLUE 0x001F
+#define GxEPD_ORANGE 0xFC00
+
+/*
+ * The display classes renderer.cpp instantiates (GxEPD2_BW, GxEPD2_3C,
+ * GxEPD2_7C), drawing into a frame buffer instead of a panel:
+ *
+ *   - paged drawing works as on the device: firstPage() clears the frame,
+ *     each page only keeps the pixels of its band of rows and nextPage()
+ *     moves to the next band, so a command the display list fails to
+ *     replay on a page is missing from the image;
+ *   - text, bitmaps and lines are rasterized like Adafruit GFX and GxEPD2
+ *     (custom fonts at text size 1, drawInvertedBitmap(), Bresenham lines,
+ *     rotation 0 only);
+ *   - every pixel keeps the ink the panel would show, mapped from the
+ *     16-bit color like the GxEPD2 class of the panel does for the
+ *     GxEPD_* colors (other colors approximately);
+ *   - draw calls and pixels are counted for render statistics.
+ *
+ * Driver classes only carry the panel size and the BUSY callback; the
+ * callback runs once per refresh, where the panel would be busy.
+ */
+namespace gxepd2_host {
+
+// Inks in the order of the 7-color panels' pixel values.
+enum Ink : uint8_t { BLACK, WHITE, GREEN, BLUE, RED, YELLOW, ORANGE, INK_COUNT };
+
+// 8-bit RGB of each ink, for the image files.
+inline constexpr uint8_t INK_RGB[INK_COUNT][3] = {
+    {0, 0, 0}, {255, 255, 255}, {0, 160, 0}, {0, 0, 224}, {224, 0, 0}, {255, 224, 0}, {255, 128, 0},
+};
+
+// GxEPD2_BW: white stays white, every other color is black.
+inline uint8_t inkBW(uint16_t color) { return color == GxEPD_WHITE ? WHITE : BLACK; }
+
+// GxEPD2_3C: red and yellow use the color plane.
+inline uint8_t ink3C(uint16_t color) {
+  switch (color) {
+    case GxEPD_WHITE:
+      return WHITE;
+    case GxEPD_BLACK:
+      return BLACK;
+    case GxEPD_RED:
+    case GxEPD_YELLOW:
+      return RED;
+    default:
+      if ((color & 0xF800) > 0x8000 && (color & 0x07E0) < 0x0400) {
+        return RED;
+      }
+      return (color & 0xF800) + ((color & 0x07E0) << 5) + ((color & 0x001F) << 11) >= 0x18000 ? WHITE : BLACK;
+  }
+}
+
+// GxEPD2_7C::color7(): exact for the GxEPD_* colors, else by channel.
+inline uint8_t ink7C(uint16_t color) {
+  switch (color) {
+    case GxEPD_BLACK:
+      return BLACK;
+    case GxEPD_WHITE:
+      return WHITE;
+    case GxEPD_GREEN:
+      return GREEN;
+    case GxEPD_BLUE:
+      return BLUE;
+    case GxEPD_RED:
+      return RED;
+    case GxEPD_YELLOW:
+      return YELLOW;
+    case GxEPD_ORANGE:
+      return ORANGE;
+    default: {
+      const bool red = (color & 0xF800) >= 0x8000;
+      const bool green = ((color & 0x07E0) << 5) >= 0x8000;
+      const bool blue = ((color & 0x001F) << 11) >= 0x8000;
+      if (red && green && blue) {
+        return WHITE;
+      }
+      if (red && green) {
+        return (color & 0x07E0) > 0x0500 ? YELLOW : ORANGE;
+      }
+      return red ? RED : green ? GREEN : blue ? BLUE : BLACK;
+    }
+  }
+}
+
+// What one render did to the display.
+struct Stats {
+  uint32_t prints = 0;     // print() calls
+  uint32_t glyphs = 0;     // characters drawn
+  uint32_t bitmaps = 0;    // drawInvertedBitmap() calls
+  uint32_t lines = 0;      // drawLine() calls
+  uint32_t pixelCalls = 0; // drawPixel() calls
+  uint32_t written = 0;    // pixels stored into a page
+  uint32_t clipped = 0;    // pixels outside the page band or the panel
+  uint16_t pages = 0;      // pages drawn
+  uint16_t refreshes = 0;  // full refreshes (last nextPage())
+
+  uint32_t drawCalls() const { return prints + bitmaps + lines + pixelCalls; }
+};
+
+// Panel controller: its size and the BUSY callback of GxEPD2_EPD.
+class Driver {
+ public:
+  Driver(int16_t, int16_t, int16_t, int16_t) {}
+  void setBusyCallback(void (*busyCallback)(const void *), const void *busyParameter = 0) {
+    busyCallback_ = busyCallback;
+    busyParameter_ = busyParameter;
+  }
+  void busy() const {
+    if (busyCallback_ != nullptr) {
+      busyCallback_(busyParameter_);
+    }
+  }
+
+ private:
+  void (*busyCallback_)(const void *) = nullptr;
+  const void *busyParameter_ = nullptr;
+};
+
+template <typename Panel, uint16_t page_height, uint8_t (*InkOf)(uint16_t)>
+class Display : public Print {
+ public:
+  static constexpr int16_t WIDTH = Panel::WIDTH;
+  static constexpr int16_t HEIGHT = Panel::HEIGHT;
+
+  explicit Display(Panel epd2_instance) : epd2(epd2_instance), inks_(WIDTH * HEIGHT, WHITE) {}
+
+  Panel epd2;
+
+  void init(uint32_t, bool, uint16_t, bool) {
+    fillScreen(GxEPD_WHITE);
+    stats_ = Stats();
+  }
+  void setRotation(uint8_t) {}
+  void setTextSize(uint8_t) {}
+  void setTextColor(uint16_t color) { textColor_ = color; }
+  void setTextWrap(bool) {}
+  void setFullWindow() {}
+  void setFont(const GFXfont *font) { font_ = font; }
+  void setCursor(int16_t x, int16_t y) {
+    cursorX_ = x;
+    cursorY_ = y;
+  }
+  int16_t getCursorX() const { return cursorX_; }
+  int16_t getCursorY() const { return cursorY_; }
+  int16_t width() const { return WIDTH; }
+  int16_t height() const { return HEIGHT; }
+  uint16_t pageHeight() const { return page_height; }
+  void hibernate() {}
+
+  void fillScreen(uint16_t color) { std::fill(inks_.begin(), inks_.end(), InkOf(color)); }
+  void firstPage() {
+    fillScreen(GxEPD_WHITE);
+    page_ = 0;
+  }
+  // Ends the current page; after the last one the panel refreshes.
+  bool nextPage() {
+    ++stats_.pages;
+    if ((page_ + 1) * page_height < HEIGHT) {
+      ++page_;
+      return true;
+    }
+    ++stats_.refreshes;
+    epd2.busy();
+    return false;
+  }
+
+  size_t print(const char *text) {
+    ++stats_.prints;
+    return Print::print(text);
+  }
+  size_t print(const String &text) { return print(text.c_str()); }
+
+  // Adafruit_GFX::write() with a custom font.
+  size_t write(uint8_t c) override {
+    if (font_ == nullptr) {
+      cursorX_ += 6;  // the classic font is not rasterized
+      return 1;
+    }
+    if (c == '\n') {
+      cursorX_ = 0;
+      cursorY_ += font_->yAdvance;
+    } else if (c != '\r' && c >= font_->first && c <= font_->last) {
+      const GFXglyph &glyph = font_->glyph[c - font_->first];
+      if (glyph.width > 0 && glyph.height > 0) {
+        drawGlyph(glyph);
+      }
+      cursorX_ += glyph.xAdvance;
+    }
+    return 1;
+  }
+
+  // GxEPD2: pixels whose bit is clear get `color`, MSB first, rows padded to
+  // whole bytes.
+  void drawInvertedBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h, uint16_t color) {
+    ++stats_.bitmaps;
+    const int16_t byteWidth = (w + 7) / 8;
+    const uint8_t ink = InkOf(color);
+    for (int16_t j = 0; j < h; ++j) {
+      for (int16_t i = 0; i < w; ++i) {
+        if (!(bitmap[j * byteWidth + i / 8] & (0x80 >> (i & 7)))) {
+          plot(x + i, y + j, ink);
+        }
+      }
+    }
+  }
+
+  // Adafruit_GFX::writeLine().
+  void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
+    ++stats_.lines;
+    const uint8_t ink = InkOf(color);
+    const bool steep = abs(y1 - y0) > abs(x1 - x0);
+    if (steep) {
+      std::swap(x0, y0);
+      std::swap(x1, y1);
+    }
+    if (x0 > x1) {
+      std::swap(x0, x1);
+      std::swap(y0, y1);
+    }
+    const int16_t dx = x1 - x0;
+    const int16_t dy = abs(y1 - y0);
+    const int16_t ystep = y0 < y1 ? 1 : -1;
+    int16_t err = dx / 2;
+    for (; x0 <= x1; ++x0) {
+      if (steep) {
+        plot(y0, x0, ink);
+      } else {
+        plot(x0, y0, ink);
+      }
+      err -= dy;
+      if (err < 0) {
+        y0 += ystep;
+        err += dx;
+      }
+    }
+  }
+
+  void drawPixel(int16_t x, int16_t y, uint16_t color) {
+    ++stats_.pixelCalls;
+    plot(x, y, InkOf(color));
+  }
+
+  // Frame buffer, one Ink per pixel, rows top to bottom.
+  const uint8_t *inks() const { return inks_.data(); }
+  const Stats &stats() const { return stats_; }
+
+ private:
+  // Adafruit_GFX::drawChar() of a custom font glyph at text size 1.
+  void drawGlyph(const GFXglyph &glyph) {
+    ++stats_.glyphs;
+    const uint8_t ink = InkOf(textColor_);
+    const uint8_t *bitmap = font_->bitmap + glyph.bitmapOffset;
+    uint8_t bits = 0, bit = 0;
+    for (int16_t yy = 0; yy < glyph.height; ++yy) {
+      for (int16_t xx = 0; xx < glyph.width; ++xx) {
+        if (!(bit++ & 7)) {
+          bits = *bitmap++;
+        }
+        if (bits & 0x80) {
+          plot(cursorX_ + glyph.xOffset + xx, cursorY_ + glyph.yOffset + yy, ink);
+        }
+        bits <<= 1;
+      }
+    }
+  }
+
+  // Store a pixel if it lies on the panel and in the current page.
+  void plot(int32_t x, int32_t y, uint8_t ink) {
+    const int32_t top = static_cast<int32_t>(page_) * page_height;
+    if (x < 0 || x >= WIDTH || y < 0 || y >= HEIGHT || y < top || y >= top + page_height) {
+      ++stats_.clipped;
+      return;
+    }
+    ++stats_.written;
+    inks_[y * WIDTH + x] = ink;
+  }
+
+  std::vector<uint8_t> inks_;
+  Stats stats_;
+  const GFXfont *font_ = nullptr;
+  uint16_t textColor_ = GxEPD_BLACK;
+  int16_t cursorX_ = 0;
+  int16_t cursorY_ = 0;
+  uint16_t page_ = 0;
+};
+
+}  // namespace gxepd2_host
+
+#define GXEPD2_HOST_PANEL(Name, width, height)                   \
+  class Name : public gxepd2_host::Driver {                      \
+   public:                                                       \
+    static const uint16_t WIDTH = width;                         \
+    static const uint16_t HEIGHT = height;                       \
+    using gxepd2_host::Driver::Driver;                           \
+  }
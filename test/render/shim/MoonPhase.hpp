@@ -0,0 +1,2 @@
+/* Host stand-in: moon_tools.cpp is not linked, the driver supplies the moon. */
+#pragma once
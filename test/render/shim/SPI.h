@@ -0,0 +1,10 @@
+/* Host stand-in for the SPI bus the panel is remapped onto in initDisplay(). */
+#pragma once
+#include <cstdint>
+
+class SPIClass {
+ public:
+  void begin(int8_t = -1, int8_t = -1, int8_t = -1, int8_t = -1) {}
+  void end() {}
+};
+inline SPIClass SPI;
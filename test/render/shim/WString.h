@@ -0,0 +1,3 @@
+/* Host stand-in: String lives in Arduino.h. */
+#pragma once
+#include <Arduino.h>
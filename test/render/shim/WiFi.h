@@ -0,0 +1,14 @@
+/* Host stand-in for WiFiType.h's wl_status_t. */
+#pragma once
+
+typedef enum {
+  WL_STOPPED = 254,
+  WL_NO_SHIELD = 255,
+  WL_IDLE_STATUS = 0,
+  WL_NO_SSID_AVAIL = 1,
+  WL_SCAN_COMPLETED = 2,
+  WL_CONNECTED = 3,
+  WL_CONNECT_FAILED = 4,
+  WL_CONNECTION_LOST = 5,
+  WL_DISCONNECTED = 6
+} wl_status_t;
@@ -0,0 +1,13 @@
+/* Host stand-in for the ESP-IDF ADC calibration driver, see adc_oneshot.h. */
+#pragma once
+
+#include "adc_oneshot.h"
+
+typedef struct adc_cali_scheme_t *adc_cali_handle_t;
+typedef enum {
+  ADC_CALI_SCHEME_VER_LINE_FITTING = 1 << 0,
+  ADC_CALI_SCHEME_VER_CURVE_FITTING = 1 << 1,
+} adc_cali_scheme_ver_t;
+
+inline esp_err_t adc_cali_check_scheme(adc_cali_scheme_ver_t *) { return ESP_FAIL; }
+inline esp_err_t adc_cali_raw_to_voltage(adc_cali_handle_t, int, int *) { return ESP_FAIL; }
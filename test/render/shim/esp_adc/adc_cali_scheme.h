@@ -0,0 +1,15 @@
+/* Host stand-in for the ESP-IDF ADC calibration schemes, see adc_oneshot.h. */
+#pragma once
+
+#include "adc_cali.h"
+
+typedef struct {
+  adc_unit_t unit_id;
+  adc_atten_t atten;
+  adc_bitwidth_t bitwidth;
+  uint32_t default_vref;
+} adc_cali_line_fitting_config_t;
+
+inline esp_err_t adc_cali_create_scheme_line_fitting(const adc_cali_line_fitting_config_t *, adc_cali_handle_t *) {
+  return ESP_FAIL;
+}
@@ -0,0 +1,31 @@
+/* Host stand-in for the ESP-IDF ADC oneshot driver. There is no battery on
+ * the host: every call fails, so readBatteryVoltage() returns false. */
+#pragma once
+
+#include <Arduino.h>
+
+typedef enum { ADC_UNIT_1, ADC_UNIT_2 } adc_unit_t;
+typedef enum { ADC_CHANNEL_0 } adc_channel_t;
+typedef enum { ADC_ULP_MODE_DISABLE } adc_ulp_mode_t;
+typedef enum { ADC_ATTEN_DB_12 = 3 } adc_atten_t;
+typedef enum { ADC_BITWIDTH_12 = 12 } adc_bitwidth_t;
+typedef struct adc_oneshot_unit_ctx_t *adc_oneshot_unit_handle_t;
+
+typedef struct {
+  adc_unit_t unit_id;
+  adc_ulp_mode_t ulp_mode;
+} adc_oneshot_unit_init_cfg_t;
+
+typedef struct {
+  adc_atten_t atten;
+  adc_bitwidth_t bitwidth;
+} adc_oneshot_chan_cfg_t;
+
+inline esp_err_t adc_oneshot_io_to_channel(int, adc_unit_t *, adc_channel_t *) { return ESP_FAIL; }
+inline esp_err_t adc_oneshot_new_unit(const adc_oneshot_unit_init_cfg_t *, adc_oneshot_unit_handle_t *) {
+  return ESP_FAIL;
+}
+inline esp_err_t adc_oneshot_config_channel(adc_oneshot_unit_handle_t, adc_channel_t, const adc_oneshot_chan_cfg_t *) {
+  return ESP_FAIL;
+}
+inline esp_err_t adc_oneshot_read(adc_oneshot_unit_handle_t, adc_channel_t, int *) { return ESP_FAIL; }
@@ -0,0 +1,270 @@
+/* Baseline One Call decoder and decode measurement shared by the OWM suites.
+ *
+ * decodeDom() is the decoder OWMProvider used before the streaming
+ * handler: a filtered ArduinoJson document of the whole response, copied
+ * into the model afterwards. The suites keep it as the reference the
+ * streaming decoder must agree with, and as the "before" of the heap and
+ * time report.
+ *
+ * GPL-3.0, see LICENSE.
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <functional>
+#include <unity.h>
+#include <vector>
+
+#include "data_models.h"
+#include "owm_provider.h"
+#include "provider_result_utils.h"
+#include "response_body.h"
+
+namespace owm_onecall_bench {
+
+constexpr int kDomAlerts = 8;
+
+inline ProviderResult decodeDom(ResponseBody &json, forecast_t &forecast, std::vector<weather_alert_t> *alerts) {
+  JsonDocument filter;
+  filter["current"] = true;
+  filter["minutely"] = false;
+  filter["hourly"] = true;
+  filter["daily"] = true;
+  if (alerts == nullptr) {
+    filter["alerts"] = false;
+  } else {
+    for (int i = 0; i < kDomAlerts; ++i) {
+      filter["alerts"][i]["sender_name"] = false;
+      filter["alerts"][i]["event"] = true;
+      filter["alerts"][i]["start"] = true;
+      filter["alerts"][i]["end"] = true;
+      filter["alerts"][i]["description"] = false;
+      filter["alerts"][i]["tags"] = true;
+    }
+  }
+  JsonDocument doc;
+  DeserializationError error = deserializeJson(doc, json, DeserializationOption::Filter(filter));
+  if (error) {
+    return mapDeserializationError(error);
+  }
+  forecast.lat = doc["lat"].as<float>();
+  forecast.lon = doc["lon"].as<float>();
+  forecast.timezone = doc["timezone"].as<const char *>();
+  forecast.timezone_offset = doc["timezone_offset"].as<int>();
+
+  JsonObject current = doc["current"];
+  forecast.current.dt = current["dt"].as<int64_t>();
+  forecast.current.sunrise = current["sunrise"].as<int64_t>();
+  forecast.current.sunset = current["sunset"].as<int64_t>();
+  forecast.current.temp = current["temp"].as<float>();
+  forecast.current.feels_like = current["feels_like"].as<float>();
+  forecast.current.pressure = current["pressure"].as<int>();
+  forecast.current.humidity = current["humidity"].as<int>();
+  forecast.current.dew_point = current["dew_point"].as<float>();
+  forecast.current.clouds = current["clouds"].as<int>();
+  forecast.current.uvi = current["uvi"].as<float>();
+  forecast.current.visibility = current["visibility"].as<int>();
+  forecast.current.wind_speed = current["wind_speed"].as<float>();
+  forecast.current.wind_gust = current["wind_gust"].as<float>();
+  forecast.current.wind_deg = current["wind_deg"].as<int>();
+  forecast.current.rain_1h = current["rain"]["1h"].as<float>();
+  forecast.current.snow_1h = current["snow"]["1h"].as<float>();
+  JsonObject current_weather = current["weather"][0];
+  forecast.current.weather.condition = OWMProvider::mapWeatherCode(current_weather["id"].as<int>());
+  forecast.current.is_day = current_weather["icon"].as<String>().endsWith("d");
+
+  int i = 0;
+  for (JsonObject hourly : doc["hourly"].as<JsonArray>()) {
+    forecast.hourly[i].dt = hourly["dt"].as<int64_t>();
+    forecast.hourly[i].temp = hourly["temp"].as<float>();
+    forecast.hourly[i].feels_like = hourly["feels_like"].as<float>();
+    forecast.hourly[i].pressure = hourly["pressure"].as<int>();
+    forecast.hourly[i].humidity = hourly["humidity"].as<int>();
+    forecast.hourly[i].dew_point = hourly["dew_point"].as<float>();
+    forecast.hourly[i].clouds = hourly["clouds"].as<int>();
+    forecast.hourly[i].uvi = hourly["uvi"].as<float>();
+    forecast.hourly[i].visibility = hourly["visibility"].as<int>();
+    forecast.hourly[i].wind_speed = hourly["wind_speed"].as<float>();
+    forecast.hourly[i].wind_gust = hourly["wind_gust"].as<float>();
+    forecast.hourly[i].wind_deg = hourly["wind_deg"].as<int>();
+    forecast.hourly[i].pop = hourly["pop"].as<float>() * 100;
+    forecast.hourly[i].rain_1h = hourly["rain"]["1h"].as<float>();
+    forecast.hourly[i].snow_1h = hourly["snow"]["1h"].as<float>();
+    JsonObject hourly_weather = hourly["weather"][0];
+    forecast.hourly[i].weather.condition = OWMProvider::mapWeatherCode(hourly_weather["id"].as<int>());
+    forecast.hourly[i].is_day = hourly_weather["icon"].as<String>().endsWith("d");
+    if (i == NUM_HOURLY - 1) break;
+    ++i;
+  }
+
+  i = 0;
+  for (JsonObject daily : doc["daily"].as<JsonArray>()) {
+    forecast.daily[i].dt = daily["dt"].as<int64_t>();
+    forecast.daily[i].sunrise = daily["sunrise"].as<int64_t>();
+    forecast.daily[i].sunset = daily["sunset"].as<int64_t>();
+    JsonObject daily_temp = daily["temp"];
+    forecast.daily[i].temp.morn = daily_temp["morn"].as<float>();
+    forecast.daily[i].temp.day = daily_temp["day"].as<float>();
+    forecast.daily[i].temp.eve = daily_temp["eve"].as<float>();
+    forecast.daily[i].temp.night = daily_temp["night"].as<float>();
+    forecast.daily[i].temp.min = daily_temp["min"].as<float>();
+    forecast.daily[i].temp.max = daily_temp["max"].as<float>();
+    forecast.daily[i].pressure = daily["pressure"].as<int>();
+    forecast.daily[i].humidity = daily["humidity"].as<int>();
+    forecast.daily[i].dew_point = daily["dew_point"].as<float>();
+    forecast.daily[i].clouds = daily["clouds"].as<int>();
+    forecast.daily[i].uvi = daily["uvi"].as<float>();
+    forecast.daily[i].visibility = daily["visibility"].as<int>();
+    forecast.daily[i].wind_speed = daily["wind_speed"].as<float>();
+    forecast.daily[i].wind_gust = daily["wind_gust"].as<float>();
+    forecast.daily[i].wind_deg = daily["wind_deg"].as<int>();
+    forecast.daily[i].pop = daily["pop"].as<float>() * 100;
+    forecast.daily[i].rain = daily["rain"].as<float>();
+    forecast.daily[i].snow = daily["snow"].as<float>();
+    JsonObject daily_weather = daily["weather"][0];
+    forecast.daily[i].weather.condition = OWMProvider::mapWeatherCode(daily_weather["id"].as<int>());
+    if (i == NUM_DAILY - 1) break;
+    ++i;
+  }
+
+  if (alerts != nullptr) {
+    i = 0;
+    for (JsonObject alert : doc["alerts"].as<JsonArray>()) {
+      weather_alert_t new_alert = {};
+      new_alert.event = alert["event"].as<const char *>();
+      new_alert.start = alert["start"].as<int64_t>();
+      new_alert.end = alert["end"].as<int64_t>();
+      new_alert.tags = alert["tags"][0].as<const char *>();
+      alerts->push_back(new_alert);
+      if (i == kDomAlerts - 1) break;
+      ++i;
+    }
+  }
+  return ProviderResult::ok();
+}
+
+/* Field by field: floats within Unity's tolerance, as ArduinoJson and the
+ * streaming parser convert decimals independently. */
+inline void assertSameForecast(const forecast_t &expected, const forecast_t &actual) {
+  TEST_ASSERT_EQUAL_FLOAT(expected.lat, actual.lat);
+  TEST_ASSERT_EQUAL_FLOAT(expected.lon, actual.lon);
+  TEST_ASSERT_EQUAL_STRING(expected.timezone.c_str(), actual.timezone.c_str());
+  TEST_ASSERT_EQUAL_INT(expected.timezone_offset, actual.timezone_offset);
+  const current_t &ec = expected.current;
+  const current_t &ac = actual.current;
+  TEST_ASSERT_EQUAL_INT64(ec.dt, ac.dt);
+  TEST_ASSERT_EQUAL_INT64(ec.sunrise, ac.sunrise);
+  TEST_ASSERT_EQUAL_INT64(ec.sunset, ac.sunset);
+  TEST_ASSERT_EQUAL_FLOAT(ec.temp, ac.temp);
+  TEST_ASSERT_EQUAL_FLOAT(ec.feels_like, ac.feels_like);
+  TEST_ASSERT_EQUAL_INT(ec.pressure, ac.pressure);
+  TEST_ASSERT_EQUAL_INT(ec.humidity, ac.humidity);
+  TEST_ASSERT_EQUAL_FLOAT(ec.dew_point, ac.dew_point);
+  TEST_ASSERT_EQUAL_INT(ec.clouds, ac.clouds);
+  TEST_ASSERT_EQUAL_FLOAT(ec.uvi, ac.uvi);
+  TEST_ASSERT_EQUAL_INT(ec.visibility, ac.visibility);
+  TEST_ASSERT_EQUAL_FLOAT(ec.wind_speed, ac.wind_speed);
+  TEST_ASSERT_EQUAL_FLOAT(ec.wind_gust, ac.wind_gust);
+  TEST_ASSERT_EQUAL_INT(ec.wind_deg, ac.wind_deg);
+  TEST_ASSERT_EQUAL_FLOAT(ec.rain_1h, ac.rain_1h);
+  TEST_ASSERT_EQUAL_FLOAT(ec.snow_1h, ac.snow_1h);
+  TEST_ASSERT_EQUAL(ec.is_day, ac.is_day);
+  TEST_ASSERT_EQUAL(ec.weather.condition, ac.weather.condition);
+  for (int i = 0; i < NUM_HOURLY; ++i) {
+    const hourly_t &e = expected.hourly[i];
+    const hourly_t &a = actual.hourly[i];
+    TEST_ASSERT_EQUAL_INT64(e.dt, a.dt);
+    TEST_ASSERT_EQUAL_FLOAT(e.temp, a.temp);
+    TEST_ASSERT_EQUAL_FLOAT(e.feels_like, a.feels_like);
+    TEST_ASSERT_EQUAL_INT(e.pressure, a.pressure);
+    TEST_ASSERT_EQUAL_INT(e.humidity, a.humidity);
+    TEST_ASSERT_EQUAL_FLOAT(e.dew_point, a.dew_point);
+    TEST_ASSERT_EQUAL_INT(e.clouds, a.clouds);
+    TEST_ASSERT_EQUAL_FLOAT(e.uvi, a.uvi);
+    TEST_ASSERT_EQUAL_INT(e.visibility, a.visibility);
+    TEST_ASSERT_EQUAL_FLOAT(e.wind_speed, a.wind_speed);
+    TEST_ASSERT_EQUAL_FLOAT(e.wind_gust, a.wind_gust);
+    TEST_ASSERT_EQUAL_INT(e.wind_deg, a.wind_deg);
+    TEST_ASSERT_EQUAL_INT(e.pop, a.pop);
+    TEST_ASSERT_EQUAL_FLOAT(e.rain_1h, a.rain_1h);
+    TEST_ASSERT_EQUAL_FLOAT(e.snow_1h, a.snow_1h);
+    TEST_ASSERT_EQUAL(e.is_day, a.is_day);
+    TEST_ASSERT_EQUAL(e.weather.condition, a.weather.condition);
+  }
+  for (int i = 0; i < NUM_DAILY; ++i) {
+    const daily_t &e = expected.daily[i];
+    const daily_t &a = actual.daily[i];
+    TEST_ASSERT_EQUAL_INT64(e.dt, a.dt);
+    TEST_ASSERT_EQUAL_INT64(e.sunrise, a.sunrise);
+    TEST_ASSERT_EQUAL_INT64(e.sunset, a.sunset);
+    TEST_ASSERT_EQUAL_FLOAT(e.temp.morn, a.temp.morn);
+    TEST_ASSERT_EQUAL_FLOAT(e.temp.day, a.temp.day);
+    TEST_ASSERT_EQUAL_FLOAT(e.temp.eve, a.temp.eve);
+    TEST_ASSERT_EQUAL_FLOAT(e.temp.night, a.temp.night);
+    TEST_ASSERT_EQUAL_FLOAT(e.temp.min, a.temp.min);
+    TEST_ASSERT_EQUAL_FLOAT(e.temp.max, a.temp.max);
+    TEST_ASSERT_EQUAL_INT(e.pressure, a.pressure);
+    TEST_ASSERT_EQUAL_INT(e.humidity, a.humidity);
+    TEST_ASSERT_EQUAL_FLOAT(e.dew_point, a.dew_point);
+    TEST_ASSERT_EQUAL_INT(e.clouds, a.clouds);
+    TEST_ASSERT_EQUAL_FLOAT(e.uvi, a.uvi);
+    TEST_ASSERT_EQUAL_INT(e.visibility, a.visibility);
+    TEST_ASSERT_EQUAL_FLOAT(e.wind_speed, a.wind_speed);
+    TEST_ASSERT_EQUAL_FLOAT(e.wind_gust, a.wind_gust);
+    TEST_ASSERT_EQUAL_INT(e.wind_deg, a.wind_deg);
+    TEST_ASSERT_EQUAL_INT(e.pop, a.pop);
+    TEST_ASSERT_EQUAL_FLOAT(e.rain, a.rain);
+    TEST_ASSERT_EQUAL_FLOAT(e.snow, a.snow);
+    TEST_ASSERT_EQUAL(e.weather.condition, a.weather.condition);
+  }
+}
+
+/* Fixture body that notes the lowest free heap at every refill, i.e. while
+ * the decoder's allocations are live (as fetchHeapSample() does on a real
+ * fetch). */
+class HeapSamplingBody : public MemoryBody {
+ public:
+  HeapSamplingBody(const char *data, size_t len, size_t chunkSize) : MemoryBody(data, len, chunkSize) {}
+
+  uint32_t minFree = UINT32_MAX;
+
+ protected:
+  bool fill(const char *&data, size_t &len) override {
+    const uint32_t freeHeap = ESP.getFreeHeap();
+    minFree = freeHeap < minFree ? freeHeap : minFree;
+    return MemoryBody::fill(data, len);
+  }
+};
+
+struct Measurement {
+  uint32_t peakHeap;  // bytes allocated at the deepest point of the decode
+  uint32_t us;        // average decode time
+};
+
+/* Decode `json` `runs` times from 512 B chunks (a typical bulk read). */
+inline Measurement measure(const char *json, int runs, const std::function<ProviderResult(ResponseBody &)> &decode) {
+  Measurement m{0, 0};
+  const size_t len = strlen(json);
+  const uint32_t start = micros();
+  for (int i = 0; i < runs; ++i) {
+    const uint32_t freeBefore = ESP.getFreeHeap();
+    HeapSamplingBody body(json, len, 512);
+    decode(body);
+    const uint32_t peak = freeBefore > body.minFree ? freeBefore - body.minFree : 0;
+    m.peakHeap = peak > m.peakHeap ? peak : m.peakHeap;
+  }
+  m.us = (micros() - start) / static_cast<uint32_t>(runs);
+  return m;
+}
+
+inline void report(const char *name, const Measurement &dom, const Measurement &sax) {
+  char msg[160];
+  snprintf(msg, sizeof(msg), "%s: JsonDocument peak heap %u B, %u us; streaming peak heap %u B, %u us", name,
+           static_cast<unsigned>(dom.peakHeap), static_cast<unsigned>(dom.us), static_cast<unsigned>(sax.peakHeap),
+           static_cast<unsigned>(sax.us));
+  TEST_MESSAGE(msg);
+}
+
+}  // namespace owm_onecall_bench
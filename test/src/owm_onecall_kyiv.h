@@ -0,0 +1,12 @@
+/* One Call API 3.0 response fixture for Kyiv, shared by the OWM suites.
+ *
+ * Synthetic: laid out exactly like a live response to the query the
+ * provider builds (units=metric, exclude=minutely; 48 hourly and 8 daily
+ * entries, two alerts), with values generated for 2026-08-19 and frozen so
+ * the tests can hardcode them. GPL-3.0 applies to this file as part of the
+ * project.
+ */
+
+#pragma once
+
+static const char kOwmOneCallKyiv[] PROGMEM = R"JSON({"lat":50.4989,"lon":30.4974,"timezone":"Europe/Kyiv","timezone_offset":10800,"current":{"dt":1787120434,"sunrise":1787108951,"sunset":1787160620,"temp":21.37,"feels_like":21.02,"pressure":1013,"humidity":58,"dew_point":12.74,"uvi":2.31,"clouds":40,"visibility":10000,"wind_speed":3.6,"wind_deg":290,"wind_gust":6.71,"rain":{"1h":0.27},"weather":[{"id":500,"main":"Rain","description":"light rain","icon":"10d"}]},"hourly":[{"dt":1787119200,"temp":16.82,"feels_like":16.42,"pressure":1010,"humidity":50,"dew_point":8.52,"uvi":3.74,"clouds":0,"visibility":10000,"wind_speed":2.0,"wind_deg":200,"wind_gust":4.0,"weather":[{"id":800,"main":"Clear","description":"clear sky","icon":"01d"}],"pop":0.0},{"dt":1787122800,"temp":18.46,"feels_like":18.06,"pressure":1011,"humidity":53,"dew_point":10.16,"uvi":4.69,"clouds":13,"visibility":10000,"wind_speed":2.7,"wind_deg":211,"wind_gust":5.1,"weather":[{"id":800,"main":"Clear","description":"clear sky","icon":"01d"}],"pop":0.7},{"dt":1787126400,"temp":20.65,"feels_like":20.25,"pressure":1012,"humidity":56,"dew_point":12.35,"uvi":5.41,"clouds":26,"visibility":10000,"wind_speed":3.4,"wind_deg":222,"wind_gust":6.2,"weather":[{"id":800,"main":"Clear","description":"clear sky","icon":"01d"}],"pop":0.4},{"dt":1787130000,"temp":21.52,"feels_like":21.12,"pressure":1013,"humidity":59,"dew_point":13.22,"uvi":5.85,"clouds":39,"visibility":10000,"wind_speed":4.1,"wind_deg":233,"wind_gust":7.3,"weather":[{"id":801,"main":"Clouds","description":"few clouds","icon":"02d"}],"pop":0.1},{"dt":1787133600,"temp":23.1,"feels_like":22.7,"pressure":1014,"humidity":62,"dew_point":14.8,"uvi":6.0,"clouds":52,"visibility":10000,"wind_speed":4.8,"wind_deg":244,"wind_gust":8.4,"weather":[{"id":801,"main":"Clouds","description":"few clouds","icon":"02d"}],"pop":0.8},{"dt":1787137200,"temp":23.63,"feels_like":23.23,"pressure":1015,"humidity":65,"dew_point":15.33,"uvi":5.85,"clouds":65,"visibility":10000,"wind_speed":5.5,"wind_deg":255,"wind_gust":9.5,"weather":[{"id":803,"main":"Clouds","description":"broken clouds","icon":"04d"}],"pop":0.5},{"dt":1787140800,"temp":23.56,"feels_like":23.16,"pressure":1016,"humidity":68,"dew_point":15.26,"uvi":5.41,"clouds":78,"visibility":10000,"wind_speed":6.2,"wind_deg":266,"wind_gust":10.6,"weather":[{"id":803,"main":"Clouds","description":"broken clouds","icon":"04d"}],"pop":0.2},{"dt":1787144400,"temp":23.77,"feels_like":23.37,"pressure":1010,"humidity":71,"dew_point":15.47,"uvi":4.69,"clouds":91,"visibility":10000,"wind_speed":6.9,"wind_deg":277,"wind_gust":11.7,"weather":[{"id":500,"main":"Rain","description":"light rain","icon":"10d"}],"pop":0.9,"rain":{"1h":1.22}},{"dt":1787148000,"temp":22.6,"feels_like":22.2,"pressure":1011,"humidity":74,"dew_point":14.3,"uvi":3.74,"clouds":4,"visibility":10000,"wind_speed":7.6,"wind_deg":288,"wind_gust":12.8,"weather":[{"id":500,"main":"Rain","description":"light rain","icon":"10d"}],"pop":0.6,"rain":{"1h":0.11}},{"dt":1787151600,"temp":21.88,"feels_like":21.48,"pressure":1012,"humidity":77,"dew_point":13.58,"uvi":2.6,"clouds":17,"visibility":10000,"wind_speed":2.0,"wind_deg":299,"wind_gust":4.0,"weather":[{"id":804,"main":"Clouds","description":"overcast clouds","icon":"04d"}],"pop":0.3},{"dt":1787155200,"temp":20.07,"feels_like":19.67,"pressure":1013,"humidity":80,"dew_point":11.77,"uvi":1.34,"clouds":30,"visibility":10000,"wind_speed":2.7,"wind_deg":310,"wind_gust":5.1,"weather":[{"id":804,"main":"Clouds","description":"overcast clouds","icon":"04d"}],"pop":0.0},{"dt":1787158800,"temp":18.4,"feels_like":18.0,"pressure":1014,"humidity":83,"dew_point":10.1,"uvi":0,"clouds":43,"visibility":10000,"wind_speed":3.4,"wind_deg":321,"wind_gust":6.2,"weather":[{"id":211,"main":"Thunderstorm","description":"thunderstorm","icon":"11n"}],"pop":0.7,"rain":{"1h":1.22}},{"dt":1787162400,"temp":16.92,"feels_like":16.52,"pressure":1015,"humidity":86,"dew_point":8.62,"uvi":0,"clouds":56,"visibility":10000,"wind_speed":4.1,"wind_deg":332,"wind_gust":7.3,"weather":[{"id":211,"main":"Thunderstorm","description":"thunderstorm","icon":"11n"}],"pop":0.4,"rain":{"1h":0.11}},{"dt":1787166000,"temp":15.52,"feels_like":15.12,"pressure":1016,"humidity":89,"dew_point":7.22,"uvi":0,"clouds":69,"visibility":10000,"wind_speed":4.8,"wind_deg":343,"wind_gust":8.4,"weather":[{"id":211,"main":"Thunderstorm","description":"thunderstorm","icon":"11n"}],"pop":0.1,"rain":{"1h":0.48}},{"dt":1787169600,"temp":13.12,"feels_like":12.72,"pressure":1010,"humidity":52,"dew_point":4.82,"uvi":0,"clouds":82,"visibility":10000,"wind_speed":5.5,"wind_deg":354,"wind_gust":9.5,"weather":[{"id":800,"main":"Clear","description":"clear sky","icon":"01n"}],"pop":0.8},{"dt":1787173200,"temp":11.77,"feels_like":11.37,"pressure":1011,"humidity":55,"dew_point":3.47,"uvi":0,"clouds":95,"visibility":10000,"wind_speed":6.2,"wind_deg":5,"wind_gust":10.6,"weather":[{"id":800,"main":"Clear","description":"clear sky","icon":"01n"}],"pop":0.5},{"dt":1787176800,"temp":11.07,"feels_like":10.67,"pressure":1012,"humidity":58,"dew_point":2.77,"uvi":0,"clouds":8,"visibility":10000,"wind_speed":6.9,"wind_deg":16,"wind_gust":11.7,"weather":[{"id":801,"main":"Clouds","description":"few clouds","icon":"02n"}],"pop":0.2},{"dt":1787180400,"temp":10.69,"feels_like":10.29,"pressure":1013,"humidity":61,"dew_point":2.39,"uvi":0,"clouds":21,"visibility":10000,"wind_speed":7.6,"wind_deg":27,"wind_gust":12.8,"weather":[{"id":801,"main":"Clouds","description":"few clouds","icon":"02n"}],"pop":0.9},{"dt":1787184000,"temp":10.08,"feels_like":9.68,"pressure":1014,"humidity":64,"dew_point":1.78,"uvi":0,"clouds":34,"visibility":10000,"wind_speed":2.0,"wind_deg":38,"wind_gust":4.0,"weather":[{"id":803,"main":"Clouds","description":"broken clouds","icon":"04n"}],"pop":0.6},{"dt":1787187600,"temp":10.14,"feels_like":9.74,"pressure":1015,"humidity":67,"dew_point":1.84,"uvi":0,"clouds":47,"visibility":10000,"wind_speed":2.7,"wind_deg":49,"wind_gust":5.1,"weather":[{"id":803,"main":"Clouds","description":"broken clouds","icon":"04n"}],"pop":0.3},{"dt":1787191200,"temp":11.41,"feels_like":11.01,"pressure":1016,"humidity":70,"dew_point":3.11,"uvi":0,"clouds":60,"visibility":10000,"wind_speed":3.4,"wind_deg":60,"wind_gust":6.2,"weather":[{"id":500,"main":"Rain","description":"light rain","icon":"10n"}],"pop":0.0,"rain":{"1h":0.11}},{"dt":1787194800,"temp":11.6,"feels_like":11.2,"pressure":1010,"humidity":73,"dew_point":3.3,"uvi":0,"clouds":73,"visibility":10000,"wind_speed":4.1,"wind_deg":71,"wind_gust":7.3,"weather":[{"id":500,"main":"Rain","description":"light rain","icon":"10d"}],"pop":0.7,"rain":{"1h":0.48}},{"dt":1787198400,"temp":13.86,"feels_like":13.46,"pressure":1011,"humidity":76,"dew_point":5.56,"uvi":1.34,"clouds":86,"visibility":10000,"wind_speed":4.8,"wind_deg":82,"wind_gust":8.4,"weather":[{"id":804,"main":"Clouds","description":"overcast clouds","icon":"04d"}],"pop":0.4},{"dt":1787202000,"temp":14.98,"feels_like":14.58,"pressure":1012,"humidity":79,"dew_point":6.68,"uvi":2.6,"clouds":99,"visibility":10000,"wind_speed":5.5,"wind_deg":93,"wind_gust":9.5,"weather":[{"id":804,"main":"Clouds","description":"overcast clouds","icon":"04d"}],"pop":0.1},{"dt":1787205600,"temp":16.64,"feels_like":16.24,"pressure":1013,"humidity":82,"dew_point":8.34,"uvi":3.74,"clouds":12,"visibility":10000,"wind_speed":6.2,"wind_deg":104,"wind_gust":10.6,"weather":[{"id":804,"main":"Clouds","description":"overcast clouds","icon":"04d"}],"pop":0.8},{"dt":1787209200,"temp":18.43,"feels_like":18.03,"pressure":1014,"humidity":85,"dew_point":10.13,"uvi":4.69,"clouds":25,"visibility":10000,"wind_speed":6.9,"wind_deg":115,"wind_gust":11.7,"weather":[{"id":211,"main":"Thunderstorm","description":"thunderstorm","icon":"11d"}],"pop":0.5,"rain":{"1h":0.48}},{"dt":1787212800,"temp":20.31,"feels_like":19.91,"pressure":1015,"humidity":88,"dew_point":12.01,"uvi":5.41,"clouds":38,"visibility":10000,"wind_speed":7.6,"wind_deg":126,"wind_gust":12.8,"weather":[{"id":211,"main":"Thunderstorm","description":"thunderstorm","icon":"11d"}],"pop":0.2,"rain":{"1h":0.85}},{"dt":1787216400,"temp":22.27,"feels_like":21.87,"pressure":1016,"humidity":51,"dew_point":13.97,"uvi":5.85,"clouds":51,"visibility":10000,"wind_speed":2.0,"wind_deg":137,"wind_gust":4.0,"weather":[{"id":800,"main":"Clear","description":"clear sky","icon":"01d"}],"pop":0.9},{"dt":1787220000,"temp":22.74,"feels_like":22.34,"pressure":1010,"humidity":54,"dew_point":14.44,"uvi":6.0,"clouds":64,"visibility":10000,"wind_speed":2.7,"wind_deg":148,"wind_gust":5.1,"weather":[{"id":800,"main":"Clear","description":"clear sky","icon":"01d"}],"pop":0.6},{"dt":1787223600,"temp":23.84,"feels_like":23.44,"pressure":1011,"humidity":57,"dew_point":15.54,"uvi":5.85,"clouds":77,"visibility":10000,"wind_speed":3.4,"wind_deg":159,"wind_gust":6.2,"weather":[{"id":801,"main":"Clouds","description":"few clouds","icon":"02d"}],"pop":0.3},{"dt":1787227200,"temp":24.14,"feels_like":23.74,"pressure":1012,"humidity":60,"dew_point":15.84,"uvi":5.41,"clouds":90,"visibility":10000,"wind_speed":4.1,"wind_deg":170,"wind_gust":7.3,"weather":[{"id":801,"main":"Clouds","description":"few clouds","icon":"02d"}],"pop":0.0},{"dt":1787230800,"temp":23.63,"feels_like":23.23,"pressure":1013,"humidity":63,"dew_point":15.33,"uvi":4.69,"clouds":3,"visibility":10000,"wind_speed":4.8,"wind_deg":181,"wind_gust":8.4,"weather":[{"id":803,"main":"Clouds","description":"broken clouds","icon":"04d"}],"pop":0.7},{"dt":1787234400,"temp":23.11,"feels_like":22.71,"pressure":1014,"humidity":66,"dew_point":14.81,"uvi":3.74,"clouds":16,"visibility":10000,"wind_speed":5.5,"wind_deg":192,"wind_gust":9.5,"weather":[{"id":803,"main":"Clouds","description":"broken clouds","icon":"04d"}],"pop":0.4},{"dt":1787238000,"temp":21.51,"feels_like":21.11,"pressure":1015,"humidity":69,"dew_point":13.21,"uvi":2.6,"clouds":29,"visibility":10000,"wind_speed":6.2,"wind_deg":203,"wind_gust":10.6,"weather":[{"id":500,"main":"Rain","description":"light rain","icon":"10d"}],"pop":0.1,"rain":{"1h":0.48}},{"dt":1787241600,"temp":20.06,"feels_like":19.66,"pressure":1016,"humidity":72,"dew_point":11.76,"uvi":1.34,"clouds":42,"visibility":10000,"wind_speed":6.9,"wind_deg":214,"wind_gust":11.7,"weather":[{"id":500,"main":"Rain","description":"light rain","icon":"10d"}],"pop":0.8,"rain":{"1h":0.85}},{"dt":1787245200,"temp":18.52,"feels_like":18.12,"pressure":1010,"humidity":75,"dew_point":10.22,"uvi":0,"clouds":55,"visibility":10000,"wind_speed":7.6,"wind_deg":225,"wind_gust":12.8,"weather":[{"id":500,"main":"Rain","description":"light rain","icon":"10n"}],"pop":0.5,"rain":{"1h":1.22}},{"dt":1787248800,"temp":17.18,"feels_like":16.78,"pressure":1011,"humidity":78,"dew_point":8.88,"uvi":0,"clouds":68,"visibility":10000,"wind_speed":2.0,"wind_deg":236,"wind_gust":4.0,"weather":[{"id":804,"main":"Clouds","description":"overcast clouds","icon":"04n"}],"pop":0.2},{"dt":1787252400,"temp":15.12,"feels_like":14.72,"pressure":1012,"humidity":81,"dew_point":6.82,"uvi":0,"clouds":81,"visibility":10000,"wind_speed":2.7,"wind_deg":247,"wind_gust":5.1,"weather":[{"id":804,"main":"Clouds","description":"overcast clouds","icon":"04n"}],"pop":0.9},{"dt":1787256000,"temp":13.31,"feels_like":12.91,"pressure":1013,"humidity":84,"dew_point":5.01,"uvi":0,"clouds":94,"visibility":10000,"wind_speed":3.4,"wind_deg":258,"wind_gust":6.2,"weather":[{"id":211,"main":"Thunderstorm","description":"thunderstorm","icon":"11n"}],"pop":0.6,"rain":{"1h":0.85}},{"dt":1787259600,"temp":12.14,"feels_like":11.74,"pressure":1014,"humidity":87,"dew_point":3.84,"uvi":0,"clouds":7,"visibility":10000,"wind_speed":4.1,"wind_deg":269,"wind_gust":7.3,"weather":[{"id":211,"main":"Thunderstorm","description":"thunderstorm","icon":"11n"}],"pop":0.3,"rain":{"1h":1.22}},{"dt":1787263200,"temp":10.89,"feels_like":10.49,"pressure":1015,"humidity":50,"dew_point":2.59,"uvi":0,"clouds":20,"visibility":10000,"wind_speed":4.8,"wind_deg":280,"wind_gust":8.4,"weather":[{"id":800,"main":"Clear","description":"clear sky","icon":"01n"}],"pop":0.0},{"dt":1787266800,"temp":10.04,"feels_like":9.64,"pressure":1016,"humidity":53,"dew_point":1.74,"uvi":0,"clouds":33,"visibility":10000,"wind_speed":5.5,"wind_deg":291,"wind_gust":9.5,"weather":[{"id":800,"main":"Clear","description":"clear sky","icon":"01n"}],"pop":0.7},{"dt":1787270400,"temp":10.29,"feels_like":9.89,"pressure":1010,"humidity":56,"dew_point":1.99,"uvi":0,"clouds":46,"visibility":10000,"wind_speed":6.2,"wind_deg":302,"wind_gust":10.6,"weather":[{"id":801,"main":"Clouds","description":"few clouds","icon":"02n"}],"pop":0.4},{"dt":1787274000,"temp":10.44,"feels_like":10.04,"pressure":1011,"humidity":59,"dew_point":2.14,"uvi":0,"clouds":59,"visibility":10000,"wind_speed":6.9,"wind_deg":313,"wind_gust":11.7,"weather":[{"id":801,"main":"Clouds","description":"few clouds","icon":"02n"}],"pop":0.1},{"dt":1787277600,"temp":10.68,"feels_like":10.28,"pressure":1012,"humidity":62,"dew_point":2.38,"uvi":0,"clouds":72,"visibility":10000,"wind_speed":7.6,"wind_deg":324,"wind_gust":12.8,"weather":[{"id":803,"main":"Clouds","description":"broken clouds","icon":"04n"}],"pop":0.8},{"dt":1787281200,"temp":12.12,"feels_like":11.72,"pressure":1013,"humidity":65,"dew_point":3.82,"uvi":0,"clouds":85,"visibility":10000,"wind_speed":2.0,"wind_deg":335,"wind_gust":4.0,"weather":[{"id":803,"main":"Clouds","description":"broken clouds","icon":"04d"}],"pop":0.5},{"dt":1787284800,"temp":13.53,"feels_like":13.13,"pressure":1014,"humidity":68,"dew_point":5.23,"uvi":1.34,"clouds":98,"visibility":10000,"wind_speed":2.7,"wind_deg":346,"wind_gust":5.1,"weather":[{"id":803,"main":"Clouds","description":"broken clouds","icon":"04d"}],"pop":0.2},{"dt":1787288400,"temp":15.56,"feels_like":15.16,"pressure":1015,"humidity":71,"dew_point":7.26,"uvi":2.6,"clouds":11,"visibility":10000,"wind_speed":3.4,"wind_deg":357,"wind_gust":6.2,"weather":[{"id":500,"main":"Rain","description":"light rain","icon":"10d"}],"pop":0.9,"rain":{"1h":1.22}}],"daily":[{"dt":1787130000,"sunrise":1787108951,"sunset":1787160620,"moonrise":1787120000,"moonset":1787170000,"moon_phase":0.21,"summary":"Expect a day of partly cloudy with rain","temp":{"day":20.7,"min":12.0,"max":22,"night":13.1,"eve":19.6,"morn":12.7},"feels_like":{"day":20.4,"night":12.8,"eve":19.3,"morn":12.4},"pressure":1012,"humidity":55,"dew_point":9.5,"wind_speed":3.1,"wind_deg":250,"wind_gust":7.2,"weather":[{"id":801,"main":"Clouds","description":"few clouds","icon":"02d"}],"clouds":0,"pop":0.0,"uvi":5.2},{"dt":1787216400,"sunrise":1787195413,"sunset":1787246905,"moonrise":1787209300,"moonset":1787259500,"moon_phase":0.24,"summary":"Expect a day of partly cloudy with rain","temp":{"day":23.7,"min":12.6,"max":25,"night":13.7,"eve":22.6,"morn":13.3},"feels_like":{"day":23.4,"night":13.4,"eve":22.3,"morn":13.0},"pressure":1013,"humidity":58,"dew_point":9.9,"wind_speed":3.6,"wind_deg":267,"wind_gust":8.0,"weather":[{"id":500,"main":"Rain","description":"light rain","icon":"10d"}],"clouds":23,"pop":0.3,"uvi":5.3,"rain":2.3},{"dt":1787302800,"sunrise":1787281875,"sunset":1787333190,"moonrise":1787298600,"moonset":1787349000,"moon_phase":0.28,"summary":"Expect a day of partly cloudy with rain","temp":{"day":21.7,"min":13.2,"max":23,"night":14.3,"eve":20.6,"morn":13.9},"feels_like":{"day":21.4,"night":14.0,"eve":20.3,"morn":13.6},"pressure":1014,"humidity":61,"dew_point":10.3,"wind_speed":4.1,"wind_deg":284,"wind_gust":8.8,"weather":[{"id":211,"main":"Thunderstorm","description":"thunderstorm","icon":"11d"}],"clouds":46,"pop":0.6,"uvi":5.4,"rain":3.2},{"dt":1787389200,"sunrise":1787368337,"sunset":1787419475,"moonrise":1787387900,"moonset":1787438500,"moon_phase":0.31,"summary":"Expect a day of partly cloudy with rain","temp":{"day":24.7,"min":13.8,"max":26,"night":14.9,"eve":23.6,"morn":14.5},"feels_like":{"day":24.4,"night":14.6,"eve":23.3,"morn":14.2},"pressure":1015,"humidity":64,"dew_point":10.7,"wind_speed":4.6,"wind_deg":301,"wind_gust":9.6,"weather":[{"id":801,"main":"Clouds","description":"few clouds","icon":"02d"}],"clouds":69,"pop":0.9,"uvi":5.5},{"dt":1787475600,"sunrise":1787454799,"sunset":1787505760,"moonrise":1787477200,"moonset":1787528000,"moon_phase":0.35,"summary":"Expect a day of partly cloudy with rain","temp":{"day":22.7,"min":14.4,"max":24,"night":15.5,"eve":21.6,"morn":15.1},"feels_like":{"day":22.4,"night":15.2,"eve":21.3,"morn":14.8},"pressure":1016,"humidity":67,"dew_point":11.1,"wind_speed":5.1,"wind_deg":318,"wind_gust":10.4,"weather":[{"id":500,"main":"Rain","description":"light rain","icon":"10d"}],"clouds":92,"pop":0.2,"uvi":5.6,"rain":5.0},{"dt":1787562000,"sunrise":1787541261,"sunset":1787592045,"moonrise":1787566500,"moonset":1787617500,"moon_phase":0.38,"summary":"Expect a day of partly cloudy with rain","temp":{"day":20.7,"min":15.0,"max":22,"night":16.1,"eve":19.6,"morn":15.7},"feels_like":{"day":20.4,"night":15.8,"eve":19.3,"morn":15.4},"pressure":1017,"humidity":70,"dew_point":11.5,"wind_speed":5.6,"wind_deg":335,"wind_gust":11.2,"weather":[{"id":211,"main":"Thunderstorm","description":"thunderstorm","icon":"11d"}],"clouds":15,"pop":0.5,"uvi":5.7,"rain":5.9},{"dt":1787648400,"sunrise":1787627723,"sunset":1787678330,"moonrise":1787655800,"moonset":1787707000,"moon_phase":0.41,"summary":"Expect a day of partly cloudy with rain","temp":{"day":23.7,"min":15.6,"max":25,"night":16.7,"eve":22.6,"morn":16.3},"feels_like":{"day":23.4,"night":16.4,"eve":22.3,"morn":16.0},"pressure":1018,"humidity":73,"dew_point":11.9,"wind_speed":6.1,"wind_deg":352,"wind_gust":12.0,"weather":[{"id":801,"main":"Clouds","description":"few clouds","icon":"02d"}],"clouds":38,"pop":0.8,"uvi":5.8},{"dt":1787734800,"sunrise":1787714185,"sunset":1787764615,"moonrise":1787745100,"moonset":1787796500,"moon_phase":0.45,"summary":"Expect a day of partly cloudy with rain","temp":{"day":21.7,"min":16.2,"max":23,"night":17.3,"eve":20.6,"morn":16.9},"feels_like":{"day":21.4,"night":17.0,"eve":20.3,"morn":16.6},"pressure":1019,"humidity":76,"dew_point":12.3,"wind_speed":6.6,"wind_deg":9,"wind_gust":12.8,"weather":[{"id":500,"main":"Rain","description":"light rain","icon":"10d"}],"clouds":61,"pop":0.1,"uvi":5.9,"rain":7.7}],"alerts":[{"sender_name":"Ukrainian Hydrometeorological Center","event":"Thunderstorm warning","start":1787126400,"end":1787169600,"description":"In the afternoon and evening, thunderstorms are expected in places in Kyiv and the region; hail and wind gusts of 15-20 m/s. Level I danger, yellow.","tags":["Thunderstorm","Wind"]},{"sender_name":"Ukrainian Hydrometeorological Center","event":"Fire danger","start":1787205600,"end":1787378400,"description":"Extreme fire danger (class 5) is expected in Kyiv and the region.","tags":["Fire warning"]}]})JSON";
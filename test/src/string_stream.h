@@ -1,7 +1,8 @@
 /* Shared test helper: a minimal read-only Stream over a String.
  *
  * The framework's StreamString does not expose String assignment in this
- * Arduino core, so suites parse fixtures through this wrapper. To keep peak
+ * Arduino core, so suites that need a Stream (the per-byte baseline of the
+ * response body benchmark) read fixtures through this wrapper. To keep peak
  * heap low, the String is borrowed, not copied, whenever the caller already
  * owns it (the stream must not outlive it); construction from a C string -
  * char arrays, literals, temporaries built by implicit conversion - owns a
@@ -10,12 +10,31 @@
 
 #include "../test_harness.h"
 
+#include "air_quality_window.inc"
+#include "display_list.inc"
 #include "display_utils.inc"
+#include "fetch_cancel.inc"
+#include "fetch_schedule.inc"
+#include "inflate_stream.inc"
+#include "line_breaker.inc"
 #include "moon_tools.inc"
 #include "meteoalarm.inc"
 #include "open_meteo_air_quality_provider.inc"
 #include "open_meteo_weather_provider.inc"
+#include "open_meteo_flatbuffers.inc"  // after the provider suites: uses their fixtures
+#include "forecast_refresh.inc"        // likewise
+#include "parse_pipeline.inc"
+#include "response_body.inc"
+#include "response_cache.inc"
 #include "rtc_drift_correction.inc"
+#include "stack_watermark.inc"
+#include "text_metrics.inc"
+#include "tls_session_cache.inc"
+#include "view_model.inc"
+#include "wake_profiler.inc"
+#include "weather_column_scan.inc"
+#include "weather_key_dispatch.inc"
+#include "wifi_fast_connect.inc"
 
 void setUp(void) { test_harness::dispatchSetUp(); }
 
@@ -25,12 +44,31 @@ void setup() {
   delay(200);  // let the emulated UART settle
   UNITY_BEGIN();
 
+  air_quality_window_tests::registerTests();
+  display_list_tests::registerTests();
   display_utils_tests::registerTests();
+  fetch_cancel_tests::registerTests();
+  fetch_schedule_tests::registerTests();
+  inflate_stream_tests::registerTests();
+  line_breaker_tests::registerTests();
   rtc_drift_correction_tests::registerTests();
   moon_tools_tests::registerTests();
   open_meteo_weather_tests::registerTests();
   open_meteo_air_quality_tests::registerTests();
+  open_meteo_flatbuffers_tests::registerTests();
+  forecast_refresh_tests::registerTests();
   meteoalarm_tests::registerTests();
+  parse_pipeline_tests::registerTests();
+  response_body_tests::registerTests();
+  response_cache_tests::registerTests();
+  stack_watermark_tests::registerTests();
+  text_metrics_tests::registerTests();
+  tls_session_cache_tests::registerTests();
+  view_model_tests::registerTests();
+  wake_profiler_tests::registerTests();
+  weather_column_scan_tests::registerTests();
+  weather_key_dispatch_tests::registerTests();
+  wifi_fast_connect_tests::registerTests();
 
   UNITY_END();
 }
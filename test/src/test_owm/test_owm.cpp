@@ -6,6 +6,7 @@
 #include <unity.h>
 
 #include "../test_harness.h"
+#include "owm_onecall.inc"
 #include "owm_weather_provider.inc"
 
 void setUp(void) { test_harness::dispatchSetUp(); }
@@ -16,6 +17,7 @@ void setup() {
   delay(200);  // let the emulated UART settle
   UNITY_BEGIN();
   owm_weather_tests::registerTests();
+  owm_onecall_tests::registerTests();
   UNITY_END();
 }
 
@@ -6,6 +6,7 @@
 #include <unity.h>
 
 #include "fetch_executor.inc"
+#include "owm_onecall_alerts.inc"
 #include "../test_harness.h"
 
 void setUp(void) { test_harness::dispatchSetUp(); }
@@ -16,6 +17,7 @@ void setup() {
   delay(200);  // let the emulated UART settle
   UNITY_BEGIN();
   fetch_executor_tests::registerTests();
+  owm_onecall_alerts_tests::registerTests();
   UNITY_END();
 }
 